@@ -0,0 +1,89 @@
+#pragma once
+
+#include "application/SystemManager.h"
+#include "infrastructure/logger/Logger.h"
+#include "infrastructure/utils/FixedThreadPool.h"
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 分组反馈轮询调度器 -- 主循环"反馈阶段"的并行执行者
+ *
+ * 每个分组拥有独立的 SystemContext + 驱动（+ FakePLC），彼此之间没有共享可变状态，
+ * 因此 pollFeedback 与急停命令消费可以在分组之间并行执行。
+ *
+ * pollAll() 的语义与原先 main.cpp 中的顺序循环完全一致:
+ *   对每个分组:
+ *     1. drv->pollFeedback(ctx)                  -- 反馈注入（轴 + 龙门 + 急停）
+ *     2. 消费 EmergencyStopController 的 pending command 并下发
+ *   全部分组完成后才返回（join 屏障），随后调用方再推进 ViewModel 阶段。
+ *
+ * 线程约束:
+ *   - 同一分组在一次 pollAll() 中只由一个线程处理
+ *   - ViewModel / Orchestrator 仍然只在主线程运行，不与本阶段重叠
+ *   - workerCount == 0 时退化为主线程顺序执行（与旧行为逐字节一致）
+ */
+class GroupPollScheduler {
+public:
+    explicit GroupPollScheduler(SystemManager& manager, size_t workerCount = defaultWorkerCount())
+        : m_manager(manager)
+        , m_pool(workerCount)
+    {}
+
+    /// @brief 并行推进所有分组的反馈阶段，全部完成后返回
+    void pollAll() {
+        m_names = m_manager.groupNames();
+        m_contexts.clear();
+        for (const auto& name : m_names) {
+            SystemContext* ctx = nullptr;
+            ContextRejection r;
+            if (m_manager.tryGetGroup(name, ctx, r) && ctx && ctx->driver()) {
+                m_contexts.push_back({&name, ctx});
+            }
+        }
+
+        m_pool.parallelFor(m_contexts.size(), m_job);
+    }
+
+    [[nodiscard]] size_t workerCount() const { return m_pool.workerCount(); }
+
+    /// @brief 默认工作线程数：主线程也参与执行，因此额外线程数 = min(硬件并发, 4) - 1
+    static size_t defaultWorkerCount() {
+        size_t hw = std::max(1u, std::thread::hardware_concurrency());
+        return std::min<size_t>(hw, 4) - 1;
+    }
+
+private:
+    struct Entry {
+        const std::string* name;
+        SystemContext* ctx;
+    };
+
+    SystemManager& m_manager;
+    FixedThreadPool m_pool;
+    std::vector<std::string> m_names;
+    std::vector<Entry> m_contexts;
+    const std::function<void(size_t)> m_job = [this](size_t i) {
+        pollGroup(*m_contexts[i].name, *m_contexts[i].ctx);
+    };
+
+    static void pollGroup(const std::string& groupName, SystemContext& ctx) {
+        auto* drv = ctx.driver();
+
+        // 1. 反馈注入（轴 + 龙门 + 急停）
+        drv->pollFeedback(ctx);
+
+        // 2. 消费 EmergencyStopController 产生的 pending command
+        auto& estopCtrl = ctx.emergencyStopController();
+        if (estopCtrl.hasPendingCommand()) {
+            auto commResult = drv->send(estopCtrl.popPendingCommand());
+            if (!commResult.ok()) {
+                LOG_WARN(LogLayer::APP, "System",
+                    "[" + groupName + "] EmergencyStop command delivery failed: " + commResult.describe());
+            }
+        }
+    }
+};
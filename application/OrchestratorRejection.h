@@ -0,0 +1,12 @@
+#pragma once
+
+/**
+ * @brief 编排器流程层拒绝原因
+ *
+ * 独立于各领域拒绝枚举：领域层只裁决单条命令，
+ * 这里描述的是编排流程本身的失败（如某一步骤等待超过了配置的期限）。
+ */
+enum class OrchestratorRejection {
+    None,           // 无拒绝
+    StepTimeout,    // 当前步骤停留时间超过 OrchestratorStepTrace 配置的期限
+};
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <string>
 #include <map>
 #include <memory>
@@ -54,7 +55,28 @@ public:
     }
 
     void removeGroup(const std::string& name) {
-        m_groups.erase(name);
+        if (m_groups.erase(name) > 0) {
+            ++m_generation;
+        }
+    }
+
+    /**
+     * @brief 分组代数：每次移除分组时递增
+     *
+     * 缓存了 SystemContext* 的调用方（AxisHandle）比较代数即可判断指针是否仍有效；
+     * 新建分组不影响已有分组的地址，不递增。
+     */
+    uint64_t generation() const { return m_generation; }
+
+    /**
+     * @brief 按名称顺序遍历全部分组（一次遍历，不做逐个名称查找）
+     * @param fn 回调 fn(const std::string& name, SystemContext& group)；回调内不得增删分组
+     */
+    template<typename Fn>
+    void forEachGroup(Fn&& fn) {
+        for (auto& [name, group] : m_groups) {
+            fn(name, *group);
+        }
     }
 
     /**
@@ -73,4 +95,5 @@ public:
 
 private:
     std::map<std::string, std::unique_ptr<SystemContext>> m_groups;
+    uint64_t m_generation = 0;
 };
@@ -0,0 +1,262 @@
+#pragma once
+
+#include "infrastructure/logger/Logger.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 主循环工作项的优先级类别（声明顺序即每帧执行顺序）
+ *
+ * Feedback 与 Safety 是关键类：每帧必定执行，不受时间预算约束。
+ * Feedback 排在 Safety 之前，安全项（急停状态投影、确认延迟探针）读到的是本帧刚注入的反馈。
+ */
+enum class TickPriority : uint8_t {
+    Feedback,       ///< 分组反馈轮询 + 急停命令消费
+    Safety,         ///< 急停 ViewModel
+    Motion,         ///< 编排器推进（轴 / 龙门）
+    UiProjection,   ///< 状态投影与 Qt 信号
+    Telemetry,      ///< 周期性摘要日志
+};
+
+/**
+ * @brief 主循环心跳调度器 -- 按优先级类别、在每帧时间预算内执行工作项
+ *
+ * 取代 main.cpp 中固定顺序、无上限的 tick 列表：
+ *
+ *   TickScheduler scheduler(std::chrono::milliseconds(8));
+ *   scheduler.add("poll", TickPriority::Feedback, [&] { pollScheduler.pollAll(); });
+ *   scheduler.add("estop.A", TickPriority::Safety, [&] { emergencyVM_A.tick(); });
+ *   scheduler.add("axis.A.Y", TickPriority::Motion, [&] { qtVM_A_Y.advance(); });
+ *   scheduler.add("summary", TickPriority::Telemetry, [&] { logSummary(); }, {}, 100);
+ *   QTimer -> scheduler.tick();
+ *
+ * 每帧语义：
+ *   1. 按类别顺序执行；同类工作项按注册顺序执行，上一帧被推迟的工作项本帧最先执行（不会饿死）
+ *   2. 关键类（Feedback / Safety）全部执行
+ *   3. 非关键类在执行前检查本帧已用时间：达到 tickBudget 后，本类剩余项及所有更低类别推迟到下一帧
+ *   4. 单项耗时超过自身预算（> 0 时）记一次超限；整帧超过 tickBudget 记一次整帧超限
+ *   5. 关键阶段结束时刻超过 criticalDeadline 记一次期限错失（只能由关键项自身造成）
+ *
+ * 工作项不可抢占：一个慢的非关键项最多使本帧超出一个单项耗时，其后的非关键项全部推迟，
+ * 下一帧的关键阶段照常最先执行。
+ *
+ * 线程约束：只在主线程调用，工作项内部可自行并行（如 GroupPollScheduler）。
+ */
+class TickScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    using ClockFn = std::function<Clock::time_point()>;
+    using Work = std::function<void()>;
+
+    static constexpr size_t CLASS_COUNT = static_cast<size_t>(TickPriority::Telemetry) + 1;
+
+    /// @brief 单个工作项（或一个类别汇总）的计数
+    struct ItemStats {
+        uint64_t runs = 0;
+        uint64_t deferred = 0;                  ///< 因预算耗尽被推迟的次数
+        uint64_t overruns = 0;                  ///< 单次耗时超过自身预算的次数
+        std::chrono::nanoseconds maxCost{0};    ///< 单次最大耗时
+    };
+
+    /// @brief 整体计数
+    struct Stats {
+        uint64_t ticks = 0;
+        uint64_t overrunTicks = 0;              ///< 整帧耗时超过 tickBudget 的帧数
+        uint64_t deferringTicks = 0;            ///< 至少推迟了一个工作项的帧数
+        uint64_t deferred = 0;                  ///< 累计推迟的工作项次数
+        uint64_t criticalDeadlineMisses = 0;    ///< 关键阶段晚于 criticalDeadline 结束的帧数
+        std::chrono::nanoseconds maxCriticalPhase{0};
+        std::chrono::nanoseconds maxTick{0};
+    };
+
+    /**
+     * @param tickBudget       每帧非关键工作的时间预算（自帧开始计）
+     * @param criticalDeadline 关键阶段（Feedback + Safety）须在帧开始后多久内完成
+     */
+    explicit TickScheduler(std::chrono::microseconds tickBudget = std::chrono::milliseconds(8),
+                           std::chrono::microseconds criticalDeadline = std::chrono::milliseconds(5))
+        : m_tickBudget(tickBudget)
+        , m_criticalDeadline(criticalDeadline)
+    {}
+
+    // ========== 注册 ==========
+
+    /**
+     * @brief 注册工作项
+     * @param name        诊断名称（日志 / 统计）
+     * @param priority    优先级类别
+     * @param work        每帧执行的函数
+     * @param budget      单次耗时预算；0 表示不单独限制
+     * @param periodTicks 每隔多少帧执行一次（1 = 每帧）；被推迟的周期项在下一帧补执行
+     * @return 工作项编号（查询统计用）
+     */
+    size_t add(std::string name, TickPriority priority, Work work,
+               std::chrono::microseconds budget = std::chrono::microseconds{0},
+               uint32_t periodTicks = 1) {
+        const size_t id = m_items.size();
+        m_items.push_back(Item{std::move(name), priority, std::move(work), budget,
+                               std::max<uint32_t>(periodTicks, 1), 0, false, ItemStats{}});
+        m_classes[index(priority)].push_back(id);
+        return id;
+    }
+
+    // ========== 每帧调用 ==========
+
+    void tick() {
+        const auto start = now();
+        const uint64_t tickNo = ++m_stats.ticks;
+        bool exhausted = false;
+        uint64_t deferredThisTick = 0;
+
+        for (size_t c = 0; c < CLASS_COUNT; ++c) {
+            const bool critical = isCritical(static_cast<TickPriority>(c));
+            const auto& ids = m_classes[c];
+            const size_t n = ids.size();
+            const size_t first = m_resume[c] < n ? m_resume[c] : 0;
+            size_t resumeAt = n;
+
+            for (size_t k = 0; k < n; ++k) {
+                const size_t slot = (first + k) % n;
+                Item& item = m_items[ids[slot]];
+                if (!item.pending && tickNo - item.lastRunTick < item.periodTicks) continue;
+
+                if (!critical && !exhausted && now() - start >= m_tickBudget) {
+                    exhausted = true;
+                }
+                if (exhausted) {
+                    item.pending = true;
+                    ++item.stats.deferred;
+                    ++deferredThisTick;
+                    if (resumeAt == n) resumeAt = slot;
+                    continue;
+                }
+                run(item, tickNo);
+            }
+            m_resume[c] = resumeAt == n ? 0 : resumeAt;
+
+            if (static_cast<TickPriority>(c) == TickPriority::Safety) {
+                closeCriticalPhase(now() - start);
+            }
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now() - start);
+        m_stats.maxTick = std::max(m_stats.maxTick, elapsed);
+        if (elapsed > m_tickBudget) {
+            ++m_stats.overrunTicks;
+            LOG_WARN_EVERY_MS(5000, LogLayer::APP, "TickScheduler",
+                "tick overran budget: " + std::to_string(elapsed.count() / 1000) + "us > "
+                + std::to_string(m_tickBudget.count()) + "us");
+        }
+        if (deferredThisTick > 0) {
+            ++m_stats.deferringTicks;
+            m_stats.deferred += deferredThisTick;
+        }
+    }
+
+    // ========== 查询 ==========
+
+    [[nodiscard]] const Stats& stats() const { return m_stats; }
+    [[nodiscard]] size_t itemCount() const { return m_items.size(); }
+    [[nodiscard]] const std::string& name(size_t id) const { return m_items[id].name; }
+    [[nodiscard]] const ItemStats& itemStats(size_t id) const { return m_items[id].stats; }
+
+    /// @brief 某类别全部工作项的汇总（maxCost 取各项最大值）
+    [[nodiscard]] ItemStats classStats(TickPriority priority) const {
+        ItemStats out;
+        for (size_t id : m_classes[index(priority)]) {
+            const ItemStats& s = m_items[id].stats;
+            out.runs += s.runs;
+            out.deferred += s.deferred;
+            out.overruns += s.overruns;
+            out.maxCost = std::max(out.maxCost, s.maxCost);
+        }
+        return out;
+    }
+
+    /// @brief 当前被推迟、等待下一帧执行的工作项数
+    [[nodiscard]] size_t backlog() const {
+        return static_cast<size_t>(std::count_if(m_items.begin(), m_items.end(),
+                                                 [](const Item& i) { return i.pending; }));
+    }
+
+    [[nodiscard]] std::chrono::microseconds tickBudget() const { return m_tickBudget; }
+    [[nodiscard]] std::chrono::microseconds criticalDeadline() const { return m_criticalDeadline; }
+
+    static constexpr bool isCritical(TickPriority p) {
+        return p == TickPriority::Feedback || p == TickPriority::Safety;
+    }
+
+    // ========== 配置 / 测试辅助 ==========
+
+    void setTickBudget(std::chrono::microseconds budget) { m_tickBudget = budget; }
+    void setCriticalDeadline(std::chrono::microseconds deadline) { m_criticalDeadline = deadline; }
+
+    /// @brief 替换时钟（测试中使用虚拟时间）；空函数恢复 steady_clock
+    void setClock(ClockFn clock) { m_clock = std::move(clock); }
+
+    void resetStats() {
+        m_stats = Stats{};
+        for (auto& item : m_items) {
+            item.stats = ItemStats{};
+            item.lastRunTick = 0;
+        }
+    }
+
+private:
+    struct Item {
+        std::string name;
+        TickPriority priority;
+        Work work;
+        std::chrono::microseconds budget;
+        uint32_t periodTicks;
+        uint64_t lastRunTick;
+        bool pending;           ///< 上一帧被推迟
+        ItemStats stats;
+    };
+
+    static constexpr size_t index(TickPriority p) { return static_cast<size_t>(p); }
+
+    Clock::time_point now() const { return m_clock ? m_clock() : Clock::now(); }
+
+    void run(Item& item, uint64_t tickNo) {
+        const auto begin = now();
+        item.work();
+        const auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(now() - begin);
+
+        item.pending = false;
+        item.lastRunTick = tickNo;
+        ++item.stats.runs;
+        item.stats.maxCost = std::max(item.stats.maxCost, cost);
+        if (item.budget.count() > 0 && cost > item.budget) {
+            ++item.stats.overruns;
+            LOG_WARN_EVERY_MS(5000, LogLayer::APP, "TickScheduler",
+                item.name + " overran its budget: " + std::to_string(cost.count() / 1000) + "us > "
+                + std::to_string(item.budget.count()) + "us");
+        }
+    }
+
+    void closeCriticalPhase(Clock::duration elapsed) {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+        m_stats.maxCriticalPhase = std::max(m_stats.maxCriticalPhase, ns);
+        if (ns > m_criticalDeadline) {
+            ++m_stats.criticalDeadlineMisses;
+            LOG_WARN_EVERY_MS(5000, LogLayer::APP, "TickScheduler",
+                "critical phase missed its deadline: " + std::to_string(ns.count() / 1000) + "us > "
+                + std::to_string(m_criticalDeadline.count()) + "us");
+        }
+    }
+
+    std::chrono::microseconds m_tickBudget;
+    std::chrono::microseconds m_criticalDeadline;
+    ClockFn m_clock;
+
+    std::vector<Item> m_items;
+    std::array<std::vector<size_t>, CLASS_COUNT> m_classes{};
+    std::array<size_t, CLASS_COUNT> m_resume{};   ///< 每类下一帧的起始位置（首个被推迟的项）
+    Stats m_stats;
+};
@@ -1,17 +1,19 @@
 #pragma once
+#include <type_traits>
 #include <variant>
 #include "entity/ContextRejection.h"
 #include "entity/Axis.h"              // RejectionReason
 #include "gantry/GantryRejection.h"
 #include "safety/SafetyRejection.h"
 #include "infrastructure/ISystemDriver.h"  // CommunicationResult
+#include "application/OrchestratorRejection.h"
 
 /**
  * @brief 应用层统一的错误聚合类型
  * 
  * 各领域层保持自己的错误枚举独立定义（Axis::RejectionReason、
- * ContextRejection、GantryRejection、SafetyRejection），UseCase 在跨越多个层级时，
- * 用此 variant 聚合所有可能的错误类型，不做类型擦除。
+ * ContextRejection、GantryRejection、SafetyRejection），编排器自身的流程失败使用
+ * OrchestratorRejection。UseCase 在跨越多个层级时，用此 variant 聚合所有可能的错误类型，不做类型擦除。
  * 
  * std::monostate 代表"执行成功，无错误"。
  */
@@ -21,5 +23,11 @@ using UseCaseError = std::variant<
     RejectionReason,        // Axis 领域层（命令未生成）
     CommunicationResult,    // 通讯失败（命令已生成但未送达 PLC）
     GantryRejection,        // Gantry 联动层
-    SafetyRejection         // 安全域急停层
+    SafetyRejection,        // 安全域急停层
+    OrchestratorRejection   // 编排器流程层（步骤超时）
 >;
+
+// UseCaseError 沿 UseCase -> Orchestrator -> ViewModel 逐层按值返回，
+// 所有备选均为枚举或平凡类型，整体保持平凡可拷贝（无分配、无析构开销）
+static_assert(std::is_trivially_copyable_v<UseCaseError>,
+              "UseCaseError 必须保持平凡可拷贝");
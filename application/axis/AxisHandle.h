@@ -0,0 +1,101 @@
+#pragma once
+#include "application/SystemManager.h"
+#include "domain/entity/AxisId.h"
+#include "domain/entity/ContextRejection.h"
+#include "domain/entity/SystemContext.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+
+/**
+ * @brief 预绑定的轴句柄（分组 + 轴，查找一次、按代数复核）
+ *
+ * 用例按 (manager, groupName, axisId) 调用时，每次都要做分组字符串查找 + 轴容器查找。
+ * 句柄在首次 tryAcquire() 时完成查找并缓存 SystemContext* / Axis*，之后只比较
+ * SystemManager::generation() 与 SystemContext::generation()；分组被移除、轴登记、
+ * 驱动替换都会使代数变化，句柄随即重新查找。
+ *
+ * 缓存命中时 tryAcquire() 只剩 SystemContext::checkControlAccess()（急停锁定 + 龙门语义），
+ * 拦截顺序与错误码和 tryGetAxis() 完全一致。
+ *
+ * 使用示例：
+ *   AxisHandle y(manager, "Machine_A", AxisId::Y);
+ *   EnableUseCase{}.execute(y, true);
+ *   MoveAbsoluteUseCase{}.execute(y, 100.0);
+ *
+ * 句柄不拥有分组与轴，须与 SystemManager 在同一线程使用。
+ */
+class AxisHandle {
+public:
+    AxisHandle(SystemManager& manager, std::string groupName, AxisId id)
+        : m_manager(&manager)
+        , m_groupName(std::move(groupName))
+        , m_id(id)
+    {
+    }
+
+    /// @brief 改绑到同组的另一根轴（编排器 start*() 时调用）；同一轴保留缓存
+    void rebind(AxisId id) {
+        if (id != m_id) {
+            m_id = id;
+            m_axis = nullptr;
+        }
+    }
+
+    AxisId id() const { return m_id; }
+    const std::string& groupName() const { return m_groupName; }
+
+    /**
+     * @brief Try-Get 模式获取轴（控制操作入口，等价于 tryGetGroup + tryGetAxis）
+     * @param[out] outAxis 成功时指向轴实体，失败为 nullptr
+     * @param[out] reason  失败时的拒绝原因（GroupNotFound / SystemSafetyLocked / 龙门语义 / AxisNotRegistered）
+     * @return true 允许访问；false 拒绝访问
+     */
+    bool tryAcquire(Axis*& outAxis, ContextRejection& reason) {
+        if (isCurrent()) {
+            if (!m_group->checkControlAccess(m_id, reason)) {
+                outAxis = nullptr;
+                return false;
+            }
+            outAxis = m_axis;
+            return true;
+        }
+        return resolve(outAxis, reason);
+    }
+
+    /// @brief 最近一次成功 tryAcquire() 所在的分组（其后同一帧内有效）
+    SystemContext* context() const { return m_group; }
+
+    /// @brief 缓存是否仍有效（诊断 / 测试用）
+    bool isCurrent() const {
+        return m_axis
+            && m_managerGeneration == m_manager->generation()
+            && m_contextGeneration == m_group->generation();
+    }
+
+private:
+    /// @brief 完整查找：分组字符串查找 + tryGetAxis，成功后记录代数
+    bool resolve(Axis*& outAxis, ContextRejection& reason) {
+        m_axis = nullptr;
+        if (!m_manager->tryGetGroup(m_groupName, m_group, reason)) {
+            outAxis = nullptr;
+            return false;
+        }
+        if (!m_group->tryGetAxis(m_id, outAxis, reason)) {
+            return false;
+        }
+        m_axis = outAxis;
+        m_managerGeneration = m_manager->generation();
+        m_contextGeneration = m_group->generation();
+        return true;
+    }
+
+    SystemManager* m_manager;
+    std::string m_groupName;
+    AxisId m_id;
+
+    SystemContext* m_group = nullptr;
+    Axis* m_axis = nullptr;
+    uint64_t m_managerGeneration = 0;
+    uint64_t m_contextGeneration = 0;
+};
@@ -4,6 +4,7 @@
 #include "domain/entity/AxisId.h"
 #include "domain/entity/SystemContext.h"
 #include "application/SystemManager.h"
+#include "application/axis/AxisHandle.h"
 
 /**
  * @brief 使能/掉电用例（统一命令总线重构版）
@@ -61,21 +62,42 @@ public:
             return ctxReason;
         }
 
+        return dispatch(*group, *axis, axisId, active);
+    }
+
+    /**
+     * @brief 对预绑定的轴执行使能/掉电（省去分组与轴查找，拦截与错误码同上）
+     * @param handle    目标轴句柄
+     * @param active    同上
+     * @return UseCaseError -- monostate 表示成功，否则为具体错误码
+     */
+    UseCaseError execute(AxisHandle& handle, bool active) {
+        Axis* axis = nullptr;
+        ContextRejection reason = ContextRejection::None;
+        if (!handle.tryAcquire(axis, reason)) {
+            return reason;
+        }
+        return dispatch(*handle.context(), *axis, handle.id(), active);
+    }
+
+private:
+    /// @brief 领域层判定 + 命令下发（两个 execute 重载共用）
+    static UseCaseError dispatch(SystemContext& group, Axis& axis, AxisId axisId, bool active) {
         // ===== 阶段 2：轴领域层状态判定 =====
-        if (!axis->enable(active)) {
-            return axis->lastRejection();  // RejectionReason::InvalidState / AlreadyMoving
+        if (!axis.enable(active)) {
+            return axis.lastRejection();  // RejectionReason::InvalidState / AlreadyMoving
         }
 
         // ===== 阶段 3：若产生了待发送命令，通过统一命令总线包装下发 =====
         //
-        // 老架构：drv->send(axisId, axis->getPendingCommand())  -> 双参数
+        // 老架构：drv->send(axisId, axis.getPendingCommand())  -> 双参数
         // 新架构：drv->send(AxisCommandWithId{axisId, cmd})     -> 统一 SystemCommand variant
         //
         // FakeAxisDriver 内部通过 std::visit 分发到 handle(AxisCommandWithId)，
         // 将命令写入 FakePLC 物理寄存器并记录 history。
-        if (axis->hasPendingCommand()) {
-            if (auto* drv = group->driver()) {
-                auto commResult = drv->send(AxisCommandWithId{axisId, axis->getPendingCommand()});
+        if (axis.hasPendingCommand()) {
+            if (auto* drv = group.driver()) {
+                auto commResult = drv->send(AxisCommandWithId{axisId, axis.getPendingCommand()});
                 if (!commResult.ok()) {
                     return commResult;
                 }
@@ -4,6 +4,7 @@
 #include "domain/entity/AxisId.h"
 #include "domain/entity/SystemContext.h"
 #include "application/SystemManager.h"
+#include "application/axis/AxisHandle.h"
 #include "infrastructure/logger/Logger.h"
 
 /**
@@ -48,22 +49,22 @@ public:
             return ctxReason;  // PhysicalAxisLockedByGantry / LogicalAxisUnavailableWhenDecoupled / AxisNotRegistered
         }
 
-        // ===== 阶段 2：轴领域层状态判定 =====
-        if (!axis->jog(dir)) {
-            return axis->lastRejection();  // RejectionReason::InvalidState / AtPositiveLimit / AtNegativeLimit ...
-        }
+        return dispatch(*group, *axis, axisId, dir);
+    }
 
-        // ===== 阶段 3：若产生了待发送命令，通过统一命令总线包装下发 =====
-        if (axis->hasPendingCommand()) {
-            if (auto* drv = group->driver()) {
-                auto commResult = drv->send(AxisCommandWithId{axisId, axis->getPendingCommand()});
-                if (!commResult.ok()) {
-                    return commResult;
-                }
-            }
+    /**
+     * @brief 对预绑定的轴执行点动（省去分组与轴查找，拦截与错误码同上）
+     * @param handle    目标轴句柄
+     * @param dir       同上
+     * @return UseCaseError -- monostate 表示成功，否则为具体错误码
+     */
+    UseCaseError execute(AxisHandle& handle, Direction dir) {
+        Axis* axis = nullptr;
+        ContextRejection reason = ContextRejection::None;
+        if (!handle.tryAcquire(axis, reason)) {
+            return reason;
         }
-
-        return std::monostate{};  // 成功
+        return dispatch(*handle.context(), *axis, handle.id(), dir);
     }
 
     /**
@@ -97,15 +98,51 @@ public:
             return;  // 龙门锁定 / 轴未注册 -> 静默返回
         }
 
+        dispatchStop(*group, *axis, axisId, dir);
+    }
+
+    /// @brief 停止预绑定轴的点动（静默语义同上）
+    void stop(AxisHandle& handle, Direction dir) {
+        Axis* axis = nullptr;
+        ContextRejection reason = ContextRejection::None;
+        if (!handle.tryAcquire(axis, reason)) {
+            return;  // 龙门锁定 / 轴未注册 -> 静默返回
+        }
+        dispatchStop(*handle.context(), *axis, handle.id(), dir);
+    }
+
+private:
+    /// @brief 领域层判定 + 命令下发（两个 execute 重载共用）
+    static UseCaseError dispatch(SystemContext& group, Axis& axis, AxisId axisId, Direction dir) {
+        // ===== 阶段 2：轴领域层状态判定 =====
+        if (!axis.jog(dir)) {
+            return axis.lastRejection();  // RejectionReason::InvalidState / AtPositiveLimit / AtNegativeLimit ...
+        }
+
+        // ===== 阶段 3：若产生了待发送命令，通过统一命令总线包装下发 =====
+        if (axis.hasPendingCommand()) {
+            if (auto* drv = group.driver()) {
+                auto commResult = drv->send(AxisCommandWithId{axisId, axis.getPendingCommand()});
+                if (!commResult.ok()) {
+                    return commResult;
+                }
+            }
+        }
+
+        return std::monostate{};  // 成功
+    }
+
+    /// @brief 领域层停止点动 + 命令下发（两个 stop 重载共用）
+    static void dispatchStop(SystemContext& group, Axis& axis, AxisId axisId, Direction dir) {
         // ===== 阶段 2：轴领域层停止点动 =====
-        if (axis->stopJog(dir)) {
+        if (axis.stopJog(dir)) {
             // 3. 将产生的指令（JogCommand {active: false}）通过统一命令总线下发
-            if (auto* drv = group->driver()) {
-                auto commResult = drv->send(AxisCommandWithId{axisId, axis->getPendingCommand()});
+            if (auto* drv = group.driver()) {
+                auto commResult = drv->send(AxisCommandWithId{axisId, axis.getPendingCommand()});
                 if (!commResult.ok()) {
                     // stop() 是 void 返回，仅记录日志不返回错误
                     LOG_WARN(LogLayer::APP, "JogUC",
-                        "send stop failed for axis, diagnostic=" + commResult.diagnostic);
+                        "send stop failed for axis, diagnostic=" + commResult.describe());
                 }
             }
         }
@@ -4,6 +4,7 @@
 #include "domain/entity/AxisId.h"
 #include "domain/entity/SystemContext.h"
 #include "application/SystemManager.h"
+#include "application/axis/AxisHandle.h"
 #include "infrastructure/logger/Logger.h"
 
 /**
@@ -47,18 +48,39 @@ public:
             return ctxReason;  // PhysicalAxisLockedByGantry / AxisNotRegistered / ...
         }
 
+        return dispatch(*group, *axis, axisId, distance);
+    }
+
+    /**
+     * @brief 对预绑定的轴执行相对位移（省去分组与轴查找，拦截与错误码同上）
+     * @param handle    目标轴句柄
+     * @param distance  同上
+     * @return UseCaseError -- monostate 表示成功，否则为具体错误码
+     */
+    UseCaseError execute(AxisHandle& handle, double distance) {
+        Axis* axis = nullptr;
+        ContextRejection reason = ContextRejection::None;
+        if (!handle.tryAcquire(axis, reason)) {
+            return reason;
+        }
+        return dispatch(*handle.context(), *axis, handle.id(), distance);
+    }
+
+private:
+    /// @brief 领域层判定 + 命令下发（两个 execute 重载共用）
+    static UseCaseError dispatch(SystemContext& group, Axis& axis, AxisId axisId, double distance) {
         // ===== 阶段 2：轴领域层状态判定 =====
-        if (!axis->moveRelative(distance)) {
+        if (!axis.moveRelative(distance)) {
             LOG_WARN(LogLayer::APP, "MoveRelUC",
                      "MoveRelative rejected. Reason code: "
-                         + std::to_string(static_cast<int>(axis->lastRejection())));
-            return axis->lastRejection();  // RejectionReason::InvalidState / TargetOutOf... / At...Limit
+                         + std::to_string(static_cast<int>(axis.lastRejection())));
+            return axis.lastRejection();  // RejectionReason::InvalidState / TargetOutOf... / At...Limit
         }
 
         // ===== 阶段 3：若产生了待发送命令，通过统一命令总线包装下发 =====
-        if (axis->hasPendingCommand()) {
-            if (auto* drv = group->driver()) {
-                auto commResult = drv->send(AxisCommandWithId{axisId, axis->getPendingCommand()});
+        if (axis.hasPendingCommand()) {
+            if (auto* drv = group.driver()) {
+                auto commResult = drv->send(AxisCommandWithId{axisId, axis.getPendingCommand()});
                 if (!commResult.ok()) {
                     return commResult;
                 }
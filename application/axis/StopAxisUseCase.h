@@ -4,6 +4,7 @@
 #include "domain/entity/AxisId.h"
 #include "domain/entity/SystemContext.h"
 #include "application/SystemManager.h"
+#include "application/axis/AxisHandle.h"
 #include "infrastructure/logger/Logger.h"
 
 /**
@@ -45,11 +46,31 @@ public:
             return ctxReason;  // PhysicalAxisLockedByGantry / AxisNotRegistered / ...
         }
 
+        return dispatch(*group, *axis, axisId);
+    }
+
+    /**
+     * @brief 对预绑定的轴执行停止（省去分组与轴查找，拦截与错误码同上）
+     * @param handle    目标轴句柄
+     * @return UseCaseError -- monostate 表示成功，否则为具体错误码
+     */
+    UseCaseError execute(AxisHandle& handle) {
+        Axis* axis = nullptr;
+        ContextRejection reason = ContextRejection::None;
+        if (!handle.tryAcquire(axis, reason)) {
+            return reason;
+        }
+        return dispatch(*handle.context(), *axis, handle.id());
+    }
+
+private:
+    /// @brief 领域层判定 + 命令下发（两个 execute 重载共用）
+    static UseCaseError dispatch(SystemContext& group, Axis& axis, AxisId axisId) {
         // ===== 阶段 2：执行停止（领域层不可拒绝） =====
-        if (axis->stop()) {
+        if (axis.stop()) {
             // 将产生的停止指令通过统一命令总线下发
-            if (auto* drv = group->driver()) {
-                auto commResult = drv->send(AxisCommandWithId{axisId, axis->getPendingCommand()});
+            if (auto* drv = group.driver()) {
+                auto commResult = drv->send(AxisCommandWithId{axisId, axis.getPendingCommand()});
                 if (!commResult.ok()) {
                     return commResult;
                 }
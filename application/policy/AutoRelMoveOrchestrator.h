@@ -1,11 +1,16 @@
 #pragma once
 
 #include "application/SystemManager.h"
+#include "application/axis/AxisHandle.h"
 #include "application/axis/EnableUseCase.h"
+#include "application/axis/StopAxisUseCase.h"
 #include "application/axis/MoveRelativeUseCase.h"
 #include "domain/entity/SystemContext.h"
 #include "domain/entity/Axis.h"
 #include "application/UseCaseError.h"
+#include "application/policy/OrchestratorWake.h"
+#include "application/policy/OrchestratorStepTrace.h"
+#include "application/policy/OrchestratorFlow.h"
 #include "infrastructure/logger/Logger.h"
 #include "infrastructure/logger/TraceScope.h"
 #include <variant>
@@ -16,6 +21,10 @@
  * @brief 相对运动编排器
  *
  * 职责：编排"使能 -> 下发相对运动 -> 等待运动开始 -> 等待运动完成 -> 掉电"的完整流程。
+ *       到位后是否掉电由轴的使能保持策略（SystemContext::enableRetention）决定；失败路径始终掉电。
+ *
+ * 执行模型：流程写成一段协程（run()），在"等待轴状态 / 位置变化"处挂起；
+ *   tick() 仍逐帧完成分组解析与安全拦截，挂起条件未满足时不执行任何流程代码。
  *
  * 分层职责：
  *   - EnableUseCase / MoveRelativeUseCase 负责：分组路由 + 轴状态幂等检查 + 下发命令
@@ -41,30 +50,36 @@ public:
         Error
     };
 
+    /// @brief 步骤计时 / 看门狗（见 OrchestratorStepTrace）
+    using StepTrace = OrchestratorStepTrace<Step, static_cast<size_t>(Step::Error) + 1>;
+
     /**
      * @param manager   系统管理器（用于 EnableUseCase / MoveRelativeUseCase 的分组路由）
      * @param groupName 目标分组名称
      */
     AutoRelMoveOrchestrator(SystemManager& manager, const std::string& groupName)
-        : m_manager(manager)
-        , m_groupName(groupName)
+        : m_groupName(groupName)
+        , m_handle(manager, groupName, AxisId::Y)
         , m_step(Step::Initial)
     {
     }
 
+    // 流程协程帧持有 this，编排器不可拷贝 / 移动
+    AutoRelMoveOrchestrator(const AutoRelMoveOrchestrator&) = delete;
+    AutoRelMoveOrchestrator& operator=(const AutoRelMoveOrchestrator&) = delete;
+
     // ========== 入口 ==========
 
     void startRel(AxisId id, double distance) {
         m_targetId = id;
+        m_handle.rebind(id);
         m_distance = distance;
         m_step = Step::EnsuringEnabled;
         m_lastError = std::monostate{};
 
-        m_moveIssued = false;
-        m_motionObserved = false;
-        m_startAbs = 0.0;
-
         m_traceId = TraceScope::current().traceId;
+        m_stepTrace.begin(id, m_step);
+        m_flow = run();
 
         LOG_INFO(LogLayer::APP, "RelOrch",
                  "[" + m_groupName + "][" + axisName(m_targetId) + "] START MoveRelative distance="
@@ -75,37 +90,28 @@ public:
 
     void tick() {
         TraceScope scope(m_groupName, axisName(m_targetId), m_traceId);
+        StepTrace::Scope traced(m_stepTrace, m_step);
 
-        // 第 0 层：分组解析（SystemManager）
-        SystemContext* group = nullptr;
-        ContextRejection mgrReason = ContextRejection::None;
-        if (!m_manager.tryGetGroup(m_groupName, group, mgrReason)) {
-            m_step = Step::Error;
-            m_lastError = mgrReason;
-            return;
-        }
-
-        // ★ Safety Lock Pre-check（Layer 0 前置于 tryGetAxis）
-        //     安全锁定时，无情中止当前编排流程，回到 Done，
-        //     避免进入 Error 状态导致急停解除后无法启动新运动。
-        if (group->emergencyStopController().isSystemLocked()) {
-            if (m_step != Step::Initial && m_step != Step::Done && m_step != Step::Error) {
-                LOG_INFO(LogLayer::APP, "RelOrch",
-                         "[" + m_groupName + "][" + axisName(m_targetId) + "] Safety locked -- aborting gracefully");
-                m_step = Step::Done;
-                m_lastError = std::monostate{};
-            }
-            return;
-        }
-
-        // 第 1 层：轴获取与龙门校验（SystemContext）
+        // 第 0 ~ 1 层：分组解析 + 轴获取与龙门校验（AxisHandle 缓存命中时不再查找，只做安全与龙门校验）
         Axis* axis = nullptr;
         ContextRejection ctxReason = ContextRejection::None;
-        if (!group->tryGetAxis(m_targetId, axis, ctxReason)) {
+        if (!m_handle.tryAcquire(axis, ctxReason)) {
+            // ★ 安全锁定（Layer 0）时，无情中止当前编排流程，回到 Done，
+            //     避免进入 Error 状态导致急停解除后无法启动新运动。
+            if (ctxReason == ContextRejection::SystemSafetyLocked) {
+                if (m_step != Step::Initial && m_step != Step::Done && m_step != Step::Error) {
+                    LOG_INFO(LogLayer::APP, "RelOrch",
+                             "[" + m_groupName + "][" + axisName(m_targetId) + "] Safety locked -- aborting gracefully");
+                    m_step = Step::Done;
+                    m_lastError = std::monostate{};
+                }
+                return;
+            }
             m_step = Step::Error;
             m_lastError = ctxReason;
             return;
         }
+        SystemContext* group = m_handle.context();
 
         // 全局最高优先级：硬件/状态错误拦截
         if (axis->state() == AxisState::Error) {
@@ -116,123 +122,31 @@ public:
             return;
         }
 
-        double pos = axis->currentAbsolutePosition();
-
-        switch (m_step) {
-        case Step::Initial:
-            break;
-
-        // ============================================================
-        // EnsuringEnabled：使能 -> 等待 Idle
-        // ============================================================
-
-        case Step::EnsuringEnabled:
-            if (axis->state() == AxisState::Disabled) {
-                LOG_DEBUG(LogLayer::APP, "RelOrch",
-                          "[" + m_groupName + "][" + axisName(m_targetId) + "] EnsuringEnabled -- sending Enable command");
-                auto err = EnableUseCase{}.execute(m_manager, m_groupName, m_targetId, true);
-                if (!std::holds_alternative<std::monostate>(err)) {
-                    m_step = Step::Error;
-                    m_lastError = err;
-                    return;
-                }
-                LOG_DEBUG(LogLayer::APP, "RelOrch",
-                          "[" + m_groupName + "][" + axisName(m_targetId) + "] Sent Enable");
-                break;
-            }
-            if (axis->state() == AxisState::Idle) {
-                LOG_DEBUG(LogLayer::APP, "RelOrch",
-                          "[" + m_groupName + "][" + axisName(m_targetId) + "] EnsuringEnabled -> IssuingMove");
-                m_step = Step::IssuingMove;
-                break;
-            }
-            // 其他状态：保持等待
-            break;
-
-        // ============================================================
-        // IssuingMove：下发相对运动指令 -> WaitingMotionStart
-        // ============================================================
-
-        case Step::IssuingMove:
-            if (m_moveIssued) break;  // 幂等保护
-
-            {
-                LOG_DEBUG(LogLayer::APP, "RelOrch",
-                          "[" + m_groupName + "][" + axisName(m_targetId) + "] IssuingMove -- sending MoveRelative command distance="
-                              + std::to_string(m_distance));
-                auto err = MoveRelativeUseCase{}.execute(m_manager, m_groupName, m_targetId, m_distance);
-                if (!std::holds_alternative<std::monostate>(err)) {
-                    LOG_ERROR(LogLayer::APP, "RelOrch",
-                              "[" + m_groupName + "][" + axisName(m_targetId) + "] MoveRelative rejected");
-                    m_lastError = err;
-                    // 失败熔断 -> 掉电
-                    EnableUseCase{}.execute(m_manager, m_groupName, m_targetId, false);
-                    m_step = Step::Error;
-                    break;
-                }
-
-                // ⭐ 记录起点（用于完成判定：终点 = startAbs + distance）
-                m_startAbs = pos;
-                m_moveIssued = true;
-                LOG_DEBUG(LogLayer::APP, "RelOrch",
-                          "[" + m_groupName + "][" + axisName(m_targetId) + "] IssuingMove -> WaitingMotionStart");
-                m_step = Step::WaitingMotionStart;
-            }
-            break;
-
-        // ============================================================
-        // WaitingMotionStart：等待运动开始
-        // ============================================================
-
-        case Step::WaitingMotionStart:
-            if (!m_motionObserved) {
-                if (axis->state() == AxisState::MovingRelative ||
-                    std::abs(pos - m_startAbs) > m_epsilon ||
-                    axis->isMoveCompleted()) {
-                    m_motionObserved = true;
-                    LOG_DEBUG(LogLayer::APP, "RelOrch",
-                              "[" + m_groupName + "][" + axisName(m_targetId) + "] WaitingMotionStart -> WaitingMotionFinish");
-                    m_step = Step::WaitingMotionFinish;
-                }
-            }
-            break;
-
-        // ============================================================
-        // WaitingMotionFinish：等待运动完成
-        // ============================================================
-
-        case Step::WaitingMotionFinish:
-            if (!m_motionObserved) break;  // 防假完成
-
-            if (axis->isMoveCompleted()) {
-                double targetPos = m_startAbs + m_distance;
-                if (std::abs(pos - targetPos) < m_epsilon) {
-                    // 物理到位 -> Done
-                    LOG_DEBUG(LogLayer::APP, "RelOrch",
-                              "[" + m_groupName + "][" + axisName(m_targetId) + "] WaitingMotionFinish -- target reached, sending Disable command");
-                    EnableUseCase{}.execute(m_manager, m_groupName, m_targetId, false);
-                    LOG_SUMMARY(LogLayer::APP, "RelOrch",
-                                "[" + m_groupName + "][" + axisName(m_targetId) + "] MoveRelative("
-                                    + std::to_string(m_distance) + ") -> SUCCESS");
-                    m_step = Step::Done;
-                } else {
-                    // 物理没到位 -> Error
-                    LOG_DEBUG(LogLayer::APP, "RelOrch",
-                              "[" + m_groupName + "][" + axisName(m_targetId) + "] WaitingMotionFinish -- target not reached, sending Disable command before abort");
-                    EnableUseCase{}.execute(m_manager, m_groupName, m_targetId, false);
-                    m_lastError = RejectionReason::InvalidState;
-                    LOG_SUMMARY(LogLayer::APP, "RelOrch",
-                                "[" + m_groupName + "][" + axisName(m_targetId) + "] MoveRelative("
-                                    + std::to_string(m_distance) + ") -> ABORTED (Target not reached)");
-                    m_step = Step::Error;
-                }
+        // 看门狗：当前步骤停留超过配置期限 -> 运动中先停止、否则掉电，以 StepTimeout 中止
+        if (m_stepTrace.deadlineExpired()) {
+            LOG_ERROR(LogLayer::APP, "RelOrch",
+                      "[" + m_groupName + "][" + axisName(m_targetId) + "] " + stepToString(m_step)
+                          + " exceeded its deadline -- aborting");
+            m_stepTrace.noteTimeout();
+            if (axis->state() == AxisState::Jogging ||
+                axis->state() == AxisState::MovingAbsolute ||
+                axis->state() == AxisState::MovingRelative) {
+                StopAxisUseCase{}.execute(m_handle);
+            } else {
+                EnableUseCase{}.execute(m_handle, false);
             }
-            break;
+            m_lastError = OrchestratorRejection::StepTimeout;
+            LOG_SUMMARY(LogLayer::APP, "RelOrch",
+                        "[" + m_groupName + "][" + axisName(m_targetId) + "] MoveRelative(" + std::to_string(m_distance) + ")" + " -> ABORTED (Step timeout)");
+            m_step = Step::Error;
+            return;
+        }
 
-        case Step::Done:
-        case Step::Error:
-        default:
-            break;
+        // 第 2 层：推进流程协程（挂起条件未满足时不执行任何流程代码）
+        if (inFlow()) {
+            m_group = group;
+            m_axis = axis;
+            m_flow.poll();
         }
     }
 
@@ -242,6 +156,34 @@ public:
     bool isDone() const { return m_step == Step::Done; }
     bool hasError() const { return m_step == Step::Error; }
 
+    /// @brief 步骤计时统计与期限配置
+    StepTrace& stepTrace() { return m_stepTrace; }
+    const StepTrace& stepTrace() const { return m_stepTrace; }
+
+    /// @brief Step 枚举转字符串（日志辅助）
+    static std::string stepToString(Step s) {
+        switch (s) {
+            case Step::Initial:             return "Initial";
+            case Step::EnsuringEnabled:     return "EnsuringEnabled";
+            case Step::IssuingMove:         return "IssuingMove";
+            case Step::WaitingMotionStart:  return "WaitingMotionStart";
+            case Step::WaitingMotionFinish: return "WaitingMotionFinish";
+            case Step::Done:                return "Done";
+            case Step::Error:               return "Error";
+            default: return "Unknown(" + std::to_string(static_cast<int>(s)) + ")";
+        }
+    }
+
+    /**
+     * @brief 当前步骤的唤醒条件（见 OrchestratorWakeGate）
+     *
+     * 由流程协程当前的挂起点声明：下发指令的步骤为 EveryTick，
+     * WaitingMotionStart 需要位置变化（起步判定看位移），其余等待步骤只看状态 / 意图变化。
+     */
+    WakeOn wakeMask() const {
+        return inFlow() ? m_flow.wakeMask() : WakeOn::None;
+    }
+
     /**
      * @brief 获取最后一次错误
      * @return UseCaseError variant，包含 ContextRejection / RejectionReason
@@ -257,6 +199,102 @@ public:
     }
 
 private:
+    // ============================================================
+    // 流程协程：EnsuringEnabled -> IssuingMove -> WaitingMotionStart -> WaitingMotionFinish
+    //   每个 co_await 对应原状态机的一次"本帧结束"，逐帧行为与之等价；
+    //   m_group / m_axis 由 tick() 在恢复前解析好，条件求值与流程代码都只在 tick() 内发生。
+    // ============================================================
+
+    FlowTask run() {
+        // EnsuringEnabled：使能 -> 等待 Idle（其他状态 Unknown/Moving... 保持等待）
+        while (m_axis->state() != AxisState::Idle) {
+            if (m_axis->state() == AxisState::Disabled) {
+                LOG_DEBUG(LogLayer::APP, "RelOrch",
+                          "[" + m_groupName + "][" + axisName(m_targetId) + "] EnsuringEnabled -- sending Enable command");
+                auto err = EnableUseCase{}.execute(m_handle, true);
+                if (!std::holds_alternative<std::monostate>(err)) {
+                    m_step = Step::Error;
+                    m_lastError = err;
+                    co_return;
+                }
+                LOG_DEBUG(LogLayer::APP, "RelOrch",
+                          "[" + m_groupName + "][" + axisName(m_targetId) + "] Sent Enable");
+            }
+            co_await until(WakeOn::AxisState | WakeOn::Safety, [this] {
+                return m_axis->state() == AxisState::Disabled || m_axis->state() == AxisState::Idle;
+            });
+        }
+        LOG_DEBUG(LogLayer::APP, "RelOrch",
+                  "[" + m_groupName + "][" + axisName(m_targetId) + "] EnsuringEnabled -> IssuingMove");
+        m_step = Step::IssuingMove;
+        co_await nextTick();
+
+        // IssuingMove：下发相对运动指令 -> WaitingMotionStart
+        LOG_DEBUG(LogLayer::APP, "RelOrch",
+                  "[" + m_groupName + "][" + axisName(m_targetId) + "] IssuingMove -- sending MoveRelative command distance="
+                      + std::to_string(m_distance));
+        auto err = MoveRelativeUseCase{}.execute(m_handle, m_distance);
+        if (!std::holds_alternative<std::monostate>(err)) {
+            LOG_ERROR(LogLayer::APP, "RelOrch",
+                      "[" + m_groupName + "][" + axisName(m_targetId) + "] MoveRelative rejected");
+            m_lastError = err;
+            // 失败熔断 -> 掉电
+            EnableUseCase{}.execute(m_handle, false);
+            m_step = Step::Error;
+            co_return;
+        }
+
+        // ⭐ 记录起点（起步判定与终点计算）
+        const double startAbs = m_axis->currentAbsolutePosition();
+        LOG_DEBUG(LogLayer::APP, "RelOrch",
+                  "[" + m_groupName + "][" + axisName(m_targetId) + "] IssuingMove -> WaitingMotionStart");
+        m_step = Step::WaitingMotionStart;
+
+        // WaitingMotionStart：进入 MovingRelative、位置离开起点或意图已闭环，任一成立即视为已起步
+        co_await until(WakeOn::AxisState | WakeOn::AxisPosition | WakeOn::Safety, [this, startAbs] {
+            return m_axis->state() == AxisState::MovingRelative ||
+                   std::abs(m_axis->currentAbsolutePosition() - startAbs) > m_epsilon ||
+                   m_axis->isMoveCompleted();
+        });
+        LOG_DEBUG(LogLayer::APP, "RelOrch",
+                  "[" + m_groupName + "][" + axisName(m_targetId) + "] WaitingMotionStart -> WaitingMotionFinish");
+        m_step = Step::WaitingMotionFinish;
+
+        // WaitingMotionFinish：等待运动完成（起步之后才判定，防假完成）
+        co_await until(WakeOn::AxisState | WakeOn::Safety, [this] { return m_axis->isMoveCompleted(); });
+
+        if (std::abs(m_axis->currentAbsolutePosition() - (startAbs + m_distance)) < m_epsilon) {
+            // 物理到位 -> Done（按使能保持策略决定是否掉电）
+            if (m_group->enableRetention(m_targetId).disablesOnCompletion()) {
+                LOG_DEBUG(LogLayer::APP, "RelOrch",
+                          "[" + m_groupName + "][" + axisName(m_targetId) + "] WaitingMotionFinish -- target reached, sending Disable command");
+                EnableUseCase{}.execute(m_handle, false);
+            } else {
+                LOG_DEBUG(LogLayer::APP, "RelOrch",
+                          "[" + m_groupName + "][" + axisName(m_targetId) + "] WaitingMotionFinish -- target reached, holding enabled (retention policy)");
+            }
+            LOG_SUMMARY(LogLayer::APP, "RelOrch",
+                        "[" + m_groupName + "][" + axisName(m_targetId) + "] MoveRelative("
+                            + std::to_string(m_distance) + ") -> SUCCESS");
+            m_step = Step::Done;
+        } else {
+            // 物理没到位 -> Error
+            LOG_DEBUG(LogLayer::APP, "RelOrch",
+                      "[" + m_groupName + "][" + axisName(m_targetId) + "] WaitingMotionFinish -- target not reached, sending Disable command before abort");
+            EnableUseCase{}.execute(m_handle, false);
+            m_lastError = RejectionReason::InvalidState;
+            LOG_SUMMARY(LogLayer::APP, "RelOrch",
+                        "[" + m_groupName + "][" + axisName(m_targetId) + "] MoveRelative("
+                            + std::to_string(m_distance) + ") -> ABORTED (Target not reached)");
+            m_step = Step::Error;
+        }
+    }
+
+    /// @brief 流程进行中（非 Initial / Done / Error）；安全拦截转入终态后残留的协程不再推进
+    bool inFlow() const {
+        return m_step != Step::Initial && m_step != Step::Done && m_step != Step::Error;
+    }
+
     static std::string axisName(AxisId id) {
         switch (id) {
             case AxisId::Y:  return "Y";
@@ -269,20 +307,22 @@ private:
         return "?";
     }
 
-    SystemManager& m_manager;
     std::string m_groupName;
+    AxisHandle m_handle;   // 预绑定的目标轴（start*() 时改绑）
     Step m_step;
     AxisId m_targetId = AxisId::Y;
     double m_distance = 0.0;
     UseCaseError m_lastError = std::monostate{};
 
-    // IssuingMove
-    bool m_moveIssued = false;
-    double m_startAbs = 0.0;
-
-    // WaitingMotionStart
-    bool m_motionObserved = false;
+    // 到位 / 起步判定容差
     const double m_epsilon = 0.01;
 
+    // 流程协程及其本帧解析结果（仅在 tick() 内有效）
+    FlowTask m_flow;
+    SystemContext* m_group = nullptr;
+    Axis* m_axis = nullptr;
+
     std::string m_traceId = "N/A";
+
+    StepTrace m_stepTrace{Step::Initial, Step::Done, Step::Error};
 };
@@ -6,7 +6,12 @@
 #include "domain/gantry/GantryPowerController.h"
 #include "domain/gantry/GantryRejection.h"
 #include "application/UseCaseError.h"
+#include "application/policy/OrchestratorStepTrace.h"
+#include "application/policy/OrchestratorFlow.h"
 #include "infrastructure/logger/Logger.h"
+#include "infrastructure/utils/LatencyHistogram.h"
+#include <algorithm>
+#include <chrono>
 #include <variant>
 #include <string>
 
@@ -20,6 +25,16 @@
  *   - GantryCouplingController 负责：联动/解耦状态机 + 生成 GantryCouplingCommand
  *   - GantryOrchestrator       负责：流程编排 + 错误转发
  *
+ * 执行模型：流程写成一段协程（run()），在"等待 PLC 确认"处挂起；
+ *   龙门状态不在 WakeStamp 中，挂起条件每帧求值（WakeOn::EveryTick）。
+ *
+ * 流水线联动（setPipelinedCoupling，默认关闭）：
+ *   联动指令紧随使能指令在同一帧下发，由 PLC 排队到使能完成后判定（PipelinedCoupling），
+ *   省去"等待使能确认 -> 下一帧下发联动"的往返；PLC 以 X1NotEnabled / X2NotEnabled 拒绝
+ *   排队的联动（不支持排队的固件）时回退到顺序流程 WaitingEnabled -> Coupling -> WaitingCoupled，
+ *   其余拒绝（如 PositionToleranceExceeded）直接进入 Error，原样记入 lastError()。
+ *   无论哪条路径，联动从 startCoupling() 到 PLC 确认的端到端耗时都记入 couplingLatency()。
+ *
  * PLC 硬件约束：
  *   -「使能轴X电机」寄存器会同时使能 X1/X2（PLC 内部逻辑）
  *   -「轴X联动使能」寄存器必须在电机使能后才可操作
@@ -39,6 +54,7 @@ public:
         WaitingEnabled,       // 等待电机使能完成
         Coupling,             // 下发联动指令
         WaitingCoupled,       // 等待 PLC 反馈联动完成
+        PipelinedCoupling,    // 使能与联动指令已连续下发，等待 PLC 确认联动（流水线模式）
         Decoupling,           // 下发解耦指令
         WaitingDecoupled,     // 等待 PLC 反馈解耦完成
         Disabling,            // 下发龙门电机掉电命令
@@ -47,6 +63,9 @@ public:
         Error
     };
 
+    /// @brief 步骤计时 / 看门狗（见 OrchestratorStepTrace）；龙门流程统一记在逻辑轴 X 名下
+    using StepTrace = OrchestratorStepTrace<Step, static_cast<size_t>(Step::Error) + 1>;
+
     /**
      * @param manager   系统管理器（用于获取 SystemContext）
      * @param groupName 目标分组名称
@@ -58,14 +77,24 @@ public:
     {
     }
 
+    // 流程协程帧持有 this，编排器不可拷贝 / 移动
+    GantryOrchestrator(const GantryOrchestrator&) = delete;
+    GantryOrchestrator& operator=(const GantryOrchestrator&) = delete;
+
+    // ========== 配置 ==========
+
+    /// @brief 流水线联动：使能命令之后紧接着下发联动命令（PLC 需支持联动排队，否则自动回退）
+    void setPipelinedCoupling(bool enabled) { m_pipelinedCoupling = enabled; }
+    bool pipelinedCoupling() const { return m_pipelinedCoupling; }
+
     // ========== 入口 ==========
 
     void startCoupling() {
-        m_step = Step::EnsuringEnabled;
+        start(Step::EnsuringEnabled, false, false);
     }
 
     void startDecoupling() {
-        m_step = Step::Decoupling;
+        start(Step::Decoupling, false, false);
     }
 
     /**
@@ -76,8 +105,7 @@ public:
      * 对应 UI「联动使能按钮」在已联动状态下的反向操作。
      */
     void stopCouplingAndDisable() {
-        m_step = Step::Decoupling;
-        m_disableAfterDecouple = true;
+        start(Step::Decoupling, false, true);
     }
 
     /**
@@ -88,13 +116,14 @@ public:
      * 对应 UI「解除联动按钮」在已联动状态下的操作（密码验证后）。
      */
     void enableAndDecouple() {
-        m_step = Step::EnsuringEnabled;
-        m_decoupleAfterEnable = true;
+        start(Step::EnsuringEnabled, true, false);
     }
 
     // ========== 逐帧驱动 ==========
 
     void tick() {
+        StepTrace::Scope traced(m_stepTrace, m_step);
+
         // 获取 SystemContext
         SystemContext* group = nullptr;
         ContextRejection mgrReason = ContextRejection::None;
@@ -106,224 +135,32 @@ public:
             return;
         }
 
-        GantryPowerController& power = group->gantryPowerController();
-        GantryCouplingController& coupling = group->gantryCouplingController();
-        ISystemDriver* drv = group->driver();
-
-        Step oldStep = m_step;
-
-        switch (m_step) {
-        case Step::Initial:
-            LOG_TRACE(LogLayer::APP, "GantryOrch",
-                m_groupName + " Initial: waiting for start command");
-            break;
-
-        // ============================================================
-        // 联动流程
-        // ============================================================
-
-        case Step::EnsuringEnabled: {
-            // 调用 GantryPowerController::requestEnable(true)
-            // 内部已做幂等/冲突检查，不在此处重复
-            auto result = power.requestEnable(true);
-            LOG_DEBUG(LogLayer::APP, "GantryOrch",
-                m_groupName + " EnsuringEnabled: requestEnable(true) result=" + rejectionToString(result));
-            if (result == GantryRejection::None) {
-                // 下发 GantryPowerCommand 到驱动
-                if (power.hasPendingCommand() && drv) {
-                    auto commResult = drv->send(power.popPendingCommand());
-                    LOG_DEBUG(LogLayer::APP, "GantryOrch",
-                        m_groupName + " EnsuringEnabled: send power command, ok=" + std::to_string(commResult.ok()));
-                    if (!commResult.ok()) {
-                        LOG_WARN(LogLayer::APP, "GantryOrch",
-                            m_groupName + " EnsuringEnabled -> Error: comm failed");
-                        m_step = Step::Error;
-                        m_lastError = commResult;
-                        return;
-                    }
-                }
-                LOG_DEBUG(LogLayer::APP, "GantryOrch",
-                    m_groupName + " EnsuringEnabled -> WaitingEnabled");
-                m_step = Step::WaitingEnabled;
-            } else {
-                LOG_WARN(LogLayer::APP, "GantryOrch",
-                    m_groupName + " EnsuringEnabled -> Error: rejected " + rejectionToString(result));
-                m_step = Step::Error;
-                m_lastError = result;
-            }
-            break;
-        }
-
-        case Step::WaitingEnabled:
-            LOG_TRACE(LogLayer::APP, "GantryOrch",
-                m_groupName + " WaitingEnabled: power.isEnabled=" + std::to_string(power.isEnabled())
-                + " decoupleAfterEnable=" + std::to_string(m_decoupleAfterEnable));
-            if (power.isEnabled()) {
-                if (m_decoupleAfterEnable) {
-                    m_decoupleAfterEnable = false;
-                    LOG_DEBUG(LogLayer::APP, "GantryOrch",
-                        m_groupName + " WaitingEnabled -> Decoupling (enableAndDecouple flow)");
-                    m_step = Step::Decoupling;
-                } else {
-                    LOG_DEBUG(LogLayer::APP, "GantryOrch",
-                        m_groupName + " WaitingEnabled -> Coupling");
-                    m_step = Step::Coupling;
-                }
-            }
-            break;
-
-        case Step::Coupling: {
-            auto result = coupling.requestCouple(true);
-            LOG_DEBUG(LogLayer::APP, "GantryOrch",
-                m_groupName + " Coupling: requestCouple(true) result=" + rejectionToString(result));
-            if (result == GantryRejection::None) {
-                // 下发 GantryCouplingCommand 到驱动
-                if (coupling.hasPendingCommand() && drv) {
-                    auto commResult = drv->send(coupling.popPendingCommand());
-                    LOG_DEBUG(LogLayer::APP, "GantryOrch",
-                        m_groupName + " Coupling: send coupling command, ok=" + std::to_string(commResult.ok()));
-                    if (!commResult.ok()) {
-                        LOG_WARN(LogLayer::APP, "GantryOrch",
-                            m_groupName + " Coupling -> Error: comm failed");
-                        m_step = Step::Error;
-                        m_lastError = commResult;
-                        return;
-                    }
-                }
-                LOG_DEBUG(LogLayer::APP, "GantryOrch",
-                    m_groupName + " Coupling -> WaitingCoupled");
-                m_step = Step::WaitingCoupled;
-            } else {
-                LOG_WARN(LogLayer::APP, "GantryOrch",
-                    m_groupName + " Coupling -> Error: rejected " + rejectionToString(result));
-                m_step = Step::Error;
-                m_lastError = result;
-            }
-            break;
+        // 看门狗：等待 PLC 确认超过配置期限 -> 撤回联动并掉电 -> StepTimeout
+        if (m_stepTrace.deadlineExpired()) {
+            LOG_ERROR(LogLayer::APP, "GantryOrch",
+                m_groupName + " " + stepToString(m_step) + " -> Error: exceeded its deadline");
+            m_stepTrace.noteTimeout();
+            m_group = group;
+            enterSafeState();
+            m_step = Step::Error;
+            m_lastError = OrchestratorRejection::StepTimeout;
+            return;
         }
 
-        case Step::WaitingCoupled:
+        if (m_step == Step::Initial) {
             LOG_TRACE(LogLayer::APP, "GantryOrch",
-                m_groupName + " WaitingCoupled: isCoupled=" + std::to_string(coupling.isCoupled())
-                + " hasError=" + std::to_string(coupling.hasError()));
-            if (coupling.isCoupled()) {
-                LOG_INFO(LogLayer::APP, "GantryOrch",
-                    m_groupName + " WaitingCoupled -> Done (coupling confirmed by PLC)");
-                m_step = Step::Done;
-            } else if (coupling.hasError()) {
-                LOG_WARN(LogLayer::APP, "GantryOrch",
-                    m_groupName + " WaitingCoupled -> Error: "
-                    + rejectionToString(coupling.getLastError()));
-                m_step = Step::Error;
-                m_lastError = coupling.getLastError();
-            }
-            break;
-
-        // ============================================================
-        // 解耦流程
-        // ============================================================
-
-        case Step::Decoupling: {
-            auto result = coupling.requestCouple(false);
-            LOG_DEBUG(LogLayer::APP, "GantryOrch",
-                m_groupName + " Decoupling: requestCouple(false) result=" + rejectionToString(result));
-            if (result == GantryRejection::None) {
-                if (coupling.hasPendingCommand() && drv) {
-                    auto commResult = drv->send(coupling.popPendingCommand());
-                    LOG_DEBUG(LogLayer::APP, "GantryOrch",
-                        m_groupName + " Decoupling: send decoupling command, ok=" + std::to_string(commResult.ok()));
-                    if (!commResult.ok()) {
-                        LOG_WARN(LogLayer::APP, "GantryOrch",
-                            m_groupName + " Decoupling -> Error: comm failed");
-                        m_step = Step::Error;
-                        m_lastError = commResult;
-                        return;
-                    }
-                }
-                LOG_DEBUG(LogLayer::APP, "GantryOrch",
-                    m_groupName + " Decoupling -> WaitingDecoupled");
-                m_step = Step::WaitingDecoupled;
-            } else {
-                LOG_WARN(LogLayer::APP, "GantryOrch",
-                    m_groupName + " Decoupling -> Error: rejected " + rejectionToString(result));
-                m_step = Step::Error;
-                m_lastError = result;
-            }
-            break;
+                m_groupName + " Initial: waiting for start command");
+            return;
         }
-
-        case Step::WaitingDecoupled:
-            LOG_TRACE(LogLayer::APP, "GantryOrch",
-                m_groupName + " WaitingDecoupled: isDecouplingRequested="
-                + std::to_string(coupling.isDecouplingRequested()));
-            // 解耦操作 PLC 不返回错误码（errorCode 始终为 None），
-            // 因此仅依赖 isDecouplingRequested 变为 false 判断解耦完成，
-            // 不需要检查 hasError()。
-            if (!coupling.isDecouplingRequested()) {
-                if (m_disableAfterDecouple) {
-                    m_disableAfterDecouple = false;
-                    LOG_DEBUG(LogLayer::APP, "GantryOrch",
-                        m_groupName + " WaitingDecoupled -> Disabling (stopCouplingAndDisable flow)");
-                    m_step = Step::Disabling;
-                } else {
-                    LOG_INFO(LogLayer::APP, "GantryOrch",
-                        m_groupName + " WaitingDecoupled -> Done (decoupling confirmed)");
-                    m_step = Step::Done;
-                }
-            }
-            break;
-
-        // ============================================================
-        // 掉电流程（stopCouplingAndDisable 后半段）
-        // ============================================================
-
-        case Step::Disabling: {
-            auto result = power.requestEnable(false);
-            LOG_DEBUG(LogLayer::APP, "GantryOrch",
-                m_groupName + " Disabling: requestEnable(false) result=" + rejectionToString(result));
-            if (result == GantryRejection::None) {
-                if (power.hasPendingCommand() && drv) {
-                    auto commResult = drv->send(power.popPendingCommand());
-                    LOG_DEBUG(LogLayer::APP, "GantryOrch",
-                        m_groupName + " Disabling: send power disable command, ok=" + std::to_string(commResult.ok()));
-                    if (!commResult.ok()) {
-                        LOG_WARN(LogLayer::APP, "GantryOrch",
-                            m_groupName + " Disabling -> Error: comm failed");
-                        m_step = Step::Error;
-                        m_lastError = commResult;
-                        return;
-                    }
-                }
-                LOG_DEBUG(LogLayer::APP, "GantryOrch",
-                    m_groupName + " Disabling -> WaitingDisabled");
-                m_step = Step::WaitingDisabled;
-            } else {
-                LOG_WARN(LogLayer::APP, "GantryOrch",
-                    m_groupName + " Disabling -> Error: rejected " + rejectionToString(result));
-                m_step = Step::Error;
-                m_lastError = result;
-            }
-            break;
+        // 终态：tick 不再执行有效逻辑（安全拦截 / 看门狗转入终态后残留的协程不再推进）
+        if (m_step == Step::Done || m_step == Step::Error) {
+            return;
         }
 
-        case Step::WaitingDisabled:
-            LOG_TRACE(LogLayer::APP, "GantryOrch",
-                m_groupName + " WaitingDisabled: power.isEnabled=" + std::to_string(power.isEnabled()));
-            if (!power.isEnabled()) {
-                LOG_INFO(LogLayer::APP, "GantryOrch",
-                    m_groupName + " WaitingDisabled -> Done (power off confirmed)");
-                m_step = Step::Done;
-            }
-            break;
-
-        case Step::Done:
-            // 终态：tick 不再执行有效逻辑
-            break;
+        Step oldStep = m_step;
 
-        case Step::Error:
-            // 终态：tick 不再执行有效逻辑
-            break;
-        }
+        m_group = group;
+        m_flow.poll();
 
         // 记录状态转换日志（当 step 变化且不是终态重复时）
         if (oldStep != m_step) {
@@ -346,6 +183,17 @@ public:
     bool isDone() const { return m_step == Step::Done; }
     bool hasError() const { return m_step == Step::Error; }
 
+    /// @brief 步骤计时统计与期限配置
+    StepTrace& stepTrace() { return m_stepTrace; }
+    const StepTrace& stepTrace() const { return m_stepTrace; }
+
+    /// @brief 联动端到端耗时（startCoupling() -> PLC 确认联动），每次成功联动记录一次
+    const LatencyHistogram& couplingLatency() const { return m_couplingLatency; }
+    std::chrono::nanoseconds lastCouplingTime() const { return m_lastCouplingTime; }
+
+    /// @brief 流水线联动因轴未使能被 PLC 拒绝、回退到顺序流程的次数
+    uint64_t pipelineFallbacks() const { return m_pipelineFallbacks; }
+
     /**
      * @brief 获取最后一次错误
      * @return UseCaseError variant，包含 ContextRejection / GantryRejection
@@ -360,6 +208,7 @@ public:
             case Step::WaitingEnabled:   return "WaitingEnabled";
             case Step::Coupling:         return "Coupling";
             case Step::WaitingCoupled:   return "WaitingCoupled";
+            case Step::PipelinedCoupling: return "PipelinedCoupling";
             case Step::Decoupling:       return "Decoupling";
             case Step::WaitingDecoupled: return "WaitingDecoupled";
             case Step::Disabling:        return "Disabling";
@@ -371,10 +220,187 @@ public:
     }
 
 private:
+    void start(Step entry, bool decoupleAfterEnable, bool disableAfterDecouple) {
+        m_step = entry;
+        m_stepTrace.begin(AxisId::X, m_step);
+        m_startedAt = m_stepTrace.now();
+        m_flow = run(entry, decoupleAfterEnable, disableAfterDecouple);
+    }
+
+    // ============================================================
+    // 流程协程
+    //   联动：EnsuringEnabled -> WaitingEnabled -> Coupling -> WaitingCoupled -> Done
+    //   流水线联动：EnsuringEnabled -> PipelinedCoupling -> Done
+    //         （PLC 以未使能拒绝时 -> WaitingEnabled -> Coupling -> WaitingCoupled -> Done；
+    //           其余拒绝 -> Error）
+    //   解耦：[EnsuringEnabled -> WaitingEnabled ->] Decoupling -> WaitingDecoupled
+    //         [-> Disabling -> WaitingDisabled] -> Done
+    //   下发步骤与其等待步骤在同一帧内衔接；等待满足后下一帧才下发下一条指令。
+    // ============================================================
+
+    FlowTask run(Step entry, bool decoupleAfterEnable, bool disableAfterDecouple) {
+        if (entry == Step::EnsuringEnabled) {
+            // GantryPowerController::requestEnable(true) 内部已做幂等/冲突检查，不在此处重复
+            if (!issue(power(), power().requestEnable(true), Step::WaitingEnabled)) co_return;
+
+            if (!decoupleAfterEnable && m_pipelinedCoupling) {
+                // 流水线：联动指令紧随使能指令下发，由 PLC 排队到使能完成后判定
+                if (!issue(coupling(), coupling().requestCouple(true), Step::PipelinedCoupling)) co_return;
+                co_await until(WakeOn::EveryTick, [this] { return !coupling().isCouplingRequested(); });
+                if (coupling().isCoupled()) {
+                    finishCoupled();
+                    co_return;
+                }
+                const GantryRejection rejected = coupling().getLastError();
+                if (rejected != GantryRejection::X1NotEnabled && rejected != GantryRejection::X2NotEnabled) {
+                    // 只有"电机尚未使能"说明 PLC 不支持排队；超差等真实拒绝原样上报，不重试
+                    LOG_WARN(LogLayer::APP, "GantryOrch",
+                        m_groupName + " PipelinedCoupling -> Error: " + rejectionToString(rejected));
+                    m_step = Step::Error;
+                    m_lastError = rejected;
+                    co_return;
+                }
+                ++m_pipelineFallbacks;
+                LOG_WARN(LogLayer::APP, "GantryOrch",
+                    m_groupName + " PipelinedCoupling rejected by PLC ("
+                    + rejectionToString(coupling().getLastError()) + ") -- falling back to sequential coupling");
+                m_step = Step::WaitingEnabled;
+            }
+            co_await until(WakeOn::EveryTick, [this] { return power().isEnabled(); });
+
+            if (!decoupleAfterEnable) {
+                LOG_DEBUG(LogLayer::APP, "GantryOrch",
+                    m_groupName + " WaitingEnabled -> Coupling");
+                m_step = Step::Coupling;
+                co_await nextTick();
+
+                if (!issue(coupling(), coupling().requestCouple(true), Step::WaitingCoupled)) co_return;
+                co_await until(WakeOn::EveryTick, [this] {
+                    return coupling().isCoupled() || coupling().hasError();
+                });
+                if (coupling().isCoupled()) {
+                    finishCoupled();
+                } else {
+                    LOG_WARN(LogLayer::APP, "GantryOrch",
+                        m_groupName + " WaitingCoupled -> Error: "
+                        + rejectionToString(coupling().getLastError()));
+                    m_step = Step::Error;
+                    m_lastError = coupling().getLastError();
+                }
+                co_return;
+            }
+
+            LOG_DEBUG(LogLayer::APP, "GantryOrch",
+                m_groupName + " WaitingEnabled -> Decoupling (enableAndDecouple flow)");
+            m_step = Step::Decoupling;
+            co_await nextTick();
+        }
+
+        if (!issue(coupling(), coupling().requestCouple(false), Step::WaitingDecoupled)) co_return;
+        // 解耦操作 PLC 不返回错误码（errorCode 始终为 None），
+        // 因此仅依赖 isDecouplingRequested 变为 false 判断解耦完成，
+        // 不需要检查 hasError()。
+        co_await until(WakeOn::EveryTick, [this] { return !coupling().isDecouplingRequested(); });
+
+        if (!disableAfterDecouple) {
+            LOG_INFO(LogLayer::APP, "GantryOrch",
+                m_groupName + " WaitingDecoupled -> Done (decoupling confirmed)");
+            m_step = Step::Done;
+            co_return;
+        }
+        LOG_DEBUG(LogLayer::APP, "GantryOrch",
+            m_groupName + " WaitingDecoupled -> Disabling (stopCouplingAndDisable flow)");
+        m_step = Step::Disabling;
+        co_await nextTick();
+
+        if (!issue(power(), power().requestEnable(false), Step::WaitingDisabled)) co_return;
+        co_await until(WakeOn::EveryTick, [this] { return !power().isEnabled(); });
+        LOG_INFO(LogLayer::APP, "GantryOrch",
+            m_groupName + " WaitingDisabled -> Done (power off confirmed)");
+        m_step = Step::Done;
+    }
+
+    /// @brief PLC 确认联动 -> Done，记录端到端耗时
+    void finishCoupled() {
+        m_lastCouplingTime = std::chrono::duration_cast<std::chrono::nanoseconds>(m_stepTrace.now() - m_startedAt);
+        m_couplingLatency.record(static_cast<uint64_t>(std::max<int64_t>(m_lastCouplingTime.count(), 0)));
+        LOG_INFO(LogLayer::APP, "GantryOrch",
+            m_groupName + " " + stepToString(m_step) + " -> Done (coupling confirmed by PLC, "
+            + std::to_string(m_lastCouplingTime.count() / 1000000) + "ms)");
+        m_step = Step::Done;
+    }
+
+    /**
+     * @brief 下发步骤：领域层请求结果 + 待发命令下发到驱动，成功后进入 next
+     * @return false 表示已转入 Error（请求被拒绝或通讯失败）
+     */
+    template<typename Controller>
+    bool issue(Controller& controller, GantryRejection result, Step next) {
+        const std::string stepName = stepToString(m_step);
+        LOG_DEBUG(LogLayer::APP, "GantryOrch",
+            m_groupName + " " + stepName + ": request result=" + rejectionToString(result));
+        if (result != GantryRejection::None) {
+            LOG_WARN(LogLayer::APP, "GantryOrch",
+                m_groupName + " " + stepName + " -> Error: rejected " + rejectionToString(result));
+            m_step = Step::Error;
+            m_lastError = result;
+            return false;
+        }
+        ISystemDriver* drv = m_group->driver();
+        if (controller.hasPendingCommand() && drv) {
+            auto commResult = drv->send(controller.popPendingCommand());
+            LOG_DEBUG(LogLayer::APP, "GantryOrch",
+                m_groupName + " " + stepName + ": send command, ok=" + std::to_string(commResult.ok()));
+            if (!commResult.ok()) {
+                LOG_WARN(LogLayer::APP, "GantryOrch",
+                    m_groupName + " " + stepName + " -> Error: comm failed");
+                m_step = Step::Error;
+                m_lastError = commResult;
+                return false;
+            }
+        }
+        LOG_DEBUG(LogLayer::APP, "GantryOrch",
+            m_groupName + " " + stepName + " -> " + stepToString(next));
+        m_step = next;
+        return true;
+    }
+
+    /**
+     * @brief 看门狗安全动作：撤回联动（含进行中的联动请求），再掉电龙门电机
+     *
+     * 发送失败只记录日志，不覆盖 StepTimeout；控制器状态由后续 PLC 反馈如实纠正。
+     */
+    void enterSafeState() {
+        ISystemDriver* drv = m_group->driver();
+        if (coupling().withdrawCouple() == GantryRejection::None && coupling().hasPendingCommand() && drv) {
+            if (!drv->send(coupling().popPendingCommand()).ok()) {
+                LOG_WARN(LogLayer::APP, "GantryOrch", m_groupName + " safe state: decouple command not sent");
+            }
+        }
+        if (power().forceDisable() == GantryRejection::None && power().hasPendingCommand() && drv) {
+            if (!drv->send(power().popPendingCommand()).ok()) {
+                LOG_WARN(LogLayer::APP, "GantryOrch", m_groupName + " safe state: power-off command not sent");
+            }
+        }
+    }
+
+    GantryPowerController& power() { return m_group->gantryPowerController(); }
+    GantryCouplingController& coupling() { return m_group->gantryCouplingController(); }
+
     SystemManager& m_manager;
     std::string m_groupName;
     Step m_step;
     UseCaseError m_lastError = std::monostate{};
-    bool m_disableAfterDecouple = false;
-    bool m_decoupleAfterEnable = false;
+
+    // 流程协程及其本帧解析的分组（仅在 tick() 内有效）
+    FlowTask m_flow;
+    SystemContext* m_group = nullptr;
+
+    StepTrace m_stepTrace{Step::Initial, Step::Done, Step::Error};
+
+    bool m_pipelinedCoupling = false;
+    StepTrace::Clock::time_point m_startedAt{};
+    LatencyHistogram m_couplingLatency;
+    std::chrono::nanoseconds m_lastCouplingTime{0};
+    uint64_t m_pipelineFallbacks = 0;
 };
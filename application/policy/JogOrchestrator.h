@@ -1,10 +1,15 @@
 #pragma once
 
 #include "application/SystemManager.h"
+#include "application/axis/AxisHandle.h"
 #include "application/axis/EnableUseCase.h"
+#include "application/axis/StopAxisUseCase.h"
 #include "domain/entity/SystemContext.h"
 #include "domain/entity/Axis.h"
 #include "application/UseCaseError.h"
+#include "application/policy/OrchestratorWake.h"
+#include "application/policy/OrchestratorStepTrace.h"
+#include "application/policy/OrchestratorFlow.h"
 #include "infrastructure/logger/Logger.h"
 #include "infrastructure/logger/TraceScope.h"
 #include <variant>
@@ -14,6 +19,10 @@
  * @brief 点动运动编排器
  *
  * 职责：编排"使能 -> 下发点动 -> 运行 -> 停止 -> 等待空闲 -> 掉电"的完整流程。
+ *       轴的使能保持策略（SystemContext::enableRetention）不是 AlwaysDisable 时，停稳即 Done，不掉电。
+ *
+ * 执行模型：流程写成一段协程（run()），在"等待轴状态变化"处挂起；
+ *   UI 停止请求通过 FlowTask::signal() 唤醒挂起中的流程。
  *
  * 分层职责：
  *   - EnableUseCase 负责：分组路由 + 轴状态幂等检查 + 下发使能/掉电命令
@@ -41,30 +50,38 @@ public:
         Error
     };
 
+    /// @brief 步骤计时 / 看门狗（见 OrchestratorStepTrace）
+    using StepTrace = OrchestratorStepTrace<Step, static_cast<size_t>(Step::Error) + 1>;
+
     /**
      * @param manager   系统管理器（用于 EnableUseCase 的分组路由）
      * @param groupName 目标分组名称
      */
     JogOrchestrator(SystemManager& manager, const std::string& groupName)
-        : m_manager(manager)
-        , m_groupName(groupName)
+        : m_groupName(groupName)
+        , m_handle(manager, groupName, AxisId::Y)
         , m_step(Step::Idle)
     {
     }
 
+    // 流程协程帧持有 this，编排器不可拷贝 / 移动
+    JogOrchestrator(const JogOrchestrator&) = delete;
+    JogOrchestrator& operator=(const JogOrchestrator&) = delete;
+
     // ========== 入口 ==========
 
     void startJog(AxisId id, Direction dir) {
         m_targetId = id;
+        m_handle.rebind(id);
         m_dir = dir;
         m_step = Step::EnsuringEnabled;
         m_lastError = std::monostate{};
 
-        m_jogIssued = false;
-        m_stopIssued = false;
-        m_disableIssued = false;
+        m_stopRequested = false;
 
         m_traceId = TraceScope::current().traceId;
+        m_stepTrace.begin(id, m_step);
+        m_flow = run();
 
         LOG_INFO(LogLayer::APP, "JogOrch",
                  "[" + m_groupName + "][" + axisName(m_targetId) + "] START Jog "
@@ -87,6 +104,9 @@ public:
             LOG_INFO(LogLayer::APP, "JogOrch",
                      "[" + m_groupName + "][" + axisName(m_targetId) + "] Stop requested by UI");
             m_step = Step::IssuingStop;
+            m_stopRequested = true;
+            m_flow.signal();
+            m_stepTrace.observe(m_step);
         }
     }
 
@@ -94,37 +114,28 @@ public:
 
     void tick() {
         TraceScope scope(m_groupName, axisName(m_targetId), m_traceId);
+        StepTrace::Scope traced(m_stepTrace, m_step);
 
-        // 第 0 层：分组解析（SystemManager）
-        SystemContext* group = nullptr;
-        ContextRejection mgrReason = ContextRejection::None;
-        if (!m_manager.tryGetGroup(m_groupName, group, mgrReason)) {
-            m_step = Step::Error;
-            m_lastError = mgrReason;
-            return;
-        }
-
-        // ★ Safety Lock Pre-check（Layer 0 前置于 tryGetAxis）
-        //     安全锁定时，无情中止当前编排流程，回到 Done，
-        //     避免进入 Error 状态导致急停解除后无法启动新 Jog。
-        if (group->emergencyStopController().isSystemLocked()) {
-            if (m_step != Step::Idle && m_step != Step::Done && m_step != Step::Error) {
-                LOG_INFO(LogLayer::APP, "JogOrch",
-                         "[" + m_groupName + "][" + axisName(m_targetId) + "] Safety locked -- aborting gracefully");
-                m_step = Step::Done;
-                m_lastError = std::monostate{};
-            }
-            return;
-        }
-
-        // 第 1 层：轴获取与龙门校验（SystemContext）
+        // 第 0 ~ 1 层：分组解析 + 轴获取与龙门校验（AxisHandle 缓存命中时不再查找，只做安全与龙门校验）
         Axis* axis = nullptr;
         ContextRejection ctxReason = ContextRejection::None;
-        if (!group->tryGetAxis(m_targetId, axis, ctxReason)) {
+        if (!m_handle.tryAcquire(axis, ctxReason)) {
+            // ★ 安全锁定（Layer 0）时，无情中止当前编排流程，回到 Done，
+            //     避免进入 Error 状态导致急停解除后无法启动新 Jog。
+            if (ctxReason == ContextRejection::SystemSafetyLocked) {
+                if (m_step != Step::Idle && m_step != Step::Done && m_step != Step::Error) {
+                    LOG_INFO(LogLayer::APP, "JogOrch",
+                             "[" + m_groupName + "][" + axisName(m_targetId) + "] Safety locked -- aborting gracefully");
+                    m_step = Step::Done;
+                    m_lastError = std::monostate{};
+                }
+                return;
+            }
             m_step = Step::Error;
             m_lastError = ctxReason;
             return;
         }
+        SystemContext* group = m_handle.context();
 
         // 全局最高优先级：硬件/状态错误拦截
         if (axis->state() == AxisState::Error) {
@@ -135,198 +146,213 @@ public:
             return;
         }
 
-        switch (m_step) {
-        case Step::Idle:
-            break;
+        // 看门狗：当前步骤停留超过配置期限 -> 运动中先停止、否则掉电，以 StepTimeout 中止
+        if (m_stepTrace.deadlineExpired()) {
+            LOG_ERROR(LogLayer::APP, "JogOrch",
+                      "[" + m_groupName + "][" + axisName(m_targetId) + "] " + stepToString(m_step)
+                          + " exceeded its deadline -- aborting");
+            m_stepTrace.noteTimeout();
+            if (axis->state() == AxisState::Jogging ||
+                axis->state() == AxisState::MovingAbsolute ||
+                axis->state() == AxisState::MovingRelative) {
+                StopAxisUseCase{}.execute(m_handle);
+            } else {
+                EnableUseCase{}.execute(m_handle, false);
+            }
+            m_lastError = OrchestratorRejection::StepTimeout;
+            LOG_SUMMARY(LogLayer::APP, "JogOrch",
+                        "[" + m_groupName + "][" + axisName(m_targetId) + "] Jog " + dirName(m_dir) + " -> ABORTED (Step timeout)");
+            m_step = Step::Error;
+            return;
+        }
+
+        // 第 2 层：推进流程协程（挂起条件未满足且无停止请求时不执行任何流程代码）
+        if (inFlow()) {
+            m_group = group;
+            m_axis = axis;
+            m_flow.poll();
+        }
+    }
+
+    // ========== 状态查询 ==========
 
-        // ============================================================
-        // EnsuringEnabled：使能 -> 等待 Idle
-        // ============================================================
+    Step currentStep() const { return m_step; }
+    bool isDone() const { return m_step == Step::Done; }
+    bool hasError() const { return m_step == Step::Error; }
 
-        case Step::EnsuringEnabled:
-            if (axis->state() == AxisState::Disabled) {
+    /// @brief 步骤计时统计与期限配置
+    StepTrace& stepTrace() { return m_stepTrace; }
+    const StepTrace& stepTrace() const { return m_stepTrace; }
+
+    /// @brief Step 枚举转字符串（日志辅助）
+    static std::string stepToString(Step s) {
+        switch (s) {
+            case Step::Idle:                return "Idle";
+            case Step::EnsuringEnabled:     return "EnsuringEnabled";
+            case Step::IssuingJog:          return "IssuingJog";
+            case Step::Jogging:             return "Jogging";
+            case Step::IssuingStop:         return "IssuingStop";
+            case Step::WaitingForIdle:      return "WaitingForIdle";
+            case Step::EnsuringDisabled:    return "EnsuringDisabled";
+            case Step::Done:                return "Done";
+            case Step::Error:               return "Error";
+            default: return "Unknown(" + std::to_string(static_cast<int>(s)) + ")";
+        }
+    }
+
+    /// @brief 当前步骤的唤醒条件（见 OrchestratorWakeGate），由流程协程当前的挂起点声明
+    WakeOn wakeMask() const {
+        return inFlow() ? m_flow.wakeMask() : WakeOn::None;
+    }
+
+    /**
+     * @brief 获取最后一次错误
+     * @return UseCaseError variant，包含 ContextRejection / RejectionReason
+     */
+    UseCaseError lastError() const { return m_lastError; }
+
+    /// @brief 获取错误码（保持向后兼容的 RejectionReason 提取）
+    /// @note 仅当错误来自 Axis 领域层时有效；SystemManager/SystemContext 层错误返回 None
+    RejectionReason errorReason() const {
+        if (std::holds_alternative<RejectionReason>(m_lastError)) {
+            return std::get<RejectionReason>(m_lastError);
+        }
+        return RejectionReason::None;
+    }
+
+private:
+    // ============================================================
+    // 流程协程：EnsuringEnabled -> IssuingJog -> Jogging -> IssuingStop -> WaitingForIdle -> EnsuringDisabled
+    //   每个 co_await 对应原状态机的一次"本帧结束"；停止请求（m_stopRequested）在每次恢复后检查，
+    //   直接跳到 IssuingStop。m_group / m_axis 由 tick() 在恢复前解析好。
+    // ============================================================
+
+    FlowTask run() {
+        // EnsuringEnabled：使能 -> 等待 Idle（其他状态 Unknown/Moving... 保持等待）
+        while (!m_stopRequested && m_axis->state() != AxisState::Idle) {
+            if (m_axis->state() == AxisState::Disabled) {
                 LOG_DEBUG(LogLayer::APP, "JogOrch",
                           "[" + m_groupName + "][" + axisName(m_targetId) + "] EnsuringEnabled -- sending Enable command");
                 // EnableUseCase 内部已做分组路由 + 领域幂等检查
-                auto err = EnableUseCase{}.execute(m_manager, m_groupName, m_targetId, true);
+                auto err = EnableUseCase{}.execute(m_handle, true);
                 if (!std::holds_alternative<std::monostate>(err)) {
                     m_step = Step::Error;
                     m_lastError = err;
-                    return;
+                    co_return;
                 }
                 LOG_DEBUG(LogLayer::APP, "JogOrch",
                           "[" + m_groupName + "][" + axisName(m_targetId) + "] Sent Enable");
-                break;
             }
-            if (axis->state() == AxisState::Idle) {
-                LOG_DEBUG(LogLayer::APP, "JogOrch",
-                          "[" + m_groupName + "][" + axisName(m_targetId) + "] EnsuringEnabled -> IssuingJog");
-                m_step = Step::IssuingJog;
-                break;
-            }
-            // 其他状态（Unknown/Moving...）：保持等待
-            LOG_DEBUG(LogLayer::APP, "JogOrch",
-                      "[" + m_groupName + "][" + axisName(m_targetId) + "] EnsuringEnabled -- waiting, axis state="
-                          + std::string(axisStateName(axis->state())));
-            break;
-
-        // ============================================================
-        // IssuingJog：下发点动指令 -> Jogging
-        // ============================================================
+            co_await until(WakeOn::AxisState | WakeOn::Safety, [this] {
+                return m_axis->state() == AxisState::Disabled || m_axis->state() == AxisState::Idle;
+            });
+        }
 
-        case Step::IssuingJog:
-            if (m_jogIssued) break;  // 幂等保护
+        if (!m_stopRequested) {
+            LOG_DEBUG(LogLayer::APP, "JogOrch",
+                      "[" + m_groupName + "][" + axisName(m_targetId) + "] EnsuringEnabled -> IssuingJog");
+            m_step = Step::IssuingJog;
+            co_await nextTick();
+        }
 
+        if (!m_stopRequested) {
+            // IssuingJog：下发点动指令 -> Jogging
             LOG_DEBUG(LogLayer::APP, "JogOrch",
                       "[" + m_groupName + "][" + axisName(m_targetId) + "] IssuingJog -- sending Jog command " + dirName(m_dir));
 
             // 调用领域层语义检查
-            if (!axis->jog(m_dir)) {
+            if (!m_axis->jog(m_dir)) {
                 LOG_ERROR(LogLayer::APP, "JogOrch",
                           "[" + m_groupName + "][" + axisName(m_targetId) + "] Jog rejected: "
-                              + std::to_string(static_cast<int>(axis->lastRejection())));
-                m_lastError = axis->lastRejection();
+                              + std::to_string(static_cast<int>(m_axis->lastRejection())));
+                m_lastError = m_axis->lastRejection();
                 // 失败熔断 -> 掉电
-                EnableUseCase{}.execute(m_manager, m_groupName, m_targetId, false);
+                EnableUseCase{}.execute(m_handle, false);
                 m_step = Step::Error;
-                break;
+                co_return;
             }
 
             // 领域层通过 -> 下发 JogCommand 到驱动
-            if (axis->hasPendingCommand()) {
-                if (auto* drv = group->driver()) {
-                    auto commResult = drv->send(AxisCommandWithId{m_targetId, axis->getPendingCommand()});
-                    if (!commResult.ok()) {
-                        m_step = Step::Error;
-                        m_lastError = commResult;
-                        return;
-                    }
-                }
-            }
+            if (!sendPendingCommand()) co_return;
 
-            m_jogIssued = true;
             LOG_DEBUG(LogLayer::APP, "JogOrch",
                       "[" + m_groupName + "][" + axisName(m_targetId) + "] IssuingJog -> Jogging");
             m_step = Step::Jogging;
-            break;
 
-        // ============================================================
-        // Jogging：运行中监视
-        // ============================================================
-
-        case Step::Jogging:
-            // 异常跌落检测：轴意外回到 Idle 且无待处理指令
-            if (axis->state() == AxisState::Idle && !axis->hasPendingCommand()) {
+            // Jogging：运行中监视 -- 异常跌落检测（轴意外回到 Idle 且无待处理指令）
+            co_await until(WakeOn::AxisState | WakeOn::Safety, [this] {
+                return m_axis->state() == AxisState::Idle && !m_axis->hasPendingCommand();
+            });
+            if (!m_stopRequested) {
                 LOG_ERROR(LogLayer::APP, "JogOrch",
                           "[" + m_groupName + "][" + axisName(m_targetId) + "] "
                           "Axis unexpectedly Idle during Jog -- forcing stop sequence");
                 m_step = Step::IssuingStop;
-            } else {
-                LOG_DEBUG(LogLayer::APP, "JogOrch",
-                          "[" + m_groupName + "][" + axisName(m_targetId) + "] Jogging -- axis state="
-                              + std::string(axisStateName(axis->state())));
+                co_await nextTick();
             }
-            break;
+        }
 
-        // ============================================================
         // IssuingStop：下发停止 -> WaitingForIdle
-        // ============================================================
-
-        case Step::IssuingStop:
-            if (!m_stopIssued) {
-                LOG_DEBUG(LogLayer::APP, "JogOrch",
-                          "[" + m_groupName + "][" + axisName(m_targetId) + "] IssuingStop -- sending Stop command");
-                if (axis->stopJog(m_dir)) {
-                    if (axis->hasPendingCommand()) {
-                        if (auto* drv = group->driver()) {
-                            auto commResult = drv->send(AxisCommandWithId{m_targetId, axis->getPendingCommand()});
-                            if (!commResult.ok()) {
-                                m_step = Step::Error;
-                                m_lastError = commResult;
-                                return;
-                            }
-                        }
-                    }
-                }
-                m_stopIssued = true;
-            }
-            LOG_DEBUG(LogLayer::APP, "JogOrch",
-                      "[" + m_groupName + "][" + axisName(m_targetId) + "] IssuingStop -> WaitingForIdle");
-            m_step = Step::WaitingForIdle;
-            break;
+        LOG_DEBUG(LogLayer::APP, "JogOrch",
+                  "[" + m_groupName + "][" + axisName(m_targetId) + "] IssuingStop -- sending Stop command");
+        if (m_axis->stopJog(m_dir)) {
+            if (!sendPendingCommand()) co_return;
+        }
+        LOG_DEBUG(LogLayer::APP, "JogOrch",
+                  "[" + m_groupName + "][" + axisName(m_targetId) + "] IssuingStop -> WaitingForIdle");
+        m_step = Step::WaitingForIdle;
 
-        // ============================================================
         // WaitingForIdle：等待轴停稳
-        // ============================================================
-
-        case Step::WaitingForIdle:
-            if (axis->state() == AxisState::Idle) {
-                LOG_DEBUG(LogLayer::APP, "JogOrch",
-                          "[" + m_groupName + "][" + axisName(m_targetId) + "] WaitingForIdle -> EnsuringDisabled");
-                m_step = Step::EnsuringDisabled;
-            } else {
-                LOG_DEBUG(LogLayer::APP, "JogOrch",
-                          "[" + m_groupName + "][" + axisName(m_targetId) + "] WaitingForIdle -- waiting, axis state="
-                              + std::string(axisStateName(axis->state())));
-            }
-            break;
+        co_await until(WakeOn::AxisState | WakeOn::Safety, [this] { return m_axis->state() == AxisState::Idle; });
+
+        // 使能保持策略：保持使能时跳过掉电，下一次点动无需等待上电延迟
+        if (!m_group->enableRetention(m_targetId).disablesOnCompletion()) {
+            LOG_SUMMARY(LogLayer::APP, "JogOrch",
+                        "[" + m_groupName + "][" + axisName(m_targetId) + "] Jog -> SUCCESS (Stopped, Held Enabled)");
+            m_step = Step::Done;
+            co_return;
+        }
+        LOG_DEBUG(LogLayer::APP, "JogOrch",
+                  "[" + m_groupName + "][" + axisName(m_targetId) + "] WaitingForIdle -> EnsuringDisabled");
+        m_step = Step::EnsuringDisabled;
+        co_await nextTick();
 
-        // ============================================================
         // EnsuringDisabled：掉电 -> Done
-        // ============================================================
-
-        case Step::EnsuringDisabled:
-            if (!m_disableIssued) {
-                LOG_DEBUG(LogLayer::APP, "JogOrch",
-                          "[" + m_groupName + "][" + axisName(m_targetId) + "] EnsuringDisabled -- sending Disable command");
-                auto err = EnableUseCase{}.execute(m_manager, m_groupName, m_targetId, false);
-                if (!std::holds_alternative<std::monostate>(err)) {
-                    m_step = Step::Error;
-                    m_lastError = err;
-                    return;
-                }
-                m_disableIssued = true;
-            }
-            if (axis->state() == AxisState::Disabled) {
-                LOG_SUMMARY(LogLayer::APP, "JogOrch",
-                            "[" + m_groupName + "][" + axisName(m_targetId) + "] Jog -> SUCCESS (Safely Stopped)");
-                m_step = Step::Done;
-            } else {
-                LOG_DEBUG(LogLayer::APP, "JogOrch",
-                          "[" + m_groupName + "][" + axisName(m_targetId) + "] EnsuringDisabled -- waiting, axis state="
-                              + std::string(axisStateName(axis->state())));
-            }
-            break;
-
-        case Step::Done:
-        case Step::Error:
-        default:
-            break;
+        LOG_DEBUG(LogLayer::APP, "JogOrch",
+                  "[" + m_groupName + "][" + axisName(m_targetId) + "] EnsuringDisabled -- sending Disable command");
+        auto err = EnableUseCase{}.execute(m_handle, false);
+        if (!std::holds_alternative<std::monostate>(err)) {
+            m_step = Step::Error;
+            m_lastError = err;
+            co_return;
         }
+        while (m_axis->state() != AxisState::Disabled) {
+            co_await until(WakeOn::AxisState | WakeOn::Safety, [this] { return m_axis->state() == AxisState::Disabled; });
+        }
+        LOG_SUMMARY(LogLayer::APP, "JogOrch",
+                    "[" + m_groupName + "][" + axisName(m_targetId) + "] Jog -> SUCCESS (Safely Stopped)");
+        m_step = Step::Done;
     }
 
-    // ========== 状态查询 ==========
-
-    Step currentStep() const { return m_step; }
-    bool isDone() const { return m_step == Step::Done; }
-    bool hasError() const { return m_step == Step::Error; }
-
-    /**
-     * @brief 获取最后一次错误
-     * @return UseCaseError variant，包含 ContextRejection / RejectionReason
-     */
-    UseCaseError lastError() const { return m_lastError; }
-
-    /// @brief 获取错误码（保持向后兼容的 RejectionReason 提取）
-    /// @note 仅当错误来自 Axis 领域层时有效；SystemManager/SystemContext 层错误返回 None
-    RejectionReason errorReason() const {
-        if (std::holds_alternative<RejectionReason>(m_lastError)) {
-            return std::get<RejectionReason>(m_lastError);
+    /// @brief 领域层产生的点动 / 停止命令下发到驱动；通讯失败时转入 Error 并返回 false
+    bool sendPendingCommand() {
+        if (!m_axis->hasPendingCommand()) return true;
+        auto* drv = m_group->driver();
+        if (!drv) return true;
+        auto commResult = drv->send(AxisCommandWithId{m_targetId, m_axis->getPendingCommand()});
+        if (!commResult.ok()) {
+            m_step = Step::Error;
+            m_lastError = commResult;
+            return false;
         }
-        return RejectionReason::None;
+        return true;
+    }
+
+    /// @brief 流程进行中（非 Idle / Done / Error）；安全拦截转入终态后残留的协程不再推进
+    bool inFlow() const {
+        return m_step != Step::Idle && m_step != Step::Done && m_step != Step::Error;
     }
 
-private:
     static std::string axisName(AxisId id) {
         switch (id) {
             case AxisId::Y:  return "Y";
@@ -343,16 +369,21 @@ private:
         return dir == Direction::Forward ? "Forward(+)" : "Backward(-)";
     }
 
-    SystemManager& m_manager;
     std::string m_groupName;
+    AxisHandle m_handle;   // 预绑定的目标轴（start*() 时改绑）
     Step m_step;
     AxisId m_targetId = AxisId::Y;
     Direction m_dir = Direction::Forward;
     UseCaseError m_lastError = std::monostate{};
 
-    bool m_jogIssued = false;
-    bool m_stopIssued = false;
-    bool m_disableIssued = false;
+    bool m_stopRequested = false;   // UI 停止请求（外部事件，协程恢复后检查）
+
+    // 流程协程及其本帧解析结果（仅在 tick() 内有效）
+    FlowTask m_flow;
+    SystemContext* m_group = nullptr;
+    Axis* m_axis = nullptr;
 
     std::string m_traceId = "N/A";
+
+    StepTrace m_stepTrace{Step::Idle, Step::Done, Step::Error};
 };
@@ -0,0 +1,539 @@
+#pragma once
+
+#include "application/SystemManager.h"
+#include "application/axis/EnableUseCase.h"
+#include "application/axis/MoveAbsoluteUseCase.h"
+#include "application/axis/StopAxisUseCase.h"
+#include "domain/entity/SystemContext.h"
+#include "domain/entity/Axis.h"
+#include "application/UseCaseError.h"
+#include "infrastructure/logger/Logger.h"
+#include "infrastructure/logger/TraceScope.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+#include <variant>
+#include <vector>
+
+/**
+ * @brief 运动程序段
+ *
+ * Absolute: targets 为各轴目标绝对位置（同段各轴并行运动）
+ * Relative: targets 为各轴相对上一段终点的距离
+ * Dwell:    所有先前段闭环后停留 dwellMs，期间不下发后续段
+ */
+struct MotionSegment {
+    enum class Kind { Absolute, Relative, Dwell };
+
+    struct AxisValue {
+        AxisId id;
+        double value;
+    };
+
+    Kind kind = Kind::Dwell;
+    std::vector<AxisValue> targets;
+    int dwellMs = 0;
+
+    static MotionSegment absolute(std::vector<AxisValue> targets) {
+        return MotionSegment{Kind::Absolute, std::move(targets), 0};
+    }
+    static MotionSegment relative(std::vector<AxisValue> distances) {
+        return MotionSegment{Kind::Relative, std::move(distances), 0};
+    }
+    static MotionSegment dwell(int ms) {
+        return MotionSegment{Kind::Dwell, {}, ms};
+    }
+};
+
+/**
+ * @brief 运动程序执行器 -- 整段程序只使能 / 掉电一次
+ *
+ * 单轴编排器每次运动都走一遍 使能 -> 定位 -> 掉电；执行器把一串段当作一个程序：
+ *
+ *   EnsuringEnabled ──► Running ──────────────────────────► Done（全部段闭环后掉电）
+ *                         │  ▲
+ *                 pause() ▼  │ resume()
+ *                       Pausing ──► Paused
+ *
+ *   abort()：停止运动中的轴 -> Aborting -> 掉电 -> Aborted
+ *   急停锁定：直接 Aborted（PLC 已停机，不再下发任何指令）
+ *
+ * 段的下发（Running 每帧）：
+ *   1. 先做闭环检测：运动段的全部轴定位闭环且到达终点即完成；停留段计时到即完成
+ *   2. 再从第一个未完成段起，在 LOOKAHEAD_SEGMENTS 窗口内依次尝试下发：
+ *      - 轴被更早的未完成段占用 -> 跳过（同一轴上的段严格按序）
+ *      - 轴互不相交 -> 立即下发（前瞻：不必等前一段闭环）
+ *      - 停留段是屏障：只有它成为第一个未完成段时才开始计时，窗口在此截止
+ *   闭环检测与下发在同一帧完成，上一段闭环的那一帧就下发下一段。
+ *
+ * 终点在程序开始时一次算好（相对段以上一段的计划终点为基准，不累积到位误差），
+ * 全部以绝对定位下发；越过软限位的程序在任何轴运动前整体拒绝。
+ * 暂停会停止运动中的段并把它们退回待下发，恢复后按原终点重新下发；停留计时在暂停期间冻结。
+ *
+ * 使用示例：
+ *   MotionProgramExecutor exec(manager, "Machine_A");
+ *   exec.start({MotionSegment::absolute({{AxisId::Y, 100.0}}),
+ *               MotionSegment::dwell(200),
+ *               MotionSegment::relative({{AxisId::Y, -50.0}, {AxisId::Z, 10.0}})});
+ *   while (!exec.isDone() && !exec.hasError() && !exec.isAborted()) {
+ *       exec.tick();          // 主循环周期（默认 10ms）
+ *   }
+ */
+class MotionProgramExecutor {
+public:
+    enum class Step {
+        Initial,
+        EnsuringEnabled,   // 使能程序涉及的全部轴
+        Running,           // 下发 / 跟踪各段
+        Pausing,           // 停止运动中的段，等待停稳
+        Paused,
+        Aborting,          // 停止运动中的段，停稳后掉电
+        Done,
+        Aborted,
+        Error
+    };
+
+    static constexpr int DEFAULT_CYCLE_MS = 10;
+    static constexpr size_t LOOKAHEAD_SEGMENTS = 8;
+
+    /**
+     * @param manager   系统管理器（用于 UseCase 的分组路由）
+     * @param groupName 目标分组名称
+     */
+    MotionProgramExecutor(SystemManager& manager, const std::string& groupName)
+        : m_manager(manager)
+        , m_groupName(groupName)
+        , m_step(Step::Initial)
+    {
+    }
+
+    // ========== 入口 ==========
+
+    /**
+     * @brief 开始执行程序
+     *
+     * 空程序、运动段无目标、段内重复轴、负停留时间 -> 直接 Error（InvalidArgument）。
+     */
+    void start(std::vector<MotionSegment> program) {
+        m_program = std::move(program);
+        m_runs.assign(m_program.size(), SegmentRun{});
+        m_axisIds.clear();
+        m_head = 0;
+        m_planned = false;
+        m_lastError = std::monostate{};
+        m_traceId = TraceScope::current().traceId;
+
+        bool valid = !m_program.empty();
+        for (const auto& seg : m_program) {
+            if (seg.kind == MotionSegment::Kind::Dwell) {
+                valid = valid && seg.dwellMs >= 0;
+                continue;
+            }
+            valid = valid && !seg.targets.empty();
+            for (size_t a = 0; a < seg.targets.size(); ++a) {
+                for (size_t b = a + 1; b < seg.targets.size(); ++b) {
+                    valid = valid && seg.targets[a].id != seg.targets[b].id;
+                }
+                if (std::find(m_axisIds.begin(), m_axisIds.end(), seg.targets[a].id) == m_axisIds.end()) {
+                    m_axisIds.push_back(seg.targets[a].id);
+                }
+            }
+        }
+        if (!valid) {
+            LOG_ERROR(LogLayer::APP, "ProgExec",
+                      "[" + m_groupName + "] START rejected -- invalid program");
+            m_lastError = RejectionReason::InvalidArgument;
+            m_step = Step::Error;
+            return;
+        }
+
+        m_step = Step::EnsuringEnabled;
+        LOG_INFO(LogLayer::APP, "ProgExec",
+                 "[" + m_groupName + "] START program segments=" + std::to_string(m_program.size())
+                     + " axes=" + std::to_string(m_axisIds.size()));
+    }
+
+    /// @brief 暂停：停止运动中的段并保持使能；仅 EnsuringEnabled / Running 可暂停
+    bool pause() {
+        if (m_step != Step::EnsuringEnabled && m_step != Step::Running) return false;
+        LOG_INFO(LogLayer::APP, "ProgExec", "[" + m_groupName + "] Pause requested");
+        m_step = Step::Pausing;
+        return true;
+    }
+
+    /// @brief 恢复：仅 Paused 可恢复；被暂停打断的段按原终点重新下发
+    bool resume() {
+        if (m_step != Step::Paused) return false;
+        LOG_INFO(LogLayer::APP, "ProgExec", "[" + m_groupName + "] Resume requested");
+        m_step = m_planned ? Step::Running : Step::EnsuringEnabled;
+        return true;
+    }
+
+    /// @brief 中止：停止运动中的段，停稳后掉电；终态下调用无效果
+    void abort() {
+        if (m_step == Step::Initial || isTerminal()) return;
+        LOG_INFO(LogLayer::APP, "ProgExec", "[" + m_groupName + "] Abort requested");
+        m_step = Step::Aborting;
+    }
+
+    // ========== 逐帧驱动 ==========
+
+    /// @param elapsedMs 距上一帧的时间（停留段计时用）
+    void tick(int elapsedMs = DEFAULT_CYCLE_MS) {
+        TraceScope scope(m_groupName, "program", m_traceId);
+
+        if (m_step == Step::Initial || m_step == Step::Paused || isTerminal()) {
+            return;
+        }
+
+        // 第 0 层：分组解析（SystemManager）
+        SystemContext* group = nullptr;
+        ContextRejection mgrReason = ContextRejection::None;
+        if (!m_manager.tryGetGroup(m_groupName, group, mgrReason)) {
+            m_step = Step::Error;
+            m_lastError = mgrReason;
+            return;
+        }
+
+        // ★ Safety Lock：PLC 已停机，程序不可续，直接 Aborted
+        if (group->emergencyStopController().isSystemLocked()) {
+            LOG_INFO(LogLayer::APP, "ProgExec",
+                     "[" + m_groupName + "] Safety locked -- program aborted at segment " + std::to_string(m_head));
+            m_step = Step::Aborted;
+            return;
+        }
+
+        // 第 1 层：全部轴获取与龙门校验 + 硬件错误拦截
+        m_axes.assign(m_axisIds.size(), nullptr);
+        for (size_t i = 0; i < m_axisIds.size(); ++i) {
+            ContextRejection ctxReason = ContextRejection::None;
+            if (!group->tryGetAxis(m_axisIds[i], m_axes[i], ctxReason)) {
+                fail(ctxReason);
+                return;
+            }
+            if (m_axes[i]->state() == AxisState::Error) {
+                LOG_ERROR(LogLayer::APP, "ProgExec",
+                          "[" + m_groupName + "][" + axisName(m_axisIds[i]) + "] Axis Error state -- aborting program");
+                fail(m_axes[i]->lastRejection());
+                return;
+            }
+        }
+
+        switch (m_step) {
+        case Step::EnsuringEnabled: {
+            bool allIdle = true;
+            for (size_t i = 0; i < m_axisIds.size(); ++i) {
+                if (m_axes[i]->state() == AxisState::Disabled) {
+                    auto err = EnableUseCase{}.execute(m_manager, m_groupName, m_axisIds[i], true);
+                    if (!std::holds_alternative<std::monostate>(err)) {
+                        fail(err);
+                        return;
+                    }
+                }
+                allIdle = allIdle && m_axes[i]->state() == AxisState::Idle;
+            }
+            if (!allIdle) break;
+            if (!m_planned && !planEndpoints()) return;
+            LOG_DEBUG(LogLayer::APP, "ProgExec", "[" + m_groupName + "] EnsuringEnabled -> Running");
+            m_step = Step::Running;
+            runProgram(0);   // 使能完成的同一帧下发第一批段
+            break;
+        }
+
+        case Step::Running:
+            runProgram(elapsedMs);
+            break;
+
+        case Step::Pausing:
+            if (!closeFinished(0)) return;
+            stopActiveMoves(/*requeue=*/true);
+            if (allSettled()) {
+                LOG_INFO(LogLayer::APP, "ProgExec",
+                         "[" + m_groupName + "] Paused at segment " + std::to_string(m_head));
+                m_step = Step::Paused;
+            }
+            break;
+
+        case Step::Aborting:
+            stopActiveMoves(/*requeue=*/false);
+            if (allSettled()) {
+                disableAll();
+                LOG_SUMMARY(LogLayer::APP, "ProgExec",
+                            "[" + m_groupName + "] Program -> ABORTED at segment " + std::to_string(m_head)
+                                + "/" + std::to_string(m_program.size()));
+                m_step = Step::Aborted;
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    // ========== 状态查询 ==========
+
+    Step currentStep() const { return m_step; }
+    bool isDone() const { return m_step == Step::Done; }
+    bool hasError() const { return m_step == Step::Error; }
+    bool isAborted() const { return m_step == Step::Aborted; }
+    bool isPaused() const { return m_step == Step::Paused; }
+
+    size_t segmentCount() const { return m_program.size(); }
+
+    /// @brief 已完成的段数
+    size_t segmentsCompleted() const {
+        return static_cast<size_t>(std::count_if(m_runs.begin(), m_runs.end(),
+            [](const SegmentRun& r) { return r.status == SegmentStatus::Closed; }));
+    }
+
+    /// @brief 正在执行（已下发或停留计时中）的段数
+    size_t segmentsActive() const {
+        return static_cast<size_t>(std::count_if(m_runs.begin(), m_runs.end(),
+            [](const SegmentRun& r) { return r.status == SegmentStatus::Active; }));
+    }
+
+    /// @brief 获取最后一次错误
+    UseCaseError lastError() const { return m_lastError; }
+
+    /// @brief 获取错误码（保持与单轴编排器一致的 RejectionReason 提取）
+    RejectionReason errorReason() const {
+        if (std::holds_alternative<RejectionReason>(m_lastError)) {
+            return std::get<RejectionReason>(m_lastError);
+        }
+        return RejectionReason::None;
+    }
+
+private:
+    enum class SegmentStatus { Pending, Active, Closed };
+
+    struct SegmentRun {
+        SegmentStatus status = SegmentStatus::Pending;
+        std::vector<double> endpoints;   ///< 与 MotionSegment::targets 一一对应的绝对终点
+        int dwellElapsedMs = 0;
+        bool stopSent = false;
+    };
+
+    bool isTerminal() const {
+        return m_step == Step::Done || m_step == Step::Aborted || m_step == Step::Error;
+    }
+
+    Axis* axisOf(AxisId id) const {
+        for (size_t i = 0; i < m_axisIds.size(); ++i) {
+            if (m_axisIds[i] == id) return m_axes[i];
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief 以当前位置为起点算出每段的绝对终点；越过软限位时整体拒绝
+     */
+    bool planEndpoints() {
+        std::map<AxisId, double> planned;
+        for (size_t i = 0; i < m_axisIds.size(); ++i) {
+            planned[m_axisIds[i]] = m_axes[i]->currentAbsolutePosition();
+        }
+        for (size_t s = 0; s < m_program.size(); ++s) {
+            const auto& seg = m_program[s];
+            auto& run = m_runs[s];
+            run.endpoints.clear();
+            for (const auto& t : seg.targets) {
+                double& pos = planned[t.id];
+                pos = seg.kind == MotionSegment::Kind::Absolute ? t.value : pos + t.value;
+                const Axis* axis = axisOf(t.id);
+                if (pos > axis->positiveSoftLimit() || pos < axis->negativeSoftLimit()) {
+                    LOG_ERROR(LogLayer::APP, "ProgExec",
+                              "[" + m_groupName + "][" + axisName(t.id) + "] segment " + std::to_string(s)
+                                  + " endpoint " + std::to_string(pos) + " outside soft limits -- rejecting program");
+                    fail(pos > axis->positiveSoftLimit() ? RejectionReason::TargetOutOfPositiveLimit
+                                                         : RejectionReason::TargetOutOfNegativeLimit);
+                    return false;
+                }
+                run.endpoints.push_back(pos);
+            }
+        }
+        m_planned = true;
+        return true;
+    }
+
+    /**
+     * @brief 闭环检测：运动段全部轴定位闭环且到达终点；停留段计时到
+     * @return false 表示某段闭环但未到位，已进入 Error
+     */
+    bool closeFinished(int elapsedMs) {
+        const size_t end = std::min(m_program.size(), m_head + LOOKAHEAD_SEGMENTS);
+        for (size_t s = m_head; s < end; ++s) {
+            auto& run = m_runs[s];
+            if (run.status != SegmentStatus::Active) continue;
+            const auto& seg = m_program[s];
+            if (seg.kind == MotionSegment::Kind::Dwell) {
+                run.dwellElapsedMs += elapsedMs;
+                if (run.dwellElapsedMs >= seg.dwellMs) run.status = SegmentStatus::Closed;
+                continue;
+            }
+            bool closed = true;
+            for (const auto& t : seg.targets) {
+                closed = closed && axisOf(t.id)->isMoveCompleted();
+            }
+            if (!closed) continue;
+            for (size_t k = 0; k < seg.targets.size(); ++k) {
+                if (std::abs(axisOf(seg.targets[k].id)->currentAbsolutePosition() - run.endpoints[k]) >= m_epsilon) {
+                    LOG_SUMMARY(LogLayer::APP, "ProgExec",
+                                "[" + m_groupName + "][" + axisName(seg.targets[k].id) + "] segment "
+                                    + std::to_string(s) + " -> ABORTED (Target not reached)");
+                    run.status = SegmentStatus::Closed;
+                    fail(RejectionReason::InvalidState);
+                    return false;
+                }
+            }
+            run.status = SegmentStatus::Closed;
+            LOG_DEBUG(LogLayer::APP, "ProgExec",
+                      "[" + m_groupName + "] segment " + std::to_string(s) + " closed");
+        }
+        while (m_head < m_program.size() && m_runs[m_head].status == SegmentStatus::Closed) ++m_head;
+        return true;
+    }
+
+    void runProgram(int elapsedMs) {
+        if (!closeFinished(elapsedMs)) return;
+
+        if (m_head == m_program.size()) {
+            disableAll();
+            LOG_SUMMARY(LogLayer::APP, "ProgExec",
+                        "[" + m_groupName + "] Program (" + std::to_string(m_program.size()) + " segments) -> SUCCESS");
+            m_step = Step::Done;
+            return;
+        }
+
+        // 前瞻下发：同一轴按序，轴不相交的段提前下发，停留段为屏障
+        std::vector<AxisId> blocked;
+        const auto isBlocked = [&](const MotionSegment& seg) {
+            return std::any_of(seg.targets.begin(), seg.targets.end(), [&](const MotionSegment::AxisValue& t) {
+                return std::find(blocked.begin(), blocked.end(), t.id) != blocked.end();
+            });
+        };
+        const auto block = [&](const MotionSegment& seg) {
+            for (const auto& t : seg.targets) blocked.push_back(t.id);
+        };
+
+        const size_t end = std::min(m_program.size(), m_head + LOOKAHEAD_SEGMENTS);
+        for (size_t s = m_head; s < end; ++s) {
+            auto& run = m_runs[s];
+            const auto& seg = m_program[s];
+            if (run.status == SegmentStatus::Closed) continue;
+
+            if (seg.kind == MotionSegment::Kind::Dwell) {
+                if (run.status == SegmentStatus::Pending && s == m_head) {
+                    LOG_DEBUG(LogLayer::APP, "ProgExec",
+                              "[" + m_groupName + "] segment " + std::to_string(s) + " dwell "
+                                  + std::to_string(seg.dwellMs) + "ms");
+                    run.status = SegmentStatus::Active;
+                    run.dwellElapsedMs = 0;
+                }
+                break;
+            }
+
+            if (run.status == SegmentStatus::Active || isBlocked(seg)) {
+                block(seg);
+                continue;
+            }
+
+            for (size_t k = 0; k < seg.targets.size(); ++k) {
+                auto err = MoveAbsoluteUseCase{}.execute(m_manager, m_groupName, seg.targets[k].id, run.endpoints[k]);
+                if (!std::holds_alternative<std::monostate>(err)) {
+                    LOG_ERROR(LogLayer::APP, "ProgExec",
+                              "[" + m_groupName + "][" + axisName(seg.targets[k].id) + "] segment "
+                                  + std::to_string(s) + " MoveAbsolute rejected");
+                    run.status = SegmentStatus::Active;   // 已下发的轴由 fail() 停止
+                    fail(err);
+                    return;
+                }
+            }
+            run.status = SegmentStatus::Active;
+            run.stopSent = false;
+            LOG_DEBUG(LogLayer::APP, "ProgExec",
+                      "[" + m_groupName + "] segment " + std::to_string(s) + " issued"
+                          + (s == m_head ? "" : " (look-ahead)"));
+            block(seg);
+        }
+    }
+
+    /**
+     * @brief 对运动中的段下发停止（每段一次）
+     * @param requeue true：段退回待下发（暂停）；false：保持原状态（中止 / 出错）
+     * @return 是否存在运动中的段
+     */
+    bool stopActiveMoves(bool requeue) {
+        bool any = false;
+        for (size_t s = m_head; s < m_program.size(); ++s) {
+            auto& run = m_runs[s];
+            const auto& seg = m_program[s];
+            if (run.status != SegmentStatus::Active || seg.kind == MotionSegment::Kind::Dwell) continue;
+            any = true;
+            if (!run.stopSent) {
+                for (const auto& t : seg.targets) {
+                    StopAxisUseCase{}.execute(m_manager, m_groupName, t.id);
+                }
+                run.stopSent = true;
+            }
+            if (requeue) {
+                run.status = SegmentStatus::Pending;
+                run.stopSent = false;
+            }
+        }
+        return any;
+    }
+
+    /// @brief 程序涉及的轴全部停稳（无运动状态、无待闭环的停止）
+    bool allSettled() const {
+        for (const Axis* axis : m_axes) {
+            const AxisState s = axis->state();
+            if (s == AxisState::Jogging || s == AxisState::MovingAbsolute || s == AxisState::MovingRelative
+                || axis->hasPendingStop()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief 有运动中的段时停止它们，否则掉电全部轴；进入 Error
+    void fail(const UseCaseError& reason) {
+        if (!stopActiveMoves(/*requeue=*/false)) disableAll();
+        m_lastError = reason;
+        m_step = Step::Error;
+    }
+
+    void disableAll() {
+        for (AxisId id : m_axisIds) {
+            EnableUseCase{}.execute(m_manager, m_groupName, id, false);
+        }
+    }
+
+    static std::string axisName(AxisId id) {
+        switch (id) {
+            case AxisId::Y:  return "Y";
+            case AxisId::Z:  return "Z";
+            case AxisId::R:  return "R";
+            case AxisId::X:  return "X";
+            case AxisId::X1: return "X1";
+            case AxisId::X2: return "X2";
+        }
+        return "?";
+    }
+
+    SystemManager& m_manager;
+    std::string m_groupName;
+    Step m_step;
+
+    std::vector<MotionSegment> m_program;
+    std::vector<SegmentRun> m_runs;
+    std::vector<AxisId> m_axisIds;   ///< 程序涉及的轴（去重，首次出现顺序）
+    std::vector<Axis*> m_axes;       ///< 本帧解析结果，与 m_axisIds 对应
+    size_t m_head = 0;               ///< 第一个未完成段
+    bool m_planned = false;
+
+    UseCaseError m_lastError = std::monostate{};
+    const double m_epsilon = 0.01;
+
+    std::string m_traceId = "N/A";
+};
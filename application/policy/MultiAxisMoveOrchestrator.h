@@ -0,0 +1,478 @@
+#pragma once
+
+#include "application/SystemManager.h"
+#include "application/axis/EnableUseCase.h"
+#include "application/axis/MoveAbsoluteUseCase.h"
+#include "application/axis/StopAxisUseCase.h"
+#include "domain/entity/SystemContext.h"
+#include "domain/entity/Axis.h"
+#include "application/UseCaseError.h"
+#include "infrastructure/logger/Logger.h"
+#include "infrastructure/logger/TraceScope.h"
+#include <algorithm>
+#include <variant>
+#include <string>
+#include <vector>
+#include <cmath>
+
+/**
+ * @brief 多轴同步到位编排器
+ *
+ * 职责：把同一分组中的若干轴一起移动到一个目标位姿，并让所有轴在同一时刻到位。
+ *
+ *   使能全部轴 -> 按同步到位换算各轴定位速度 -> 同一帧下发全部定位
+ *   -> 等待全部轴闭环 -> 恢复原定位速度 -> 掉电
+ *
+ * 同步速度换算（匀速模型）：
+ *   T   = max_i( |d_i| / v_i )          v_i 为各轴当前的定位速度，T 为最慢轴的耗时
+ *   v_i' = |d_i| / T                    v_i' <= v_i，任何轴都不会超过自身的速度设定
+ *
+ * PLC 侧启用了加减速曲线时，各轴斜坡耗时不同，到位时刻相差的是斜坡差而不是整段行程。
+ *
+ * 分层职责：
+ *   - EnableUseCase / MoveAbsoluteUseCase / StopAxisUseCase 负责：分组路由 + 轴状态检查 + 下发命令
+ *   - Axis 领域层负责：定位 / 速度设定的语义校验与闭环
+ *   - MultiAxisMoveOrchestrator 负责：多轴流程编排 + 同步速度换算 + 错误转发
+ *
+ * 任一轴运动中出错时，其余仍在运动的轴被停止，再进入 Error（避免位姿只走一半的轴继续运动）。
+ * 中止路径（出错 / 急停）同样把已改为同步速度的轴恢复到原定位速度，之后的单轴定位不会变慢。
+ *
+ * 使用示例：
+ *   MultiAxisMoveOrchestrator orch(manager, "Machine_A");
+ *   orch.startAbs({{AxisId::Y, 100.0}, {AxisId::Z, -20.0}, {AxisId::R, 45.0}});
+ *   while (orch.currentStep() != Step::Done && orch.currentStep() != Step::Error) {
+ *       orch.tick();
+ *   }
+ */
+class MultiAxisMoveOrchestrator {
+public:
+    enum class Step {
+        Initial,
+        EnsuringEnabled,     // 下发使能，等待全部轴 Idle
+        SyncingVelocity,     // 下发同步速度，等待全部轴速度闭环
+        IssuingMoves,        // 同一帧下发全部绝对定位
+        WaitingMotionFinish, // 等待全部轴定位闭环
+        RestoringVelocity,   // 恢复原定位速度后掉电
+        Done,
+        Error
+    };
+
+    /// @brief 单轴目标
+    struct AxisTarget {
+        AxisId id;
+        double target;
+    };
+
+    /**
+     * @param manager   系统管理器（用于 UseCase 的分组路由）
+     * @param groupName 目标分组名称
+     */
+    MultiAxisMoveOrchestrator(SystemManager& manager, const std::string& groupName)
+        : m_manager(manager)
+        , m_groupName(groupName)
+        , m_step(Step::Initial)
+    {
+    }
+
+    // ========== 入口 ==========
+
+    /**
+     * @brief 开始一次多轴绝对定位
+     *
+     * targets 为空或包含重复轴时直接进入 Error（InvalidArgument）。
+     */
+    void startAbs(const std::vector<AxisTarget>& targets) {
+        m_legs.clear();
+        m_lastError = std::monostate{};
+        m_syncSeconds = 0.0;
+        m_traceId = TraceScope::current().traceId;
+
+        for (const auto& t : targets) {
+            const bool duplicate = std::any_of(m_legs.begin(), m_legs.end(),
+                [&](const Leg& l) { return l.id == t.id; });
+            if (duplicate) {
+                LOG_ERROR(LogLayer::APP, "MultiOrch",
+                          "[" + m_groupName + "] START rejected -- duplicate axis " + axisName(t.id));
+                m_legs.clear();
+                break;
+            }
+            Leg leg;
+            leg.id = t.id;
+            leg.target = t.target;
+            m_legs.push_back(leg);
+        }
+
+        if (m_legs.empty()) {
+            m_lastError = RejectionReason::InvalidArgument;
+            m_step = Step::Error;
+            return;
+        }
+
+        m_step = Step::EnsuringEnabled;
+        LOG_INFO(LogLayer::APP, "MultiOrch",
+                 "[" + m_groupName + "] START MultiAxisMove " + describeTargets());
+    }
+
+    // ========== 逐帧驱动 ==========
+
+    void tick() {
+        TraceScope scope(m_groupName, "multi", m_traceId);
+
+        if (m_step == Step::Initial || m_step == Step::Done || m_step == Step::Error) {
+            return;
+        }
+
+        // 第 0 层：分组解析（SystemManager）
+        SystemContext* group = nullptr;
+        ContextRejection mgrReason = ContextRejection::None;
+        if (!m_manager.tryGetGroup(m_groupName, group, mgrReason)) {
+            m_step = Step::Error;
+            m_lastError = mgrReason;
+            return;
+        }
+
+        // ★ Safety Lock Pre-check：与单轴编排器一致，急停时优雅中止回到 Done
+        if (group->emergencyStopController().isSystemLocked()) {
+            LOG_INFO(LogLayer::APP, "MultiOrch",
+                     "[" + m_groupName + "] Safety locked -- aborting gracefully");
+            restoreVelocities(group);
+            m_step = Step::Done;
+            m_lastError = std::monostate{};
+            return;
+        }
+
+        // 第 1 层：全部轴获取与龙门校验 + 硬件错误拦截
+        std::vector<Axis*> axes(m_legs.size(), nullptr);
+        for (size_t i = 0; i < m_legs.size(); ++i) {
+            ContextRejection ctxReason = ContextRejection::None;
+            if (!group->tryGetAxis(m_legs[i].id, axes[i], ctxReason)) {
+                abort(ctxReason);
+                return;
+            }
+            if (axes[i]->state() == AxisState::Error) {
+                LOG_ERROR(LogLayer::APP, "MultiOrch",
+                          "[" + m_groupName + "][" + axisName(m_legs[i].id) + "] Axis Error state -- aborting");
+                abort(axes[i]->lastRejection());
+                return;
+            }
+        }
+
+        switch (m_step) {
+
+        // ============================================================
+        // EnsuringEnabled：使能全部轴 -> 全部 Idle 后规划同步速度
+        // ============================================================
+
+        case Step::EnsuringEnabled: {
+            bool allIdle = true;
+            for (size_t i = 0; i < m_legs.size(); ++i) {
+                if (axes[i]->state() == AxisState::Disabled) {
+                    auto err = EnableUseCase{}.execute(m_manager, m_groupName, m_legs[i].id, true);
+                    if (!std::holds_alternative<std::monostate>(err)) {
+                        abort(err);
+                        return;
+                    }
+                }
+                allIdle = allIdle && axes[i]->state() == AxisState::Idle;
+            }
+            if (!allIdle) break;
+
+            if (!planSync(axes)) return;
+            if (m_syncSeconds <= 0.0) {
+                LOG_SUMMARY(LogLayer::APP, "MultiOrch",
+                            "[" + m_groupName + "] MultiAxisMove -> SUCCESS (already at target)");
+                disableAll();
+                m_step = Step::Done;
+                break;
+            }
+            LOG_DEBUG(LogLayer::APP, "MultiOrch",
+                      "[" + m_groupName + "] EnsuringEnabled -> SyncingVelocity, T="
+                          + std::to_string(m_syncSeconds) + "s");
+            m_step = Step::SyncingVelocity;
+            break;
+        }
+
+        // ============================================================
+        // SyncingVelocity：下发同步速度 -> 全部闭环后下发定位
+        // ============================================================
+
+        case Step::SyncingVelocity:
+            if (!sendVelocities(group, axes, /*restore=*/false)) return;
+            if (!velocitiesClosed(axes, /*restore=*/false)) break;
+            LOG_DEBUG(LogLayer::APP, "MultiOrch",
+                      "[" + m_groupName + "] SyncingVelocity -> IssuingMoves");
+            m_step = Step::IssuingMoves;
+            break;
+
+        // ============================================================
+        // IssuingMoves：同一帧下发全部绝对定位
+        // ============================================================
+
+        case Step::IssuingMoves:
+            for (size_t i = 0; i < m_legs.size(); ++i) {
+                Leg& leg = m_legs[i];
+                if (!leg.moving) continue;
+                auto err = MoveAbsoluteUseCase{}.execute(m_manager, m_groupName, leg.id, leg.target);
+                if (!std::holds_alternative<std::monostate>(err)) {
+                    LOG_ERROR(LogLayer::APP, "MultiOrch",
+                              "[" + m_groupName + "][" + axisName(leg.id) + "] MoveAbsolute rejected");
+                    abort(err);
+                    return;
+                }
+                leg.issued = true;
+            }
+            LOG_DEBUG(LogLayer::APP, "MultiOrch",
+                      "[" + m_groupName + "] IssuingMoves -> WaitingMotionFinish");
+            m_step = Step::WaitingMotionFinish;
+            break;
+
+        // ============================================================
+        // WaitingMotionFinish：全部轴定位闭环
+        // ============================================================
+
+        case Step::WaitingMotionFinish: {
+            bool allClosed = true;
+            for (size_t i = 0; i < m_legs.size(); ++i) {
+                allClosed = allClosed && (!m_legs[i].moving || axes[i]->isMoveCompleted());
+            }
+            if (!allClosed) break;
+
+            // 全部已闭环：不再需要停止，失败路径直接掉电；恢复阶段重新下发速度
+            for (auto& leg : m_legs) {
+                leg.issued = false;
+                leg.velocitySent = false;
+            }
+            for (size_t i = 0; i < m_legs.size(); ++i) {
+                if (std::abs(axes[i]->currentAbsolutePosition() - m_legs[i].target) >= m_epsilon) {
+                    LOG_SUMMARY(LogLayer::APP, "MultiOrch",
+                                "[" + m_groupName + "][" + axisName(m_legs[i].id) + "] MultiAxisMove -> ABORTED (Target not reached)");
+                    abort(RejectionReason::InvalidState);
+                    return;
+                }
+            }
+            LOG_DEBUG(LogLayer::APP, "MultiOrch",
+                      "[" + m_groupName + "] WaitingMotionFinish -> RestoringVelocity");
+            m_step = Step::RestoringVelocity;
+            break;
+        }
+
+        // ============================================================
+        // RestoringVelocity：恢复原定位速度 -> 闭环后掉电
+        // ============================================================
+
+        case Step::RestoringVelocity:
+            if (!sendVelocities(group, axes, /*restore=*/true)) return;
+            if (!velocitiesClosed(axes, /*restore=*/true)) break;
+            disableAll();
+            LOG_SUMMARY(LogLayer::APP, "MultiOrch",
+                        "[" + m_groupName + "] MultiAxisMove " + describeTargets() + " -> SUCCESS");
+            m_step = Step::Done;
+            break;
+
+        case Step::Initial:
+        case Step::Done:
+        case Step::Error:
+        default:
+            break;
+        }
+    }
+
+    // ========== 状态查询 ==========
+
+    Step currentStep() const { return m_step; }
+    bool isDone() const { return m_step == Step::Done; }
+    bool hasError() const { return m_step == Step::Error; }
+
+    /// @brief 同步后的共同运动时长（秒，匀速模型）；规划前为 0
+    double syncDuration() const { return m_syncSeconds; }
+
+    /// @brief 同步后下发给该轴的定位速度；轴不在本次目标中或无需运动时返回 0
+    double syncVelocity(AxisId id) const {
+        for (const auto& leg : m_legs) {
+            if (leg.id == id) return leg.moving ? leg.syncVelocity : 0.0;
+        }
+        return 0.0;
+    }
+
+    /**
+     * @brief 获取最后一次错误
+     * @return UseCaseError variant，包含 ContextRejection / RejectionReason / CommunicationResult
+     */
+    UseCaseError lastError() const { return m_lastError; }
+
+    /// @brief 获取错误码（保持与单轴编排器一致的 RejectionReason 提取）
+    RejectionReason errorReason() const {
+        if (std::holds_alternative<RejectionReason>(m_lastError)) {
+            return std::get<RejectionReason>(m_lastError);
+        }
+        return RejectionReason::None;
+    }
+
+private:
+    struct Leg {
+        AxisId id = AxisId::Y;
+        double target = 0.0;
+        double originalVelocity = 0.0;
+        double syncVelocity = 0.0;
+        bool moving = false;          ///< 距离超过到位容差，需要下发定位
+        bool velocityChanged = false; ///< PLC 中的定位速度已改为同步速度，尚未下发恢复
+        bool velocitySent = false;    ///< 当前阶段的速度设定已下发
+        bool issued = false;          ///< 定位已下发
+    };
+
+    /**
+     * @brief 记录起点并换算同步速度；目标越过软限位时在任何轴运动前拒绝
+     */
+    bool planSync(const std::vector<Axis*>& axes) {
+        m_syncSeconds = 0.0;
+        for (size_t i = 0; i < m_legs.size(); ++i) {
+            Leg& leg = m_legs[i];
+            const Axis* axis = axes[i];
+            if (leg.target > axis->positiveSoftLimit() || leg.target < axis->negativeSoftLimit()) {
+                LOG_ERROR(LogLayer::APP, "MultiOrch",
+                          "[" + m_groupName + "][" + axisName(leg.id) + "] target outside soft limits -- rejecting whole move");
+                abort(leg.target > axis->positiveSoftLimit() ? RejectionReason::TargetOutOfPositiveLimit
+                                                             : RejectionReason::TargetOutOfNegativeLimit);
+                return false;
+            }
+            const double distance = std::abs(leg.target - axis->currentAbsolutePosition());
+            leg.originalVelocity = axis->getMoveVelocity();
+            leg.moving = distance >= m_epsilon;
+            leg.velocitySent = false;
+            leg.velocityChanged = false;
+            leg.issued = false;
+            if (!leg.moving) continue;
+            if (leg.originalVelocity <= 0.0) {
+                abort(RejectionReason::InvalidState);
+                return false;
+            }
+            m_syncSeconds = std::max(m_syncSeconds, distance / leg.originalVelocity);
+        }
+        for (size_t i = 0; i < m_legs.size(); ++i) {
+            Leg& leg = m_legs[i];
+            if (!leg.moving) continue;
+            leg.syncVelocity = std::abs(leg.target - axes[i]->currentAbsolutePosition()) / m_syncSeconds;
+        }
+        return true;
+    }
+
+    double wantedVelocity(const Leg& leg, bool restore) const {
+        return restore ? leg.originalVelocity : leg.syncVelocity;
+    }
+
+    /**
+     * @brief 为速度与期望不一致的运动轴下发速度设定（每阶段每轴一次）
+     */
+    bool sendVelocities(SystemContext* group, const std::vector<Axis*>& axes, bool restore) {
+        for (size_t i = 0; i < m_legs.size(); ++i) {
+            Leg& leg = m_legs[i];
+            if (!leg.moving || leg.velocitySent) continue;
+            leg.velocitySent = true;
+            const double v = wantedVelocity(leg, restore);
+            if (axes[i]->getMoveVelocity() == v) continue;
+            if (!axes[i]->setMoveVelocity(v)) {
+                abort(axes[i]->lastRejection());
+                return false;
+            }
+            if (auto* drv = group->driver()) {
+                auto commResult = drv->send(AxisCommandWithId{leg.id, axes[i]->getPendingCommand()});
+                if (!commResult.ok()) {
+                    abort(commResult);
+                    return false;
+                }
+            }
+            leg.velocityChanged = !restore;
+        }
+        return true;
+    }
+
+    bool velocitiesClosed(const std::vector<Axis*>& axes, bool restore) const {
+        for (size_t i = 0; i < m_legs.size(); ++i) {
+            if (!m_legs[i].moving) continue;
+            if (axes[i]->getMoveVelocity() != wantedVelocity(m_legs[i], restore)
+                || !axes[i]->isMoveCompleted()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief 有轴已在运动时停止这些轴，否则掉电全部轴；恢复原定位速度后进入 Error
+    void abort(const UseCaseError& reason) {
+        bool stopped = false;
+        for (auto& leg : m_legs) {
+            if (!leg.issued) continue;
+            StopAxisUseCase{}.execute(m_manager, m_groupName, leg.id);
+            leg.issued = false;
+            stopped = true;
+        }
+        if (!stopped) disableAll();
+
+        SystemContext* group = nullptr;
+        ContextRejection mgrReason = ContextRejection::None;
+        if (m_manager.tryGetGroup(m_groupName, group, mgrReason)) {
+            restoreVelocities(group);
+        }
+        m_lastError = reason;
+        m_step = Step::Error;
+    }
+
+    /**
+     * @brief 中止路径：把仍为同步速度的轴的定位速度直接写回 PLC
+     *
+     * 不经 Axis::setMoveVelocity 的状态检查（急停锁定 / 轴 Error 时同样要恢复），
+     * 领域层的速度由后续反馈同步。发送失败只记录日志，不覆盖中止原因。
+     */
+    void restoreVelocities(SystemContext* group) {
+        ISystemDriver* drv = group->driver();
+        for (auto& leg : m_legs) {
+            if (!leg.velocityChanged) continue;
+            leg.velocityChanged = false;
+            if (!drv) continue;
+            const auto commResult = drv->send(AxisCommandWithId{leg.id, SetMoveVelocityCommand{leg.originalVelocity}});
+            if (!commResult.ok()) {
+                LOG_WARN(LogLayer::APP, "MultiOrch",
+                         "[" + m_groupName + "][" + axisName(leg.id) + "] failed to restore move velocity "
+                             + std::to_string(leg.originalVelocity));
+            }
+        }
+    }
+
+    void disableAll() {
+        for (const auto& leg : m_legs) {
+            EnableUseCase{}.execute(m_manager, m_groupName, leg.id, false);
+        }
+    }
+
+    std::string describeTargets() const {
+        std::string s;
+        for (const auto& leg : m_legs) {
+            if (!s.empty()) s += " ";
+            s += axisName(leg.id) + "=" + std::to_string(leg.target);
+        }
+        return s;
+    }
+
+    static std::string axisName(AxisId id) {
+        switch (id) {
+            case AxisId::Y:  return "Y";
+            case AxisId::Z:  return "Z";
+            case AxisId::R:  return "R";
+            case AxisId::X:  return "X";
+            case AxisId::X1: return "X1";
+            case AxisId::X2: return "X2";
+        }
+        return "?";
+    }
+
+    SystemManager& m_manager;
+    std::string m_groupName;
+    Step m_step;
+    std::vector<Leg> m_legs;
+    double m_syncSeconds = 0.0;
+    UseCaseError m_lastError = std::monostate{};
+
+    const double m_epsilon = 0.01;
+
+    std::string m_traceId = "N/A";
+};
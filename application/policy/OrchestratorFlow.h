@@ -0,0 +1,140 @@
+#pragma once
+
+#include "application/policy/OrchestratorWake.h"
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+/**
+ * @brief 编排流程协程（由 tick() 驱动的 C++20 协程）
+ *
+ * 编排器把"使能 -> 下发 -> 等待 -> 掉电"写成一段顺序代码，在等待处挂起：
+ *
+ *   FlowTask run() {
+ *       co_await until(WakeOn::AxisState | WakeOn::Safety, [this] { return m_axis->state() == AxisState::Idle; });
+ *       ...下发指令...
+ *       co_await nextTick();
+ *   }
+ *
+ * 驱动约定（与原 switch 状态机逐帧等价）：
+ *   - 协程创建后先挂起，第一次 poll() 才开始执行（对应 start*() 之后的第一帧）
+ *   - 每个 co_await 至少挂起到下一帧；之后每帧 poll() 先求值条件，满足才恢复
+ *   - 挂起期间不执行任何流程代码，条件求值只读当前帧已解析好的轴 / 分组
+ *   - wakeMask() 由当前挂起点声明，供 OrchestratorWakeGate 决定本帧是否需要 tick()
+ *   - signal() 供外部事件（如 UI 停止点动）立即唤醒，无论条件是否满足
+ *
+ * 开销：挂起的流程只占一个协程帧（一次堆分配，启动时发生）加一个条件函数指针，
+ * 条件对象存放在协程帧内，挂起 / 恢复本身不分配内存。
+ *
+ * 不使用异常：协程体内的失败一律写入编排器的 m_lastError 后 co_return。
+ */
+class FlowTask {
+public:
+    /// @brief 当前挂起点：唤醒掩码 + 类型擦除的就绪条件（空 = 下一帧即就绪）
+    struct Wait {
+        WakeOn mask = WakeOn::EveryTick;
+        bool (*ready)(const void*) = nullptr;
+        const void* condition = nullptr;
+    };
+
+    struct promise_type {
+        Wait wait;
+        bool signalled = false;
+
+        FlowTask get_return_object() { return FlowTask{Handle::from_promise(*this)}; }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+    using Handle = std::coroutine_handle<promise_type>;
+
+    FlowTask() = default;
+    FlowTask(FlowTask&& other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+    FlowTask& operator=(FlowTask&& other) noexcept {
+        if (this != &other) {
+            reset();
+            m_handle = std::exchange(other.m_handle, {});
+        }
+        return *this;
+    }
+    FlowTask(const FlowTask&) = delete;
+    FlowTask& operator=(const FlowTask&) = delete;
+    ~FlowTask() { reset(); }
+
+    /// @brief 流程已启动且尚未结束
+    bool active() const { return m_handle && !m_handle.done(); }
+
+    /// @brief 当前挂起点的唤醒条件；已结束为 None，被 signal() 时为 EveryTick
+    WakeOn wakeMask() const {
+        if (!active()) return WakeOn::None;
+        const auto& p = m_handle.promise();
+        return p.signalled ? WakeOn::EveryTick : p.wait.mask;
+    }
+
+    /// @brief 外部事件：下一次 poll() 无条件恢复
+    void signal() {
+        if (active()) m_handle.promise().signalled = true;
+    }
+
+    /**
+     * @brief 条件满足（或已 signal）时恢复一次，运行到下一个挂起点或结束
+     * @return 本帧是否执行了流程代码
+     */
+    bool poll() {
+        if (!active()) return false;
+        auto& p = m_handle.promise();
+        if (!p.signalled && p.wait.ready && !p.wait.ready(p.wait.condition)) {
+            return false;
+        }
+        p.signalled = false;
+        m_handle.resume();
+        return true;
+    }
+
+    /// @brief 销毁流程（挂起点上的局部对象按正常顺序析构）
+    void reset() {
+        if (m_handle) {
+            m_handle.destroy();
+            m_handle = {};
+        }
+    }
+
+private:
+    explicit FlowTask(Handle h) : m_handle(h) {}
+
+    Handle m_handle{};
+};
+
+/// @brief co_await until(mask, pred)：挂起到 pred() 为 true 的那一帧
+template<typename Pred>
+class FlowUntil {
+public:
+    FlowUntil(WakeOn mask, Pred pred) : m_mask(mask), m_pred(std::move(pred)) {}
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(FlowTask::Handle h) noexcept {
+        h.promise().wait = FlowTask::Wait{m_mask, &FlowUntil::check, this};
+    }
+    void await_resume() const noexcept {}
+
+private:
+    static bool check(const void* self) { return static_cast<const FlowUntil*>(self)->m_pred(); }
+
+    WakeOn m_mask;
+    Pred m_pred;
+};
+
+template<typename Pred>
+FlowUntil<Pred> until(WakeOn mask, Pred pred) {
+    return FlowUntil<Pred>(mask, std::move(pred));
+}
+
+/// @brief co_await nextTick()：挂起一帧（下发指令的步骤，每帧推进）
+struct FlowNextTick {
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(FlowTask::Handle h) noexcept { h.promise().wait = FlowTask::Wait{}; }
+    void await_resume() const noexcept {}
+};
+
+inline FlowNextTick nextTick() { return {}; }
@@ -0,0 +1,215 @@
+#pragma once
+
+#include "domain/entity/AxisId.h"
+#include "infrastructure/utils/LatencyHistogram.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 编排器步骤计时 + 看门狗
+ *
+ * 每个编排器持有一份，按 Step 枚举记录：
+ *   1. 步骤切换的时间戳（最近 HISTORY 次，环形缓冲）
+ *   2. 每根轴、每个步骤的停留时长直方图（LatencyHistogram，纳秒）
+ *   3. 每个步骤可选的期限（deadline）：超期后由编排器转入 Error(StepTimeout)
+ *
+ * 调用约定（编排器内部）：
+ *   start*()  -> begin(axis, step)            进入首个步骤
+ *   tick()    -> Scope traced(trace, m_step)  析构时 observe(m_step)，捕获本帧所有出口上的切换
+ *             -> deadlineExpired()            已超期则编排器自行中止并 noteTimeout()
+ *
+ * 时钟只在步骤切换和检查已配置期限时读取；未配置期限的步骤每帧没有额外开销。
+ * 期限的检测精度等于 tick() 的推进间隔（经 OrchestratorWakeGate 推进时为心跳周期）。
+ *
+ * 查询示例：
+ *   auto s = orch.stepTrace().summary(AxisId::Y, Step::EnsuringEnabled);   // p50 / p99 / max（微秒）
+ *
+ * @tparam StepT      编排器的 Step 枚举
+ * @tparam STEP_COUNT Step 枚举值个数（各编排器以 Error + 1 给出）
+ */
+template<typename StepT, size_t STEP_COUNT>
+class OrchestratorStepTrace {
+public:
+    using Clock = std::chrono::steady_clock;
+    using ClockFn = std::function<Clock::time_point()>;
+
+    static constexpr size_t HISTORY = 32;
+
+    /// @brief 一次步骤切换
+    struct Transition {
+        AxisId axis = AxisId::Y;
+        StepT from{};
+        StepT to{};
+        Clock::time_point at{};
+    };
+
+    /// @brief tick() 作用域守卫：析构时记录本帧结束时的步骤
+    class Scope {
+    public:
+        Scope(OrchestratorStepTrace& trace, const StepT& step) : m_trace(trace), m_step(step) {}
+        ~Scope() { m_trace.observe(m_step); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        OrchestratorStepTrace& m_trace;
+        const StepT& m_step;
+    };
+
+    /**
+     * @param idle  编排器的空闲步骤（Initial / Idle）
+     * @param done  成功终态
+     * @param error 失败终态
+     * 进入这三个步骤即结束计时，它们本身不计停留时长、也不受期限约束。
+     */
+    OrchestratorStepTrace(StepT idle, StepT done, StepT error)
+        : m_idle(idle), m_done(done), m_error(error) {}
+
+    // ========== 配置 ==========
+
+    /// @brief 替换时钟（测试中接入 FakeAxisDriver 的链路时钟）；空函数恢复 steady_clock
+    void setClock(ClockFn clock) { m_clock = std::move(clock); }
+
+    /// @brief 步骤期限；0 表示不限（默认）
+    void setDeadline(StepT step, std::chrono::milliseconds limit) { m_deadlines[index(step)] = limit; }
+    std::chrono::milliseconds deadline(StepT step) const { return m_deadlines[index(step)]; }
+
+    // ========== 编排器调用 ==========
+
+    /// @brief 流程（重新）开始：上一个未结束的步骤按其停留时间入账
+    void begin(AxisId axis, StepT step) {
+        const auto now = this->now();
+        if (m_active) {
+            close(now);
+        }
+        pushTransition(axis, m_step, step, now);
+        m_axis = axis;
+        m_step = step;
+        m_enteredAt = now;
+        m_active = !isTerminal(step);
+    }
+
+    /// @brief 记录当前步骤；与上次不同则切换计时，进入终态即停止计时
+    void observe(StepT step) {
+        if (!m_active || step == m_step) return;
+        const auto now = this->now();
+        close(now);
+        pushTransition(m_axis, m_step, step, now);
+        m_step = step;
+        m_enteredAt = now;
+        m_active = !isTerminal(step);
+    }
+
+    /// @brief 当前步骤是否已超过其期限
+    bool deadlineExpired() const {
+        if (!m_active) return false;
+        const auto limit = m_deadlines[index(m_step)];
+        return limit.count() > 0 && now() - m_enteredAt >= limit;
+    }
+
+    /// @brief 为当前步骤记一次超时（编排器据此转入 Error 前调用）
+    void noteTimeout() {
+        if (m_active) ++stats(m_axis, m_step).timeouts;
+    }
+
+    // ========== 查询 ==========
+
+    /// @brief 当前时钟读数（与步骤计时同源，供编排器测量跨步骤的端到端时长）
+    Clock::time_point now() const { return m_clock ? m_clock() : Clock::now(); }
+
+    StepT currentStep() const { return m_step; }
+    Clock::time_point enteredAt() const { return m_enteredAt; }
+    std::chrono::nanoseconds elapsedInStep() const {
+        return m_active ? now() - m_enteredAt : std::chrono::nanoseconds{0};
+    }
+
+    /// @brief 某轴某步骤的停留时长摘要（微秒）；从未进入过返回全零
+    LatencySummary summary(AxisId axis, StepT step) const {
+        LatencySummary out;
+        const LatencyHistogram* h = histogram(axis, step);
+        if (!h || h->count() == 0) return out;
+        out.count = h->count();
+        out.p50Us = static_cast<double>(h->percentile(0.50)) / 1000.0;
+        out.p99Us = static_cast<double>(h->percentile(0.99)) / 1000.0;
+        out.maxUs = static_cast<double>(h->max()) / 1000.0;
+        return out;
+    }
+
+    /// @brief 原始直方图（未记录过该轴时为 nullptr）
+    const LatencyHistogram* histogram(AxisId axis, StepT step) const {
+        auto it = m_stats.find(axis);
+        return it != m_stats.end() ? &(*it->second)[index(step)].durations : nullptr;
+    }
+
+    uint64_t timeouts(AxisId axis, StepT step) const {
+        auto it = m_stats.find(axis);
+        return it != m_stats.end() ? (*it->second)[index(step)].timeouts : 0;
+    }
+
+    /// @brief 最近的步骤切换，按时间从旧到新
+    std::vector<Transition> recentTransitions() const {
+        std::vector<Transition> out;
+        const size_t n = std::min(m_transitionCount, HISTORY);
+        out.reserve(n);
+        for (size_t i = m_transitionCount - n; i < m_transitionCount; ++i) {
+            out.push_back(m_transitions[i % HISTORY]);
+        }
+        return out;
+    }
+
+    /// @brief 清空统计与切换记录（期限与时钟保留）
+    void resetStats() {
+        m_stats.clear();
+        m_transitionCount = 0;
+    }
+
+private:
+    struct StepStats {
+        LatencyHistogram durations;
+        uint64_t timeouts = 0;
+    };
+    using AxisStats = std::array<StepStats, STEP_COUNT>;
+
+    static constexpr size_t index(StepT step) { return static_cast<size_t>(step); }
+
+    /// @brief 每根轴的统计在首次使用时分配（单轴约 STEP_COUNT × 4KB）
+    StepStats& stats(AxisId axis, StepT step) {
+        auto& steps = m_stats[axis];
+        if (!steps) steps = std::make_unique<AxisStats>();
+        return (*steps)[index(step)];
+    }
+
+    void close(Clock::time_point now) {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_enteredAt).count();
+        stats(m_axis, m_step).durations.record(static_cast<uint64_t>(std::max<int64_t>(ns, 0)));
+    }
+
+    bool isTerminal(StepT step) const { return step == m_idle || step == m_done || step == m_error; }
+
+    void pushTransition(AxisId axis, StepT from, StepT to, Clock::time_point at) {
+        m_transitions[m_transitionCount % HISTORY] = Transition{axis, from, to, at};
+        ++m_transitionCount;
+    }
+
+    StepT m_idle;
+    StepT m_done;
+    StepT m_error;
+
+    ClockFn m_clock;
+    std::array<std::chrono::milliseconds, STEP_COUNT> m_deadlines{};
+    std::unordered_map<AxisId, std::unique_ptr<AxisStats>> m_stats;
+
+    bool m_active = false;
+    AxisId m_axis = AxisId::Y;
+    StepT m_step = m_idle;
+    Clock::time_point m_enteredAt{};
+
+    std::array<Transition, HISTORY> m_transitions{};
+    size_t m_transitionCount = 0;
+};
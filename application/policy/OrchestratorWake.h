@@ -0,0 +1,125 @@
+#pragma once
+
+#include "domain/entity/SystemContext.h"
+#include "domain/entity/Axis.h"
+#include <cstdint>
+
+/**
+ * @brief 编排器唤醒条件（位掩码）
+ *
+ * 每个编排器按当前步骤声明自己在等什么（wakeMask()），
+ * 调用方只在对应变化发生时才推进它的 tick()：
+ *
+ *   Initial / Done / Error          -> None         （不推进，直到下一次 start*）
+ *   下发指令的步骤（IssuingMove ...） -> EveryTick    （本帧就要动作）
+ *   等待反馈的步骤                   -> AxisState | AxisPosition | Safety 的组合
+ */
+enum class WakeOn : uint8_t {
+    None         = 0,
+    AxisState    = 1 << 0,   ///< 轴状态 / 限位状态位 / 待决意图种类变化（Axis::stateRevision）
+    AxisPosition = 1 << 1,   ///< 轴位置变化（Axis::positionRevision）
+    Safety       = 1 << 2,   ///< 急停状态 / 龙门联动状态变化（决定 tryGetAxis 的裁决）
+    EveryTick    = 1 << 7,   ///< 当前步骤本身需要动作，每帧推进
+};
+
+constexpr WakeOn operator|(WakeOn a, WakeOn b) {
+    return static_cast<WakeOn>(static_cast<uint8_t>(a) | static_cast<uint8_t>(b));
+}
+
+constexpr bool hasWake(WakeOn mask, WakeOn bit) {
+    return (static_cast<uint8_t>(mask) & static_cast<uint8_t>(bit)) != 0;
+}
+
+/**
+ * @brief 一帧开始时的可观测变化戳
+ *
+ * 由调用方在推进编排器前采集一次（同一轴的三个编排器共用），
+ * 只读取计数与枚举值，不经过 tryGetAxis 的安全锁定拦截。
+ */
+struct WakeStamp {
+    uint64_t axisState = 0;
+    uint64_t axisPosition = 0;
+    uint8_t safety = 0;
+    uint8_t coupling = 0;
+    bool axisReadable = false;
+
+    static WakeStamp capture(SystemContext& group, AxisId id) {
+        WakeStamp s;
+        s.safety = static_cast<uint8_t>(group.emergencyStopController().state());
+        s.coupling = static_cast<uint8_t>(group.gantryCouplingController().status());
+        Axis* axis = nullptr;
+        ContextRejection reason = ContextRejection::None;
+        if (group.tryReadAxis(id, axis, reason) && axis) {
+            s.axisReadable = true;
+            s.axisState = axis->stateRevision();
+            s.axisPosition = axis->positionRevision();
+        }
+        return s;
+    }
+};
+
+/**
+ * @brief 单个编排器的唤醒闸门
+ *
+ * 判定顺序：
+ *   1. arm() 过（start* / stop* 等显式入口之后）   -> 推进
+ *   2. wakeMask() == None                          -> 不推进
+ *   3. EveryTick                                    -> 推进
+ *   4. 掩码内任一变化戳与上次推进时不同              -> 推进
+ *   5. 活动步骤距上次推进已满 HEARTBEAT_TICKS 帧     -> 推进（心跳：补发丢失的指令、超时类判断）
+ *
+ * 推进后若步骤发生变化，自动 arm()，保证新步骤至少被推进一次。
+ *
+ * 使用示例：
+ *   WakeStamp now = WakeStamp::capture(*group, AxisId::Y);
+ *   m_absGate.drive(*m_absOrch, now);
+ */
+class OrchestratorWakeGate {
+public:
+    static constexpr uint32_t HEARTBEAT_TICKS = 10;
+
+    /// @brief 下一帧无条件推进一次
+    void arm() { m_armed = true; }
+    bool isArmed() const { return m_armed; }
+
+    /// @brief 按唤醒条件判定本帧是否推进；推进则记录变化戳
+    bool shouldWake(WakeOn mask, const WakeStamp& now) {
+        bool wake = m_armed || hasWake(mask, WakeOn::EveryTick);
+        if (!wake && mask != WakeOn::None) {
+            wake = (hasWake(mask, WakeOn::AxisState)
+                        && (now.axisState != m_seen.axisState || now.axisReadable != m_seen.axisReadable))
+                || (hasWake(mask, WakeOn::AxisPosition) && now.axisPosition != m_seen.axisPosition)
+                || (hasWake(mask, WakeOn::Safety)
+                        && (now.safety != m_seen.safety || now.coupling != m_seen.coupling))
+                || m_sinceWake + 1 >= HEARTBEAT_TICKS;
+        }
+        if (!wake) {
+            if (mask != WakeOn::None) ++m_sinceWake;
+            return false;
+        }
+        m_seen = now;
+        m_sinceWake = 0;
+        m_armed = false;
+        ++m_wakes;
+        return true;
+    }
+
+    /// @brief 判定并推进编排器；返回本帧是否推进
+    template <typename Orch>
+    bool drive(Orch& orch, const WakeStamp& now) {
+        if (!shouldWake(orch.wakeMask(), now)) return false;
+        const auto before = orch.currentStep();
+        orch.tick();
+        if (orch.currentStep() != before) arm();
+        return true;
+    }
+
+    /// @brief 累计推进次数（诊断用）
+    uint64_t wakes() const { return m_wakes; }
+
+private:
+    WakeStamp m_seen;
+    uint32_t m_sinceWake = 0;
+    bool m_armed = false;
+    uint64_t m_wakes = 0;
+};
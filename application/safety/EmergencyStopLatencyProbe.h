@@ -0,0 +1,193 @@
+#pragma once
+#include "application/SystemManager.h"
+#include "domain/entity/SystemContext.h"
+#include "infrastructure/utils/LatencyHistogram.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 急停确认延迟探针（请求 -> 各分组 EmergencyStopController 到达 EmergencyStopped）
+ *
+ * 调用约定：
+ *   GlobalEmergencyStopUseCase::execute(manager, &probe)   arm() + 每个分组 track() / fail()
+ *   每帧所有分组 pollFeedback() 之后 -> probe.poll()         记录新到达 EmergencyStopped 的分组
+ *
+ * 延迟 = 确认帧的 poll() 时刻 - arm() 时刻，分辨率等于 poll() 的调用间隔（主循环周期）。
+ * 受理的分组的确认延迟计入直方图；worstCase() 是全部请求中的最大值，供安全验收使用。
+ *
+ * 急停下发失败的分组（NotSynchronized / 通讯失败）记为未确认，延迟视为无穷大：
+ * 之后 lastWorstCase() / worstCase() 返回 nanoseconds::max()，任何预算判定都不会通过。
+ * 请求前已在急停流程中（AlreadyInState）的分组照常等待确认，但其延迟不是本次请求产生的，
+ * 不计入直方图与最坏值，只在 alreadyInState() 中单独计数。
+ *
+ * 探针按名称记录分组；SystemManager::generation() 变化（有分组被移除）时重新查找，
+ * 已不存在的分组记为未确认并停止跟踪。
+ */
+class EmergencyStopLatencyProbe {
+public:
+    using Clock = std::chrono::steady_clock;
+    using ClockFn = std::function<Clock::time_point()>;
+
+    /// @brief 单个分组在最近一次请求中的结果
+    struct GroupLatency {
+        std::string groupName;
+        std::chrono::nanoseconds latency{0};   ///< 已确认时有效
+        bool confirmed = false;
+        bool alreadyInState = false;           ///< 请求前已在急停流程中（不计入延迟统计）
+        bool failed = false;                   ///< 急停未被受理 / 下发失败（延迟视为无穷大）
+    };
+
+    /// @brief 替换时钟（测试 / 基准中接入 FakeAxisDriver 的链路时钟）；空函数恢复 steady_clock
+    void setClock(ClockFn clock) { m_clock = std::move(clock); }
+
+    // ========== 用例调用 ==========
+
+    /// @brief 新的急停请求：记录请求时刻，上一次请求中未确认的分组不再跟踪
+    void arm(SystemManager& manager) {
+        m_manager = &manager;
+        m_managerGeneration = manager.generation();
+        m_requestedAt = now();
+        m_groups.clear();
+        m_targets.clear();
+        m_pending = 0;
+        ++m_requests;
+    }
+
+    /**
+     * @brief 跟踪一个已受理急停的分组
+     * @param alreadyInState 请求前该分组已在急停流程中（确认后不计入延迟统计）
+     */
+    void track(const std::string& name, SystemContext& group, bool alreadyInState = false) {
+        m_groups.push_back(GroupLatency{name, std::chrono::nanoseconds{0}, false, alreadyInState, false});
+        m_targets.push_back(&group);
+        ++m_pending;
+        if (alreadyInState) ++m_alreadyInState;
+    }
+
+    /// @brief 记录一个急停未被受理的分组（不等待确认，最坏值视为无穷大）
+    void fail(const std::string& name) {
+        m_groups.push_back(GroupLatency{name, std::chrono::nanoseconds::max(), false, false, true});
+        m_targets.push_back(nullptr);
+        ++m_failures;
+    }
+
+    // ========== 每帧调用 ==========
+
+    /**
+     * @brief 检查尚未确认的分组
+     * @return 仍在等待确认的分组数
+     */
+    size_t poll() {
+        if (m_pending == 0) return 0;
+        if (m_manager->generation() != m_managerGeneration) {
+            reresolve();
+        }
+        const auto t = now();
+        for (size_t i = 0; i < m_groups.size(); ++i) {
+            if (!m_targets[i] || m_groups[i].confirmed) continue;
+            if (!m_targets[i]->emergencyStopController().isEmergencyStopped()) continue;
+
+            const auto latency = std::max(std::chrono::nanoseconds{0},
+                std::chrono::duration_cast<std::chrono::nanoseconds>(t - m_requestedAt));
+            m_groups[i].latency = latency;
+            m_groups[i].confirmed = true;
+            if (!m_groups[i].alreadyInState) {
+                m_histogram.record(static_cast<uint64_t>(latency.count()));
+            }
+            --m_pending;
+        }
+        return m_pending;
+    }
+
+    // ========== 查询 ==========
+
+    Clock::time_point now() const { return m_clock ? m_clock() : Clock::now(); }
+
+    /// @brief 最近一次请求跟踪的分组是否已全部确认
+    bool allConfirmed() const { return m_pending == 0; }
+    size_t pending() const { return m_pending; }
+
+    /// @brief 最近一次请求距今的时长（等待中的分组至少已等待这么久）
+    std::chrono::nanoseconds elapsed() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(now() - m_requestedAt);
+    }
+
+    /// @brief 最近一次请求的逐分组结果（按分组名称顺序）
+    const std::vector<GroupLatency>& lastRequest() const { return m_groups; }
+
+    /// @brief 最近一次请求中最慢的已确认分组（有分组失败时为 nanoseconds::max()）
+    std::chrono::nanoseconds lastWorstCase() const {
+        std::chrono::nanoseconds worst{0};
+        for (const auto& g : m_groups) {
+            if (g.failed) return std::chrono::nanoseconds::max();
+            if (g.confirmed && !g.alreadyInState) worst = std::max(worst, g.latency);
+        }
+        return worst;
+    }
+
+    /// @brief 全部请求、全部分组中的最大确认延迟（曾有分组失败时为 nanoseconds::max()）
+    std::chrono::nanoseconds worstCase() const {
+        if (m_failures > 0) return std::chrono::nanoseconds::max();
+        return std::chrono::nanoseconds(static_cast<int64_t>(m_histogram.max()));
+    }
+
+    /// @brief 确认延迟摘要（微秒）
+    LatencySummary summary() const {
+        LatencySummary out;
+        if (m_histogram.count() == 0) return out;
+        out.count = m_histogram.count();
+        out.p50Us = static_cast<double>(m_histogram.percentile(0.50)) / 1000.0;
+        out.p99Us = static_cast<double>(m_histogram.percentile(0.99)) / 1000.0;
+        out.maxUs = static_cast<double>(m_histogram.max()) / 1000.0;
+        return out;
+    }
+
+    const LatencyHistogram& histogram() const { return m_histogram; }
+    uint64_t requests() const { return m_requests; }
+    /// @brief 累计急停未被受理的分组次数
+    uint64_t failures() const { return m_failures; }
+    /// @brief 累计请求前已在急停流程中的分组次数（其延迟不计入直方图）
+    uint64_t alreadyInState() const { return m_alreadyInState; }
+
+    /// @brief 清空累计统计（最近一次请求的跟踪保留）
+    void resetStats() {
+        m_histogram.clear();
+        m_requests = 0;
+        m_failures = 0;
+        m_alreadyInState = 0;
+    }
+
+private:
+    void reresolve() {
+        m_managerGeneration = m_manager->generation();
+        for (size_t i = 0; i < m_groups.size(); ++i) {
+            if (!m_targets[i] || m_groups[i].confirmed) continue;
+            SystemContext* group = nullptr;
+            ContextRejection reason = ContextRejection::None;
+            if (m_manager->tryGetGroup(m_groups[i].groupName, group, reason)) {
+                m_targets[i] = group;
+            } else {
+                m_targets[i] = nullptr;
+                --m_pending;
+            }
+        }
+    }
+
+    ClockFn m_clock;
+    SystemManager* m_manager = nullptr;
+    uint64_t m_managerGeneration = 0;
+    Clock::time_point m_requestedAt{};
+
+    std::vector<GroupLatency> m_groups;
+    std::vector<SystemContext*> m_targets;   ///< 与 m_groups 一一对应；nullptr = 分组已移除
+    size_t m_pending = 0;
+
+    LatencyHistogram m_histogram;
+    uint64_t m_requests = 0;
+    uint64_t m_failures = 0;
+    uint64_t m_alreadyInState = 0;
+};
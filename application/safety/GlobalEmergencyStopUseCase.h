@@ -0,0 +1,98 @@
+#pragma once
+#include "application/UseCaseError.h"
+#include "application/SystemManager.h"
+#include "application/safety/EmergencyStopLatencyProbe.h"
+#include "domain/entity/SystemContext.h"
+#include "domain/safety/SafetyRejection.h"
+#include "domain/safety/SafetyState.h"
+#include "infrastructure/logger/Logger.h"
+#include <string>
+#include <variant>
+
+/**
+ * @brief 全局急停 UseCase（一次遍历，对全部分组扇出）
+ *
+ * 完整调用链：
+ *   UI -> GlobalEmergencyStopUseCase.execute(manager, &probe) -> UseCaseError
+ *
+ * 与 EmergencyStopUseCase 的区别：
+ *   1. 不按名称逐个查找：SystemManager::forEachGroup() 一次遍历全部分组
+ *   2. 命令经 ISystemDriver::sendUrgent() 下发，排在各驱动中所有尚未写入 PLC 的命令之前
+ *   3. 单个分组失败不中断扇出：其余分组照常下发，返回第一个失败
+ *   4. AlreadyInState（已在急停流程中）视为成功，探针单独计数、不计入确认延迟统计；
+ *      仍处于 EmergencyStopping 的分组重发一次急停命令（上次下发可能因通讯失败未送达）
+ *
+ * 每个分组的领域裁决与 EmergencyStopUseCase 相同（EmergencyStopController::requestEmergencyStop），
+ * NotSynchronized / ReleasingEmergencyStop 的分组照常被拒绝并记日志。
+ *
+ * 传入 EmergencyStopLatencyProbe 时，探针在遍历前记录请求时刻，
+ * 并跟踪每个受理的分组直到其 EmergencyStopController 到达 EmergencyStopped；
+ * 失败的分组经 fail() 记为未确认（最坏延迟视为无穷大）。
+ */
+class GlobalEmergencyStopUseCase {
+public:
+    GlobalEmergencyStopUseCase() = default;
+
+    /**
+     * @brief 对全部分组触发设备急停
+     * @param manager 系统管理器（分组注册表）
+     * @param probe   可选的确认延迟探针（调用方每帧 poll()）
+     * @return UseCaseError -- monostate 表示全部分组已受理，否则为第一个失败分组的错误
+     */
+    UseCaseError execute(SystemManager& manager, EmergencyStopLatencyProbe* probe = nullptr) {
+        if (probe) {
+            probe->arm(manager);
+        }
+
+        UseCaseError first = std::monostate{};
+        manager.forEachGroup([&](const std::string& name, SystemContext& group) {
+            bool alreadyInState = false;
+            UseCaseError result = stopGroup(group, alreadyInState);
+            if (std::holds_alternative<std::monostate>(result)) {
+                if (probe) probe->track(name, group, alreadyInState);
+                return;
+            }
+            LOG_WARN(LogLayer::APP, "GlobalEStopUC", "group " + name + " rejected emergency stop");
+            if (probe) probe->fail(name);
+            if (std::holds_alternative<std::monostate>(first)) {
+                first = result;
+            }
+        });
+        return first;
+    }
+
+private:
+    /// @param alreadyInState [out] 分组在请求前已处于急停流程中
+    static UseCaseError stopGroup(SystemContext& group, bool& alreadyInState) {
+        // ===== 阶段 1：安全域状态机裁决（已在急停流程中 = 幂等成功） =====
+        auto& controller = group.emergencyStopController();
+        SafetyRejection rejection = controller.requestEmergencyStop();
+        if (rejection == SafetyRejection::AlreadyInState) {
+            alreadyInState = true;
+            // 仍在 EmergencyStopping：上一次下发可能未送达，重发（急停寄存器写入幂等）
+            if (controller.state() == SafetyState::EmergencyStopping) {
+                if (auto* drv = group.driver()) {
+                    auto commResult = drv->sendUrgent(EmergencyStopCommand{ true });
+                    if (!commResult.ok()) {
+                        return commResult;
+                    }
+                }
+            }
+            return std::monostate{};
+        }
+        if (rejection != SafetyRejection::None) {
+            return rejection;  // NotSynchronized / InvalidStateTransition
+        }
+
+        // ===== 阶段 2：插队下发至物理驱动 =====
+        if (controller.hasPendingCommand()) {
+            if (auto* drv = group.driver()) {
+                auto commResult = drv->sendUrgent(controller.popPendingCommand());
+                if (!commResult.ok()) {
+                    return commResult;
+                }
+            }
+        }
+        return std::monostate{};
+    }
+};
@@ -0,0 +1,174 @@
+#include "application/SystemManager.h"
+#include "application/safety/EmergencyStopLatencyProbe.h"
+#include "application/safety/GlobalEmergencyStopUseCase.h"
+#include "domain/entity/SystemContext.h"
+#include "infrastructure/FakeAxisDriver.h"
+#include "infrastructure/FakePLC.h"
+#include "infrastructure/RetryingDriver.h"
+#include "infrastructure/logger/Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// 全局急停确认延迟基准（安全验收）
+//
+// 用法:
+//   bench_emergency_stop [分组数] [每种链路的 seed 数] [预算 ms]      默认 8 50 150
+//
+// 每个 seed 搭建 N 个分组（FakePLC -> FakeAxisDriver(链路模型) -> RetryingDriver），
+// 每组所有轴先排入 使能 + 绝对定位 命令，随后 GlobalEmergencyStopUseCase 一次扇出，
+// 由 EmergencyStopLatencyProbe 记录 请求 -> 各组 EmergencyStopped 的延迟。
+//
+// 时间单位为虚拟毫秒（主循环周期 10ms），逐 seed 可复现。
+// ideal / typical 链路的最坏延迟超过预算、或有分组未确认时，进程返回 1（可直接接入 CI）；
+// degraded 链路只报告，不参与判定。
+// ============================================================================
+
+namespace {
+
+constexpr int MAX_CYCLES = 1000;
+
+struct Fleet {
+    struct Group {
+        std::unique_ptr<FakePLC> plc;
+        std::unique_ptr<FakeAxisDriver> raw;
+        std::unique_ptr<RetryingDriver> driver;
+        SystemContext* ctx = nullptr;
+    };
+
+    SystemManager manager;
+    std::vector<Group> groups;
+    RetryingDriver::Clock::time_point retryNow{};
+    EmergencyStopLatencyProbe probe;
+
+    Fleet(size_t count, const LinkModel& link) {
+        for (size_t i = 0; i < count; ++i) {
+            Group g;
+            g.plc = std::make_unique<FakePLC>();
+            g.raw = std::make_unique<FakeAxisDriver>(*g.plc);
+            LinkModel perGroup = link;
+            perGroup.seed = link.seed * 1000 + static_cast<uint32_t>(i);
+            g.raw->setLinkModel(perGroup);
+            g.driver = std::make_unique<RetryingDriver>(*g.raw);
+            g.driver->setClock([this] { return retryNow; });
+            const std::string name = std::string("G") + std::to_string(i);
+            ContextRejection r;
+            manager.createGroup(name, r);
+            manager.tryGetGroup(name, g.ctx, r);
+            g.ctx->setDriver(g.driver.get());
+            groups.push_back(std::move(g));
+        }
+        probe.setClock([this] {
+            return EmergencyStopLatencyProbe::Clock::time_point{}
+                + std::chrono::milliseconds(groups.front().raw->linkClockMs());
+        });
+    }
+
+    void cycle() {
+        retryNow += std::chrono::milliseconds(FakeAxisDriver::CYCLE_MS);
+        for (auto& g : groups) g.driver->pollFeedback(*g.ctx);
+        probe.poll();
+    }
+
+    bool sync() {
+        for (int c = 0; c < MAX_CYCLES; ++c) {
+            bool synced = true;
+            for (const auto& g : groups) {
+                synced = synced && !g.ctx->emergencyStopController().isNotSynchronized();
+            }
+            if (synced) return true;
+            cycle();
+        }
+        return false;
+    }
+};
+
+/// @brief 一次扇出的结果
+struct Sample {
+    std::vector<int64_t> latenciesMs;   ///< 已确认分组的确认延迟
+    size_t unconfirmed = 0;             ///< 被拒绝或超时未确认的分组
+};
+
+Sample measure(size_t groups, const LinkModel& link) {
+    Sample s;
+    Fleet fleet(groups, link);
+    if (!fleet.sync()) {
+        s.unconfirmed = groups;
+        return s;
+    }
+    for (auto& g : fleet.groups) {
+        for (auto id : g.plc->axisIds()) {
+            g.driver->send(AxisCommandWithId{id, EnableCommand{true}});
+            g.driver->send(AxisCommandWithId{id, MoveCommand{MoveType::Absolute, 50.0, 0.0}});
+        }
+    }
+
+    GlobalEmergencyStopUseCase{}.execute(fleet.manager, &fleet.probe);
+    for (int c = 0; c < MAX_CYCLES && !fleet.probe.allConfirmed(); ++c) {
+        fleet.cycle();
+    }
+
+    const auto& outcome = fleet.probe.lastRequest();
+    s.unconfirmed = groups - outcome.size();
+    for (const auto& g : outcome) {
+        if (g.confirmed && g.alreadyInState) continue;   // 延迟不属于本次请求
+        if (g.confirmed) {
+            s.latenciesMs.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(g.latency).count());
+        } else {
+            ++s.unconfirmed;
+        }
+    }
+    return s;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    LoggerConfig logCfg;
+    logCfg.enableConsole = false;
+    logCfg.enableFile = false;
+    Logger::init(logCfg);
+
+    const size_t groups = argc > 1 ? std::max<size_t>(std::strtoul(argv[1], nullptr, 10), 1) : 8;
+    const uint32_t seeds = argc > 2 ? std::max<uint32_t>(static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)), 1) : 50;
+    const int64_t budgetMs = argc > 3 ? std::strtoll(argv[3], nullptr, 10) : 150;
+
+    struct Profile { const char* name; LinkModel (*make)(uint32_t); bool checked; };
+    const Profile profiles[] = {
+        {"ideal",    [](uint32_t) { return LinkModel::ideal(); }, true},
+        {"typical",  LinkModel::typical,                          true},
+        {"degraded", LinkModel::degraded,                         false},
+    };
+
+    std::printf("groups=%zu seeds=%u budget=%lld ms\n", groups, seeds, static_cast<long long>(budgetMs));
+    bool pass = true;
+    for (const auto& p : profiles) {
+        std::vector<int64_t> all;
+        size_t unconfirmed = 0;
+        for (uint32_t seed = 1; seed <= seeds; ++seed) {
+            const Sample s = measure(groups, p.make(seed));
+            all.insert(all.end(), s.latenciesMs.begin(), s.latenciesMs.end());
+            unconfirmed += s.unconfirmed;
+        }
+        std::sort(all.begin(), all.end());
+        const int64_t p50 = all.empty() ? -1 : all[all.size() / 2];
+        const int64_t p99 = all.empty() ? -1 : all[std::min(all.size() - 1, all.size() * 99 / 100)];
+        const int64_t worst = all.empty() ? -1 : all.back();
+
+        const bool ok = !all.empty() && unconfirmed == 0 && worst <= budgetMs;
+        if (p.checked && !ok) pass = false;
+        std::printf("%-9s  p50=%4lld ms  p99=%4lld ms  worst=%4lld ms  unconfirmed=%zu/%zu  %s\n",
+            p.name, static_cast<long long>(p50), static_cast<long long>(p99), static_cast<long long>(worst),
+            unconfirmed, groups * seeds, p.checked ? (ok ? "PASS" : "FAIL") : "(report only)");
+    }
+
+    Logger::shutdown();
+    return pass ? 0 : 1;
+}
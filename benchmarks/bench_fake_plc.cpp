@@ -0,0 +1,173 @@
+#include "infrastructure/FakePLC.h"
+#include "infrastructure/logger/Logger.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// ============================================================================
+// FakePLC 扫描周期基准
+//
+// 用法:
+//   bench_fake_plc [轴数 ...]          默认 6 64 256 1024 4096
+//
+// 每个规模:
+//   - 构造 N 轴 FakePLC，全部使能
+//   - 1/3 轴往复定位，1/3 轴点动（触碰限位后反向），其余静止
+//   - 统计 tick(10) 的平均耗时，以及折算到每轴每周期的耗时
+//
+// 输出的 "realtime x" = 10ms 周期预算 / 单次 tick 耗时，
+// 即仿真器单核能比实时快多少倍（上层负载测试时应远大于 1）。
+//
+// 另测长行程场景（每轴一次长距离定位，速度各不相同）：
+// 逐 10ms 推进 与 advanceToNextEvent() 事件跳跃 推进到全部到位的耗时对比。
+// ============================================================================
+
+namespace {
+
+constexpr int CYCLE_MS = 10;
+
+std::vector<AxisId> makeAxes(size_t n) {
+    std::vector<AxisId> ids;
+    ids.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        ids.push_back(static_cast<AxisId>(i));
+    }
+    return ids;
+}
+
+void runOne(size_t axisCount) {
+    const auto ids = makeAxes(axisCount);
+    FakePLC plc(ids);
+
+    for (auto id : ids) {
+        plc.setSimulatedMoveVelocity(id, 50.0);
+        plc.setSimulatedJogVelocity(id, 200.0);
+        plc.setLimits(id, 100.0, -100.0);
+        plc.onCommand(id, EnableCommand{true});
+    }
+    plc.tick(200);
+
+    // 给运动轴下发命令；到位 / 触限后重新下发，保持负载稳定
+    auto refill = [&] {
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (plc.getFeedback(ids[i]).state != AxisState::Idle) continue;
+            switch (i % 3) {
+                case 0: {
+                    const double target = plc.getFeedback(ids[i]).absPos > 0.0 ? -50.0 : 50.0;
+                    plc.onCommand(ids[i], MoveCommand{MoveType::Absolute, target, 0.0});
+                    break;
+                }
+                case 1: {
+                    const auto dir = plc.getFeedback(ids[i]).absPos > 0.0 ? Direction::Backward
+                                                                          : Direction::Forward;
+                    plc.onCommand(ids[i], JogCommand{dir, true});
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    };
+
+    // 预热
+    for (int k = 0; k < 100; ++k) {
+        refill();
+        plc.tick(CYCLE_MS);
+    }
+
+    // 命令下发不计时，只度量 tick()
+    const int ticksPerRound = 50;
+    const int rounds = static_cast<int>(std::max<size_t>(20, 200000 / (axisCount * ticksPerRound)));
+    std::chrono::nanoseconds total{0};
+    long long ticks = 0;
+    for (int r = 0; r < rounds; ++r) {
+        refill();
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int k = 0; k < ticksPerRound; ++k) {
+            plc.tick(CYCLE_MS);
+        }
+        total += std::chrono::steady_clock::now() - t0;
+        ticks += ticksPerRound;
+    }
+
+    const double nsPerTick = static_cast<double>(total.count()) / static_cast<double>(ticks);
+    std::printf("%6zu axes  %10.1f ns/tick  %7.2f ns/axis-tick  realtime x%.0f\n",
+        axisCount, nsPerTick, nsPerTick / static_cast<double>(axisCount),
+        CYCLE_MS * 1e6 / nsPerTick);
+}
+
+/// @brief 长行程：逐周期推进 vs 事件跳跃（只在到位时刻停下）
+void runLongMoves(size_t axisCount) {
+    const auto ids = makeAxes(axisCount);
+    auto setup = [&](FakePLC& plc) {
+        for (size_t i = 0; i < ids.size(); ++i) {
+            plc.setSimulatedMoveVelocity(ids[i], 20.0 + static_cast<double>(i % 17));
+            plc.onCommand(ids[i], EnableCommand{true});
+        }
+        plc.tick(200);
+        for (auto id : ids) plc.onCommand(id, MoveCommand{MoveType::Absolute, 900.0, 0.0});
+    };
+    auto allIdle = [&](const FakePLC& plc) {
+        for (auto id : ids) {
+            if (plc.getFeedback(id).state != AxisState::Idle) return false;
+        }
+        return true;
+    };
+
+    FakePLC stepped(ids);
+    setup(stepped);
+    const auto t0 = std::chrono::steady_clock::now();
+    double simMs = 0.0;
+    while (!allIdle(stepped)) {
+        stepped.tick(CYCLE_MS);
+        simMs += CYCLE_MS;
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+
+    FakePLC jumped(ids);
+    setup(jumped);
+    long long jumps = 0;
+    const auto t2 = std::chrono::steady_clock::now();
+    while (!allIdle(jumped)) {
+        jumped.advanceToNextEvent(1e9);
+        ++jumps;
+    }
+    const auto t3 = std::chrono::steady_clock::now();
+
+    const double steppedUs = std::chrono::duration<double, std::micro>(t1 - t0).count();
+    const double jumpedUs = std::chrono::duration<double, std::micro>(t3 - t2).count();
+    std::printf("%6zu axes  long moves %.1fs sim: 10ms steps %9.1f us (%lld ticks)  event jumps %9.1f us (%lld jumps)  x%.1f\n",
+        axisCount, simMs / 1000.0, steppedUs, static_cast<long long>(simMs / CYCLE_MS),
+        jumpedUs, jumps, jumpedUs > 0.0 ? steppedUs / jumpedUs : 0.0);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    // 限位日志走控制台会淹没计时结果
+    LoggerConfig logCfg;
+    logCfg.enableConsole = false;
+    logCfg.enableFile = false;
+    Logger::init(logCfg);
+
+    std::vector<size_t> sizes;
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(static_cast<size_t>(std::strtoul(argv[i], nullptr, 10)));
+    }
+    if (sizes.empty()) {
+        sizes = {6, 64, 256, 1024, 4096};
+    }
+
+    for (auto n : sizes) {
+        if (n > 0) runOne(n);
+    }
+    for (auto n : sizes) {
+        if (n > 0) runLongMoves(n);
+    }
+
+    Logger::shutdown();
+    return 0;
+}
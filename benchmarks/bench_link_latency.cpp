@@ -0,0 +1,178 @@
+#include "application/SystemManager.h"
+#include "application/policy/AutoAbsMoveOrchestrator.h"
+#include "application/policy/GantryOrchestrator.h"
+#include "application/policy/JogOrchestrator.h"
+#include "domain/entity/SystemContext.h"
+#include "infrastructure/FakeAxisDriver.h"
+#include "infrastructure/FakePLC.h"
+#include "infrastructure/RetryingDriver.h"
+#include "infrastructure/logger/Logger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// 编排器端到端延迟基准（链路模型）
+//
+// 用法:
+//   bench_link_latency [每种链路的 seed 数]      默认 20
+//
+// 对 ideal / typical / degraded 三种链路，各用 N 个 seed 跑:
+//   - abs-move   : Disabled 的 Y 轴绝对定位 50mm（含使能）直到编排器 Done
+//   - jog-start  : startJog 到 PLC 进入 Jogging
+//   - jog-stop   : stopJog 到编排器 Done
+//   - gantry     : 龙门掉电 -> 使能 -> 联动完成
+// 时间单位为虚拟毫秒（主循环周期 10ms），与宿主机速度无关，结果逐 seed 可复现。
+// FakeAxisDriver 外包一层 RetryingDriver（虚拟时钟），与现场部署的驱动栈一致。
+// ============================================================================
+
+namespace {
+
+constexpr int CYCLE_MS = FakeAxisDriver::CYCLE_MS;
+constexpr int MAX_CYCLES = 3000;
+
+struct Rig {
+    FakePLC plc;
+    FakeAxisDriver raw{plc};
+    RetryingDriver driver{raw};
+    SystemManager manager;
+    SystemContext* ctx = nullptr;
+    RetryingDriver::Clock::time_point now{};
+    const std::string group = "G";
+
+    explicit Rig(const LinkModel& link) {
+        raw.setLinkModel(link);
+        driver.setClock([this] { return now; });
+        ContextRejection r;
+        manager.createGroup(group, r);
+        manager.tryGetGroup(group, ctx, r);
+        ctx->setDriver(&driver);
+        for (auto id : plc.axisIds()) plc.setSimulatedMoveVelocity(id, 50.0);
+    }
+
+    int loop(const std::function<void()>& tick, const std::function<bool()>& done) {
+        for (int c = 0; c < MAX_CYCLES; ++c) {
+            if (done()) return c;
+            cycle();
+            tick();
+        }
+        return -1;
+    }
+
+    void cycle() {
+        now += std::chrono::milliseconds(CYCLE_MS);
+        driver.pollFeedback(*ctx);
+    }
+
+    bool sync() {
+        return loop([] {}, [this] {
+            return !ctx->emergencyStopController().isNotSynchronized()
+                && !ctx->gantryCouplingController().isNotSynchronized();
+        }) >= 0;
+    }
+};
+
+/// @brief 一次测量结果（周期数，-1 = 失败 / 超时）
+struct Sample {
+    int absMove = -1;
+    int jogStart = -1;
+    int jogStop = -1;
+    int gantry = -1;
+};
+
+Sample measure(const LinkModel& link) {
+    Sample s;
+    {
+        Rig rig(link);
+        if (rig.sync()) {
+            AutoAbsMoveOrchestrator orch(rig.manager, rig.group);
+            orch.startAbs(AxisId::Y, 50.0);
+            const int c = rig.loop([&] { orch.tick(); }, [&] { return orch.isDone() || orch.hasError(); });
+            if (c >= 0 && orch.isDone() && std::abs(rig.plc.getFeedback(AxisId::Y).absPos - 50.0) < 1e-6) s.absMove = c;
+        }
+    }
+    {
+        Rig rig(link);
+        if (rig.sync()) {
+            JogOrchestrator orch(rig.manager, rig.group);
+            orch.startJog(AxisId::Y, Direction::Forward);
+            const int c = rig.loop([&] { orch.tick(); }, [&] {
+                return orch.hasError() || rig.plc.getFeedback(AxisId::Y).state == AxisState::Jogging;
+            });
+            if (c >= 0 && !orch.hasError()) {
+                s.jogStart = c;
+                for (int k = 0; k < 20; ++k) { rig.cycle(); orch.tick(); }
+                orch.stopJog(AxisId::Y, Direction::Forward);
+                const int d = rig.loop([&] { orch.tick(); }, [&] { return orch.isDone() || orch.hasError(); });
+                if (d >= 0 && orch.isDone()) s.jogStop = d;
+            }
+        }
+    }
+    {
+        Rig rig(link);
+        if (rig.sync()) {
+            GantryOrchestrator orch(rig.manager, rig.group);
+            orch.startCoupling();
+            const int c = rig.loop([&] { orch.tick(); }, [&] { return orch.isDone() || orch.hasError(); });
+            if (c >= 0 && orch.isDone() && rig.plc.getGantryFeedback().isCoupled) s.gantry = c;
+        }
+    }
+    return s;
+}
+
+void printRow(const char* link, const char* flow, std::vector<int> cycles) {
+    const size_t total = cycles.size();
+    cycles.erase(std::remove(cycles.begin(), cycles.end(), -1), cycles.end());
+    const size_t failed = total - cycles.size();
+    if (cycles.empty()) {
+        std::printf("%-9s %-10s  all %zu runs failed\n", link, flow, total);
+        return;
+    }
+    std::sort(cycles.begin(), cycles.end());
+    const int p50 = cycles[cycles.size() / 2];
+    const int p90 = cycles[std::min(cycles.size() - 1, cycles.size() * 9 / 10)];
+    std::printf("%-9s %-10s  p50=%6d ms  p90=%6d ms  max=%6d ms  failed=%zu/%zu\n",
+        link, flow, p50 * CYCLE_MS, p90 * CYCLE_MS, cycles.back() * CYCLE_MS, failed, total);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    LoggerConfig logCfg;
+    logCfg.enableConsole = false;
+    logCfg.enableFile = false;
+    Logger::init(logCfg);
+
+    const uint32_t seeds = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 20;
+
+    struct Profile { const char* name; LinkModel (*make)(uint32_t); };
+    const Profile profiles[] = {
+        {"ideal",    [](uint32_t) { return LinkModel::ideal(); }},
+        {"typical",  LinkModel::typical},
+        {"degraded", LinkModel::degraded},
+    };
+
+    for (const auto& p : profiles) {
+        std::vector<int> absMove, jogStart, jogStop, gantry;
+        for (uint32_t seed = 1; seed <= std::max<uint32_t>(seeds, 1); ++seed) {
+            const Sample s = measure(p.make(seed));
+            absMove.push_back(s.absMove);
+            jogStart.push_back(s.jogStart);
+            jogStop.push_back(s.jogStop);
+            gantry.push_back(s.gantry);
+        }
+        printRow(p.name, "abs-move", absMove);
+        printRow(p.name, "jog-start", jogStart);
+        printRow(p.name, "jog-stop", jogStop);
+        printRow(p.name, "gantry", gantry);
+    }
+
+    Logger::shutdown();
+    return 0;
+}
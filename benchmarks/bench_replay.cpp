@@ -0,0 +1,151 @@
+#include "application/SystemManager.h"
+#include "domain/entity/SystemContext.h"
+#include "infrastructure/CaptureFile.h"
+#include "infrastructure/ReplayDriver.h"
+#include "infrastructure/logger/Logger.h"
+#include "presentation/viewmodel/AxisViewModelCore.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// 捕获回放基准
+//
+// 用法:
+//   servoV6_headless --load 16x32 --soak 60 --record load.cap
+//   bench_replay load.cap [重复次数]              默认 3
+//
+// 把捕获文件中每个分组的反馈序列以最快速度重新注入 SystemContext，
+// 并在每个周期 tick 全部 AxisViewModelCore（与主循环的阶段顺序一致）。
+// 不运行 PLC 物理推演与链路仿真，测得的是上层（领域 + 编排 + ViewModel）
+// 在现场反馈序列下的吞吐，可与 --load 的分阶段耗时直接对照。
+// ============================================================================
+
+namespace {
+
+struct ReplayGroup {
+    std::string name;
+    std::unique_ptr<ReplayDriver> driver;
+    SystemContext* ctx = nullptr;
+    std::vector<AxisId> axisIds;
+    std::vector<std::unique_ptr<AxisViewModelCore>> axes;
+};
+
+/// @brief 分组的首帧反馈（用于登记轴集合）；没有反馈时返回 false
+bool firstFrame(const CaptureReader& reader, uint16_t group, FeedbackFrame& out) {
+    for (const auto& r : reader.records()) {
+        if (r.group == group && CaptureReader::decodeFeedback(r, out)) return true;
+    }
+    return false;
+}
+
+struct PassResult {
+    uint64_t cycles = 0;
+    uint64_t frames = 0;
+    uint64_t divergences = 0;
+    size_t axes = 0;
+    double wallSeconds = 0.0;
+};
+
+PassResult runPass(const CaptureReader& reader) {
+    SystemManager manager;
+    std::vector<ReplayGroup> groups;
+    ContextRejection reason;
+
+    const auto& names = reader.groupNames();
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (names[i].empty()) continue;
+        const auto id = static_cast<uint16_t>(i);
+        FeedbackFrame frame;
+        if (!firstFrame(reader, id, frame)) continue;
+
+        ReplayGroup g;
+        g.name = names[i];
+        g.driver = std::make_unique<ReplayDriver>(reader, id);
+        if (!manager.createGroup(g.name, reason) || !manager.tryGetGroup(g.name, g.ctx, reason)) continue;
+        g.ctx->setDriver(g.driver.get());
+        for (const auto& [axisId, fb] : frame.axes) {
+            g.ctx->registerAxis(axisId);
+            g.ctx->setAxisIdentity(axisId, g.name);
+            g.axisIds.push_back(axisId);
+        }
+        groups.push_back(std::move(g));
+    }
+
+    PassResult result;
+    const auto start = std::chrono::steady_clock::now();
+
+    // 首次同步之后再创建 ViewModel（与 main.cpp 一致）
+    for (auto& g : groups) {
+        g.driver->pollFeedback(*g.ctx);
+    }
+    for (auto& g : groups) {
+        for (auto id : g.axisIds) {
+            g.axes.push_back(std::make_unique<AxisViewModelCore>(manager, g.name, id));
+            ++result.axes;
+        }
+    }
+
+    bool running = true;
+    while (running) {
+        running = false;
+        for (auto& g : groups) {
+            if (g.driver->finished()) continue;
+            running = true;
+            g.driver->pollFeedback(*g.ctx);
+        }
+        for (auto& g : groups) {
+            for (auto& vm : g.axes) vm->tick();
+        }
+        if (running) ++result.cycles;
+    }
+
+    result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (const auto& g : groups) {
+        result.frames += g.driver->stats().framesDispatched;
+        result.divergences += g.driver->stats().divergences;
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <capture-file> [repeats]\n", argv[0]);
+        return 2;
+    }
+    const int repeats = argc > 2 ? std::max(1, std::atoi(argv[2])) : 3;
+
+    LoggerConfig logCfg;
+    logCfg.enableConsole = false;
+    logCfg.enableFile = false;
+    Logger::init(logCfg);
+
+    CaptureReader reader;
+    if (!reader.open(argv[1])) {
+        std::fprintf(stderr, "cannot open capture %s\n", argv[1]);
+        Logger::shutdown();
+        return 1;
+    }
+
+    std::printf("capture: %zu records, %zu groups\n", reader.records().size(), reader.groupNames().size());
+    for (int pass = 0; pass < repeats; ++pass) {
+        const PassResult r = runPass(reader);
+        const double perCycleUs = r.cycles ? r.wallSeconds * 1e6 / static_cast<double>(r.cycles) : 0.0;
+        std::printf("pass %d: %zu axes, %llu cycles, %llu frames in %.3fs -> %.0f frames/s, %.1f us/cycle, divergences=%llu\n",
+            pass, r.axes,
+            static_cast<unsigned long long>(r.cycles), static_cast<unsigned long long>(r.frames),
+            r.wallSeconds, r.wallSeconds > 0.0 ? static_cast<double>(r.frames) / r.wallSeconds : 0.0,
+            perCycleUs, static_cast<unsigned long long>(r.divergences));
+    }
+
+    Logger::shutdown();
+    return 0;
+}
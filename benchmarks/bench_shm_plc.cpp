@@ -0,0 +1,127 @@
+#include "application/SystemManager.h"
+#include "domain/entity/SystemContext.h"
+#include "infrastructure/FakeAxisDriver.h"
+#include "infrastructure/FakePLC.h"
+#include "infrastructure/ShmPlcDriver.h"
+#include "infrastructure/ShmPlcServer.h"
+#include "infrastructure/logger/Logger.h"
+#include "infrastructure/utils/LatencyHistogram.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+// ============================================================================
+// 进程外仿真器往返延迟基准
+//
+// 用法:
+//   bench_shm_plc [每组轴数] [周期数]             默认 6 轴 / 20000 周期
+//
+// 对同一份 FakePLC 配置分别测量每周期 pollFeedback 的墙钟耗时:
+//   - in-process : FakeAxisDriver 直接调用 FakePLC（仿真耗时计入调用方线程）
+//   - shm        : fork 出的 ShmPlcServer 子进程，Lockstep 握手（跨进程往返 + 反馈块 seqlock 读）
+// 两者的差值即进程边界本身的代价；子进程的 CPU 时间可单独用 perf / top 观察。
+// ============================================================================
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Rig {
+    SystemManager manager;
+    SystemContext* ctx = nullptr;
+
+    explicit Rig(ISystemDriver& driver) {
+        ContextRejection r;
+        manager.createGroup("G", r);
+        manager.tryGetGroup("G", ctx, r);
+        ctx->setDriver(&driver);
+    }
+};
+
+LatencyHistogram measure(ISystemDriver& driver, int cycles) {
+    Rig rig(driver);
+    for (int i = 0; i < 200; ++i) driver.pollFeedback(*rig.ctx);   // 预热
+
+    LatencyHistogram h;
+    for (int i = 0; i < cycles; ++i) {
+        const auto t0 = Clock::now();
+        driver.pollFeedback(*rig.ctx);
+        h.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count()));
+    }
+    return h;
+}
+
+void print(const char* name, const LatencyHistogram& h) {
+    std::printf("  %-11s p50=%7.2fus  p99=%7.2fus  p99.9=%7.2fus  max=%8.2fus\n", name,
+        h.percentile(0.50) / 1000.0, h.percentile(0.99) / 1000.0,
+        h.percentile(0.999) / 1000.0, h.max() / 1000.0);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const size_t axes = argc > 1 ? static_cast<size_t>(std::max(1, std::atoi(argv[1]))) : 6;
+    const int cycles = argc > 2 ? std::max(1, std::atoi(argv[2])) : 20000;
+    if (axes > shmplc::MAX_AXES) {
+        std::fprintf(stderr, "at most %u axes per group\n", shmplc::MAX_AXES);
+        return 2;
+    }
+
+    LoggerConfig logCfg;
+    logCfg.enableConsole = false;
+    logCfg.enableFile = false;
+    Logger::init(logCfg);
+
+    const FakePLCConfig cfg = FakePLCConfig::scaled(axes, 1, FakeAxisProfile{20.0, 50.0, 1000.0, -1000.0});
+    std::printf("pollFeedback wall time, %zu axes, %d cycles\n", cfg.axes.size(), cycles);
+
+    {
+        FakePLC plc(cfg);
+        FakeAxisDriver driver(plc);
+        print("in-process", measure(driver, cycles));
+    }
+
+    // 日志线程在 fork 前停掉，子进程不继承持锁状态
+    Logger::shutdown();
+    const std::string seg = shmplc::segmentName("bench." + std::to_string(::getpid()));
+    const pid_t child = ::fork();
+    if (child < 0) {
+        std::perror("fork");
+        return 1;
+    }
+    if (child == 0) {
+        ShmPlcServer server(seg, cfg);
+        if (!server.start()) ::_exit(1);
+        std::atomic<bool> never{false};
+        server.run(never);
+        server.stop();
+        ::_exit(0);
+    }
+
+    ShmPlcDriver driver(seg);
+    bool connected = false;
+    for (int i = 0; i < 1000 && !connected; ++i) {
+        connected = driver.connect();
+        if (!connected) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    int rc = 0;
+    if (connected) {
+        print("shm", measure(driver, cycles));
+        std::printf("  tick timeouts=%llu\n", static_cast<unsigned long long>(driver.stats().tickTimeouts));
+        driver.requestServerShutdown();
+    } else {
+        std::fprintf(stderr, "simulator child did not come online\n");
+        ::kill(child, SIGKILL);
+        rc = 1;
+    }
+    ::waitpid(child, nullptr, 0);
+    return rc;
+}
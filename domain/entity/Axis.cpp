@@ -40,6 +40,11 @@ void Axis::applyFeedback(const AxisFeedback &feedback)
 
     // --- 状态镜像 + 速度镜像 ---
     AxisState prevState = m_state;
+    const double prevAbs = m_current_abs_pos;
+    const double prevRel = m_current_rel_pos;
+    const bool prevPosLimit = m_pos_limit_active;
+    const bool prevNegLimit = m_neg_limit_active;
+    const size_t prevIntent = m_pending_intent.index();
     m_state = feedback.state;
     m_current_abs_pos = feedback.absPos;
     m_current_rel_pos = feedback.relPos;
@@ -213,6 +218,15 @@ void Axis::applyFeedback(const AxisFeedback &feedback)
             m_pending_intent = std::monostate{};
         }
     }
+
+    // --- 变化计数 ---
+    if (prevState != m_state || prevPosLimit != m_pos_limit_active || prevNegLimit != m_neg_limit_active
+        || prevIntent != m_pending_intent.index()) {
+        ++m_state_revision;
+    }
+    if (prevAbs != m_current_abs_pos || prevRel != m_current_rel_pos) {
+        ++m_position_revision;
+    }
 }
 
 bool Axis::enable(bool active)
@@ -674,3 +688,13 @@ bool Axis::hasPendingStop() const
 {
     return std::holds_alternative<StopCommand>(m_pending_intent);
 }
+
+uint64_t Axis::stateRevision() const
+{
+    return m_state_revision;
+}
+
+uint64_t Axis::positionRevision() const
+{
+    return m_position_revision;
+}
@@ -2,6 +2,7 @@
 #define AXIS_H
 #pragma once
 #include "AxisId.h"
+#include <cstdint>
 #include <variant>
 #include <string>
 
@@ -175,6 +176,12 @@ public:
     const AxisCommand& getPendingCommand() const;
 
     bool hasPendingStop() const;
+
+    // 变化计数（仅由 applyFeedback 推进，供编排器按需唤醒）
+    /// @brief 状态 / 限位状态位 / 待决意图种类 变化一次 +1
+    uint64_t stateRevision() const;
+    /// @brief 绝对 / 相对位置变化一次 +1
+    uint64_t positionRevision() const;
     
 
 private:
@@ -206,5 +213,8 @@ private:
 
     static constexpr double POSITION_EPSILON = 0.01;
     RejectionReason m_last_rejection = RejectionReason::None;
+
+    uint64_t m_state_revision = 0;
+    uint64_t m_position_revision = 0;
 };
 #endif // AXIS_H
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * @brief 轴使能保持策略 -- 运动 / 点动成功结束后是否立即掉电
+ *
+ * AlwaysDisable:     结束即掉电（默认，与原编排器行为一致）
+ * HoldFor:           保持使能 holdMs，期间没有新的操作则掉电（由 AxisViewModelCore 计时）
+ * HoldUntilDisabled: 保持使能，直到显式掉电
+ *
+ * 保持使能时，下一次点动 / 定位的 EnsuringEnabled 直接看到 Idle，省去伺服上电延迟。
+ * 急停由 PLC 强制全部轴掉电，不受本策略影响；编排器的失败路径（熔断 / 未到位）始终掉电。
+ */
+struct EnableRetention {
+    enum class Mode : uint8_t { AlwaysDisable, HoldFor, HoldUntilDisabled };
+
+    Mode mode = Mode::AlwaysDisable;
+    int holdMs = 0;
+
+    static EnableRetention alwaysDisable() { return {Mode::AlwaysDisable, 0}; }
+    static EnableRetention holdFor(int ms) { return {Mode::HoldFor, ms}; }
+    static EnableRetention holdUntilDisabled() { return {Mode::HoldUntilDisabled, 0}; }
+
+    /// @brief 编排器成功结束时是否应当掉电
+    bool disablesOnCompletion() const { return mode == Mode::AlwaysDisable; }
+};
@@ -4,11 +4,13 @@
 #include "entity/Axis.h"
 #include "entity/AxisId.h"
 #include "entity/ContextRejection.h"
+#include "entity/EnableRetention.h"
 #include "gantry/GantryCouplingController.h"
 #include "gantry/GantryPowerController.h"
 #include "safety/EmergencyStopController.h"
 #include "infrastructure/ISystemDriver.h"
 #include "infrastructure/logger/Logger.h"
+#include <cstdint>
 #include <unordered_map>
 #include <sstream>
 
@@ -48,21 +50,30 @@ public:
      *       纯遥测读取请使用 tryReadAxis()，它绕过安全锁定仅保留龙门语义。
      */
     bool tryGetAxis(AxisId id, Axis*& outAxis, ContextRejection& reason) {
-        // ==========================================
-        // Layer 0：安全域最高优先级拦截
-        // 急停中 / 未同步 / 过渡中 -> 所有轴访问全部拒绝
-        // ==========================================
-        if (m_emergencyStopController.isSystemLocked()) {
-            reason = ContextRejection::SystemSafetyLocked;
+        if (!checkSafetyAccess(id, reason)) {
             outAxis = nullptr;
-            // ★ 缺失项2：拒绝日志
-            logAxisRejection(id, reason);
             return false;
         }
-
         return tryGetAxisInternal(id, outAxis, reason);
     }
 
+    /**
+     * @brief 控制访问校验（不做容器查找）
+     *
+     * 与 tryGetAxis() 相同的 Layer 0 ~ Layer 2 拦截，供已缓存轴指针的调用方（AxisHandle）
+     * 每次下发前复核；轴实体的存续由 generation() 保证。
+     */
+    bool checkControlAccess(AxisId id, ContextRejection& reason) {
+        return checkSafetyAccess(id, reason) && checkGantryAccess(id, reason);
+    }
+
+    /**
+     * @brief 结构代数：轴登记或驱动替换时递增
+     *
+     * 缓存了 Axis* / ISystemDriver* 的调用方比较代数即可判断缓存是否仍有效，无需重新查找。
+     */
+    uint64_t generation() const { return m_generation; }
+
     /**
      * @brief Try-Read 模式读取轴对象（遥测读取入口）
      *
@@ -95,9 +106,41 @@ public:
      */
     EmergencyStopController& emergencyStopController() { return m_emergencyStopController; }
 
-    void setDriver(ISystemDriver* driver) { m_driver = driver; }
+    void setDriver(ISystemDriver* driver) {
+        m_driver = driver;
+        ++m_generation;
+    }
     ISystemDriver* driver() { return m_driver; }
 
+    /**
+     * @brief 登记额外的轴实体（非标准机型 / 负载测试）
+     * @param id 轴编号（可为 AxisId 具名值之外的任意编号）
+     * @return true 新登记；false 该轴已存在（保持原实体不变）
+     *
+     * 只有 X / X1 / X2 受龙门语义约束，额外登记的轴均按普通轴处理。
+     * 应在驱动首次 pollFeedback 之前完成登记，否则该轴的反馈被 AxisNotRegistered 拒绝。
+     */
+    bool registerAxis(AxisId id) {
+        auto [it, inserted] = m_axes.try_emplace(id);
+        if (inserted) {
+            it->second = std::make_unique<Axis>();
+            ++m_generation;
+        }
+        return inserted;
+    }
+
+    /// @brief 已登记的轴数量（默认 6）
+    size_t axisCount() const { return m_axes.size(); }
+
+    // --- 使能保持策略 ---
+    /// @brief 设置指定轴的使能保持策略（未设置的轴为 AlwaysDisable）
+    void setEnableRetention(AxisId id, const EnableRetention& policy) { m_enableRetention[id] = policy; }
+
+    EnableRetention enableRetention(AxisId id) const {
+        auto it = m_enableRetention.find(id);
+        return it != m_enableRetention.end() ? it->second : EnableRetention{};
+    }
+
     /**
      * @brief 直接为指定轴设置身份信息（绕过龙门语义拦截，仅用于日志系统初始化）
      * @param id 目标轴ID
@@ -123,12 +166,45 @@ private:
      * 在被拒绝时输出详细日志（缺失项2）。
      */
     bool tryGetAxisInternal(AxisId id, Axis*& outAxis, ContextRejection& reason) {
+        if (!checkGantryAccess(id, reason)) {
+            outAxis = nullptr;
+            return false;
+        }
+
+        // C. 容器查找
+        auto it = m_axes.find(id);
+        if (it == m_axes.end()) {
+            reason = ContextRejection::AxisNotRegistered;
+            outAxis = nullptr;
+            logAxisRejection(id, reason);
+            return false;
+        }
+
+        // D. 校验通过
+        outAxis = it->second.get();
+        reason = ContextRejection::None;
+        return true;
+    }
+
+    /// @brief Layer 0：安全域最高优先级拦截（急停中 / 未同步 / 过渡中 -> 所有轴访问全部拒绝）
+    bool checkSafetyAccess(AxisId id, ContextRejection& reason) {
+        if (m_emergencyStopController.isSystemLocked()) {
+            reason = ContextRejection::SystemSafetyLocked;
+            // ★ 缺失项2：拒绝日志
+            logAxisRejection(id, reason);
+            return false;
+        }
+        reason = ContextRejection::None;
+        return true;
+    }
+
+    /// @brief Layer 1 ~ 2：龙门同步 + 龙门语义
+    bool checkGantryAccess(AxisId id, ContextRejection& reason) {
         // 仅龙门相关轴受联动状态约束，非龙门轴跳过
         if (id == AxisId::X || id == AxisId::X1 || id == AxisId::X2) {
             // A. 前置拦截：状态机尚未同步，物理真相未知 -> 拒绝一切龙门轴访问
             if (m_gantryCouplingController->isNotSynchronized()) {
                 reason = ContextRejection::GantryNotSynchronized;
-                outAxis = nullptr;
                 // ★ 缺失项2：拒绝日志（含龙门同步状态详情）
                 logAxisRejection(id, reason, "couplingState=NotSynchronized");
                 return false;
@@ -138,14 +214,12 @@ private:
             if (m_gantryCouplingController->isCoupled()) {
                 if (id == AxisId::X1 || id == AxisId::X2) {
                     reason = ContextRejection::PhysicalAxisLockedByGantry;
-                    outAxis = nullptr;
                     logAxisRejection(id, reason, "isCoupled=true");
                     return false;
                 }
             } else {
                 if (id == AxisId::X) {
                     reason = ContextRejection::LogicalAxisUnavailableWhenDecoupled;
-                    outAxis = nullptr;
                     logAxisRejection(id, reason,
                         "couplingState="
                         + std::string(gantryCouplingStatusToString(m_gantryCouplingController->isCouplingRequested()
@@ -158,17 +232,6 @@ private:
             }
         }
 
-        // C. 容器查找
-        auto it = m_axes.find(id);
-        if (it == m_axes.end()) {
-            reason = ContextRejection::AxisNotRegistered;
-            outAxis = nullptr;
-            logAxisRejection(id, reason);
-            return false;
-        }
-
-        // D. 校验通过
-        outAxis = it->second.get();
         reason = ContextRejection::None;
         return true;
     }
@@ -193,5 +256,7 @@ private:
     std::unique_ptr<GantryCouplingController> m_gantryCouplingController;
     std::unique_ptr<GantryPowerController> m_gantryPowerController;
     EmergencyStopController m_emergencyStopController;  // 值语义，SystemContext 组合持有
+    std::unordered_map<AxisId, EnableRetention> m_enableRetention;
     ISystemDriver* m_driver = nullptr;
+    uint64_t m_generation = 0;
 };
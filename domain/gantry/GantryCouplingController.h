@@ -25,6 +25,7 @@ struct GantryCouplingCommand {
 //   NotSynchronized -> Coupled / Decoupled（仅通过 applyFeedback 退出）
 //   Decoupled       -> CouplingRequested -> Coupled
 //   Coupled         -> DecouplingRequested -> Decoupled
+//   CouplingRequested / Coupled -> [withdrawCouple] -> DecouplingRequested
 // ==========================================
 
 class GantryCouplingController {
@@ -36,6 +37,7 @@ public:
     bool isCoupled() const { return m_state.isCoupled(); }
     bool isCouplingRequested() const { return m_state.isCouplingRequested(); }
     bool isDecouplingRequested() const { return m_state.isDecouplingRequested(); } 
+    GantryCouplingState::Status status() const { return m_state.status(); }
 
     // --- 错误查询 ---
     bool hasError() const { return m_last_error != GantryRejection::None; }
@@ -83,6 +85,25 @@ public:
         return GantryRejection::None;
     }
 
+    /**
+     * @brief 撤回联动（上层流程超时等异常退出时的安全动作）
+     *
+     * 与 requestCouple(false) 不同，联动请求进行中（CouplingRequested）也可撤回：
+     * 直接生成解耦意图并进入 DecouplingRequested，等待 PLC 反馈解耦。
+     * @return None 已生成解耦意图或本就未联动；NotSynchronized 尚未同步
+     */
+    GantryRejection withdrawCouple() {
+        if (m_state.isNotSynchronized()) {
+            return GantryRejection::NotSynchronized;
+        }
+        if (!m_state.isCoupled() && !m_state.isCouplingRequested()) {
+            return GantryRejection::None;
+        }
+        m_pending_intent = GantryCouplingCommand{ false };
+        m_state.requestDecouple();
+        return GantryRejection::None;
+    }
+
     // ==========================================
     // 核心 2：意图暴露与弹出 (Pop Intent)
     // ==========================================
@@ -16,6 +16,7 @@
  *  Enabling  ──[applyFeedback]────────-> Enabled / Disabled
  *  Enabled   ──[requestEnable(false)]─-> Disabling + GantryPowerCommand
  *  Disabling ──[applyFeedback]────────-> Disabled / Enabled
+ *  Enabling / Enabled ──[forceDisable]─-> Disabling + GantryPowerCommand
  *
  * m_enabled 废除，由 m_status 统一管理：
  *  - isEnabled() -> m_status == Enabled
@@ -56,6 +57,22 @@ public:
         return GantryRejection::None;
     }
 
+    /**
+     * @brief 强制掉电（上层流程超时等异常退出时的安全动作）
+     *
+     * 与 requestEnable(false) 不同，使能进行中（Enabling）也可掉电：
+     * 直接生成掉电命令并进入 Disabling，由后续反馈如实反映物理真相。
+     * @return None 已生成掉电命令或本就掉电 / 掉电中；NotSynchronized 尚未同步
+     */
+    GantryRejection forceDisable() {
+        if (m_status == Status::NotSynchronized) return GantryRejection::NotSynchronized;
+        if (m_status == Status::Disabled || m_status == Status::Disabling) return GantryRejection::None;
+
+        m_pending_command = GantryPowerCommand{false};
+        m_status = Status::Disabling;
+        return GantryRejection::None;
+    }
+
     // ========== 状态查询 ==========
 
     Status status() const { return m_status; }
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @brief 点到点定位的速度曲线类型
+ *
+ * Constant:    无限加速度，起步即达到定位速度（原 FakePLC 行为）
+ * Trapezoidal: 加速度受限（加 / 减速度可不同），速度曲线为梯形，行程不足时退化为三角形
+ * SCurve:      加加速度（jerk）也受限，七段式 S 曲线，加速度连续
+ */
+enum class MotionProfileType : uint8_t { Constant = 0, Trapezoidal = 1, SCurve = 2 };
+
+/**
+ * @brief 运动约束（单位 mm、秒）
+ *
+ * acceleration / deceleration <= 0 表示不受限（该段斜坡耗时为 0）；
+ * jerk <= 0 时 SCurve 退化为 Trapezoidal。
+ */
+struct MotionLimits {
+    double velocity     = 50.0;   ///< mm/s
+    double acceleration = 0.0;    ///< mm/s²
+    double deceleration = 0.0;    ///< mm/s²
+    double jerk         = 0.0;    ///< mm/s³
+};
+
+/**
+ * @brief 静止到静止的一维定位规划（纯计算，无状态）
+ *
+ * 整段由 加速斜坡 -> 匀速段 -> 减速斜坡 组成：
+ *
+ *   v ▲      ┌──────────┐  vp              每个斜坡是从 0 到 vp 的 jerk 受限加速：
+ *     │     ╱            ╲                   [0, tj]         加速度按 +jerk 上升
+ *     │    ╱              ╲                  [tj, T - tj]    恒加速度
+ *     │   ╱                ╲                 [T - tj, T]     加速度按 -jerk 回落
+ *     └──┴──────────────────┴──► t         斜坡速度曲线中心对称，行程 = vp · T / 2
+ *       加速      匀速      减速
+ *
+ * 减速斜坡是以减速度参数规划的加速斜坡的时间反演。
+ * 行程不足以到达 velocity 时，二分求出两个斜坡恰好拼满行程的峰值速度 vp（匀速段为 0）。
+ *
+ * 使用示例：
+ *   MotionPlan p = MotionPlan::plan(MotionProfileType::Trapezoidal, 10.0, {50.0, 500.0, 500.0, 0.0});
+ *   p.duration();        // 0.3 s（匀速模型为 0.2 s）
+ *   p.distanceAt(0.1);   // 2.5 mm
+ */
+class MotionPlan {
+public:
+    /**
+     * @brief 规划一次行程为 distance（取绝对值）的定位
+     *
+     * velocity <= 0 时永远不会到位：duration() 为 +inf，distanceAt() 恒为 0。
+     */
+    static MotionPlan plan(MotionProfileType type, double distance, const MotionLimits& limits) {
+        MotionPlan p;
+        p.m_distance = std::abs(distance);
+        if (limits.velocity <= 0.0) {
+            p.m_cruise = p.m_distance > 0.0 ? std::numeric_limits<double>::infinity() : 0.0;
+            return p;
+        }
+        if (p.m_distance <= 0.0) return p;
+
+        double accel = 0.0, decel = 0.0, jerk = 0.0;
+        if (type != MotionProfileType::Constant) {
+            accel = limits.acceleration;
+            decel = limits.deceleration;
+            jerk = (type == MotionProfileType::SCurve) ? limits.jerk : 0.0;
+        }
+
+        double vp = limits.velocity;
+        if (Ramp::make(vp, accel, jerk).distance() + Ramp::make(vp, decel, jerk).distance() > p.m_distance) {
+            // 三角形 / 无匀速段：峰值速度与斜坡行程单调相关，二分求解
+            double lo = 0.0, hi = vp;
+            for (int k = 0; k < BISECTION_STEPS; ++k) {
+                const double mid = 0.5 * (lo + hi);
+                const double d = Ramp::make(mid, accel, jerk).distance() + Ramp::make(mid, decel, jerk).distance();
+                (d > p.m_distance ? hi : lo) = mid;
+            }
+            vp = lo;
+        }
+        p.m_peak = vp;
+        p.m_accel = Ramp::make(vp, accel, jerk);
+        p.m_decel = Ramp::make(vp, decel, jerk);
+        p.m_cruise = std::max(0.0, p.m_distance - p.m_accel.distance() - p.m_decel.distance()) / vp;
+        return p;
+    }
+
+    /// @brief 总耗时（秒）
+    [[nodiscard]] double duration() const { return m_accel.time + m_cruise + m_decel.time; }
+
+    /// @brief 行程（mm，非负）
+    [[nodiscard]] double distance() const { return m_distance; }
+
+    /// @brief 峰值速度（mm/s）；行程足够长时等于 MotionLimits::velocity
+    [[nodiscard]] double peakVelocity() const { return m_peak; }
+
+    /// @brief 起步后 t 秒已走过的距离（mm），t 钳位到 [0, duration()]
+    [[nodiscard]] double distanceAt(double t) const {
+        if (t <= 0.0) return 0.0;
+        const double total = duration();
+        if (t >= total) return m_distance;
+        if (t < m_accel.time) return m_accel.distanceAt(t);
+        const double cruiseEnd = m_accel.time + m_cruise;
+        if (t < cruiseEnd) return m_accel.distance() + m_peak * (t - m_accel.time);
+        return m_distance - m_decel.distanceAt(total - t);
+    }
+
+    /**
+     * @brief 走过 s（mm）所需的最短时间（秒）
+     *
+     * 返回满足 distanceAt(t) >= s 的时刻（二分上界），按它推进后位置一定已越过 s。
+     * s >= distance() 时返回 duration()。
+     */
+    [[nodiscard]] double timeAtDistance(double s) const {
+        if (s <= 0.0) return 0.0;
+        const double total = duration();
+        if (s >= m_distance || !std::isfinite(total)) return total;
+        double lo = 0.0, hi = total;
+        for (int k = 0; k < BISECTION_STEPS; ++k) {
+            const double mid = 0.5 * (lo + hi);
+            (distanceAt(mid) >= s ? hi : lo) = mid;
+        }
+        return hi;
+    }
+
+private:
+    static constexpr int BISECTION_STEPS = 100;
+
+    /// @brief 从 0 加速到 vp 的斜坡（jerk == 0 表示加速度阶跃，即梯形斜坡）
+    struct Ramp {
+        double jerk = 0.0;
+        double accel = 0.0;   ///< 恒加速段的加速度（S 曲线未达到加速度上限时为实际峰值）
+        double tj = 0.0;      ///< 加速度上升 / 回落段各自的时长
+        double time = 0.0;    ///< 斜坡总时长
+        double peak = 0.0;    ///< 末速度 vp
+
+        static Ramp make(double vp, double accelLimit, double jerkLimit) {
+            Ramp r;
+            r.peak = vp;
+            if (vp <= 0.0 || accelLimit <= 0.0) return r;   // 不受限：瞬间到速
+            if (jerkLimit <= 0.0) {
+                r.accel = accelLimit;
+                r.time = vp / accelLimit;
+            } else if (vp * jerkLimit >= accelLimit * accelLimit) {
+                r.jerk = jerkLimit;
+                r.accel = accelLimit;
+                r.tj = accelLimit / jerkLimit;
+                r.time = vp / accelLimit + r.tj;
+            } else {
+                // 加速度尚未升到上限就要开始回落
+                r.jerk = jerkLimit;
+                r.tj = std::sqrt(vp / jerkLimit);
+                r.accel = jerkLimit * r.tj;
+                r.time = 2.0 * r.tj;
+            }
+            return r;
+        }
+
+        [[nodiscard]] double distance() const { return 0.5 * peak * time; }
+
+        [[nodiscard]] double distanceAt(double t) const {
+            t = std::clamp(t, 0.0, time);
+            if (t <= tj) return jerk * t * t * t / 6.0;
+            const double v1 = 0.5 * jerk * tj * tj;
+            const double s1 = jerk * tj * tj * tj / 6.0;
+            const double t2 = time - tj;
+            if (t <= t2) {
+                const double u = t - tj;
+                return s1 + v1 * u + 0.5 * accel * u * u;
+            }
+            const double c = t2 - tj;
+            const double v2 = v1 + accel * c;
+            const double s2 = s1 + v1 * c + 0.5 * accel * c * c;
+            const double u = t - t2;
+            return s2 + v2 * u + 0.5 * accel * u * u - jerk * u * u * u / 6.0;
+        }
+    };
+
+    double m_distance = 0.0;
+    double m_peak = 0.0;
+    double m_cruise = 0.0;
+    Ramp m_accel;
+    Ramp m_decel;
+};
@@ -0,0 +1,539 @@
+#ifndef CAPTURE_FILE_H
+#define CAPTURE_FILE_H
+
+#include "infrastructure/FeedbackFrame.h"
+#include "infrastructure/ISystemDriver.h"
+#include "infrastructure/logger/Logger.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SERVOV6_CAPTURE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define SERVOV6_CAPTURE_MMAP 0
+#endif
+
+// ============================================================================
+// 驱动流量捕获文件（录制 / 回放共用的二进制格式）
+//
+// 文件布局:
+//   CaptureHeader（32 字节）
+//   Record*:  RecordHeader（16 字节） + payload（size 字节，按 8 字节对齐补零）
+//
+// 记录类型:
+//   GroupName  -- 分组编号 -> 分组名（RecordingDriver 构造时写入一次）
+//   Command    -- 一次 send(): SystemCommand 原始字节 + 通讯结果（status / exceptionCode）
+//   Feedback   -- 一次 pollFeedback() 分派的 FeedbackFrame
+//   NoFeedback -- 一次 pollFeedback() 没有分派任何快照（丢帧 / 链路断开）
+//
+// 命令与反馈按结构体原始字节存放（要求平凡可拷贝），因此文件只能由同一构建读取；
+// 头部保存各结构体大小作为布局指纹，不匹配时拒绝打开。
+//
+// 写入端在 POSIX 平台上使用 mmap：文件按容量预先扩展、翻倍增长，追加只是一次 memcpy；
+// 进程崩溃时已写入的页仍在页缓存中，现场问题的反馈序列不会丢失
+// （未写满的尾部为全零，读取端遇到类型 0 即视为结束）。其他平台退化为 stdio 顺序写。
+// ============================================================================
+
+namespace capture {
+
+constexpr char MAGIC[8] = {'S', 'V', '6', 'C', 'A', 'P', '0', '1'};
+constexpr uint32_t VERSION = 1;
+
+enum class RecordType : uint16_t {
+    End = 0,        ///< 全零尾部（未写满的 mmap 容量）
+    GroupName = 1,
+    Command = 2,
+    Feedback = 3,
+    NoFeedback = 4,
+};
+
+struct CaptureHeader {
+    char magic[8];
+    uint32_t version;
+    uint16_t commandSize;        ///< sizeof(SystemCommand)
+    uint16_t axisFeedbackSize;   ///< sizeof(AxisFeedback)
+    uint16_t gantryFeedbackSize; ///< sizeof(GantryFeedback)
+    uint16_t reserved0 = 0;
+    uint32_t reserved1 = 0;
+    uint64_t reserved2 = 0;
+
+    static CaptureHeader current() {
+        CaptureHeader h{};
+        std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+        h.version = VERSION;
+        h.commandSize = sizeof(SystemCommand);
+        h.axisFeedbackSize = sizeof(AxisFeedback);
+        h.gantryFeedbackSize = sizeof(GantryFeedback);
+        return h;
+    }
+
+    [[nodiscard]] bool compatible() const {
+        const CaptureHeader c = current();
+        return std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0
+            && version == c.version
+            && commandSize == c.commandSize
+            && axisFeedbackSize == c.axisFeedbackSize
+            && gantryFeedbackSize == c.gantryFeedbackSize;
+    }
+};
+
+struct RecordHeader {
+    uint16_t type;
+    uint16_t group;
+    uint32_t size;          ///< payload 字节数（不含对齐补零）
+    uint64_t timestampNs;   ///< 相对录制开始的单调时钟
+};
+
+static_assert(sizeof(CaptureHeader) == 32, "CaptureHeader 布局固定为 32 字节");
+static_assert(sizeof(RecordHeader) == 16, "RecordHeader 布局固定为 16 字节");
+static_assert(std::is_trivially_copyable_v<SystemCommand>, "SystemCommand 按原始字节录制");
+static_assert(std::is_trivially_copyable_v<AxisFeedback>, "AxisFeedback 按原始字节录制");
+static_assert(std::is_trivially_copyable_v<GantryFeedback>, "GantryFeedback 按原始字节录制");
+
+/// @brief Command 记录的 payload
+struct CommandPayload {
+    SystemCommand cmd;
+    int32_t status;
+    int32_t exceptionCode;
+};
+
+/// @brief Feedback 记录 payload 的定长前缀（其后紧跟 axisCount 个 AxisEntry）
+struct FeedbackPrefix {
+    uint64_t generation;
+    GantryFeedback gantry;
+    uint8_t emergencyStopped;
+    uint32_t axisCount;
+};
+
+struct AxisEntry {
+    int32_t id;
+    AxisFeedback feedback;
+};
+
+constexpr size_t align8(size_t n) { return (n + 7) & ~size_t{7}; }
+
+} // namespace capture
+
+/**
+ * @brief 捕获文件写入端（多个 RecordingDriver 共享，线程安全）
+ *
+ * GroupPollScheduler 并行轮询时各分组的 RecordingDriver 会并发追加，
+ * 追加操作由互斥锁串行化，记录在文件中的顺序即追加顺序。
+ */
+class CaptureWriter {
+public:
+    using Clock = std::chrono::steady_clock;
+    using NowFn = std::function<Clock::time_point()>;
+
+    CaptureWriter() : m_now([] { return Clock::now(); }) {}
+    ~CaptureWriter() { close(); }
+
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    /// @brief 创建（覆盖）捕获文件；失败时记录日志并返回 false
+    bool open(const std::string& path, size_t initialCapacity = size_t{1} << 20) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        closeLocked();
+        m_path = path;
+        m_start = m_now();
+        if (!openBackend(std::max(initialCapacity, sizeof(capture::CaptureHeader) + 4096))) {
+            LOG_ERROR(LogLayer::HAL, "Capture", "cannot create capture file " + path);
+            return false;
+        }
+        const auto header = capture::CaptureHeader::current();
+        writeLocked(&header, sizeof(header));
+        LOG_INFO(LogLayer::HAL, "Capture", "recording to " + path);
+        return true;
+    }
+
+    /// @brief 结束录制：截断到实际长度并释放映射
+    void close() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        closeLocked();
+    }
+
+    [[nodiscard]] bool isOpen() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_open;
+    }
+
+    [[nodiscard]] uint64_t recordCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_records;
+    }
+
+    [[nodiscard]] uint64_t bytesWritten() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_used;
+    }
+
+    // ========== 记录 ==========
+
+    void appendGroupName(uint16_t group, const std::string& name) {
+        append(capture::RecordType::GroupName, group, name.data(), static_cast<uint32_t>(name.size()));
+    }
+
+    void appendCommand(uint16_t group, const SystemCommand& cmd, const CommunicationResult& result) {
+        // 按 CommandPayload 布局逐字段拷入已清零的字节缓冲区：字段间与末尾的填充字节确定为 0，便于按字节比较
+        const capture::CommandPayload p{cmd, static_cast<int32_t>(result.status), result.exceptionCode};
+        alignas(capture::CommandPayload) unsigned char bytes[sizeof(capture::CommandPayload)] = {};
+        copyField(bytes, p, p.cmd);
+        copyField(bytes, p, p.status);
+        copyField(bytes, p, p.exceptionCode);
+        append(capture::RecordType::Command, group, bytes, sizeof(bytes));
+    }
+
+    void appendFeedback(uint16_t group, const FeedbackFrame& frame) {
+        capture::FeedbackPrefix prefix;
+        std::memset(&prefix, 0, sizeof(prefix));
+        prefix.generation = frame.generation;
+        prefix.gantry = frame.gantry;
+        prefix.emergencyStopped = frame.emergencyStopped ? 1 : 0;
+        prefix.axisCount = static_cast<uint32_t>(frame.axes.size());
+
+        const size_t size = sizeof(prefix) + frame.axes.size() * sizeof(capture::AxisEntry);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!beginRecordLocked(capture::RecordType::Feedback, group, size)) return;
+        writeLocked(&prefix, sizeof(prefix));
+        for (const auto& [id, fb] : frame.axes) {
+            capture::AxisEntry e;
+            std::memset(&e, 0, sizeof(e));
+            e.id = static_cast<int32_t>(id);
+            e.feedback = fb;
+            writeLocked(&e, sizeof(e));
+        }
+        endRecordLocked(size);
+    }
+
+    void appendNoFeedback(uint16_t group) {
+        append(capture::RecordType::NoFeedback, group, nullptr, 0);
+    }
+
+    // ========== 测试辅助 ==========
+
+    /// @brief 注入时钟（测试中使用虚拟时间；须在 open() 之前调用）
+    void setClock(NowFn now) { m_now = std::move(now); }
+
+private:
+    mutable std::mutex m_mutex;
+    std::string m_path;
+    NowFn m_now;
+    Clock::time_point m_start{};
+    bool m_open = false;
+    uint64_t m_used = 0;
+    uint64_t m_records = 0;
+
+#if SERVOV6_CAPTURE_MMAP
+    int m_fd = -1;
+    uint8_t* m_map = nullptr;
+    size_t m_capacity = 0;
+
+    bool openBackend(size_t capacity) {
+        m_fd = ::open(m_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (m_fd < 0) return false;
+        m_used = 0;
+        m_records = 0;
+        m_open = true;
+        if (!remapLocked(capacity)) {
+            closeLocked();
+            return false;
+        }
+        return true;
+    }
+
+    /// @brief 扩展文件并重新映射（翻倍增长，摊还 O(1)）
+    bool remapLocked(size_t capacity) {
+        if (m_map) {
+            ::munmap(m_map, m_capacity);
+            m_map = nullptr;
+        }
+        if (::ftruncate(m_fd, static_cast<off_t>(capacity)) != 0) return false;
+        void* p = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        if (p == MAP_FAILED) return false;
+        m_map = static_cast<uint8_t*>(p);
+        m_capacity = capacity;
+        return true;
+    }
+
+    bool reserveLocked(size_t n) {
+        if (m_used + n <= m_capacity) return true;
+        size_t cap = m_capacity;
+        while (cap < m_used + n) cap *= 2;
+        if (remapLocked(cap)) return true;
+        LOG_ERROR(LogLayer::HAL, "Capture", "cannot grow capture file " + m_path + ", recording stopped");
+        closeLocked();
+        return false;
+    }
+
+    void writeLocked(const void* data, size_t n) {
+        if (n == 0) return;
+        std::memcpy(m_map + m_used, data, n);
+        m_used += n;
+    }
+
+    void closeLocked() {
+        if (!m_open) return;
+        if (m_map) {
+            ::munmap(m_map, m_capacity);
+            m_map = nullptr;
+        }
+        if (m_fd >= 0) {
+            if (::ftruncate(m_fd, static_cast<off_t>(m_used)) != 0) {
+                LOG_WARN(LogLayer::HAL, "Capture", "cannot trim capture file " + m_path);
+            }
+            ::close(m_fd);
+            m_fd = -1;
+        }
+        m_capacity = 0;
+        m_open = false;
+    }
+#else
+    std::FILE* m_file = nullptr;
+
+    bool openBackend(size_t /*capacity*/) {
+        m_file = std::fopen(m_path.c_str(), "wb");
+        if (!m_file) return false;
+        m_used = 0;
+        m_records = 0;
+        m_open = true;
+        return true;
+    }
+
+    bool reserveLocked(size_t /*n*/) { return true; }
+
+    void writeLocked(const void* data, size_t n) {
+        if (n == 0) return;
+        std::fwrite(data, 1, n, m_file);
+        m_used += n;
+    }
+
+    void closeLocked() {
+        if (!m_open) return;
+        std::fclose(m_file);
+        m_file = nullptr;
+        m_open = false;
+    }
+#endif
+
+    uint64_t timestampLocked() const {
+        const auto d = m_now() - m_start;
+        return static_cast<uint64_t>(std::max<int64_t>(
+            0, std::chrono::duration_cast<std::chrono::nanoseconds>(d).count()));
+    }
+
+    bool beginRecordLocked(capture::RecordType type, uint16_t group, size_t payloadSize) {
+        if (!m_open) return false;
+        if (!reserveLocked(sizeof(capture::RecordHeader) + capture::align8(payloadSize))) return false;
+        const capture::RecordHeader h{static_cast<uint16_t>(type), group,
+                                      static_cast<uint32_t>(payloadSize), timestampLocked()};
+        writeLocked(&h, sizeof(h));
+        return true;
+    }
+
+    void endRecordLocked(size_t payloadSize) {
+        static constexpr uint8_t ZEROS[8] = {};
+        writeLocked(ZEROS, capture::align8(payloadSize) - payloadSize);
+        ++m_records;
+    }
+
+    /// @brief 把 payload 的一个字段按其在结构体内的偏移拷入字节缓冲区
+    template<typename Payload, typename Field>
+    static void copyField(unsigned char* dst, const Payload& payload, const Field& field) {
+        const auto offset = reinterpret_cast<const unsigned char*>(&field)
+                          - reinterpret_cast<const unsigned char*>(&payload);
+        std::memcpy(dst + offset, &field, sizeof(field));
+    }
+
+    void append(capture::RecordType type, uint16_t group, const void* payload, uint32_t size) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!beginRecordLocked(type, group, size)) return;
+        writeLocked(payload, size);
+        endRecordLocked(size);
+    }
+};
+
+/**
+ * @brief 捕获文件读取端（整文件只读映射 + 记录索引）
+ *
+ * open() 一次性扫描全部记录建立索引；之后的访问只是指针运算，可被多个 ReplayDriver 共享。
+ * 末尾不完整的记录（录制进程崩溃）与全零尾部被忽略。
+ */
+class CaptureReader {
+public:
+    struct Record {
+        capture::RecordType type;
+        uint16_t group;
+        uint64_t timestampNs;
+        const uint8_t* payload;
+        uint32_t size;
+    };
+
+    CaptureReader() = default;
+    ~CaptureReader() { close(); }
+
+    CaptureReader(const CaptureReader&) = delete;
+    CaptureReader& operator=(const CaptureReader&) = delete;
+
+    /// @brief 打开并索引捕获文件；文件不存在 / 格式或布局不兼容时返回 false
+    bool open(const std::string& path) {
+        close();
+        if (!mapFile(path)) {
+            LOG_ERROR(LogLayer::HAL, "Capture", "cannot open capture file " + path);
+            return false;
+        }
+        capture::CaptureHeader header;
+        if (m_size < sizeof(header)) {
+            LOG_ERROR(LogLayer::HAL, "Capture", "capture file too short: " + path);
+            close();
+            return false;
+        }
+        std::memcpy(&header, m_data, sizeof(header));
+        if (!header.compatible()) {
+            LOG_ERROR(LogLayer::HAL, "Capture", "incompatible capture file (magic / version / layout): " + path);
+            close();
+            return false;
+        }
+        index();
+        return true;
+    }
+
+    void close() {
+        unmapFile();
+        m_records.clear();
+        m_groupNames.clear();
+    }
+
+    [[nodiscard]] const std::vector<Record>& records() const { return m_records; }
+
+    /// @brief 录制时登记的分组名（下标 = 分组编号，未登记为空串）
+    [[nodiscard]] const std::vector<std::string>& groupNames() const { return m_groupNames; }
+
+    /// @return 分组名对应的编号；未找到返回 false
+    bool tryGetGroupId(const std::string& name, uint16_t& out) const {
+        for (size_t i = 0; i < m_groupNames.size(); ++i) {
+            if (m_groupNames[i] == name) {
+                out = static_cast<uint16_t>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // ========== 解码 ==========
+
+    static bool decodeCommand(const Record& r, capture::CommandPayload& out) {
+        if (r.type != capture::RecordType::Command || r.size != sizeof(out)) return false;
+        std::memcpy(&out, r.payload, sizeof(out));
+        return true;
+    }
+
+    /// @brief 解码到 out（复用 axes 容量）
+    static bool decodeFeedback(const Record& r, FeedbackFrame& out) {
+        capture::FeedbackPrefix prefix;
+        if (r.type != capture::RecordType::Feedback || r.size < sizeof(prefix)) return false;
+        std::memcpy(&prefix, r.payload, sizeof(prefix));
+        if (r.size != sizeof(prefix) + prefix.axisCount * sizeof(capture::AxisEntry)) return false;
+
+        out.generation = prefix.generation;
+        out.gantry = prefix.gantry;
+        out.emergencyStopped = prefix.emergencyStopped != 0;
+        out.axes.clear();
+        const uint8_t* p = r.payload + sizeof(prefix);
+        for (uint32_t i = 0; i < prefix.axisCount; ++i, p += sizeof(capture::AxisEntry)) {
+            capture::AxisEntry e;
+            std::memcpy(&e, p, sizeof(e));
+            out.axes.emplace_back(static_cast<AxisId>(e.id), e.feedback);
+        }
+        return true;
+    }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    std::vector<Record> m_records;
+    std::vector<std::string> m_groupNames;
+
+#if SERVOV6_CAPTURE_MMAP
+    void* m_map = nullptr;
+
+    bool mapFile(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+        void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return false;
+        m_map = p;
+        m_data = static_cast<const uint8_t*>(p);
+        m_size = static_cast<size_t>(st.st_size);
+        return true;
+    }
+
+    void unmapFile() {
+        if (m_map) ::munmap(m_map, m_size);
+        m_map = nullptr;
+        m_data = nullptr;
+        m_size = 0;
+    }
+#else
+    std::vector<uint8_t> m_buffer;
+
+    bool mapFile(const std::string& path) {
+        std::FILE* f = std::fopen(path.c_str(), "rb");
+        if (!f) return false;
+        uint8_t chunk[65536];
+        size_t n = 0;
+        while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0) {
+            m_buffer.insert(m_buffer.end(), chunk, chunk + n);
+        }
+        std::fclose(f);
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+        return m_size > 0;
+    }
+
+    void unmapFile() {
+        m_buffer.clear();
+        m_data = nullptr;
+        m_size = 0;
+    }
+#endif
+
+    void index() {
+        size_t off = sizeof(capture::CaptureHeader);
+        while (off + sizeof(capture::RecordHeader) <= m_size) {
+            capture::RecordHeader h;
+            std::memcpy(&h, m_data + off, sizeof(h));
+            const auto type = static_cast<capture::RecordType>(h.type);
+            if (type == capture::RecordType::End) break;
+            const size_t body = off + sizeof(h);
+            if (body + capture::align8(h.size) > m_size) break;   // 不完整的尾部记录
+
+            const Record r{type, h.group, h.timestampNs, m_data + body, h.size};
+            if (type == capture::RecordType::GroupName) {
+                if (h.group >= m_groupNames.size()) m_groupNames.resize(h.group + 1u);
+                m_groupNames[h.group].assign(reinterpret_cast<const char*>(r.payload), r.size);
+            }
+            m_records.push_back(r);
+            off = body + capture::align8(h.size);
+        }
+    }
+};
+
+#endif // CAPTURE_FILE_H
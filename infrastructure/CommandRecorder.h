@@ -0,0 +1,230 @@
+#ifndef COMMAND_RECORDER_H
+#define COMMAND_RECORDER_H
+
+#include "domain/entity/Axis.h"
+#include "domain/entity/AxisId.h"
+#include "infrastructure/logger/Logger.h"
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+/// @brief 一条已下发的轴命令
+struct CommandRecord {
+    AxisId id;
+    AxisCommand cmd;
+};
+
+static_assert(std::is_trivially_copyable_v<CommandRecord>,
+              "CommandRecord 需可平凡拷贝，才能按原始字节落盘");
+
+/**
+ * @brief 固定容量的命令环形记录器（FakeAxisDriver::history 的底层容器）
+ *
+ * 设计要点:
+ *   1. 内存有界: 容量写满后覆盖最旧记录，长时间运行的仿真工位不再无限增长
+ *   2. O(1) 查询: 维护 "类型是否出现过" 与 "(轴, 类型) -> 最后一条命令" 两张索引，
+ *      has<T>() / lastForAxis<T>() 不再线性扫描。
+ *      索引覆盖全部历史（含已被覆盖的记录），仅 clear() 时重置。
+ *   3. 可选落盘: enableSpill(path) 后每条记录同时以原始字节追加写入文件，
+ *      readSpill() 读回完整历史 -- 测试需要全量历史时不必占用无界内存
+ *
+ * 兼容 std::vector 的常用只读接口（size / empty / [] / begin / end / rbegin / rend），
+ * 下标 0 始终是当前保留的最旧记录。
+ */
+class CommandRecorder {
+public:
+    using value_type = CommandRecord;
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+    static constexpr size_t TYPE_COUNT = std::variant_size_v<AxisCommand>;
+
+    // ==================== 随机访问迭代器 ====================
+
+    class const_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = CommandRecord;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const CommandRecord*;
+        using reference         = const CommandRecord&;
+
+        const_iterator() = default;
+        const_iterator(const CommandRecorder* owner, size_t pos) : m_owner(owner), m_pos(pos) {}
+
+        reference operator*() const { return (*m_owner)[m_pos]; }
+        pointer operator->() const { return &(*m_owner)[m_pos]; }
+        reference operator[](difference_type n) const { return (*m_owner)[m_pos + n]; }
+
+        const_iterator& operator++() { ++m_pos; return *this; }
+        const_iterator operator++(int) { auto t = *this; ++m_pos; return t; }
+        const_iterator& operator--() { --m_pos; return *this; }
+        const_iterator operator--(int) { auto t = *this; --m_pos; return t; }
+        const_iterator& operator+=(difference_type n) { m_pos += n; return *this; }
+        const_iterator& operator-=(difference_type n) { m_pos -= n; return *this; }
+        friend const_iterator operator+(const_iterator it, difference_type n) { return it += n; }
+        friend const_iterator operator+(difference_type n, const_iterator it) { return it += n; }
+        friend const_iterator operator-(const_iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const const_iterator& a, const const_iterator& b) {
+            return static_cast<difference_type>(a.m_pos) - static_cast<difference_type>(b.m_pos);
+        }
+        friend bool operator==(const const_iterator& a, const const_iterator& b) { return a.m_pos == b.m_pos; }
+        friend auto operator<=>(const const_iterator& a, const const_iterator& b) { return a.m_pos <=> b.m_pos; }
+
+    private:
+        const CommandRecorder* m_owner = nullptr;
+        size_t m_pos = 0;
+    };
+    using iterator = const_iterator;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    explicit CommandRecorder(size_t capacity = DEFAULT_CAPACITY)
+        : m_buffer(capacity > 0 ? capacity : 1) {}
+
+    ~CommandRecorder() { closeSpill(); }
+
+    CommandRecorder(const CommandRecorder&) = delete;
+    CommandRecorder& operator=(const CommandRecorder&) = delete;
+
+    // ==================== 写入 ====================
+
+    void push_back(const CommandRecord& r) {
+        size_t slot = (m_head + m_size) % m_buffer.size();
+        if (m_size == m_buffer.size()) {
+            m_head = (m_head + 1) % m_buffer.size();
+            ++m_evicted;
+        } else {
+            ++m_size;
+        }
+        m_buffer[slot] = r;
+
+        const size_t type = r.cmd.index();
+        m_seenType[type] = true;
+        m_lastByAxis[r.id][type] = r.cmd;
+
+        if (m_spill) {
+            if (std::fwrite(&r, sizeof(CommandRecord), 1, m_spill) != 1) {
+                LOG_WARN(LogLayer::HAL, "CommandRecorder", "spill write failed, disabling spill");
+                closeSpill();
+            }
+        }
+    }
+
+    /// @brief 清空环形缓冲、查询索引与落盘文件
+    void clear() {
+        m_head = 0;
+        m_size = 0;
+        m_evicted = 0;
+        m_seenType.fill(false);
+        m_lastByAxis.clear();
+        if (m_spill) {
+            std::fclose(m_spill);
+            m_spill = std::fopen(m_spillPath.c_str(), "w+b");
+        }
+    }
+
+    // ==================== 只读访问 ====================
+
+    [[nodiscard]] size_t size() const { return m_size; }
+    [[nodiscard]] bool empty() const { return m_size == 0; }
+    [[nodiscard]] size_t capacity() const { return m_buffer.size(); }
+
+    /// @brief 因容量写满而被覆盖的记录数
+    [[nodiscard]] size_t evicted() const { return m_evicted; }
+
+    const CommandRecord& operator[](size_t i) const {
+        return m_buffer[(m_head + i) % m_buffer.size()];
+    }
+    const CommandRecord& back() const { return (*this)[m_size - 1]; }
+
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, m_size}; }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    // ==================== O(1) 查询 ====================
+
+    /// @brief 是否下发过类型为 T 的命令（任意轴）
+    template<typename T>
+    [[nodiscard]] bool has() const {
+        return m_seenType[typeIndex<T>()];
+    }
+
+    /// @brief 指定轴最后一条类型为 T 的命令；从未下发过则返回 T{}
+    template<typename T>
+    [[nodiscard]] T lastForAxis(AxisId id) const {
+        auto it = m_lastByAxis.find(id);
+        if (it == m_lastByAxis.end()) return T{};
+        if (auto* cmd = std::get_if<T>(&it->second[typeIndex<T>()])) return *cmd;
+        return T{};
+    }
+
+    // ==================== 落盘 ====================
+
+    /// @brief 开启落盘（截断已有文件）
+    bool enableSpill(const std::string& path) {
+        closeSpill();
+        m_spill = std::fopen(path.c_str(), "w+b");
+        if (!m_spill) {
+            LOG_WARN(LogLayer::HAL, "CommandRecorder", "cannot open spill file: " + path);
+            return false;
+        }
+        m_spillPath = path;
+        return true;
+    }
+
+    [[nodiscard]] bool spillEnabled() const { return m_spill != nullptr; }
+
+    /// @brief 读回落盘的完整历史（未开启落盘时返回内存中保留的部分）
+    [[nodiscard]] std::vector<CommandRecord> readSpill() const {
+        if (!m_spill) return std::vector<CommandRecord>(begin(), end());
+
+        std::fflush(m_spill);
+        std::vector<CommandRecord> out;
+        std::FILE* in = std::fopen(m_spillPath.c_str(), "rb");
+        if (!in) return out;
+        CommandRecord r;
+        while (std::fread(&r, sizeof(CommandRecord), 1, in) == 1) {
+            out.push_back(r);
+        }
+        std::fclose(in);
+        return out;
+    }
+
+private:
+    std::vector<CommandRecord> m_buffer;
+    size_t m_head = 0;
+    size_t m_size = 0;
+    size_t m_evicted = 0;
+
+    std::array<bool, TYPE_COUNT> m_seenType{};
+    std::unordered_map<AxisId, std::array<AxisCommand, TYPE_COUNT>> m_lastByAxis;
+
+    std::FILE* m_spill = nullptr;
+    std::string m_spillPath;
+
+    void closeSpill() {
+        if (m_spill) {
+            std::fclose(m_spill);
+            m_spill = nullptr;
+        }
+    }
+
+    template<typename T, size_t I = 0>
+    static constexpr size_t typeIndex() {
+        if constexpr (I >= TYPE_COUNT) {
+            static_assert(I < TYPE_COUNT, "T 不是 AxisCommand 的备选类型");
+            return I;
+        } else if constexpr (std::is_same_v<T, std::variant_alternative_t<I, AxisCommand>>) {
+            return I;
+        } else {
+            return typeIndex<T, I + 1>();
+        }
+    }
+};
+
+#endif // COMMAND_RECORDER_H
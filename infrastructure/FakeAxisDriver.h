@@ -3,11 +3,18 @@
 
 #include "../infrastructure/ISystemDriver.h"
 #include "FakePLC.h"
+#include "CommandRecorder.h"
+#include "FeedbackFrame.h"
+#include "LinkModel.h"
 #include "domain/entity/SystemContext.h"
 #include "infrastructure/logger/Logger.h"
 #include "infrastructure/utils/CommandFormatter.h"
 #include <vector>
+#include <algorithm>
 #include <array>
+#include <deque>
+#include <iterator>
+#include <random>
 #include <variant>
 
 /**
@@ -32,19 +39,28 @@
  *
  * send() 返回 CommunicationResult:
  *   - 未连接时返回 Disconnected
- *   - 正常时处理命令后返回 Sent
+ *   - 按链路模型判定的通讯失败返回 Timeout / Busy / ProtocolError（命令不写入 PLC）
+ *   - 正常时返回 Sent；理想链路下命令立即写入 PLC，否则在链路延迟到期后写入
+ * sendUrgent() 结果语义相同，但命令排在所有在途普通命令之前（急停插队）
  *
  * --- 反馈通路 ---
  *
  * pollFeedback() 实现:
  *   1. 推进 FakePLC 一个周期 (tick)
- *   2. 遍历所有 6 个轴，读取 FakePLC 反馈并注入 Axis::applyFeedback()
- *   3. 注入急停状态反馈 -> EmergencyStopController::applyFeedback()
- *   4. 注入龙门反馈 -> GantryCouplingController::applyFeedback()
- *                     + GantryPowerController::applyFeedback()
+ *   2. 读取 FeedbackFrame 快照并分派（见 FeedbackFrame::dispatchTo）:
+ *      急停 -> EmergencyStopController::applyFeedback()
+ *      龙门 -> GantryPowerController / GantryCouplingController::applyFeedback()
+ *      各轴 -> Axis::applyFeedback()
+ *
+ * --- 链路模型 ---
+ *   setLinkModel() 注入命令/反馈延迟、抖动、通讯失败与丢帧（见 LinkModel）。
+ *   链路时钟由 pollFeedback 按 CYCLE_MS 推进，所有随机量来自 LinkModel::seed，逐周期可复现。
+ *   默认理想链路，行为与引入链路模型之前一致。
  *
  * --- 测试辅助 ---
  *   disconnect() / connect() -- 模拟网络通断
+ *   history -- 固定容量的环形命令记录（见 CommandRecorder），
+ *              has<T>() / lastForAxis<T>() 为 O(1) 索引查询
  *
  * 使用示例：
  *   FakePLC plcA, plcB;
@@ -54,54 +70,80 @@
  */
 class FakeAxisDriver : public ISystemDriver {
 public:
-    struct Record {
-        AxisId id;
-        AxisCommand cmd;
-    };
+    using Record = CommandRecord;
+
+    /// @brief 每次 pollFeedback 推进的 PLC / 链路时间
+    static constexpr int CYCLE_MS = 10;
 
-    explicit FakeAxisDriver(FakePLC& plc) : m_plc(plc) {}
+    explicit FakeAxisDriver(FakePLC& plc, size_t historyCapacity = CommandRecorder::DEFAULT_CAPACITY)
+        : history(historyCapacity), m_plc(plc) {}
 
     // ========== ISystemDriver 统一入口 ==========
 
     CommunicationResult send(const SystemCommand& cmd) override {
-        if (!m_connected) {
-            return CommunicationResult{
-                CommunicationResult::Status::Disconnected,
-                0,
-                "Fake driver not connected"
-            };
-        }
-        std::visit([this](auto&& c) {
-            handle(c);
-        }, cmd);
-        return CommunicationResult{};  // Fake 驱动永远通讯成功
+        return transmit(cmd, false);
+    }
+
+    /// @brief 插队发送：不排在在途命令之后，链路延迟从现在起算；在途命令顺延到其后到达
+    CommunicationResult sendUrgent(const SystemCommand& cmd) override {
+        return transmit(cmd, true);
     }
 
     void pollFeedback(SystemContext& ctx) override {
-        // 1. 推进硬件模拟一个周期
-        m_plc.tick(10);
-
-        // 2. 注入安全状态反馈 -- 急停
-        ctx.emergencyStopController().applyFeedback(m_plc.getEmergencyStopFeedback());
-
-        // 3. 注入龙门反馈 -- 电机使能 + 联动状态
-        GantryFeedback gf = m_plc.getGantryFeedback();
-        ctx.gantryPowerController().applyFeedback(gf);
-        ctx.gantryCouplingController().applyFeedback(gf);
-
-        // 4. 读取所有轴的反馈并注入
-        constexpr std::array<AxisId, 6> ALL_AXIS_IDS = {
-            AxisId::X, AxisId::X1, AxisId::X2, AxisId::Y, AxisId::Z, AxisId::R
-        };
-        for (auto axisId : ALL_AXIS_IDS) {
-            Axis* axis = nullptr;
-            ContextRejection r;
-            if (ctx.tryGetAxis(axisId, axis, r) && axis) {
-                axis->applyFeedback(m_plc.getFeedback(axisId));
-            }
+        m_clockMs += CYCLE_MS;
+        ++m_stats.polls;
+        m_dispatched = nullptr;
+
+        // 1. 链路延迟到期的命令写入 PLC（在本周期扫描之前）
+        while (!m_inflight.empty() && m_inflight.front().dueMs <= m_clockMs) {
+            deliver(m_inflight.front().cmd);
+            m_inflight.pop_front();
         }
+
+        // 2. 推进硬件模拟一个周期
+        m_plc.tick(CYCLE_MS);
+
+        // 3. 读取反馈快照（急停 + 龙门 + 全部轴）并注入领域实体
+        if (m_link.maxFeedbackAgeMs() <= 0) {
+            if (rollFrameDrop()) return;
+            m_frame.captureFrom(m_plc);
+            m_frame.dispatchTo(ctx);
+            m_dispatched = &m_frame;
+            return;
+        }
+        pollDelayedFeedback(ctx);
     }
 
+    [[nodiscard]] const FeedbackFrame* lastFeedbackFrame() const override { return m_dispatched; }
+
+    // ========== 链路模型 ==========
+
+    /// @brief 替换链路模型（重置随机序列、在途命令与快照历史；链路时钟保持不变）
+    void setLinkModel(const LinkModel& model) {
+        m_link = model;
+        m_rng.seed(model.seed);
+        for (const auto& f : m_inflight) {
+            deliver(f.cmd);
+        }
+        m_inflight.clear();
+        m_lastDueMs = 0;
+
+        const size_t depth = static_cast<size_t>(std::max(model.maxFeedbackAgeMs(), 0) / CYCLE_MS) + 2;
+        m_frames.assign(depth, FeedbackFrame{});
+        m_stamps.assign(depth, -1);
+        m_head = 0;
+        m_lastStampMs = -1;
+    }
+
+    [[nodiscard]] const LinkModel& linkModel() const { return m_link; }
+    [[nodiscard]] const LinkStats& linkStats() const { return m_stats; }
+
+    /// @brief 链路虚拟时钟（ms，每次 pollFeedback 推进 CYCLE_MS）
+    [[nodiscard]] int64_t linkClockMs() const { return m_clockMs; }
+
+    /// @brief 已发送成功、尚未到达 PLC 的命令数
+    [[nodiscard]] size_t commandsInFlight() const { return m_inflight.size(); }
+
     // ========== 测试辅助 ==========
 
     /// @brief 模拟网络断开（测试用）
@@ -110,38 +152,174 @@ public:
     /// @brief 模拟网络恢复（测试用）
     void connect() { m_connected = true; }
 
-    std::vector<Record> history;  // 公开，测试可直接读写/迭代
+    CommandRecorder history;  // 公开，测试可直接读取/迭代/清空
 
     template<typename T>
     bool has() const {
-        for (const auto& r : history) {
-            if (std::holds_alternative<T>(r.cmd)) return true;
-        }
-        return false;
+        return history.has<T>();
     }
 
     template<typename T>
     T lastForAxis(AxisId targetId) const {
-        for (auto it = history.rbegin(); it != history.rend(); ++it) {
-            if (it->id == targetId) {
-                if (auto* cmd = std::get_if<T>(&it->cmd)) {
-                    return *cmd;
-                }
-            }
-        }
-        return T{};
+        return history.lastForAxis<T>(targetId);
     }
 
 private:
+    struct InFlight {
+        int64_t dueMs;
+        SystemCommand cmd;
+        bool urgent;   ///< 经 sendUrgent() 插队
+    };
+
     FakePLC& m_plc;
     bool m_connected = true;  // Fake 驱动默认已连接
+    FeedbackFrame m_frame;    // 反馈快照（跨周期复用容量）
+    const FeedbackFrame* m_dispatched = nullptr;  // 本周期分派的快照（未分派为 nullptr）
+
+    // 链路模型状态
+    LinkModel m_link;
+    LinkStats m_stats;
+    std::mt19937 m_rng{1};
+    int64_t m_clockMs = 0;
+    int64_t m_lastDueMs = 0;
+    std::deque<InFlight> m_inflight;
+    std::vector<FeedbackFrame> m_frames;   ///< 反馈快照环（仅反馈有延迟时使用）
+    std::vector<int64_t> m_stamps;         ///< 对应快照的链路时刻（-1 = 空）
+    size_t m_head = 0;
+    int64_t m_lastStampMs = -1;            ///< 最近一次分派的快照时刻
+
+    // ========== 链路模型辅助 ==========
+
+    /// @brief [0, 1) 均匀随机数（取 mt19937 高 24 位，结果不依赖标准库的分布实现）
+    double uniform() {
+        return static_cast<double>(m_rng() >> 8) * (1.0 / 16777216.0);
+    }
+
+    int jitter(int maxMs) {
+        return maxMs > 0 ? static_cast<int>(m_rng() % static_cast<uint32_t>(maxMs + 1)) : 0;
+    }
+
+    bool rollCommandFault(CommunicationResult& out) {
+        if (m_link.faultRate() <= 0.0) return false;
+        double r = uniform();
+        if ((r -= m_link.timeoutRate) < 0.0) {
+            ++m_stats.timeouts;
+            out = CommunicationResult{CommunicationResult::Status::Timeout, 0, "Simulated link timeout"};
+            return true;
+        }
+        if ((r -= m_link.busyRate) < 0.0) {
+            ++m_stats.busy;
+            out = CommunicationResult{CommunicationResult::Status::Busy, 0x06, "Simulated PLC busy"};
+            return true;
+        }
+        if ((r -= m_link.protocolErrorRate) < 0.0) {
+            ++m_stats.protocolErrors;
+            out = CommunicationResult{CommunicationResult::Status::ProtocolError, 0x04, "Simulated server device failure"};
+            return true;
+        }
+        return false;
+    }
+
+    bool rollFrameDrop() {
+        if (m_link.dropFeedbackRate <= 0.0 || uniform() >= m_link.dropFeedbackRate) return false;
+        ++m_stats.framesDropped;
+        LOG_TRACE(LogLayer::HAL, "Driver", "Simulated feedback frame dropped");
+        return true;
+    }
+
+    /// @brief 反馈有延迟时：本周期快照入环，分派"延迟之前"的那一帧
+    void pollDelayedFeedback(SystemContext& ctx) {
+        const size_t depth = m_frames.size();
+        m_frames[m_head].captureFrom(m_plc);
+        m_stamps[m_head] = m_clockMs;
+        m_head = (m_head + 1) % depth;
+
+        const int64_t wanted = m_clockMs - m_link.feedbackDelayMs - jitter(m_link.feedbackJitterMs);
+        if (rollFrameDrop()) return;
+
+        size_t best = depth;
+        for (size_t k = 0; k < depth; ++k) {
+            const int64_t t = m_stamps[k];
+            if (t >= 0 && t <= wanted && (best == depth || t > m_stamps[best])) best = k;
+        }
+        // 链路尚未送回任何快照，或抖动后的快照不比上次新：本周期没有新反馈
+        if (best == depth || m_stamps[best] <= m_lastStampMs) return;
+
+        m_lastStampMs = m_stamps[best];
+        m_frames[best].dispatchTo(ctx);
+        m_dispatched = &m_frames[best];
+    }
+
+    /// @brief 命令通路公共部分：连接检查 -> 故障判定 -> 记录 -> 立即写入或进入在途队列
+    CommunicationResult transmit(const SystemCommand& cmd, bool urgent) {
+        if (!m_connected) {
+            return CommunicationResult{
+                CommunicationResult::Status::Disconnected,
+                0,
+                "Fake driver not connected"
+            };
+        }
+        ++m_stats.sends;
+        if (urgent) ++m_stats.urgentSends;
+
+        CommunicationResult fault;
+        if (rollCommandFault(fault)) {
+            return fault;
+        }
+
+        std::visit([this](auto&& c) {
+            record(c);
+        }, cmd);
+
+        // 在途的普通急停命令（如解除）作废，否则会在插队命令之后到达、覆盖急停寄存器
+        if (urgent && std::holds_alternative<EmergencyStopCommand>(cmd)) {
+            std::erase_if(m_inflight, [](const InFlight& f) {
+                return !f.urgent && std::holds_alternative<EmergencyStopCommand>(f.cmd);
+            });
+        }
+
+        const int delay = m_link.commandDelayMs + jitter(m_link.commandJitterMs);
+        if (delay <= 0 && (urgent || m_inflight.empty())) {
+            deliver(cmd);
+        } else if (urgent) {
+            // 插队：排在先前的插队命令之后、普通命令之前；被越过的命令顺延（串行链路顺序保持）
+            auto pos = std::find_if(m_inflight.begin(), m_inflight.end(),
+                                    [](const InFlight& f) { return !f.urgent; });
+            int64_t due = m_clockMs + delay;
+            if (pos != m_inflight.begin()) due = std::max(due, std::prev(pos)->dueMs);
+            for (auto it = pos; it != m_inflight.end(); ++it) {
+                it->dueMs = std::max(it->dueMs, due);
+            }
+            m_lastDueMs = std::max(m_lastDueMs, due);
+            m_inflight.insert(pos, InFlight{due, cmd, true});
+        } else {
+            // 串行链路：到达时刻不早于前一条命令
+            m_lastDueMs = std::max(m_clockMs + delay, m_lastDueMs);
+            m_inflight.push_back(InFlight{m_lastDueMs, cmd, false});
+        }
+        return CommunicationResult{};
+    }
 
     // ========== 命令分发处理 ==========
 
-    void handle(const AxisCommandWithId& c) {
+    /// @brief 发送时记录（history 反映驱动"已发出"的命令，与是否已到达 PLC 无关）
+    void record(const AxisCommandWithId& c) {
         LOG_TRACE(LogLayer::HAL, "Driver", "Sending to PLC: " + utils::format(c.cmd));
-
         history.push_back({c.id, c.cmd});
+    }
+
+    template<typename T>
+    void record(const T&) {}
+
+    /// @brief 写入 PLC 寄存器（理想链路下在 send() 内立即执行）
+    void deliver(const SystemCommand& cmd) {
+        ++m_stats.delivered;
+        std::visit([this](auto&& c) {
+            handle(c);
+        }, cmd);
+    }
+
+    void handle(const AxisCommandWithId& c) {
         m_plc.onCommand(c.id, c.cmd);
     }
 
@@ -5,10 +5,16 @@
 #include "../domain/entity/Axis.h"
 #include "../domain/entity/AxisId.h"
 #include "../domain/gantry/GantryFeedback.h"
+#include "../domain/motion/MotionProfile.h"
+#include "FakePLCConfig.h"
 #include "infrastructure/logger/Logger.h"
 #include <cmath>
 #include <algorithm>
-#include <unordered_map>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 // --- 急停仿真相关 ---
 
@@ -58,7 +64,7 @@ struct GantryPhysicalState {
  * ║  SystemContext_A            SystemContext_B                 ║
  * ╚══════════════════════════════════════════════════════════════╝
  *
- * 每个 FakePLC 内部独立维护 6 个轴的物理状态寄存器。
+ * 每个 FakePLC 内部独立维护一组轴的物理状态寄存器（默认 6 轴，可按需构造任意多轴）。
  * 不同 FakePLC 实例之间完全隔离 —— GroupA 的指令不会影响 GroupB 的轴。
  *
  * --- 急停仿真模型 ---
@@ -87,23 +93,89 @@ struct GantryPhysicalState {
  *   - GANTRY_POWER_DELAY_MS    (150ms) 电机使能延迟
  *   - GANTRY_COUPLING_DELAY_MS (100ms) 耦合/解耦延迟
  *
+ * 联动排队（setGantryCouplingFollowsPower，默认关闭）：
+ *   开启后，电机使能进行中收到的联动请求不会因"未使能"被拒绝，而是挂起到使能完成的
+ *   同一扫描周期再检查条件（对应支持联动指令排队的 PLC 固件）；关闭时按上述延迟独立计时，
+ *   使能未完成即以 errorCode=2 拒绝。
+ *
  * PLC 在每个 tick 中执行扫描周期：刷新物理状态 -> 条件检查 -> 反馈生成。
+ * 各延迟定时器以 double 毫秒计时，到期时刻由 tick 的事件拆分精确命中（见 tick 的说明）。
  * 联动建立后会持续监测：超差/报警/掉电/急停任一触发即自动解耦。
+ * 龙门寄存器按组（GantryUnit）独立仿真，可通过 FakePLCConfig 配置多组；
+ * 第 0 组即领域层可见的 X / X1 / X2（见 FakePLCConfig 的说明）。
+ * 没有配置任何龙门组时（如轴集合中缺少 X / X1 / X2），龙门仿真整体停用。
+ *
+ * --- 轴寄存器布局 ---
+ *
+ * 轴状态按 Structure-of-Arrays 存放（AxisBank：每个字段一个连续数组，下标 = 槽位），
+ * AxisId -> 槽位 通过按枚举值索引的查找表 O(1) 完成。
+ * tick 内的 使能过渡 / 运动学 / 限位 三步合并为一次遍历全部槽位的循环，
+ * 循环体只有数据选择（无分支、无日志、无查找），便于编译器向量化；
+ * 限位上升沿只在循环内打标记，日志在循环结束后的冷路径中统一输出。
+ *
+ * --- 变步长 / 事件推进 ---
+ *
+ * tick(ms) 接受任意非负 double 步长，结果与步长划分无关（tick(3000) 与 300 次 tick(10) 一致）：
+ *   - 单轴事件（到位 / 触限 / 使能完成）在扫描内按解析式钳位，任意步长都精确；
+ *   - 跨子系统事件（急停生效/解除、龙门使能、龙门联动/解耦判定）把 tick 拆成子步，
+ *     子步恰好结束在事件时刻，判定时读取的是该时刻的轴状态。
+ * nextEventIn() 给出下一个离散事件的剩余时间（含单轴事件；无事件时为 +inf），
+ * advanceToNextEvent() 直接跳到该时刻，长时间静止或长行程定位不必按 10ms 逐步推进。
+ *
+ * --- 定位速度曲线 ---
+ *
+ * 每轴可选 Constant（默认，无限加速度）/ Trapezoidal / SCurve（见 MotionPlan）。
+ * 非 Constant 的轴在接受 MoveCommand 时按当时的定位速度与加减速参数规划整段行程，
+ * 之后位置按 "起点 + 规划距离(已运行时间)" 解析求值，与步长划分无关，到位时刻即规划时长。
+ * 运动中修改定位速度只影响下一次定位；点动与停止仍为匀速 / 立即停止。
+ * estimateMoveTimeMs() 用同一份规划预测定位耗时（节拍规划 / 吞吐估算）。
+ *
+ * 负载测试可用 FakePLC(std::vector<AxisId>) 构造成百上千个轴（见 benchmarks/bench_fake_plc），
+ * 或用 FakePLC(FakePLCConfig) 同时指定每轴速度/限位与多组龙门（见 FakePLCConfig::scaled）。
  *
  * 使用示例：
  *   FakePLC plcA, plcB;  // 两台独立硬件
  *   plcA.onCommand(AxisId::Y, EnableCommand{true});  // 只影响 plcA 的 Y 轴
  *   plcB.tick(10);  // 只推进 plcB 的物理引擎
+ *   plcA.advanceToNextEvent(5000.0);  // 直接跳到 plcA 的下一个事件（最多 5s）
  */
 class FakePLC {
 public:
-    FakePLC() {
-        m_axes[AxisId::Y] = AxisStateInternal{};
-        m_axes[AxisId::Z] = AxisStateInternal{};
-        m_axes[AxisId::R] = AxisStateInternal{};
-        m_axes[AxisId::X] = AxisStateInternal{};
-        m_axes[AxisId::X1] = AxisStateInternal{};
-        m_axes[AxisId::X2] = AxisStateInternal{};
+    FakePLC()
+        : FakePLC({AxisId::Y, AxisId::Z, AxisId::R, AxisId::X, AxisId::X1, AxisId::X2}) {}
+
+    /**
+     * @brief 以指定轴集合构造（负载测试用）
+     *
+     * 轴编号不限于 AxisId 具名枚举值，可用 static_cast<AxisId>(n) 构造任意数量的轴。
+     * 重复的轴编号只登记一次。
+     */
+    explicit FakePLC(const std::vector<AxisId>& axes) {
+        for (auto id : axes) {
+            addAxis(id);
+        }
+        addGantry({AxisId::X, AxisId::X1, AxisId::X2});
+    }
+
+    /**
+     * @brief 按配置构造：轴集合 + 每轴速度/限位 + 龙门组
+     *
+     * 引用了未登记轴的龙门组被忽略（记录告警）。
+     */
+    explicit FakePLC(const FakePLCConfig& cfg) {
+        for (const auto& a : cfg.axes) {
+            addAxis(a.id);
+            applyProfile(a.id, a.profile);
+        }
+        m_axisConfig = cfg.axes;
+        m_gantryCouplingFollowsPower = cfg.gantryCouplingFollowsPower;
+        for (const auto& g : cfg.gantries) {
+            if (!addGantry(g)) {
+                LOG_WARN(LogLayer::HAL, "PLC",
+                    "gantry group ignored: logical=" + axisIdToString(g.logical)
+                    + " axes not registered");
+            }
+        }
     }
 
     // ========== 核心对外接口（多轴签名） ==========
@@ -120,94 +192,173 @@ public:
     /**
      * @brief 下发龙门相关命令（GantryCouplingCommand / GantryPowerCommand）
      *
-     * 龙门命令不绑定特定轴，由 GantryOrchestrator 通过 Driver -> PLC 路径下发。
+     * 龙门命令不绑定特定轴，由 GantryOrchestrator 通过 Driver -> PLC 路径下发，
+     * 作用于第 0 组龙门。
      */
-    void onGantryCommand(const GantryCouplingCommand& cmd) {
-        m_gantryCouplingCmdPending = true;
-        m_gantryCouplingTarget = cmd.enableCoupling;
-        m_gantryCouplingTimer = 0;
-        m_gantryFeedbackLocked = false;  // 新命令到来，让 PLC 重新接管
+    void onGantryCommand(const GantryCouplingCommand& cmd) { onGantryCommand(0, cmd); }
+    void onGantryCommand(const GantryPowerCommand& cmd) { onGantryCommand(0, cmd); }
+
+    /// @brief 向指定龙门组下发命令（组号越界时忽略）
+    void onGantryCommand(size_t group, const GantryCouplingCommand& cmd) {
+        if (group >= m_gantries.size()) return;
+        GantryUnit& g = m_gantries[group];
+        g.couplingCmdPending = true;
+        g.couplingTarget = cmd.enableCoupling;
+        g.couplingTimer = 0;
+        g.feedback.errorCode = 0;   // 新命令重新判定，上一次的拒绝码作废
+        g.feedbackLocked = false;  // 新命令到来，让 PLC 重新接管
     }
 
-    void onGantryCommand(const GantryPowerCommand& cmd) {
-        m_gantryPowerCmdPending = true;
-        m_gantryPowerTarget = cmd.enable;
-        m_gantryPowerTimer = 0;
+    void onGantryCommand(size_t group, const GantryPowerCommand& cmd) {
+        if (group >= m_gantries.size()) return;
+        GantryUnit& g = m_gantries[group];
+        g.powerCmdPending = true;
+        g.powerTarget = cmd.enable;
+        g.powerTimer = 0;
     }
 
+    /**
+     * @brief 联动请求是否排在电机使能之后（见类说明"联动排队"）
+     *
+     * 开启后上位机可以在使能命令之后紧接着下发联动命令，省去等待使能确认的往返。
+     */
+    void setGantryCouplingFollowsPower(bool enabled) { m_gantryCouplingFollowsPower = enabled; }
+    bool gantryCouplingFollowsPower() const { return m_gantryCouplingFollowsPower; }
+
     /**
      * @brief 强制设置"设备急停"命令寄存器（用于测试注入命令来源）
+     *
+     * 重复写入相同的值不是新的边沿，不重启生效计时（上位机补发急停不会推迟急停生效）。
      */
     void forceEmergencyStopCommand(bool active) {
+        if (active == m_emergencyStopCmdPending) return;
         m_emergencyStopCmdPending = active;
         m_emergencyStopTimer = 0;
     }
 
     /**
-     * @brief 物理引擎 heartbeat
+     * @brief 统一命令入口 -- 按 SystemCommand 备选分派到对应寄存器
      *
-     * 执行顺序：
-     *   1. 急停延迟状态机
-     *   2. 各轴状态跃迁 -> 运动学推演 -> 限位检测（先推演轴，让 X1/X2 位置更新）
-     *   3. 龙门状态机（依赖最新 X1/X2 物理状态 -> 必须在轴推演之后执行）
+     * 供按请求流批量写入的驱动使用（见 SharedPlcTransport）。
      */
-    void tick(int ms) {
-        // --- 急停延迟状态机 ---
-        tickEmergencyStop(ms);
-
-        // --- 各轴独立推演 ---
-        for (auto& [id, axis] : m_axes) {
-            LOG_TRACE_EVERY_N(50, LogLayer::HAL, "PLC",
-                "Tick axis=" + axisIdToString(id) + " pos=" + std::to_string(axis.feedback.absPos));
-
-            if (axis.stop_requested) {
-                axis.feedback.state = AxisState::Idle;
-                axis.stop_requested = false;
+    void onSystemCommand(const SystemCommand& cmd) {
+        std::visit([this](auto&& c) {
+            using T = std::decay_t<decltype(c)>;
+            if constexpr (std::is_same_v<T, AxisCommandWithId>) {
+                onCommand(c.id, c.cmd);
+            } else if constexpr (std::is_same_v<T, EmergencyStopCommand>) {
+                forceEmergencyStopCommand(c.active);
+            } else {
+                onGantryCommand(c);
             }
+        }, cmd);
+    }
 
-            updateStateTransitions(axis, ms);
-            updateKinematics(axis, ms);
-            checkHardwareLimits(axis);
-
-            axis.feedback.relPos = axis.feedback.absPos - axis.feedback.relZeroAbsPos;
+    /**
+     * @brief 物理引擎 heartbeat（任意非负步长，毫秒）
+     *
+     * 步长按跨子系统事件（急停 / 龙门定时器到期）拆成子步，每个子步执行一次扫描：
+     *   1. 各轴状态跃迁 -> 运动学推演 -> 限位检测（先推演轴，让 X1/X2 位置更新）
+     *   2. 急停延迟状态机（在子步末尾生效：轴先走完急停生效前的行程，再被强制掉电）
+     *   3. 龙门状态机（依赖最新 X1/X2 物理状态 -> 必须在轴推演之后执行）
+     */
+    void tick(double ms) {
+        double remaining = std::max(0.0, ms);
+        do {
+            // 下限保证前进（定时器已在阈值上时以 EVENT_EPSILON_MS 的子步触发）
+            const double dt = std::min(remaining, std::max(nextScanEventIn(), EVENT_EPSILON_MS));
+            scan(dt);
+            remaining -= dt;
+        } while (remaining > EVENT_EPSILON_MS);
+
+        LOG_TRACE_EVERY_N(50, LogLayer::HAL, "PLC",
+            "Tick axes=" + std::to_string(m_ids.size()) + " ms=" + std::to_string(ms));
+    }
 
-            LOG_TRACE_EVERY_N(50, LogLayer::HAL, "PLC",
-                "relPos update: axis=" + axisIdToString(id)
-                + " abs=" + std::to_string(axis.feedback.absPos)
-                + " base=" + std::to_string(axis.feedback.relZeroAbsPos)
-                + " rel=" + std::to_string(axis.feedback.relPos));
+    /**
+     * @brief 距下一个离散事件的时间（毫秒）；没有待发生的事件时返回 +inf
+     *
+     * 事件包括：定位到位、运动触限、使能完成、待执行的停止请求（0）、
+     * 急停生效/解除、龙门使能、龙门联动/解耦判定。
+     * 两个事件之间 PLC 的状态只有位置在连续变化（匀速或按速度曲线），跳过中间周期不会丢失任何状态跃迁。
+     * 复杂度 O(轴数)，供快进仿真调用，tick() 本身不依赖它。
+     */
+    [[nodiscard]] double nextEventIn() const {
+        double next = nextScanEventIn();
+        for (size_t i = 0; i < m_ids.size(); ++i) {
+            next = std::min(next, axisEventIn(i));
         }
+        return next;
+    }
 
-        // --- 龙门状态机（依赖最新的X1/X2物理状态 -> 必须在轴推演之后执行） ---
-        tickGantry(ms);
+    /**
+     * @brief 推进到下一个事件时刻（最多 maxMs），返回实际推进的毫秒数
+     *
+     * 空闲的 PLC（无事件）直接推进 maxMs。
+     */
+    double advanceToNextEvent(double maxMs) {
+        const double dt = std::min(nextEventIn(), std::max(0.0, maxMs));
+        tick(dt);
+        return dt;
     }
 
     /**
      * @brief 读取指定轴的当前反馈
      */
     AxisFeedback getFeedback(AxisId id) const {
-        return m_axes.at(id).feedback;
+        const size_t i = slotOf(id);
+        return AxisFeedback{
+            m_bank.state[i],
+            m_bank.absPos[i],
+            m_bank.relPos[i],
+            m_bank.relZeroAbsPos[i],
+            m_bank.posLimit[i] != 0,
+            m_bank.negLimit[i] != 0,
+            m_bank.posLimitValue[i],
+            m_bank.negLimitValue[i],
+            m_bank.reportedJogVelocity[i],
+            m_bank.reportedMoveVelocity[i]
+        };
+    }
+
+    /// @brief 已登记的轴（按构造顺序 = 槽位顺序）
+    const std::vector<AxisId>& axisIds() const { return m_ids; }
+
+    size_t axisCount() const { return m_ids.size(); }
+
+    bool hasAxis(AxisId id) const {
+        const auto key = static_cast<size_t>(id);
+        return key < m_slotOf.size() && m_slotOf[key] != NO_SLOT;
     }
 
     // ========== 龙门仿真接口 ==========
 
     /**
-     * @brief 获取龙门反馈快照（用于 pollFeedback 注入领域实体）
+     * @brief 获取龙门反馈快照（第 0 组，用于 pollFeedback 注入领域实体）
      */
     GantryFeedback getGantryFeedback() const {
-        return m_gantryFeedback;
+        return getGantryFeedback(0);
     }
 
+    /// @brief 指定龙门组的反馈快照（组号越界时返回全 false）
+    GantryFeedback getGantryFeedback(size_t group) const {
+        return group < m_gantries.size() ? m_gantries[group].feedback : GantryFeedback{false, false, 0};
+    }
+
+    size_t gantryCount() const { return m_gantries.size(); }
+
     /**
-     * @brief 强制设置龙门反馈（用于测试注入龙门物理状态）
+     * @brief 强制设置龙门反馈（第 0 组，用于测试注入龙门物理状态）
      *
      * bypass 延迟，直接覆盖反馈寄存器。设置后锁定自动刷新。
      */
     void forceGantryFeedback(const GantryFeedback& fb) {
-        m_gantryFeedback = fb;
-        m_gantryPowerCmdPending = false;
-        m_gantryCouplingCmdPending = false;
-        m_gantryFeedbackLocked = true;
+        if (m_gantries.empty()) return;
+        GantryUnit& g = m_gantries[0];
+        g.feedback = fb;
+        g.powerCmdPending = false;
+        g.couplingCmdPending = false;
+        g.feedbackLocked = true;
     }
 
     /**
@@ -217,8 +368,9 @@ public:
      * 模拟 PLC 检测到 X1/X2 未使能/未静止/超差等条件时写入的错误码。
      */
     void forceGantryCouplingError(int errorCode) {
-        m_gantryFeedback.errorCode = errorCode;
-        m_gantryFeedbackLocked = true;
+        if (m_gantries.empty()) return;
+        m_gantries[0].feedback.errorCode = errorCode;
+        m_gantries[0].feedbackLocked = true;
     }
 
     // ========== 急停仿真接口 ==========
@@ -245,95 +397,221 @@ public:
     // ========== 仿真环境配置接口 ==========
 
     void forceState(AxisId id, AxisState s) {
-        m_axes.at(id).feedback.state = s;
+        m_bank.state[slotOf(id)] = s;
     }
 
     void setSimulatedMoveVelocity(AxisId id, double v) {
-        m_axes.at(id).move_velocity = std::abs(v);
-        m_axes.at(id).feedback.getMoveVelocity = std::abs(v);
+        const size_t i = slotOf(id);
+        m_bank.moveVelocity[i] = std::abs(v);
+        m_bank.reportedMoveVelocity[i] = std::abs(v);
     }
 
     void setSimulatedJogVelocity(AxisId id, double v) {
-        m_axes.at(id).jog_velocity = std::abs(v);
-        m_axes.at(id).feedback.getjogVelocity = std::abs(v);
+        const size_t i = slotOf(id);
+        m_bank.jogVelocity[i] = std::abs(v);
+        m_bank.reportedJogVelocity[i] = std::abs(v);
     }
 
     void setLimits(AxisId id, double pos, double neg) {
-        auto& axis = m_axes.at(id);
-        axis.feedback.posLimitValue = pos;
-        axis.feedback.negLimitValue = neg;
+        const size_t i = slotOf(id);
+        m_bank.posLimitValue[i] = pos;
+        m_bank.negLimitValue[i] = neg;
     }
 
     void setAbsolutePosition(AxisId id, double pos) {
-        m_axes.at(id).feedback.absPos = pos;
+        m_bank.absPos[slotOf(id)] = pos;
+    }
+
+    /**
+     * @brief 设置定位速度曲线（对之后下发的 MoveCommand 生效）
+     * @param accel / decel  mm/s²，<= 0 表示该方向不受限
+     * @param jerk           mm/s³，仅 SCurve 使用，<= 0 时等同 Trapezoidal
+     */
+    void setMotionProfile(AxisId id, MotionProfileType type, double accel, double decel, double jerk = 0.0) {
+        const size_t i = slotOf(id);
+        m_bank.profileType[i] = type;
+        m_bank.acceleration[i] = std::abs(accel);
+        m_bank.deceleration[i] = std::abs(decel);
+        m_bank.jerk[i] = std::abs(jerk);
+        m_anyProfiled = std::any_of(m_bank.profileType.begin(), m_bank.profileType.end(),
+            [](MotionProfileType t) { return t != MotionProfileType::Constant; });
+    }
+
+    /// @brief 指定轴当前的运动约束（定位速度 + 速度曲线参数）
+    MotionLimits motionLimits(AxisId id) const {
+        const size_t i = slotOf(id);
+        return MotionLimits{m_bank.moveVelocity[i], m_bank.acceleration[i], m_bank.deceleration[i], m_bank.jerk[i]};
+    }
+
+    /**
+     * @brief 预测从当前位置定位到 target 的耗时（毫秒）
+     *
+     * 与该轴实际执行定位时使用同一份规划（当前定位速度 + 速度曲线），不含使能延迟与通讯周期；
+     * 不考虑软限位（越限的目标在实际执行时会提前停在限位上）。定位速度为 0 时返回 +inf。
+     */
+    double estimateMoveTimeMs(AxisId id, double target, MoveType type = MoveType::Absolute) const {
+        const size_t i = slotOf(id);
+        const double start = m_bank.absPos[i];
+        const double end = (type == MoveType::Absolute) ? target : start + target;
+        return MotionPlan::plan(m_bank.profileType[i], end - start, motionLimits(id)).duration() * 1000.0;
     }
 
     /**
      * @brief 重置所有轴 + 急停状态 + 龙门状态到初始值
+     *
+     * 按 FakePLCConfig 构造的实例回到构造时的每轴速度/限位/速度曲线，
+     * 而不是寄存器上电默认值；构造后经 setter 修改的参数不保留。
      */
     void resetAll() {
-        for (auto& [id, axis] : m_axes) {
-            axis = AxisStateInternal{};
+        const size_t n = m_ids.size();
+        m_bank = AxisBank{};
+        for (size_t i = 0; i < n; ++i) {
+            m_bank.append();
+        }
+        m_anyProfiled = false;
+        for (const auto& a : m_axisConfig) {
+            applyProfile(a.id, a.profile);
         }
         m_emergencyStopCmdPending = false;
         m_emergencyStopTimer = 0;
         m_emergencyStoppedReg = false;
-        m_gantryFeedback = GantryFeedback{false, false, 0};
-        m_gantryPowerCmdPending = false;
-        m_gantryPowerTimer = 0;
-        m_gantryCouplingCmdPending = false;
-        m_gantryCouplingTimer = 0;
-        m_gantryPhysical = GantryPhysicalState{};
-        m_gantryFeedbackLocked = false;
+        for (auto& g : m_gantries) {
+            g = GantryUnit{g.slotX, g.slotX1, g.slotX2};
+        }
     }
 
 private:
-    struct AxisStateInternal {
-        AxisFeedback feedback{ AxisState::Disabled, 0.0, 0.0, 0.0, false, false, 1000.0, -1000.0 };
-        double move_velocity = 50.0;
-        double jog_velocity = 10.0;
-        int enable_timer_ms = 0;
-        double target_pos = 0.0;
-        Direction jog_dir = Direction::Forward;
-        bool stop_requested = false;
+    /**
+     * @brief 轴寄存器组（Structure-of-Arrays，下标 = 槽位）
+     *
+     * 热字段（tick 每周期读写）在前，仅由命令/配置接口访问的冷字段在后。
+     * 布尔量使用 uint8_t 存放，保证数组连续、可按字节向量化。
+     */
+    struct AxisBank {
+        // --- 热字段 ---
+        std::vector<AxisState> state;
+        std::vector<double>    absPos;
+        std::vector<double>    relPos;
+        std::vector<double>    relZeroAbsPos;
+        std::vector<double>    targetPos;
+        std::vector<double>    moveVelocity;
+        std::vector<double>    jogVelocity;
+        std::vector<double>    jogSign;          ///< 点动方向：+1.0 正向 / -1.0 反向
+        std::vector<double>    posLimitValue;
+        std::vector<double>    negLimitValue;
+        std::vector<double>    enableTimerMs;
+        std::vector<uint8_t>   stopRequested;
+        std::vector<uint8_t>   posLimit;
+        std::vector<uint8_t>   negLimit;
+        std::vector<uint8_t>   limitEdge;        ///< 本周期限位上升沿：bit0 正限位 / bit1 负限位
+        std::vector<double>    moveStep;         ///< 本子步定位轴允许走过的距离（scanMoveSteps 填写）
+
+        // --- 速度曲线（仅非 Constant 的定位轴在运动中读写） ---
+        std::vector<MotionProfileType> profileType;
+        std::vector<double>    acceleration;
+        std::vector<double>    deceleration;
+        std::vector<double>    jerk;
+        std::vector<double>    moveStart;        ///< 本次定位的起点
+        std::vector<double>    moveElapsedMs;    ///< 本次定位已运行的时间
+        std::vector<MotionPlan> movePlan;
+
+        // --- 冷字段（反馈寄存器中的速度回读值） ---
+        std::vector<double>    reportedJogVelocity;
+        std::vector<double>    reportedMoveVelocity;
+
+        /// @brief 追加一个默认轴（未使能、限位 ±1000、定位速度 50、点动速度 10）
+        void append() {
+            state.push_back(AxisState::Disabled);
+            absPos.push_back(0.0);
+            relPos.push_back(0.0);
+            relZeroAbsPos.push_back(0.0);
+            targetPos.push_back(0.0);
+            moveVelocity.push_back(50.0);
+            jogVelocity.push_back(10.0);
+            jogSign.push_back(1.0);
+            posLimitValue.push_back(1000.0);
+            negLimitValue.push_back(-1000.0);
+            enableTimerMs.push_back(0.0);
+            stopRequested.push_back(0);
+            posLimit.push_back(0);
+            negLimit.push_back(0);
+            limitEdge.push_back(0);
+            moveStep.push_back(0.0);
+            profileType.push_back(MotionProfileType::Constant);
+            acceleration.push_back(0.0);
+            deceleration.push_back(0.0);
+            jerk.push_back(0.0);
+            moveStart.push_back(0.0);
+            moveElapsedMs.push_back(0.0);
+            movePlan.emplace_back();
+            reportedJogVelocity.push_back(0.0);
+            reportedMoveVelocity.push_back(0.0);
+        }
     };
 
-    std::unordered_map<AxisId, AxisStateInternal> m_axes;
+    static constexpr int32_t NO_SLOT = -1;
 
-    // ========== 急停寄存器（命令/状态分离） ==========
+    /// @brief 写入单轴配置参数（构造与 resetAll 共用）
+    void applyProfile(AxisId id, const FakeAxisProfile& p) {
+        setSimulatedJogVelocity(id, p.jogVelocity);
+        setSimulatedMoveVelocity(id, p.moveVelocity);
+        setLimits(id, p.posLimit, p.negLimit);
+        setMotionProfile(id, p.motion, p.acceleration, p.deceleration, p.jerk);
+    }
 
-    /// @brief "设备急停"命令寄存器（对应 PLC 输入，Driver 写入）
-    bool m_emergencyStopCmdPending = false;
+    AxisBank m_bank;
+    std::vector<FakeAxisConfig> m_axisConfig;  ///< 按配置构造时的每轴参数（resetAll 重新写入）
+    bool m_anyProfiled = false;         ///< 是否有轴配置了非 Constant 速度曲线（否则跳过曲线求值）
+    std::vector<AxisId> m_ids;          ///< 槽位 -> AxisId
+    std::vector<int32_t> m_slotOf;      ///< AxisId 枚举值 -> 槽位（NO_SLOT = 未登记）
 
-    /// @brief 延迟定时器（从命令变更到状态变更的过渡时间）
-    int m_emergencyStopTimer = 0;
+    // ========== 龙门寄存器（命令/反馈分离，每组一份） ==========
 
-    /// @brief "设备急停中"状态寄存器（对应 PLC 输出，Driver 读取反馈）
-    bool m_emergencyStoppedReg = false;
+    /// @brief 一组龙门的寄存器与仿真状态
+    struct GantryUnit {
+        size_t slotX = 0;     ///< 逻辑轴槽位
+        size_t slotX1 = 0;    ///< 物理轴 1 槽位
+        size_t slotX2 = 0;    ///< 物理轴 2 槽位
 
-    // ========== 龙门寄存器（命令/反馈分离） ==========
+        /// @brief 龙门反馈寄存器
+        GantryFeedback feedback{false, false, 0};
 
-    /// @brief 龙门反馈寄存器
-    GantryFeedback m_gantryFeedback{false, false, 0};
+        /// @brief 龙门物理状态快照（每个 tick 从两根物理轴聚合刷新）
+        GantryPhysicalState physical{};
 
-    /// @brief 龙门物理状态快照（每个 tick 从 X1/X2 聚合刷新）
-    GantryPhysicalState m_gantryPhysical{};
+        /// @brief 测试注入锁定标志（true 时跳过该组的自动刷新）
+        bool feedbackLocked = false;
 
-    /// @brief 测试注入锁定标志（true 时跳过 tickGantry 自动刷新）
-    bool m_gantryFeedbackLocked = false;
+        /// @brief 龙门电机使能命令延迟仿真
+        bool powerCmdPending = false;
+        bool powerTarget = false;
+        double powerTimer = 0.0;
 
-    /// @brief 龙门电机使能命令延迟仿真
-    bool m_gantryPowerCmdPending = false;
-    bool m_gantryPowerTarget = false;
-    int m_gantryPowerTimer = 0;
-    static constexpr int GANTRY_POWER_DELAY_MS = 150;
+        /// @brief 龙门耦合/解耦命令延迟仿真
+        bool couplingCmdPending = false;
+        bool couplingTarget = false;
+        double couplingTimer = 0.0;
+    };
+
+    std::vector<GantryUnit> m_gantries;
 
-    /// @brief 龙门耦合/解耦命令延迟仿真
-    bool m_gantryCouplingCmdPending = false;
-    bool m_gantryCouplingTarget = false;
-    int m_gantryCouplingTimer = 0;
+    static constexpr int GANTRY_POWER_DELAY_MS = 150;
     static constexpr int GANTRY_COUPLING_DELAY_MS = 100;
 
+    /// @brief 联动请求排在电机使能之后（见 setGantryCouplingFollowsPower）
+    bool m_gantryCouplingFollowsPower = false;
+
+    // ========== 急停寄存器（命令/状态分离） ==========
+
+    /// @brief "设备急停"命令寄存器（对应 PLC 输入，Driver 写入）
+    bool m_emergencyStopCmdPending = false;
+
+    /// @brief 延迟定时器（从命令变更到状态变更的过渡时间）
+    double m_emergencyStopTimer = 0.0;
+
+    /// @brief "设备急停中"状态寄存器（对应 PLC 输出，Driver 读取反馈）
+    bool m_emergencyStoppedReg = false;
+
     // ========== 内部方法 ==========
 
     static std::string axisIdToString(AxisId id) {
@@ -345,230 +623,373 @@ private:
             case AxisId::X1: return "X1";
             case AxisId::X2: return "X2";
         }
-        return "?";
+        return "#" + std::to_string(static_cast<int>(id));
     }
 
     static constexpr int ENABLE_DELAY_MS = 150;
 
+    /// @brief 定时器到期判定容差：子步长由"阈值 - 已计时"算出，浮点累加可能差 1 ulp
+    static constexpr double EVENT_EPSILON_MS = 1e-9;
+
+    /// @brief 到位判定容差（mm）：按解析到达时间推进后的浮点残差不应再多出一个微小子步
+    /// （限位不加容差：停在限位上的轴必须能以任意小的步长反向离开）
+    static constexpr double POSITION_EPSILON = 1e-9;
+
+    /// @brief 定时器是否已到期（含容差）
+    static bool expired(double timer, double delay) { return timer + EVENT_EPSILON_MS >= delay; }
+
+    /// @brief 定时器剩余时间（已到期为 0）
+    static double remainingOf(double timer, double delay) { return std::max(0.0, delay - timer); }
+
+    // ========== 事件推进 ==========
+
+    /// @brief 一次扫描（子步）：轴 -> 急停 -> 龙门
+    void scan(double ms) {
+        if (tickAxes(ms)) {
+            logLimitEdges();
+        }
+        tickEmergencyStop(ms);
+        tickGantry(ms);
+    }
+
+    /**
+     * @brief 跨子系统事件的剩余时间（急停定时器 + 各龙门组定时器），O(龙门组数)
+     *
+     * 这些事件的判定依赖事件时刻其他轴的状态，tick 必须把子步切在这里；
+     * 单轴事件在扫描内已被解析钳位，不需要切分。
+     */
+    double nextScanEventIn() const {
+        double next = std::numeric_limits<double>::infinity();
+        if (m_emergencyStopCmdPending != m_emergencyStoppedReg) {
+            const int delay = m_emergencyStopCmdPending ? EMERGENCY_STOP_ENGAGE_DELAY_MS
+                                                        : EMERGENCY_STOP_RELEASE_DELAY_MS;
+            next = remainingOf(m_emergencyStopTimer, delay);
+        }
+        for (const auto& g : m_gantries) {
+            if (g.feedbackLocked) continue;
+            if (g.powerCmdPending) {
+                next = std::min(next, remainingOf(g.powerTimer, GANTRY_POWER_DELAY_MS));
+            }
+            // 挂起在使能之后的联动请求与使能完成同一时刻判定，由上面的使能事件切分
+            if (g.couplingCmdPending && !couplingHeldByPower(g)) {
+                next = std::min(next, remainingOf(g.couplingTimer, GANTRY_COUPLING_DELAY_MS));
+            }
+        }
+        return next;
+    }
+
+    /// @brief 单轴的下一个事件（停止请求 / 使能完成 / 到位 / 触限）
+    double axisEventIn(size_t i) const {
+        constexpr double NEVER = std::numeric_limits<double>::infinity();
+        const AxisBank& b = m_bank;
+        if (b.stopRequested[i]) return 0.0;
+
+        const double p = b.absPos[i];
+        const double pl = b.posLimitValue[i];
+        const double nl = b.negLimitValue[i];
+        switch (b.state[i]) {
+            case AxisState::Unknown:
+                return remainingOf(b.enableTimerMs[i], ENABLE_DELAY_MS);
+            case AxisState::MovingAbsolute:
+            case AxisState::MovingRelative: {
+                if (b.profileType[i] != MotionProfileType::Constant) return profiledMoveEventIn(i);
+                if (b.moveVelocity[i] <= 0.0) return NEVER;
+                const double target = b.targetPos[i];
+                const double stop = target > p ? std::min(target, pl) : std::max(target, nl);
+                return std::max(0.0, std::abs(stop - p)) * 1000.0 / b.moveVelocity[i];
+            }
+            case AxisState::Jogging: {
+                if (b.jogVelocity[i] <= 0.0) return NEVER;
+                const double dist = b.jogSign[i] > 0.0 ? pl - p : p - nl;
+                return std::max(0.0, dist) * 1000.0 / b.jogVelocity[i];
+            }
+            default:
+                return NEVER;
+        }
+    }
+
+    /// @brief 按速度曲线运动的定位轴：到位（规划时长）或先触限（按规划反解触限时刻）
+    double profiledMoveEventIn(size_t i) const {
+        const AxisBank& b = m_bank;
+        const MotionPlan& plan = b.movePlan[i];
+        const double elapsed = b.moveElapsedMs[i];
+        double next = plan.duration() * 1000.0 - elapsed;
+
+        const double start = b.moveStart[i];
+        const double target = b.targetPos[i];
+        const double stop = target > start ? std::min(target, b.posLimitValue[i])
+                                           : std::max(target, b.negLimitValue[i]);
+        if (stop != target) {
+            next = std::min(next, plan.timeAtDistance(std::abs(stop - start)) * 1000.0 - elapsed);
+        }
+        return std::max(0.0, next);
+    }
+
+    // ========== 轴登记 / 查找 ==========
+
+    void addAxis(AxisId id) {
+        if (hasAxis(id)) return;
+        const auto key = static_cast<size_t>(id);
+        if (key >= m_slotOf.size()) {
+            m_slotOf.resize(key + 1, NO_SLOT);
+        }
+        m_slotOf[key] = static_cast<int32_t>(m_ids.size());
+        m_ids.push_back(id);
+        m_bank.append();
+    }
+
+    /// @brief 登记一组龙门；三根轴任一未登记时返回 false
+    bool addGantry(const FakeGantryConfig& cfg) {
+        if (!hasAxis(cfg.logical) || !hasAxis(cfg.first) || !hasAxis(cfg.second)) return false;
+        m_gantries.push_back(GantryUnit{slotOf(cfg.logical), slotOf(cfg.first), slotOf(cfg.second)});
+        return true;
+    }
+
+    /// @brief 槽位 i 是否为某个已联动龙门组的物理轴（联动时禁止独立运动）
+    bool isLockedByGantry(size_t i) const {
+        for (const auto& g : m_gantries) {
+            if (g.feedback.isCoupled && (i == g.slotX1 || i == g.slotX2)) return true;
+        }
+        return false;
+    }
+
+    /// @throws std::out_of_range 轴未登记（与原 unordered_map::at 语义一致）
+    size_t slotOf(AxisId id) const {
+        if (!hasAxis(id)) {
+            throw std::out_of_range("FakePLC: axis " + axisIdToString(id) + " not registered");
+        }
+        return static_cast<size_t>(m_slotOf[static_cast<size_t>(id)]);
+    }
+
     /// @brief 急停延迟状态机（对应用真实 PLC 的扫描周期延迟）
-    void tickEmergencyStop(int ms) {
+    void tickEmergencyStop(double ms) {
         if (m_emergencyStopCmdPending != m_emergencyStoppedReg) {
             m_emergencyStopTimer += ms;
             int requiredDelay = m_emergencyStopCmdPending
                                 ? EMERGENCY_STOP_ENGAGE_DELAY_MS
                                 : EMERGENCY_STOP_RELEASE_DELAY_MS;
-            if (m_emergencyStopTimer >= requiredDelay) {
+            if (expired(m_emergencyStopTimer, requiredDelay)) {
                 m_emergencyStoppedReg = m_emergencyStopCmdPending;
-                m_emergencyStopTimer = 0;
+                m_emergencyStopTimer = 0.0;
             }
         }
 
         // 急停生效：所有轴强制掉电 + 停止 + 解除龙门联动
         if (m_emergencyStoppedReg) {
-            for (auto& [id, axis] : m_axes) {
-                if (axis.feedback.state != AxisState::Disabled) {
-                    axis.feedback.state = AxisState::Disabled;
-                }
-                axis.enable_timer_ms = 0;
-                axis.stop_requested = false;
+            std::fill(m_bank.state.begin(), m_bank.state.end(), AxisState::Disabled);
+            std::fill(m_bank.enableTimerMs.begin(), m_bank.enableTimerMs.end(), 0.0);
+            std::fill(m_bank.stopRequested.begin(), m_bank.stopRequested.end(), uint8_t{0});
+
+            for (auto& g : m_gantries) {
+                // 主动解除龙门联动（急停具有最高优先级）
+                g.feedback.isCoupled = false;
+                g.feedback.errorCode = 0;  // 无错误
+
+                // 取消所有待处理的龙门命令
+                g.powerCmdPending = false;
+                g.powerTimer = 0;
+                g.couplingCmdPending = false;
+                g.couplingTimer = 0;
+
+                // 解除测试注入锁定（急停覆盖一切）
+                g.feedbackLocked = false;
             }
-
-            // 主动解除龙门联动（急停具有最高优先级）
-            m_gantryFeedback.isCoupled = false;
-            m_gantryFeedback.errorCode = 0;  // 无错误
-
-            // 取消所有待处理的龙门命令
-            m_gantryPowerCmdPending = false;
-            m_gantryPowerTimer = 0;
-            m_gantryCouplingCmdPending = false;
-            m_gantryCouplingTimer = 0;
-
-            // 解除测试注入锁定（急停覆盖一切）
-            m_gantryFeedbackLocked = false;
         }
     }
 
-    /// @brief 刷新龙门物理状态快照（每个 tick 从 X1/X2 聚合）
-    void refreshGantryPhysicalState() {
-        const auto& x1 = m_axes.at(AxisId::X1).feedback;
-        const auto& x2 = m_axes.at(AxisId::X2).feedback;
+    /// @brief 刷新龙门物理状态快照（每个 tick 从两根物理轴聚合）
+    void refreshGantryPhysicalState(GantryUnit& g) const {
+        const size_t x1 = g.slotX1;
+        const size_t x2 = g.slotX2;
+        const AxisState s1 = m_bank.state[x1];
+        const AxisState s2 = m_bank.state[x2];
+        GantryPhysicalState& ph = g.physical;
 
-        m_gantryPhysical.x1Enabled = (x1.state != AxisState::Disabled
-                                   && x1.state != AxisState::Unknown);
-        m_gantryPhysical.x2Enabled = (x2.state != AxisState::Disabled
-                                   && x2.state != AxisState::Unknown);
+        ph.x1Enabled = (s1 != AxisState::Disabled
+                     && s1 != AxisState::Unknown);
+        ph.x2Enabled = (s2 != AxisState::Disabled
+                     && s2 != AxisState::Unknown);
 
-        m_gantryPhysical.x1Stationary = (x1.state == AxisState::Idle);
-        m_gantryPhysical.x2Stationary = (x2.state == AxisState::Idle);
+        ph.x1Stationary = (s1 == AxisState::Idle);
+        ph.x2Stationary = (s2 == AxisState::Idle);
 
-        m_gantryPhysical.x1HasAlarm = (x1.state == AxisState::Error)
-                                   || x1.posLimit || x1.negLimit;
-        m_gantryPhysical.x2HasAlarm = (x2.state == AxisState::Error)
-                                   || x2.posLimit || x2.negLimit;
+        ph.x1HasAlarm = (s1 == AxisState::Error)
+                     || m_bank.posLimit[x1] || m_bank.negLimit[x1];
+        ph.x2HasAlarm = (s2 == AxisState::Error)
+                     || m_bank.posLimit[x2] || m_bank.negLimit[x2];
 
-        m_gantryPhysical.positionDelta = std::abs(x1.absPos - x2.absPos);
+        ph.positionDelta = std::abs(m_bank.absPos[x1] - m_bank.absPos[x2]);
 
-        m_gantryPhysical.emergencyStopActive = m_emergencyStoppedReg;
+        ph.emergencyStopActive = m_emergencyStoppedReg;
     }
 
     /// @brief 龙门联动前置条件检查
     /// @return 0=通过, 1=位置超差, 2=X1未使能, 3=X2未使能, 4=X1未静止, 5=X2未静止, 999=其他错误
-    int checkCouplingConditions() const {
+    static int checkCouplingConditions(const GantryPhysicalState& ph) {
         // 1. X1 使能检查
-        if (!m_gantryPhysical.x1Enabled) return 2; // X1NotEnabled
+        if (!ph.x1Enabled) return 2; // X1NotEnabled
 
         // 2. X2 使能检查
-        if (!m_gantryPhysical.x2Enabled) return 3; // X2NotEnabled
+        if (!ph.x2Enabled) return 3; // X2NotEnabled
 
         // 3. X1 静止检查
-        if (!m_gantryPhysical.x1Stationary) return 4; // X1NotStationary
+        if (!ph.x1Stationary) return 4; // X1NotStationary
 
         // 4. X2 静止检查
-        if (!m_gantryPhysical.x2Stationary) return 5; // X2NotStationary
+        if (!ph.x2Stationary) return 5; // X2NotStationary
 
         // 5. 位置差检查
-        if (m_gantryPhysical.positionDelta >= GANTRY_MAX_POSITION_DELTA)
+        if (ph.positionDelta >= GANTRY_MAX_POSITION_DELTA)
             return 1; // PositionToleranceExceeded
 
         // 6. 报警检查
-        if (m_gantryPhysical.x1HasAlarm || m_gantryPhysical.x2HasAlarm)
+        if (ph.x1HasAlarm || ph.x2HasAlarm)
             return 999; // UnknownError
 
         // 7. 急停检查
-        if (m_gantryPhysical.emergencyStopActive) return 999;
+        if (ph.emergencyStopActive) return 999;
 
         return 0;
     }
 
-    /// @brief 龙门状态机 -- 每个 tick 周期推进（扫描周期模型）
-    void tickGantry(int ms) {
-        // 测试注入模式：跳过自动刷新，保护测试注入的数据
-        if (m_gantryFeedbackLocked) return;
+    /// @brief 龙门状态机 -- 每个 tick 周期推进全部龙门组（扫描周期模型）
+    void tickGantry(double ms) {
+        for (auto& g : m_gantries) {
+            // 测试注入模式：跳过自动刷新，保护测试注入的数据
+            if (g.feedbackLocked) continue;
 
-        // 步骤 1：电机使能状态机（可能修改 X1/X2 状态）
-        tickGantryPower(ms);
+            // 步骤 1：电机使能状态机（可能修改物理轴状态）
+            tickGantryPower(g, ms);
 
-        // 步骤 2：刷新龙门物理状态快照（必须在 power 之后，确保读取最新 X1/X2 状态）
-        refreshGantryPhysicalState();
+            // 步骤 2：刷新龙门物理状态快照（必须在 power 之后，确保读取最新物理轴状态）
+            refreshGantryPhysicalState(g);
 
-        // 步骤 3：耦合/解耦状态机
-        tickGantryCoupling(ms);
+            // 步骤 3：耦合/解耦状态机
+            tickGantryCoupling(g, ms, couplingHeldByPower(g));
 
-        // 步骤 4：联动建立后持续监测
-        tickGantryCoupledMonitoring(ms);
+            // 步骤 4：联动建立后持续监测
+            tickGantryCoupledMonitoring(g);
 
-        // 步骤 5：同步刷新 GantryFeedback.enable
-        m_gantryFeedback.enable = m_gantryPhysical.x1Enabled
-                               && m_gantryPhysical.x2Enabled;
+            // 步骤 5：同步刷新 GantryFeedback.enable
+            g.feedback.enable = g.physical.x1Enabled && g.physical.x2Enabled;
+        }
     }
 
     /// @brief 龙门电机使能状态机
-    void tickGantryPower(int ms) {
-        if (!m_gantryPowerCmdPending) return;
+    void tickGantryPower(GantryUnit& g, double ms) {
+        if (!g.powerCmdPending) return;
 
-        m_gantryPowerTimer += ms;
-        if (m_gantryPowerTimer >= GANTRY_POWER_DELAY_MS) {
-            m_gantryPowerCmdPending = false;
-            m_gantryPowerTimer = 0;
+        g.powerTimer += ms;
+        if (expired(g.powerTimer, GANTRY_POWER_DELAY_MS)) {
+            g.powerCmdPending = false;
+            g.powerTimer = 0;
 
             // GANTRY_POWER_DELAY_MS 已提供延迟，直接设置目标状态（无需二次延迟）
-            auto& x1 = m_axes.at(AxisId::X1);
-            auto& x2 = m_axes.at(AxisId::X2);
-            auto& x  = m_axes.at(AxisId::X);
-            if (m_gantryPowerTarget) {
+            AxisState& x1 = m_bank.state[g.slotX1];
+            AxisState& x2 = m_bank.state[g.slotX2];
+            AxisState& x  = m_bank.state[g.slotX];
+            if (g.powerTarget) {
                 // 使能：急停激活时拒绝
                 if (!m_emergencyStoppedReg) {
-                    if (x1.feedback.state == AxisState::Disabled) {
-                        x1.feedback.state = AxisState::Idle;
+                    if (x1 == AxisState::Disabled) {
+                        x1 = AxisState::Idle;
                     }
-                    if (x2.feedback.state == AxisState::Disabled) {
-                        x2.feedback.state = AxisState::Idle;
+                    if (x2 == AxisState::Disabled) {
+                        x2 = AxisState::Idle;
                     }
 
-                    if (x1.feedback.state == AxisState::Idle && x2.feedback.state == AxisState::Idle) {
-                        x.feedback.state = AxisState::Idle; // 逻辑龙门轴与物理轴状态保持一致
+                    if (x1 == AxisState::Idle && x2 == AxisState::Idle) {
+                        x = AxisState::Idle; // 逻辑龙门轴与物理轴状态保持一致
                     }
                 }
             } else {
                 // 掉电：无条件
-                x1.feedback.state = AxisState::Disabled;
-                x2.feedback.state = AxisState::Disabled;
-                x.feedback.state = AxisState::Disabled;
+                x1 = AxisState::Disabled;
+                x2 = AxisState::Disabled;
+                x  = AxisState::Disabled;
             }
         }
     }
 
+    /// @brief 联动请求是否正挂起等待电机使能完成（仅排队模式）
+    bool couplingHeldByPower(const GantryUnit& g) const {
+        return m_gantryCouplingFollowsPower && g.couplingTarget && g.powerCmdPending && g.powerTarget;
+    }
+
     /// @brief 龙门耦合/解耦状态机（含条件检查与拒绝逻辑）
-    void tickGantryCoupling(int ms) {
-        if (!m_gantryCouplingCmdPending) return;
+    static void tickGantryCoupling(GantryUnit& g, double ms, bool heldByPower) {
+        if (!g.couplingCmdPending) return;
 
-        m_gantryCouplingTimer += ms;
+        g.couplingTimer += ms;
 
-        if (m_gantryCouplingTarget) {
+        if (g.couplingTarget) {
             // ========== 联动请求 ==========
-            if (m_gantryCouplingTimer < GANTRY_COUPLING_DELAY_MS) return;
+            if (!expired(g.couplingTimer, GANTRY_COUPLING_DELAY_MS)) return;
+            // 排队模式：使能尚未完成，挂起到使能完成的扫描周期再判定
+            if (heldByPower) return;
 
-            int errorCode = checkCouplingConditions();
+            int errorCode = checkCouplingConditions(g.physical);
             if (errorCode != 0) {
                 // 条件不满足 -> 拒绝联动，写入错误码
-                m_gantryFeedback.errorCode = errorCode;
-                m_gantryFeedback.isCoupled = false;
-                m_gantryCouplingCmdPending = false;
-                m_gantryCouplingTimer = 0;
+                g.feedback.errorCode = errorCode;
+                g.feedback.isCoupled = false;
+                g.couplingCmdPending = false;
+                g.couplingTimer = 0;
                 return;
             }
 
             // 所有条件满足 -> 联动成功
-            m_gantryFeedback.isCoupled = true;
-            m_gantryFeedback.errorCode = 0;
-            m_gantryCouplingCmdPending = false;
-            m_gantryCouplingTimer = 0;
+            g.feedback.isCoupled = true;
+            g.feedback.errorCode = 0;
+            g.couplingCmdPending = false;
+            g.couplingTimer = 0;
 
         } else {
             // ========== 解耦请求（无条件通过） ==========
-            if (m_gantryCouplingTimer >= GANTRY_COUPLING_DELAY_MS) {
-                m_gantryFeedback.isCoupled = false;
-                m_gantryFeedback.errorCode = 0;
-                m_gantryCouplingCmdPending = false;
-                m_gantryCouplingTimer = 0;
+            if (expired(g.couplingTimer, GANTRY_COUPLING_DELAY_MS)) {
+                g.feedback.isCoupled = false;
+                g.feedback.errorCode = 0;
+                g.couplingCmdPending = false;
+                g.couplingTimer = 0;
             }
         }
     }
 
     /// @brief 联动持续监测（联动建立后每个 tick 检查）
-    void tickGantryCoupledMonitoring(int /*ms*/) {
-        if (!m_gantryFeedback.isCoupled) return;
+    static void tickGantryCoupledMonitoring(GantryUnit& g) {
+        if (!g.feedback.isCoupled) return;
 
+        const GantryPhysicalState& ph = g.physical;
         bool shouldDecouple = false;
         int errorCode = 0;
 
         // 1. 轴报警检查（限位触发/Error状态，优先级最高）
-        if (m_gantryPhysical.x1HasAlarm || m_gantryPhysical.x2HasAlarm) {
+        if (ph.x1HasAlarm || ph.x2HasAlarm) {
             shouldDecouple = true;
             errorCode = 999;
         }
 
         // 2. 超差检查（联动建立后阈值放宽至 0.5mm）
-        if (!shouldDecouple && m_gantryPhysical.positionDelta >= GANTRY_COUPLED_POSITION_DELTA_ALARM) {
+        if (!shouldDecouple && ph.positionDelta >= GANTRY_COUPLED_POSITION_DELTA_ALARM) {
             shouldDecouple = true;
             errorCode = 1; // PositionToleranceExceeded
         }
 
         // 3. 掉电检查
-        if (!shouldDecouple && (!m_gantryPhysical.x1Enabled || !m_gantryPhysical.x2Enabled)) {
+        if (!shouldDecouple && (!ph.x1Enabled || !ph.x2Enabled)) {
             shouldDecouple = true;
-            errorCode = m_gantryPhysical.x1Enabled ? 3 : 2;
+            errorCode = ph.x1Enabled ? 3 : 2;
         }
 
         // 4. 急停检查
-        if (!shouldDecouple && m_gantryPhysical.emergencyStopActive) {
+        if (!shouldDecouple && ph.emergencyStopActive) {
             shouldDecouple = true;
             errorCode = 999;
         }
 
         if (shouldDecouple) {
-            m_gantryFeedback.isCoupled = false;
-            m_gantryFeedback.errorCode = errorCode;
+            g.feedback.isCoupled = false;
+            g.feedback.errorCode = errorCode;
         }
     }
 
@@ -577,31 +998,31 @@ private:
     void processCommand(AxisId id, std::monostate) {}
 
     void processCommand(AxisId id, const StopCommand&) {
-        auto& axis = m_axes.at(id);
+        const size_t i = slotOf(id);
 
         LOG_DEBUG(LogLayer::HAL, "PLC",
             "process: axis=" + axisIdToString(id)
             + " cmd=Stop"
-            + " state=" + std::to_string(static_cast<int>(axis.feedback.state)));
+            + " state=" + std::to_string(static_cast<int>(m_bank.state[i])));
 
-        if (axis.feedback.state == AxisState::Jogging ||
-            axis.feedback.state == AxisState::MovingAbsolute ||
-            axis.feedback.state == AxisState::MovingRelative) {
-            handleStop(axis);
+        if (m_bank.state[i] == AxisState::Jogging ||
+            m_bank.state[i] == AxisState::MovingAbsolute ||
+            m_bank.state[i] == AxisState::MovingRelative) {
+            handleStop(i);
         } else {
             LOG_WARN(LogLayer::HAL, "PLC",
                 "Stop ignored: axis=" + axisIdToString(id)
-                + " not in motion, state=" + std::to_string(static_cast<int>(axis.feedback.state)));
+                + " not in motion, state=" + std::to_string(static_cast<int>(m_bank.state[i])));
         }
     }
 
     void processCommand(AxisId id, const EnableCommand& cmd) {
-        auto& axis = m_axes.at(id);
+        const size_t i = slotOf(id);
 
         LOG_DEBUG(LogLayer::HAL, "PLC",
             "process: axis=" + axisIdToString(id)
             + " cmd=EnableCommand(active=" + (cmd.active ? "true" : "false") + ")"
-            + " state=" + std::to_string(static_cast<int>(axis.feedback.state)));
+            + " state=" + std::to_string(static_cast<int>(m_bank.state[i])));
 
         // 急停激活时，忽略一切使能命令（模拟真实 PLC AND NOT 设备急停 逻辑）
         if (m_emergencyStoppedReg) {
@@ -610,23 +1031,23 @@ private:
                 + " EMERGENCY STOP ACTIVE -- ignoring Enable");
             return;
         }
-        if (cmd.active && axis.feedback.state == AxisState::Disabled) {
-            axis.enable_timer_ms = 0;
+        if (cmd.active && m_bank.state[i] == AxisState::Disabled) {
+            m_bank.enableTimerMs[i] = 0;
             // 进入 Unknown 过渡态，由 updateStateTransitions 在 ENABLE_DELAY_MS 后置为 Idle
-            axis.feedback.state = AxisState::Unknown;
+            m_bank.state[i] = AxisState::Unknown;
         } else if (!cmd.active) {
-            axis.feedback.state = AxisState::Disabled;
+            m_bank.state[i] = AxisState::Disabled;
         }
     }
 
     void processCommand(AxisId id, const JogCommand& cmd) {
-        auto& axis = m_axes.at(id);
+        const size_t i = slotOf(id);
 
         LOG_DEBUG(LogLayer::HAL, "PLC",
             "process: axis=" + axisIdToString(id)
             + " cmd=JogCommand(dir=" + (cmd.dir == Direction::Forward ? "Forward" : "Backward")
             + ", active=" + (cmd.active ? "true" : "false") + ")"
-            + " state=" + std::to_string(static_cast<int>(axis.feedback.state)));
+            + " state=" + std::to_string(static_cast<int>(m_bank.state[i])));
 
         // 急停激活时，忽略所有运动命令
         if (m_emergencyStoppedReg) {
@@ -637,7 +1058,7 @@ private:
         }
 
         // 联动 ON 时，不允许 X1/X2 独立点动
-        if (m_gantryFeedback.isCoupled && (id == AxisId::X1 || id == AxisId::X2)) {
+        if (isLockedByGantry(i)) {
             LOG_WARN(LogLayer::HAL, "PLC",
                 "Jog REJECTED: axis=" + axisIdToString(id)
                 + " GANTRY COUPLED");
@@ -645,31 +1066,31 @@ private:
         }
 
         if (cmd.active) {
-            if (axis.feedback.state == AxisState::Idle) {
-                axis.feedback.state = AxisState::Jogging;
-                axis.jog_dir = cmd.dir;
+            if (m_bank.state[i] == AxisState::Idle) {
+                m_bank.state[i] = AxisState::Jogging;
+                m_bank.jogSign[i] = (cmd.dir == Direction::Forward) ? 1.0 : -1.0;
             } else {
                 LOG_WARN(LogLayer::HAL, "PLC",
                     "Jog REJECTED: axis=" + axisIdToString(id)
-                    + " state=" + std::to_string(static_cast<int>(axis.feedback.state))
+                    + " state=" + std::to_string(static_cast<int>(m_bank.state[i]))
                     + " (requires Idle)");
             }
         } else {
-            if (axis.feedback.state == AxisState::Jogging) {
-                axis.stop_requested = true;
+            if (m_bank.state[i] == AxisState::Jogging) {
+                m_bank.stopRequested[i] = 1;
             }
         }
     }
 
     void processCommand(AxisId id, const MoveCommand& cmd) {
-        auto& axis = m_axes.at(id);
+        const size_t i = slotOf(id);
 
         std::string typeStr = (cmd.type == MoveType::Absolute) ? "Absolute" : "Relative";
         LOG_DEBUG(LogLayer::HAL, "PLC",
             "process: axis=" + axisIdToString(id)
             + " cmd=MoveCommand(type=" + typeStr
             + ", target=" + std::to_string(cmd.target) + ")"
-            + " state=" + std::to_string(static_cast<int>(axis.feedback.state)));
+            + " state=" + std::to_string(static_cast<int>(m_bank.state[i])));
 
         // 急停激活时，忽略所有运动命令
         if (m_emergencyStoppedReg) {
@@ -680,121 +1101,127 @@ private:
         }
 
         // 联动 ON 时，不允许 X1/X2 独立定位
-        if (m_gantryFeedback.isCoupled && (id == AxisId::X1 || id == AxisId::X2)) {
+        if (isLockedByGantry(i)) {
             LOG_WARN(LogLayer::HAL, "PLC",
                 "Move REJECTED: axis=" + axisIdToString(id)
                 + " GANTRY COUPLED");
             return;
         }
 
-        if (axis.feedback.state == AxisState::Idle) {
-            axis.feedback.state = (cmd.type == MoveType::Absolute) ?
+        if (m_bank.state[i] == AxisState::Idle) {
+            m_bank.state[i] = (cmd.type == MoveType::Absolute) ?
                                    AxisState::MovingAbsolute : AxisState::MovingRelative;
             if (cmd.type == MoveType::Absolute) {
-                axis.target_pos = cmd.target;
+                m_bank.targetPos[i] = cmd.target;
             } else {
-                axis.target_pos = axis.feedback.absPos + cmd.target;
+                m_bank.targetPos[i] = m_bank.absPos[i] + cmd.target;
+            }
+            if (m_bank.profileType[i] != MotionProfileType::Constant) {
+                m_bank.moveStart[i] = m_bank.absPos[i];
+                m_bank.moveElapsedMs[i] = 0.0;
+                m_bank.movePlan[i] = MotionPlan::plan(m_bank.profileType[i],
+                    m_bank.targetPos[i] - m_bank.absPos[i], motionLimits(id));
             }
         } else {
             LOG_WARN(LogLayer::HAL, "PLC",
                 "Move REJECTED: axis=" + axisIdToString(id)
-                + " state=" + std::to_string(static_cast<int>(axis.feedback.state))
+                + " state=" + std::to_string(static_cast<int>(m_bank.state[i]))
                 + " (requires Idle)");
         }
     }
 
     void processCommand(AxisId id, const ZeroAbsoluteCommand&) {
-        auto& axis = m_axes.at(id);
+        const size_t i = slotOf(id);
 
         LOG_DEBUG(LogLayer::HAL, "PLC",
             "process: axis=" + axisIdToString(id)
             + " cmd=ZeroAbsolute"
-            + " state=" + std::to_string(static_cast<int>(axis.feedback.state))
-            + " absPos=" + std::to_string(axis.feedback.absPos));
+            + " state=" + std::to_string(static_cast<int>(m_bank.state[i]))
+            + " absPos=" + std::to_string(m_bank.absPos[i]));
 
-        if (axis.feedback.state == AxisState::Idle || 
-            axis.feedback.state == AxisState::Disabled) {
-            double oldAbs = axis.feedback.absPos;
-            axis.feedback.absPos = 0.0;
+        if (m_bank.state[i] == AxisState::Idle || 
+            m_bank.state[i] == AxisState::Disabled) {
+            double oldAbs = m_bank.absPos[i];
+            m_bank.absPos[i] = 0.0;
             LOG_DEBUG(LogLayer::HAL, "PLC",
                 "ZeroAbsolute executed: axis=" + axisIdToString(id)
                 + " abs " + std::to_string(oldAbs) + " -> 0.0");
         } else {
             LOG_WARN(LogLayer::HAL, "PLC",
                 "ZeroAbsolute REJECTED: axis=" + axisIdToString(id)
-                + " state=" + std::to_string(static_cast<int>(axis.feedback.state))
+                + " state=" + std::to_string(static_cast<int>(m_bank.state[i]))
                 + " (requires Idle or Disabled)");
         }
     }
     
     void processCommand(AxisId id, const SetRelativeZeroCommand&) {
-        auto& axis = m_axes.at(id);
+        const size_t i = slotOf(id);
 
         LOG_DEBUG(LogLayer::HAL, "PLC",
             "process: axis=" + axisIdToString(id)
             + " cmd=SetRelativeZero"
-            + " state=" + std::to_string(static_cast<int>(axis.feedback.state))
-            + " absPos=" + std::to_string(axis.feedback.absPos)
-            + " currentBase=" + std::to_string(axis.feedback.relZeroAbsPos));
-
-        if (axis.feedback.state == AxisState::Idle ||
-            axis.feedback.state == AxisState::Disabled) {
-            double oldBase = axis.feedback.relZeroAbsPos;
-            axis.feedback.relZeroAbsPos = axis.feedback.absPos;
+            + " state=" + std::to_string(static_cast<int>(m_bank.state[i]))
+            + " absPos=" + std::to_string(m_bank.absPos[i])
+            + " currentBase=" + std::to_string(m_bank.relZeroAbsPos[i]));
+
+        if (m_bank.state[i] == AxisState::Idle ||
+            m_bank.state[i] == AxisState::Disabled) {
+            double oldBase = m_bank.relZeroAbsPos[i];
+            m_bank.relZeroAbsPos[i] = m_bank.absPos[i];
             LOG_DEBUG(LogLayer::HAL, "PLC",
                 "SetRelativeZero executed: axis=" + axisIdToString(id)
-                + " base " + std::to_string(oldBase) + " -> " + std::to_string(axis.feedback.relZeroAbsPos));
+                + " base " + std::to_string(oldBase) + " -> " + std::to_string(m_bank.relZeroAbsPos[i]));
         } else {
             LOG_WARN(LogLayer::HAL, "PLC",
                 "SetRelativeZero REJECTED: axis=" + axisIdToString(id)
-                + " state=" + std::to_string(static_cast<int>(axis.feedback.state))
+                + " state=" + std::to_string(static_cast<int>(m_bank.state[i]))
                 + " (requires Idle or Disabled)");
         }
     }
     
     void processCommand(AxisId id, const ClearRelativeZeroCommand&) {
-        auto& axis = m_axes.at(id);
+        const size_t i = slotOf(id);
 
         LOG_DEBUG(LogLayer::HAL, "PLC",
             "process: axis=" + axisIdToString(id)
             + " cmd=ClearRelativeZero"
-            + " state=" + std::to_string(static_cast<int>(axis.feedback.state))
-            + " absPos=" + std::to_string(axis.feedback.absPos)
-            + " currentBase=" + std::to_string(axis.feedback.relZeroAbsPos));
-
-        if (axis.feedback.state == AxisState::Idle ||
-            axis.feedback.state == AxisState::Disabled) {
-            double oldBase = axis.feedback.relZeroAbsPos;
-            axis.feedback.relZeroAbsPos = 0.0;
+            + " state=" + std::to_string(static_cast<int>(m_bank.state[i]))
+            + " absPos=" + std::to_string(m_bank.absPos[i])
+            + " currentBase=" + std::to_string(m_bank.relZeroAbsPos[i]));
+
+        if (m_bank.state[i] == AxisState::Idle ||
+            m_bank.state[i] == AxisState::Disabled) {
+            double oldBase = m_bank.relZeroAbsPos[i];
+            m_bank.relZeroAbsPos[i] = 0.0;
             LOG_DEBUG(LogLayer::HAL, "PLC",
                 "ClearRelativeZero executed: axis=" + axisIdToString(id)
                 + " base " + std::to_string(oldBase) + " -> 0.0");
         } else {
             LOG_WARN(LogLayer::HAL, "PLC",
                 "ClearRelativeZero REJECTED: axis=" + axisIdToString(id)
-                + " state=" + std::to_string(static_cast<int>(axis.feedback.state))
+                + " state=" + std::to_string(static_cast<int>(m_bank.state[i]))
                 + " (requires Idle or Disabled)");
         }
     }
 
     void processCommand(AxisId id, const SetJogVelocityCommand& cmd) {
-        auto& axis = m_axes.at(id);
+        const size_t i = slotOf(id);
         LOG_DEBUG(LogLayer::HAL, "PLC",
             "process: axis=" + axisIdToString(id)
             + " cmd=SetJogVelocityCommand(velocity=" + std::to_string(cmd.velocity) + ")"
-            + " state=" + std::to_string(static_cast<int>(axis.feedback.state)));
-        axis.jog_velocity = std::abs(cmd.velocity);
-        axis.feedback.getjogVelocity = std::abs(cmd.velocity);
+            + " state=" + std::to_string(static_cast<int>(m_bank.state[i])));
+        m_bank.jogVelocity[i] = std::abs(cmd.velocity);
+        m_bank.reportedJogVelocity[i] = std::abs(cmd.velocity);
     }
 
     void processCommand(AxisId id, const SetMoveVelocityCommand& cmd) {
-        auto& axis = m_axes.at(id);
+        const size_t i = slotOf(id);
         LOG_DEBUG(LogLayer::HAL, "PLC",
             "process: axis=" + axisIdToString(id)
             + " cmd=SetMoveVelocityCommand(velocity=" + std::to_string(cmd.velocity) + ")"
-            + " state=" + std::to_string(static_cast<int>(axis.feedback.state)));
-        axis.move_velocity = std::abs(cmd.velocity);
-        axis.feedback.getMoveVelocity = std::abs(cmd.velocity);
+            + " state=" + std::to_string(static_cast<int>(m_bank.state[i])));
+        m_bank.moveVelocity[i] = std::abs(cmd.velocity);
+        m_bank.reportedMoveVelocity[i] = std::abs(cmd.velocity);
     }
 
     void processCommand(AxisId id, const GantryCouplingCommand& cmd) {
@@ -813,72 +1240,172 @@ private:
 
     // ========== 运动控制辅助 ==========
 
-    void handleStop(AxisStateInternal& axis) {
-        if (axis.feedback.state == AxisState::Jogging ||
-            axis.feedback.state == AxisState::MovingAbsolute ||
-            axis.feedback.state == AxisState::MovingRelative) {
-            axis.stop_requested = true;
+    void handleStop(size_t i) {
+        if (m_bank.state[i] == AxisState::Jogging ||
+            m_bank.state[i] == AxisState::MovingAbsolute ||
+            m_bank.state[i] == AxisState::MovingRelative) {
+            m_bank.stopRequested[i] = 1;
         }
     }
 
-    void updateStateTransitions(AxisStateInternal& axis, int ms) {
-        if (axis.feedback.state == AxisState::Unknown) {
-            axis.enable_timer_ms += ms;
-            if (axis.enable_timer_ms >= ENABLE_DELAY_MS) {
-                axis.feedback.state = AxisState::Idle;
-            }
+    /**
+     * @brief 全部轴的一个扫描周期：停止请求 -> 使能过渡 -> 定位步长 -> 运动学 -> 限位 -> 相对坐标
+     *
+     * 逐轴语义与拆分前的 updateStateTransitions / updateKinematics / checkHardwareLimits 完全一致。
+     * 按数据类型拆为线性遍历（scanStateTransitions / scanMoveSteps / scanKinematics），
+     * 循环体只有无条件读取 + 算术 + 条件选择 + 写回：无分支、无日志、无查找
+     * （速度曲线求值除外：只在配置了曲线的 PLC 上对运动中的曲线轴执行）。
+     *
+     * @return 本周期是否有轴触发限位上升沿（需要冷路径输出日志）
+     */
+    bool tickAxes(double ms) {
+        AxisBank& b = m_bank;
+        const size_t n = m_ids.size();
+        scanStateTransitions(n, ms, b.state.data(), b.enableTimerMs.data(), b.stopRequested.data());
+        scanMoveSteps(n, ms, b.moveVelocity.data(), b.moveStep.data());
+        if (m_anyProfiled) {
+            scanProfiledMoves(ms);
         }
+        return scanKinematics(n, ms,
+            b.state.data(), b.absPos.data(), b.relPos.data(), b.relZeroAbsPos.data(),
+            b.targetPos.data(), b.moveStep.data(), b.jogVelocity.data(), b.jogSign.data(),
+            b.posLimitValue.data(), b.negLimitValue.data(),
+            b.posLimit.data(), b.negLimit.data(), b.limitEdge.data());
     }
 
-    void updateKinematics(AxisStateInternal& axis, int ms) {
-        if (axis.feedback.state == AxisState::MovingAbsolute ||
-            axis.feedback.state == AxisState::MovingRelative) {
-            double step = (axis.move_velocity * ms) / 1000.0;
-            double diff = axis.target_pos - axis.feedback.absPos;
-            if (std::abs(diff) <= step) {
-                axis.feedback.absPos = axis.target_pos;
-                axis.feedback.state = AxisState::Idle;
-            } else {
-                axis.feedback.absPos += (diff > 0) ? step : -step;
-            }
-        } else if (axis.feedback.state == AxisState::Jogging) {
-            double step = (axis.jog_velocity * ms) / 1000.0;
-            if (axis.jog_dir == Direction::Forward) {
-                axis.feedback.absPos += step;
-            } else {
-                axis.feedback.absPos -= step;
-            }
+    // 以下两个扫描函数的数组参数互不重叠，声明 __restrict 以免编译器生成运行时别名检查。
+    // GCC -O3 下第 1 遍直接向量化；第 2 遍需 -fno-trapping-math（允许对浮点比较做 if-conversion）。
+
+    /// @brief 第 1 遍（状态 + 定时器）：停止请求 + 使能过渡（Unknown 持续 ENABLE_DELAY_MS 后 -> Idle）
+    static void scanStateTransitions(size_t n, double ms,
+                                     AxisState* __restrict state,
+                                     double* __restrict timer,
+                                     uint8_t* __restrict stopReq) {
+        for (size_t i = 0; i < n; ++i) {
+            AxisState s = state[i];
+            s = stopReq[i] ? AxisState::Idle : s;
+
+            const bool enabling = (s == AxisState::Unknown);
+            const double t = timer[i] + (enabling ? ms : 0.0);
+            s = (enabling & (t + EVENT_EPSILON_MS >= ENABLE_DELAY_MS)) ? AxisState::Idle : s;
+
+            timer[i] = t;
+            state[i] = s;
+            stopReq[i] = 0;
         }
     }
 
-    void checkHardwareLimits(AxisStateInternal& axis) {
-        if (axis.feedback.absPos >= axis.feedback.posLimitValue) {
-            if (!axis.feedback.posLimit) {
-                LOG_ERROR(LogLayer::HAL, "PLC", "LIMIT TRIGGERED at Positive Soft Limit: " + std::to_string(axis.feedback.posLimitValue));
-            }
-            axis.feedback.posLimit = true;
-            axis.feedback.absPos = axis.feedback.posLimitValue;
-            forceStopIfMoving(axis);
-        } else {
-            axis.feedback.posLimit = false;
+    /// @brief 匀速定位步长（速度曲线轴随后由 scanProfiledMoves 覆盖）
+    static void scanMoveSteps(size_t n, double ms,
+                              const double* __restrict mv,
+                              double* __restrict step) {
+        for (size_t i = 0; i < n; ++i) {
+            step[i] = (mv[i] * ms) / 1000.0;
         }
-        if (axis.feedback.absPos <= axis.feedback.negLimitValue) {
-            if (!axis.feedback.negLimit) {
-                LOG_ERROR(LogLayer::HAL, "PLC", "LIMIT TRIGGERED at Negative Soft Limit: " + std::to_string(axis.feedback.negLimitValue));
+    }
+
+    /**
+     * @brief 速度曲线轴的定位步长：走到 "起点 + 规划距离(已运行时间)"
+     *
+     * 到位只由规划时长决定（步长为 +inf，运动学按到位处理）；未到时刻前步长至少留出
+     * 2 × POSITION_EPSILON，避免 S 曲线尾段的微小剩余距离被位置容差提前判为到位。
+     */
+    void scanProfiledMoves(double ms) {
+        AxisBank& b = m_bank;
+        for (size_t i = 0; i < m_ids.size(); ++i) {
+            const AxisState s = b.state[i];
+            if (b.profileType[i] == MotionProfileType::Constant
+                || (s != AxisState::MovingAbsolute && s != AxisState::MovingRelative)) {
+                continue;
             }
-            axis.feedback.negLimit = true;
-            axis.feedback.absPos = axis.feedback.negLimitValue;
-            forceStopIfMoving(axis);
-        } else {
-            axis.feedback.negLimit = false;
+            const MotionPlan& plan = b.movePlan[i];
+            const double elapsed = b.moveElapsedMs[i] + ms;
+            b.moveElapsedMs[i] = elapsed;
+            if (elapsed + EVENT_EPSILON_MS >= plan.duration() * 1000.0) {
+                b.moveStep[i] = std::numeric_limits<double>::infinity();
+                continue;
+            }
+            const double start = b.moveStart[i];
+            const double target = b.targetPos[i];
+            const double planned = start + (target >= start ? 1.0 : -1.0) * plan.distanceAt(elapsed / 1000.0);
+            const double remaining = std::abs(target - b.absPos[i]);
+            b.moveStep[i] = std::min(std::abs(planned - b.absPos[i]),
+                                     std::max(0.0, remaining - 2.0 * POSITION_EPSILON));
         }
     }
 
-    void forceStopIfMoving(AxisStateInternal& axis) {
-        if (axis.feedback.state == AxisState::MovingAbsolute ||
-            axis.feedback.state == AxisState::MovingRelative ||
-            axis.feedback.state == AxisState::Jogging) {
-            axis.feedback.state = AxisState::Idle;
+    /// @brief 第 2 遍（浮点 + 状态）：运动学 + 硬件限位 + 相对坐标
+    /// @return 是否有限位上升沿（edge[i]: bit0 正限位 / bit1 负限位）
+    static bool scanKinematics(size_t n, double ms,
+                               AxisState* __restrict state,
+                               double* __restrict pos,
+                               double* __restrict rel,
+                               const double* __restrict base,
+                               const double* __restrict tgt,
+                               const double* __restrict mstep,
+                               const double* __restrict jv,
+                               const double* __restrict sign,
+                               const double* __restrict pLim,
+                               const double* __restrict nLim,
+                               uint8_t* __restrict pFlag,
+                               uint8_t* __restrict nFlag,
+                               uint8_t* __restrict edge) {
+        uint8_t anyEdge = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const double p0 = pos[i];
+            const double target = tgt[i];
+            const double pl = pLim[i];
+            const double nl = nLim[i];
+            const uint8_t pf = pFlag[i];
+            const uint8_t nf = nFlag[i];
+            AxisState s = state[i];
+
+            // 运动学：定位轴按本子步步长逼近目标（到位即 Idle），点动轴按 jogVelocity 匀速
+            const bool moving  = (s == AxisState::MovingAbsolute) | (s == AxisState::MovingRelative);
+            const bool jogging = (s == AxisState::Jogging);
+            const double moveStep = mstep[i];
+            const double jogStep  = sign[i] * ((jv[i] * ms) / 1000.0);
+            const double diff = target - p0;
+            const bool arrived = moving & (std::abs(diff) <= moveStep + POSITION_EPSILON);
+            const double stepped = p0 + (diff > 0 ? moveStep : -moveStep);
+            const double movePos = arrived ? target : stepped;
+            const double jogPos = p0 + jogStep;
+            double p = moving ? movePos : (jogging ? jogPos : p0);
+            s = arrived ? AxisState::Idle : s;
+
+            // 硬件限位：先正后负，触发即钳位；运动中的轴被强制停止
+            const uint8_t hitPos = (p >= pl) ? 1 : 0;
+            p = hitPos ? pl : p;
+            const uint8_t hitNeg = (p <= nl) ? 1 : 0;
+            p = hitNeg ? nl : p;
+
+            const uint8_t e = static_cast<uint8_t>((hitPos & (pf ^ 1)) | ((hitNeg & (nf ^ 1)) << 1));
+            anyEdge |= e;
+
+            const bool inMotion = moving | jogging;
+            s = ((hitPos | hitNeg) & inMotion) ? AxisState::Idle : s;
+
+            pos[i] = p;
+            rel[i] = p - base[i];
+            state[i] = s;
+            pFlag[i] = hitPos;
+            nFlag[i] = hitNeg;
+            edge[i] = e;
+        }
+        return anyEdge != 0;
+    }
+
+    /// @brief 限位上升沿日志（冷路径，仅在 tickAxes 报告有上升沿时执行）
+    void logLimitEdges() const {
+        for (size_t i = 0; i < m_ids.size(); ++i) {
+            if (m_bank.limitEdge[i] & 0x1) {
+                LOG_ERROR(LogLayer::HAL, "PLC", "LIMIT TRIGGERED at Positive Soft Limit: "
+                    + std::to_string(m_bank.posLimitValue[i]) + " axis=" + axisIdToString(m_ids[i]));
+            }
+            if (m_bank.limitEdge[i] & 0x2) {
+                LOG_ERROR(LogLayer::HAL, "PLC", "LIMIT TRIGGERED at Negative Soft Limit: "
+                    + std::to_string(m_bank.negLimitValue[i]) + " axis=" + axisIdToString(m_ids[i]));
+            }
         }
     }
 };
@@ -0,0 +1,103 @@
+#ifndef FAKE_PLC_CONFIG_H
+#define FAKE_PLC_CONFIG_H
+
+#include "../domain/entity/AxisId.h"
+#include "../domain/motion/MotionProfile.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief 单轴仿真参数（速度 / 软限位 / 定位速度曲线）
+ *
+ * 默认值与 FakePLC 轴寄存器的上电默认值一致。
+ * 与寄存器默认值不同的是：按配置构造时速度回读寄存器同样写入配置值
+ * （等价于构造后调用 setSimulatedJogVelocity / setSimulatedMoveVelocity）。
+ * 速度曲线默认 Constant（无限加速度），其余参数见 FakePLC::setMotionProfile。
+ */
+struct FakeAxisProfile {
+    double jogVelocity  = 10.0;
+    double moveVelocity = 50.0;
+    double posLimit     = 1000.0;
+    double negLimit     = -1000.0;
+    MotionProfileType motion = MotionProfileType::Constant;
+    double acceleration = 0.0;    ///< mm/s²
+    double deceleration = 0.0;    ///< mm/s²
+    double jerk         = 0.0;    ///< mm/s³（仅 SCurve）
+};
+
+struct FakeAxisConfig {
+    AxisId id;
+    FakeAxisProfile profile;
+};
+
+/**
+ * @brief 一组龙门轴：逻辑轴 + 两根物理轴
+ */
+struct FakeGantryConfig {
+    AxisId logical;
+    AxisId first;
+    AxisId second;
+};
+
+/**
+ * @brief FakePLC 构造配置（轴集合 + 每轴参数 + 龙门组）
+ *
+ * 领域层只有一组龙门（SystemContext 的 X / X1 / X2 语义 + 单个 GantryFeedback），
+ * 因此 gantries[0] 是对上层可见的那一组：它的反馈进入 getGantryFeedback()，
+ * 无下标的 onGantryCommand() 也作用于它。其余龙门组只在 PLC 内部仿真
+ * （耦合约束、联动监测、急停解耦），通过带下标的接口单独访问，用于给上层制造负载。
+ *
+ * 龙门组引用的三根轴必须出现在 axes 中，否则构造时忽略该组。
+ */
+struct FakePLCConfig {
+    std::vector<FakeAxisConfig> axes;
+    std::vector<FakeGantryConfig> gantries;
+
+    /// @brief 联动请求排在电机使能之后（见 FakePLC::setGantryCouplingFollowsPower）
+    bool gantryCouplingFollowsPower = false;
+
+    /// @brief 具名轴之后的第一个编号（负载测试生成的轴从这里开始编号）
+    static constexpr int FIRST_EXTRA_AXIS = static_cast<int>(AxisId::X2) + 1;
+
+    /// @brief 第 n 个生成轴的编号
+    static AxisId extraAxisId(size_t n) {
+        return static_cast<AxisId>(FIRST_EXTRA_AXIS + static_cast<int>(n));
+    }
+
+    /**
+     * @brief 与真实设备一致的 6 轴布局（Y / Z / R / X / X1 / X2，一组龙门）
+     */
+    static FakePLCConfig standard(const FakeAxisProfile& profile = {}) {
+        FakePLCConfig cfg;
+        for (auto id : {AxisId::Y, AxisId::Z, AxisId::R, AxisId::X, AxisId::X1, AxisId::X2}) {
+            cfg.axes.push_back({id, profile});
+        }
+        cfg.gantries.push_back({AxisId::X, AxisId::X1, AxisId::X2});
+        return cfg;
+    }
+
+    /**
+     * @brief 负载测试布局：标准 6 轴 + 生成轴，共 axisCount 个轴
+     *
+     * gantryPairs >= 1 时第 0 组为 X / X1 / X2；第 k 组（k >= 1）依次占用
+     * 生成轴 [3(k-1), 3(k-1)+2]，其余生成轴为普通轴。
+     * axisCount 不足 6 时按 6 计；放不下的龙门组被丢弃。
+     */
+    static FakePLCConfig scaled(size_t axisCount, size_t gantryPairs,
+                                const FakeAxisProfile& profile = {}) {
+        FakePLCConfig cfg = standard(profile);
+        if (gantryPairs == 0) cfg.gantries.clear();
+
+        const size_t extras = axisCount > cfg.axes.size() ? axisCount - cfg.axes.size() : 0;
+        for (size_t n = 0; n < extras; ++n) {
+            cfg.axes.push_back({extraAxisId(n), profile});
+        }
+        for (size_t k = 1; k < gantryPairs && 3 * k <= extras; ++k) {
+            const size_t base = 3 * (k - 1);
+            cfg.gantries.push_back({extraAxisId(base), extraAxisId(base + 1), extraAxisId(base + 2)});
+        }
+        return cfg;
+    }
+};
+
+#endif // FAKE_PLC_CONFIG_H
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "domain/entity/Axis.h"
+#include "domain/entity/AxisId.h"
+#include "domain/entity/SystemContext.h"
+#include "domain/gantry/GantryFeedback.h"
+#include "infrastructure/FakePLC.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 一次完整的反馈读取快照（一个分组的全部反馈寄存器）
+ *
+ * 反馈通路拆为两步:
+ *   1. capture:  从 PLC 寄存器映像读出 -> FeedbackFrame（纯数据，可跨线程传递 / 录制）
+ *   2. dispatch: FeedbackFrame -> SystemContext 内各领域实体的 applyFeedback()
+ *
+ * 分派顺序与原 FakeAxisDriver::pollFeedback 保持一致: 急停 -> 龙门 -> 各轴。
+ * axes 向量在多次 capture 之间复用容量，稳态下不分配。
+ */
+struct FeedbackFrame {
+    uint64_t generation = 0;                  ///< 读取批次号（同一批次的多个帧来自同一 PLC 扫描周期）
+    bool emergencyStopped = false;
+    GantryFeedback gantry{false, false, 0};
+    std::vector<std::pair<AxisId, AxisFeedback>> axes;
+
+    /// @brief 从 FakePLC 寄存器映像读取完整快照（PLC 登记的全部轴，按槽位顺序）
+    void captureFrom(const FakePLC& plc) {
+        emergencyStopped = plc.getEmergencyStopFeedback();
+        gantry = plc.getGantryFeedback();
+        axes.clear();
+        for (auto id : plc.axisIds()) {
+            axes.emplace_back(id, plc.getFeedback(id));
+        }
+    }
+
+    /// @brief 将快照注入分组内的领域实体
+    void dispatchTo(SystemContext& ctx) const {
+        // 1. 安全状态 -- 急停
+        ctx.emergencyStopController().applyFeedback(emergencyStopped);
+
+        // 2. 龙门 -- 电机使能 + 联动状态
+        ctx.gantryPowerController().applyFeedback(gantry);
+        ctx.gantryCouplingController().applyFeedback(gantry);
+
+        // 3. 各轴
+        for (const auto& [axisId, fb] : axes) {
+            Axis* axis = nullptr;
+            ContextRejection r;
+            if (ctx.tryGetAxis(axisId, axis, r) && axis) {
+                axis->applyFeedback(fb);
+            }
+        }
+    }
+};
@@ -1,9 +1,12 @@
 #pragma once
 
 #include "domain/command/SystemCommand.h"
+#include <cstdio>
 #include <string>
+#include <type_traits>
 
 class SystemContext;  // 前向声明，避免循环依赖（SystemContext.h 已 include 本文件）
+struct FeedbackFrame;  // 前向声明（见 FeedbackFrame.h）
 
 /**
  * @brief 通讯层结果 -- 精确表达 Modbus TCP 通讯的每一类失败
@@ -65,8 +68,12 @@ struct CommunicationResult {
     int exceptionCode = 0;
 
     /// 诊断信息（用于日志/UI，不参与控制流）
-    /// 例: "192.168.1.100:502 connect failed: ECONNREFUSED"
-    std::string diagnostic;
+    /// 例: "connect failed: ECONNREFUSED"
+    ///
+    /// 必须指向静态存储期的字符串（字面量 / 静态表），本结构体不负责其生命周期。
+    /// 这样 send() 在成功与失败路径上都不分配内存，CommunicationResult 与
+    /// UseCaseError 保持平凡可拷贝；需要动态上下文（地址、异常码）时由 describe() 延迟格式化。
+    const char* diagnostic = "";
 
     // ==================== 便捷判断方法 ====================
 
@@ -116,8 +123,46 @@ struct CommunicationResult {
     bool isProtocolIssue() const {
         return status == Status::ProtocolError;
     }
+
+    // ==================== 延迟格式化 ====================
+
+    /// @brief 生成完整的可读描述（仅在记日志 / 展示时调用）
+    /// 例: "ProtocolError (exception 0x2): Illegal Data Address"
+    [[nodiscard]]
+    std::string describe() const {
+        std::string out = statusName(status);
+        if (status == Status::ProtocolError) {
+            char code[16];
+            std::snprintf(code, sizeof(code), "%X", static_cast<unsigned>(exceptionCode));
+            out += " (exception 0x";
+            out += code;
+            out += ")";
+        }
+        if (diagnostic && *diagnostic) {
+            out += ": ";
+            out += diagnostic;
+        }
+        return out;
+    }
+
+    [[nodiscard]]
+    static const char* statusName(Status s) {
+        switch (s) {
+            case Status::Sent:            return "Sent";
+            case Status::NetworkError:    return "NetworkError";
+            case Status::Timeout:         return "Timeout";
+            case Status::Busy:            return "Busy";
+            case Status::ProtocolError:   return "ProtocolError";
+            case Status::InvalidResponse: return "InvalidResponse";
+            case Status::Disconnected:    return "Disconnected";
+            default:                      return "Unknown";
+        }
+    }
 };
 
+static_assert(std::is_trivially_copyable_v<CommunicationResult>,
+              "CommunicationResult 位于 send() 热路径，必须保持平凡可拷贝");
+
 /**
  * @brief 工业控制系统驱动的统一接口
  *
@@ -136,6 +181,12 @@ public:
     /// @return CommunicationResult -- 只表达通讯帧是否成功送达 PLC
     virtual CommunicationResult send(const SystemCommand& cmd) = 0;
 
+    /// @brief 插队发送（急停专用）：排在所有尚未写入 PLC 的命令之前
+    ///
+    /// 没有内部发送队列的驱动无需覆盖，默认等同 send()。
+    /// 带队列的驱动（链路模型、共享请求流）与装饰器必须覆盖，否则插队语义在该层丢失。
+    virtual CommunicationResult sendUrgent(const SystemCommand& cmd) { return send(cmd); }
+
     // ===== 反馈通路 =====
 
     /// @brief 从硬件拉取反馈并分发给 SystemContext 内的所有领域实体
@@ -151,4 +202,10 @@ public:
     ///
     /// @param ctx 目标分组上下文
     virtual void pollFeedback(SystemContext& ctx) = 0;
+
+    /// @brief 最近一次 pollFeedback() 分派的反馈快照（供录制装饰器读取）
+    ///
+    /// 返回 nullptr 表示上一次轮询没有分派任何快照（丢帧 / 链路断开），
+    /// 或驱动本身不以 FeedbackFrame 为中间表示。指针在下一次 pollFeedback() 前有效。
+    [[nodiscard]] virtual const FeedbackFrame* lastFeedbackFrame() const { return nullptr; }
 };
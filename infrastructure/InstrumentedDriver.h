@@ -0,0 +1,209 @@
+#ifndef INSTRUMENTED_DRIVER_H
+#define INSTRUMENTED_DRIVER_H
+
+#include "infrastructure/ISystemDriver.h"
+#include "infrastructure/utils/LatencyHistogram.h"
+#include <array>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <variant>
+#include <vector>
+
+/**
+ * @brief ISystemDriver 装饰器 -- 为命令通路与反馈通路记录延迟直方图
+ *
+ * 用途: 回答"这次 10ms 周期超时是 I/O、领域处理还是 UI 造成的"。
+ *       本装饰器只度量驱动调用本身（I/O 部分），领域/UI 耗时不计入。
+ *
+ * 统计维度:
+ *   - 操作类型 Op: AxisCommand 的每种备选（Jog / Move / Stop / ...）、龙门联动、
+ *                  龙门使能、急停、以及 pollFeedback
+ *   - 通讯结果 CommunicationResult::Status
+ *     （pollFeedback 无返回值，统一计入 Sent）
+ *
+ * 每个 (Op, Status) 组合一条滑动窗口直方图，首次出现时才分配。
+ * 记录与读取均持有互斥锁 -- snapshot() 可以安全地从诊断面板所在线程调用。
+ *
+ * 使用示例：
+ *   InstrumentedDriver metrics(retryingDriver);
+ *   ctx->setDriver(&metrics);
+ *   auto p99 = metrics.summary(InstrumentedDriver::Op::Poll, Status::Sent).p99Us;
+ */
+class InstrumentedDriver : public ISystemDriver {
+public:
+    using Clock = std::chrono::steady_clock;
+    using NowFn = std::function<Clock::time_point()>;
+    using Status = CommunicationResult::Status;
+
+    /// @brief 操作类型（前段与 AxisCommand 备选顺序一一对应）
+    enum class Op : uint8_t {
+        AxisNone,
+        Jog,
+        Move,
+        Stop,
+        ZeroAbsolute,
+        SetRelativeZero,
+        ClearRelativeZero,
+        Enable,
+        SetJogVelocity,
+        SetMoveVelocity,
+        GantryCoupling,
+        GantryPower,
+        EmergencyStop,
+        Poll,
+        Count
+    };
+
+    static constexpr size_t OP_COUNT = static_cast<size_t>(Op::Count);
+    static constexpr size_t STATUS_COUNT = static_cast<size_t>(Status::Disconnected) + 1;
+
+    static_assert(std::variant_size_v<AxisCommand> == static_cast<size_t>(Op::GantryCoupling),
+                  "Op 前段必须与 AxisCommand 备选一一对应");
+
+    /// @brief 单条统计序列的快照（诊断面板直接绑定）
+    struct SeriesSnapshot {
+        Op op;
+        Status status;
+        std::string opName;
+        std::string statusName;
+        LatencySummary latency;
+    };
+
+    explicit InstrumentedDriver(ISystemDriver& inner,
+                                size_t windowSlices = 10,
+                                std::chrono::milliseconds sliceDuration = std::chrono::milliseconds{1000})
+        : m_inner(inner)
+        , m_windowSlices(windowSlices)
+        , m_sliceDuration(sliceDuration)
+        , m_now([] { return Clock::now(); })
+    {}
+
+    // ========== ISystemDriver 统一入口 ==========
+
+    CommunicationResult send(const SystemCommand& cmd) override {
+        const auto start = m_now();
+        CommunicationResult result = m_inner.send(cmd);
+        const auto end = m_now();
+        record(opOf(cmd), result.status, start, end);
+        return result;
+    }
+
+    CommunicationResult sendUrgent(const SystemCommand& cmd) override {
+        const auto start = m_now();
+        CommunicationResult result = m_inner.sendUrgent(cmd);
+        const auto end = m_now();
+        record(opOf(cmd), result.status, start, end);
+        return result;
+    }
+
+    void pollFeedback(SystemContext& ctx) override {
+        const auto start = m_now();
+        m_inner.pollFeedback(ctx);
+        const auto end = m_now();
+        record(Op::Poll, Status::Sent, start, end);
+    }
+
+    [[nodiscard]] const FeedbackFrame* lastFeedbackFrame() const override {
+        return m_inner.lastFeedbackFrame();
+    }
+
+    // ========== 诊断读取 ==========
+
+    /// @brief 单条序列在滑动窗口内的 p50 / p99 / max
+    [[nodiscard]] LatencySummary summary(Op op, Status status) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto& series = m_series[slotOf(op, status)];
+        return series ? series->summary(m_now()) : LatencySummary{};
+    }
+
+    /// @brief 所有在窗口内有样本的序列
+    [[nodiscard]] std::vector<SeriesSnapshot> snapshot() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto now = m_now();
+        std::vector<SeriesSnapshot> out;
+        for (size_t i = 0; i < m_series.size(); ++i) {
+            if (!m_series[i]) continue;
+            LatencySummary s = m_series[i]->summary(now);
+            if (s.count == 0) continue;
+            Op op = static_cast<Op>(i / STATUS_COUNT);
+            Status st = static_cast<Status>(i % STATUS_COUNT);
+            out.push_back({op, st, opName(op), statusName(st), s});
+        }
+        return out;
+    }
+
+    /// @brief 清空所有统计
+    void reset() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& s : m_series) s.reset();
+    }
+
+    // ========== 分类 / 命名 ==========
+
+    [[nodiscard]]
+    static Op opOf(const SystemCommand& cmd) {
+        if (auto* a = std::get_if<AxisCommandWithId>(&cmd)) {
+            return static_cast<Op>(a->cmd.index());
+        }
+        if (std::holds_alternative<GantryCouplingCommand>(cmd)) return Op::GantryCoupling;
+        if (std::holds_alternative<GantryPowerCommand>(cmd))    return Op::GantryPower;
+        return Op::EmergencyStop;
+    }
+
+    static const char* opName(Op op) {
+        switch (op) {
+            case Op::AxisNone:          return "AxisNone";
+            case Op::Jog:               return "Jog";
+            case Op::Move:              return "Move";
+            case Op::Stop:              return "Stop";
+            case Op::ZeroAbsolute:      return "ZeroAbsolute";
+            case Op::SetRelativeZero:   return "SetRelativeZero";
+            case Op::ClearRelativeZero: return "ClearRelativeZero";
+            case Op::Enable:            return "Enable";
+            case Op::SetJogVelocity:    return "SetJogVelocity";
+            case Op::SetMoveVelocity:   return "SetMoveVelocity";
+            case Op::GantryCoupling:    return "GantryCoupling";
+            case Op::GantryPower:       return "GantryPower";
+            case Op::EmergencyStop:     return "EmergencyStop";
+            case Op::Poll:              return "Poll";
+            default:                    return "Unknown";
+        }
+    }
+
+    static const char* statusName(Status s) {
+        return CommunicationResult::statusName(s);
+    }
+
+    // ========== 测试辅助 ==========
+
+    /// @brief 注入时钟（测试中使用虚拟时间）
+    void setClock(NowFn now) { m_now = std::move(now); }
+
+private:
+    ISystemDriver& m_inner;
+    size_t m_windowSlices;
+    std::chrono::milliseconds m_sliceDuration;
+    NowFn m_now;
+
+    mutable std::mutex m_mutex;
+    std::array<std::unique_ptr<SlidingLatencyHistogram>, OP_COUNT * STATUS_COUNT> m_series;
+
+    static size_t slotOf(Op op, Status status) {
+        return static_cast<size_t>(op) * STATUS_COUNT + static_cast<size_t>(status);
+    }
+
+    void record(Op op, Status status, Clock::time_point start, Clock::time_point end) {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& series = m_series[slotOf(op, status)];
+        if (!series) {
+            series = std::make_unique<SlidingLatencyHistogram>(m_windowSlices, m_sliceDuration);
+        }
+        series->record(ns > 0 ? static_cast<uint64_t>(ns) : 0, end);
+    }
+};
+
+#endif // INSTRUMENTED_DRIVER_H
@@ -0,0 +1,93 @@
+#ifndef LINK_MODEL_H
+#define LINK_MODEL_H
+
+#include <cstdint>
+
+/**
+ * @brief 仿真通讯链路模型（延迟 / 抖动 / 通讯失败 / 丢帧）
+ *
+ * 全部时间以链路虚拟时钟计量（毫秒）：FakeAxisDriver 每次 pollFeedback 推进一个周期，
+ * 与墙钟无关，因此同一 seed 下整个栈的行为逐周期可复现，也可以放进快进仿真。
+ *
+ * --- 命令通路 ---
+ *   send() 先按概率判定通讯失败（Timeout / Busy / ProtocolError），失败的命令不写入 PLC；
+ *   成功的命令在 commandDelayMs + [0, commandJitterMs] 之后才写入 PLC 寄存器。
+ *   链路是串行的：后发的命令不会早于先发的命令到达。
+ *
+ * --- 反馈通路 ---
+ *   每次 pollFeedback 读到的是 feedbackDelayMs + [0, feedbackJitterMs] 之前的 PLC 快照
+ *   （快照不会比上一次读到的更旧）；按 dropFeedbackRate 丢弃整帧，
+ *   领域实体保留上次已知反馈（与真实驱动的读失败策略一致）。
+ *
+ * 概率为 [0, 1]，延迟为非负毫秒；默认值即理想链路（零延迟、无故障），
+ * 行为与未引入链路模型之前完全一致。
+ */
+struct LinkModel {
+    // ── 命令通路 ──
+    int commandDelayMs = 0;
+    int commandJitterMs = 0;
+    double timeoutRate = 0.0;
+    double busyRate = 0.0;
+    double protocolErrorRate = 0.0;
+
+    // ── 反馈通路 ──
+    int feedbackDelayMs = 0;
+    int feedbackJitterMs = 0;
+    double dropFeedbackRate = 0.0;
+
+    uint32_t seed = 1;
+
+    /// @brief 理想链路（默认值）
+    static LinkModel ideal() { return LinkModel{}; }
+
+    /// @brief 现场常见的以太网 Modbus 链路：单程 1~2 个周期、偶发超时与 PLC 忙、少量丢帧
+    static LinkModel typical(uint32_t seed = 1) {
+        LinkModel m;
+        m.commandDelayMs = 10;
+        m.commandJitterMs = 10;
+        m.timeoutRate = 0.01;
+        m.busyRate = 0.01;
+        m.feedbackDelayMs = 10;
+        m.feedbackJitterMs = 10;
+        m.dropFeedbackRate = 0.02;
+        m.seed = seed;
+        return m;
+    }
+
+    /// @brief 劣化链路：交换机拥塞 / 无线网桥，用于压力回归
+    static LinkModel degraded(uint32_t seed = 1) {
+        LinkModel m;
+        m.commandDelayMs = 30;
+        m.commandJitterMs = 40;
+        m.timeoutRate = 0.05;
+        m.busyRate = 0.05;
+        m.protocolErrorRate = 0.005;
+        m.feedbackDelayMs = 30;
+        m.feedbackJitterMs = 40;
+        m.dropFeedbackRate = 0.10;
+        m.seed = seed;
+        return m;
+    }
+
+    /// @brief 在下一个 [0, 1) 随机数上判定故障的总概率
+    [[nodiscard]] double faultRate() const { return timeoutRate + busyRate + protocolErrorRate; }
+
+    /// @brief 反馈快照可能的最大陈旧度（决定驱动需要保留多少历史快照）
+    [[nodiscard]] int maxFeedbackAgeMs() const { return feedbackDelayMs + feedbackJitterMs; }
+};
+
+/**
+ * @brief 链路统计（供测试 / 基准读取）
+ */
+struct LinkStats {
+    uint64_t sends = 0;             ///< send() / sendUrgent() 调用次数（含失败）
+    uint64_t urgentSends = 0;       ///< 其中经 sendUrgent() 插队的命令
+    uint64_t delivered = 0;         ///< 已写入 PLC 的命令
+    uint64_t timeouts = 0;
+    uint64_t busy = 0;
+    uint64_t protocolErrors = 0;
+    uint64_t polls = 0;
+    uint64_t framesDropped = 0;
+};
+
+#endif // LINK_MODEL_H
@@ -0,0 +1,71 @@
+#ifndef RECORDING_DRIVER_H
+#define RECORDING_DRIVER_H
+
+#include "infrastructure/CaptureFile.h"
+#include "infrastructure/ISystemDriver.h"
+#include "infrastructure/logger/Logger.h"
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief ISystemDriver 装饰器 -- 把一个分组的全部驱动流量追加到捕获文件
+ *
+ * 记录内容:
+ *   - send():         命令 + 内部驱动返回的通讯结果
+ *   - pollFeedback(): 内部驱动本周期分派的 FeedbackFrame（经 lastFeedbackFrame() 读取）；
+ *                     本周期没有分派时记一条 NoFeedback，回放时同样不分派
+ *
+ * 多个分组共享同一个 CaptureWriter，以构造时给定的分组编号区分；
+ * 构造时写入一条 GroupName 记录，回放端据此按名称找回分组。
+ *
+ * 内部驱动必须实现 lastFeedbackFrame()（FakeAxisDriver / SharedPlcDriver 及各装饰器均已实现），
+ * 否则反馈通路只会录到 NoFeedback。
+ *
+ * 使用示例：
+ *   CaptureWriter capture;
+ *   capture.open("servo.cap");
+ *   RecordingDriver recA(driverA, capture, 0, "Machine_A");
+ *   ctxA->setDriver(&recA);
+ */
+class RecordingDriver : public ISystemDriver {
+public:
+    RecordingDriver(ISystemDriver& inner, CaptureWriter& writer, uint16_t group, const std::string& groupName)
+        : m_inner(inner), m_writer(writer), m_group(group)
+    {
+        m_writer.appendGroupName(m_group, groupName);
+    }
+
+    CommunicationResult send(const SystemCommand& cmd) override {
+        const CommunicationResult result = m_inner.send(cmd);
+        m_writer.appendCommand(m_group, cmd, result);
+        return result;
+    }
+
+    CommunicationResult sendUrgent(const SystemCommand& cmd) override {
+        const CommunicationResult result = m_inner.sendUrgent(cmd);
+        m_writer.appendCommand(m_group, cmd, result);
+        return result;
+    }
+
+    void pollFeedback(SystemContext& ctx) override {
+        m_inner.pollFeedback(ctx);
+        if (const FeedbackFrame* frame = m_inner.lastFeedbackFrame()) {
+            m_writer.appendFeedback(m_group, *frame);
+        } else {
+            m_writer.appendNoFeedback(m_group);
+        }
+    }
+
+    [[nodiscard]] const FeedbackFrame* lastFeedbackFrame() const override {
+        return m_inner.lastFeedbackFrame();
+    }
+
+    [[nodiscard]] uint16_t group() const { return m_group; }
+
+private:
+    ISystemDriver& m_inner;
+    CaptureWriter& m_writer;
+    uint16_t m_group;
+};
+
+#endif // RECORDING_DRIVER_H
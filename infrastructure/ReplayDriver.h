@@ -0,0 +1,208 @@
+#ifndef REPLAY_DRIVER_H
+#define REPLAY_DRIVER_H
+
+#include "infrastructure/CaptureFile.h"
+#include "infrastructure/ISystemDriver.h"
+#include "infrastructure/logger/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+/**
+ * @brief 回放驱动 -- 把捕获文件中一个分组的反馈序列重新注入 SystemContext
+ *
+ * 反馈通路（开环）:
+ *   每次 pollFeedback() 消费该分组的下一条轮询记录：Feedback 记录解码后分派，
+ *   NoFeedback 记录不分派（与录制时一致）。序列耗尽后 finished() 为 true，
+ *   领域实体保留最后一帧。
+ *
+ * 节奏 Pacing:
+ *   - AsFastAsPossible: 每次调用立即消费下一条（基准测试 / 快速复现）
+ *   - OriginalSpeed:    按录制时间戳等待，相邻轮询的间隔与现场一致
+ *
+ * 命令通路:
+ *   send() 不驱动任何硬件。命令与录制的下一条命令比较：
+ *   一致则返回录制时的通讯结果（现场的 Timeout / Busy 同样重现）；
+ *   不一致计入 divergences（说明上层行为与现场不同），返回 Sent。
+ *   允许在前方 LOOKAHEAD 条命令内重新对齐（上层少发了命令时跳过）。
+ *
+ * 使用示例：
+ *   CaptureReader capture;
+ *   capture.open("servo.cap");
+ *   uint16_t id = 0;
+ *   capture.tryGetGroupId("Machine_A", id);
+ *   ReplayDriver replayA(capture, id);
+ *   ctxA->setDriver(&replayA);
+ */
+class ReplayDriver : public ISystemDriver {
+public:
+    using Clock   = std::chrono::steady_clock;
+    using NowFn   = std::function<Clock::time_point()>;
+    using SleepFn = std::function<void(std::chrono::nanoseconds)>;
+
+    enum class Pacing { AsFastAsPossible, OriginalSpeed };
+
+    static constexpr size_t LOOKAHEAD = 8;
+
+    /// @brief 回放统计
+    struct Stats {
+        uint64_t polls = 0;           ///< 已消费的轮询记录（含 NoFeedback）
+        uint64_t framesDispatched = 0;
+        uint64_t commandsMatched = 0;
+        uint64_t commandsSkipped = 0; ///< 重新对齐时跳过的录制命令
+        uint64_t divergences = 0;     ///< 与录制不一致的 send()
+    };
+
+    ReplayDriver(const CaptureReader& reader, uint16_t group, Pacing pacing = Pacing::AsFastAsPossible)
+        : m_pacing(pacing)
+        , m_now([] { return Clock::now(); })
+        , m_sleep([](std::chrono::nanoseconds d) { std::this_thread::sleep_for(d); })
+    {
+        for (const auto& r : reader.records()) {
+            if (r.group != group) continue;
+            switch (r.type) {
+                case capture::RecordType::Feedback:
+                case capture::RecordType::NoFeedback:
+                    m_polls.push_back(&r);
+                    break;
+                case capture::RecordType::Command:
+                    m_commands.push_back(&r);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    // ========== ISystemDriver ==========
+
+    CommunicationResult send(const SystemCommand& cmd) override {
+        const size_t end = std::min(m_commands.size(), m_nextCommand + LOOKAHEAD);
+        for (size_t k = m_nextCommand; k < end; ++k) {
+            capture::CommandPayload rec;
+            if (!CaptureReader::decodeCommand(*m_commands[k], rec) || !sameCommand(rec.cmd, cmd)) continue;
+
+            m_stats.commandsSkipped += k - m_nextCommand;
+            m_nextCommand = k + 1;
+            ++m_stats.commandsMatched;
+            return CommunicationResult{
+                static_cast<CommunicationResult::Status>(rec.status), rec.exceptionCode, "Replayed"};
+        }
+        ++m_stats.divergences;
+        LOG_WARN_EVERY_MS(5000, LogLayer::HAL, "Replay",
+            "command diverges from capture at recorded command #" + std::to_string(m_nextCommand));
+        return CommunicationResult{};
+    }
+
+    void pollFeedback(SystemContext& ctx) override {
+        m_dispatched = false;
+        if (finished()) return;
+
+        const CaptureReader::Record& r = *m_polls[m_nextPoll++];
+        ++m_stats.polls;
+        pace(r.timestampNs);
+
+        if (r.type == capture::RecordType::Feedback && CaptureReader::decodeFeedback(r, m_frame)) {
+            m_frame.dispatchTo(ctx);
+            m_dispatched = true;
+            ++m_stats.framesDispatched;
+        }
+    }
+
+    [[nodiscard]] const FeedbackFrame* lastFeedbackFrame() const override {
+        return m_dispatched ? &m_frame : nullptr;
+    }
+
+    // ========== 查询 ==========
+
+    [[nodiscard]] bool finished() const { return m_nextPoll >= m_polls.size(); }
+    [[nodiscard]] size_t pollCount() const { return m_polls.size(); }
+    [[nodiscard]] size_t commandCount() const { return m_commands.size(); }
+    [[nodiscard]] const Stats& stats() const { return m_stats; }
+
+    // ========== 测试辅助 ==========
+
+    /// @brief 注入时钟与休眠函数（OriginalSpeed 节奏的测试中使用虚拟时间）
+    void setClock(NowFn now, SleepFn sleep) {
+        m_now = std::move(now);
+        m_sleep = std::move(sleep);
+    }
+
+    /// @brief 命令语义比较（逐字段，不比较变体内未使用的字节）
+    static bool sameCommand(const SystemCommand& a, const SystemCommand& b) {
+        if (a.index() != b.index()) return false;
+        return std::visit([&b](const auto& x) {
+            using T = std::decay_t<decltype(x)>;
+            return same(x, std::get<T>(b));
+        }, a);
+    }
+
+private:
+    Pacing m_pacing;
+    NowFn m_now;
+    SleepFn m_sleep;
+
+    std::vector<const CaptureReader::Record*> m_polls;
+    std::vector<const CaptureReader::Record*> m_commands;
+    size_t m_nextPoll = 0;
+    size_t m_nextCommand = 0;
+
+    FeedbackFrame m_frame;
+    bool m_dispatched = false;
+    Stats m_stats;
+
+    bool m_paceStarted = false;
+    Clock::time_point m_paceOrigin{};
+    uint64_t m_firstTimestampNs = 0;
+
+    /// @brief OriginalSpeed：等待到"回放起点 + 录制时间偏移"
+    void pace(uint64_t timestampNs) {
+        if (m_pacing != Pacing::OriginalSpeed) return;
+        if (!m_paceStarted) {
+            m_paceStarted = true;
+            m_paceOrigin = m_now();
+            m_firstTimestampNs = timestampNs;
+            return;
+        }
+        const auto due = m_paceOrigin + std::chrono::nanoseconds(timestampNs - m_firstTimestampNs);
+        const auto now = m_now();
+        if (due > now) {
+            m_sleep(std::chrono::duration_cast<std::chrono::nanoseconds>(due - now));
+        }
+    }
+
+    // ── 逐字段比较 ──
+
+    static bool same(const AxisCommandWithId& a, const AxisCommandWithId& b) {
+        if (a.id != b.id || a.cmd.index() != b.cmd.index()) return false;
+        return std::visit([&b](const auto& x) {
+            using T = std::decay_t<decltype(x)>;
+            return same(x, std::get<T>(b.cmd));
+        }, a.cmd);
+    }
+    static bool same(const JogCommand& a, const JogCommand& b) { return a.dir == b.dir && a.active == b.active; }
+    static bool same(const MoveCommand& a, const MoveCommand& b) {
+        return a.type == b.type && a.target == b.target && a.startAbs == b.startAbs;
+    }
+    static bool same(const EnableCommand& a, const EnableCommand& b) { return a.active == b.active; }
+    static bool same(const SetJogVelocityCommand& a, const SetJogVelocityCommand& b) { return a.velocity == b.velocity; }
+    static bool same(const SetMoveVelocityCommand& a, const SetMoveVelocityCommand& b) { return a.velocity == b.velocity; }
+    static bool same(const GantryCouplingCommand& a, const GantryCouplingCommand& b) { return a.enableCoupling == b.enableCoupling; }
+    static bool same(const GantryPowerCommand& a, const GantryPowerCommand& b) { return a.enable == b.enable; }
+    static bool same(const EmergencyStopCommand& a, const EmergencyStopCommand& b) { return a.active == b.active; }
+
+    /// @brief 无字段的命令（StopCommand / ZeroAbsoluteCommand / ... / monostate）
+    template<typename T>
+    static bool same(const T&, const T&) {
+        static_assert(std::is_empty_v<T>, "带字段的命令必须提供逐字段比较");
+        return true;
+    }
+};
+
+#endif // REPLAY_DRIVER_H
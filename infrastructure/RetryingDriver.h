@@ -0,0 +1,425 @@
+#ifndef RETRYING_DRIVER_H
+#define RETRYING_DRIVER_H
+
+#include "infrastructure/ISystemDriver.h"
+#include "infrastructure/logger/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <optional>
+#include <random>
+#include <variant>
+
+/**
+ * @brief 重试策略 -- 描述一条命令在通讯层"最多愿意等多久"
+ *
+ * 退避序列: initialBackoff, initialBackoff * multiplier, ... (上限 maxBackoff)
+ * 每次退避再乘以 [1 - jitterRatio, 1 + jitterRatio] 的随机因子，
+ * 避免多个分组在交换机抖动后同一时刻集中重发。
+ *
+ * 重试不在调用线程上等待：退避只决定"最早哪一帧重发"，实际重发发生在之后的 pollFeedback()。
+ * latencyBudget 是一条命令从首次发送到最终结果的总时长上限（跨帧计）：
+ * 预计下一次尝试（退避 + 单次尝试耗时）结束时已超出预算，则放弃该命令。
+ */
+struct RetryPolicy {
+    int maxAttempts = 3;
+    std::chrono::microseconds initialBackoff{500};
+    std::chrono::microseconds maxBackoff{2000};
+    double backoffMultiplier = 2.0;
+    double jitterRatio = 0.25;
+    std::chrono::microseconds latencyBudget{30000};
+
+    /// @brief 常规命令默认策略：最多跨 3 个主循环周期
+    static RetryPolicy standard() { return RetryPolicy{}; }
+
+    /// @brief 安全命令（停止 / 急停）默认策略：
+    ///        更多的重试次数、更短的退避、更宽的预算 -- 停下来比准时更重要
+    static RetryPolicy urgent() {
+        RetryPolicy p;
+        p.maxAttempts       = 6;
+        p.initialBackoff    = std::chrono::microseconds{200};
+        p.maxBackoff        = std::chrono::microseconds{1000};
+        p.backoffMultiplier = 1.5;
+        p.jitterRatio       = 0.25;
+        p.latencyBudget     = std::chrono::microseconds{60000};
+        return p;
+    }
+};
+
+/**
+ * @brief ISystemDriver 装饰器 -- 对可重试的通讯失败做有界、非阻塞的重试
+ *
+ * 判定依据完全来自 CommunicationResult::retryable()（Timeout / Busy）:
+ *   - Sent 或不可重试的失败: 原样返回，不做任何额外动作
+ *   - 可重试的失败: 命令进入重试队列，send() 立即返回 Sent（已受理，与 SharedPlcTransport 的写队列语义一致）；
+ *     之后每次 pollFeedback() 先按序重发到期的命令，直到成功 / 次数耗尽 / 预算耗尽
+ *   - 排队的命令最终失败（次数 / 预算耗尽、不可重试的失败）时按目标锁存该失败：
+ *     同一轴（系统命令则为任一系统命令）的下一次常规 send() 不再下发，直接返回锁存的失败，
+ *     调用方（用例 / 编排器）由此得知先前"已受理"的命令并未送达
+ *   - 安全方向的命令（停止类、掉电）从不被锁存拦截：照常下发并清除该目标的锁存
+ *
+ * 主循环线程上从不休眠：一帧内最多多出一次失败的尝试（队首仍失败即停止本帧重发）。
+ *
+ * 顺序与取代:
+ *   - 队列非空时，新的常规命令排在队尾，保证命令按发送顺序到达 PLC
+ *   - 同一目标（同一轴的同类命令 / 同类系统命令）的新命令取代队列中的旧命令
+ *   - 停止类命令不排队、立即尝试，并丢弃同一轴排队中的常规命令；急停命令丢弃全部排队的常规命令
+ *
+ * 命令分级:
+ *   - 停止类（StopCommand、JogCommand{active=false}、EmergencyStopCommand）使用 urgent 策略
+ *   - 其余命令使用 standard 策略
+ *
+ * 线程约束：send() 与 pollFeedback() 不并发调用（与内部驱动的约束相同）。
+ *
+ * 使用示例：
+ *   FakeAxisDriver raw(plc);
+ *   RetryingDriver driver(raw);
+ *   ctx->setDriver(&driver);
+ */
+class RetryingDriver : public ISystemDriver {
+public:
+    using Clock   = std::chrono::steady_clock;
+    using NowFn   = std::function<Clock::time_point()>;
+
+    /// @brief 累计统计（供诊断面板 / 测试读取）
+    struct Stats {
+        uint64_t sends = 0;           ///< send() 调用次数
+        uint64_t attempts = 0;        ///< 实际下发到内部驱动的次数
+        uint64_t retriedSends = 0;    ///< 至少重试过一次的命令数
+        uint64_t recovered = 0;       ///< 重试后最终成功的命令数
+        uint64_t exhausted = 0;       ///< 重试次数或预算耗尽仍失败的命令数
+        uint64_t abandoned = 0;       ///< 排队后遇到不可重试失败而放弃的命令数
+        uint64_t superseded = 0;      ///< 排队中被新命令取代 / 被停止类命令丢弃的命令数
+        uint64_t heldForOrder = 0;    ///< 因队列非空而排队（未立即尝试）的命令数
+        uint64_t failuresReported = 0;///< 锁存的失败经后续 send() 返回给调用方的次数
+        std::chrono::microseconds totalTime{0};  ///< 所有命令从发送到最终结果的累计耗时
+        std::chrono::microseconds maxTime{0};    ///< 单条命令从发送到最终结果的最大耗时
+
+        int lastAttempts = 0;                     ///< 最近一条结束的命令的尝试次数
+        std::chrono::microseconds lastElapsed{0}; ///< 最近一条结束的命令的耗时
+    };
+
+    explicit RetryingDriver(ISystemDriver& inner,
+                            RetryPolicy standard = RetryPolicy::standard(),
+                            RetryPolicy urgent = RetryPolicy::urgent(),
+                            uint32_t jitterSeed = 0x5eed5eedu)
+        : m_inner(inner)
+        , m_standard(standard)
+        , m_urgent(urgent)
+        , m_rng(jitterSeed)
+        , m_now([] { return Clock::now(); })
+    {}
+
+    // ========== ISystemDriver 统一入口 ==========
+
+    CommunicationResult send(const SystemCommand& cmd) override {
+        return transmit(cmd, false);
+    }
+
+    /// @brief 插队发送：每次尝试都经内层 sendUrgent()，重试策略与 send() 相同（按命令类型选取）
+    CommunicationResult sendUrgent(const SystemCommand& cmd) override {
+        return transmit(cmd, true);
+    }
+
+    /// @brief 先重发到期的排队命令，再委托内部驱动读取反馈（反馈通路失败保留上次值，无需重试）
+    void pollFeedback(SystemContext& ctx) override {
+        drainRetries();
+        m_inner.pollFeedback(ctx);
+    }
+
+    [[nodiscard]] const FeedbackFrame* lastFeedbackFrame() const override {
+        return m_inner.lastFeedbackFrame();
+    }
+
+    // ========== 统计 ==========
+
+    [[nodiscard]] const Stats& stats() const { return m_stats; }
+    void resetStats() { m_stats = Stats{}; }
+
+    /// @brief 等待重发（或排队等待前序命令）的命令数
+    [[nodiscard]] size_t pendingRetries() const { return m_pending.size(); }
+
+    /// @brief 已锁存、尚未返回给调用方的失败数
+    [[nodiscard]] size_t latchedFailures() const {
+        return m_axisFailures.size() + (m_systemFailure ? 1u : 0u);
+    }
+
+    /// @brief 单次尝试耗时的滑动估计（预算判定使用）
+    [[nodiscard]] std::chrono::microseconds expectedAttemptCost() const {
+        return std::chrono::microseconds(static_cast<int64_t>(m_attemptCostUs));
+    }
+
+    /// @brief 停止类命令判定 -- 这些命令使用 urgent 策略
+    [[nodiscard]]
+    static bool isUrgent(const SystemCommand& cmd) {
+        if (std::holds_alternative<EmergencyStopCommand>(cmd)) return true;
+        if (auto* a = std::get_if<AxisCommandWithId>(&cmd)) {
+            if (std::holds_alternative<StopCommand>(a->cmd)) return true;
+            if (auto* jog = std::get_if<JogCommand>(&a->cmd)) return !jog->active;
+        }
+        return false;
+    }
+
+    /// @brief 安全方向的命令（停止类命令与掉电）：从不被锁存的失败拦截
+    [[nodiscard]]
+    static bool isSafeDirection(const SystemCommand& cmd) {
+        if (isUrgent(cmd)) return true;
+        if (auto* a = std::get_if<AxisCommandWithId>(&cmd)) {
+            if (auto* en = std::get_if<EnableCommand>(&a->cmd)) return !en->active;
+        }
+        return false;
+    }
+
+    // ========== 测试辅助 ==========
+
+    /// @brief 注入时钟（测试中使用虚拟时间）
+    void setClock(NowFn now) {
+        m_now = std::move(now);
+    }
+
+private:
+    /// @brief 排队中的命令
+    struct PendingSend {
+        SystemCommand cmd;
+        bool jumpQueue;                     ///< 经内层 sendUrgent() 下发
+        bool urgent;                        ///< 使用 urgent 策略（停止类命令）
+        int attempts;
+        Clock::time_point start;            ///< 首次 send() 时刻
+        Clock::time_point notBefore;        ///< 最早重发时刻（退避结束）
+        Clock::time_point deadline;         ///< start + latencyBudget
+        std::chrono::microseconds backoff;  ///< 下一次退避的基准值
+        CommunicationResult last;           ///< 最近一次尝试的结果（未尝试时为到期描述）
+    };
+
+    static constexpr double ATTEMPT_COST_ALPHA = 0.125;
+
+    ISystemDriver& m_inner;
+    RetryPolicy m_standard;
+    RetryPolicy m_urgent;
+    std::mt19937 m_rng;
+    NowFn m_now;
+    Stats m_stats;
+    std::deque<PendingSend> m_pending;      ///< 停止类命令在前，其余按发送顺序
+    std::map<AxisId, CommunicationResult> m_axisFailures;   ///< 按轴锁存的排队命令最终失败
+    std::optional<CommunicationResult> m_systemFailure;     ///< 系统命令（龙门等）的锁存失败
+    double m_attemptCostUs = 0.0;
+    bool m_haveAttemptCost = false;
+
+    const RetryPolicy& policyFor(const PendingSend& p) const { return p.urgent ? m_urgent : m_standard; }
+
+    std::chrono::microseconds jittered(std::chrono::microseconds base, double ratio) {
+        if (ratio <= 0.0 || base.count() <= 0) return base;
+        std::uniform_real_distribution<double> dist(1.0 - ratio, 1.0 + ratio);
+        return std::chrono::microseconds(static_cast<int64_t>(
+            static_cast<double>(base.count()) * dist(m_rng)));
+    }
+
+    static const char* tag(const PendingSend& p) { return p.urgent ? "[urgent] " : ""; }
+
+    CommunicationResult transmit(const SystemCommand& cmd, bool jumpQueue) {
+        const bool urgent = isUrgent(cmd);
+        const RetryPolicy& policy = urgent ? m_urgent : m_standard;
+        const auto now = m_now();
+        ++m_stats.sends;
+        if (auto latched = takeLatchedFailure(cmd)) {
+            return *latched;
+        }
+        dropSuperseded(cmd, urgent);
+
+        PendingSend p{cmd, jumpQueue, urgent, 0, now, now, now + policy.latencyBudget, policy.initialBackoff,
+                      CommunicationResult{CommunicationResult::Status::Timeout, 0,
+                                          "queued command expired before it could be sent"}};
+
+        // 前序命令仍在排队：常规命令排在其后，保证到达 PLC 的顺序与发送顺序一致
+        if (!urgent && !m_pending.empty()) {
+            ++m_stats.heldForOrder;
+            m_pending.push_back(std::move(p));
+            return CommunicationResult{};
+        }
+
+        CommunicationResult result = attempt(p);
+        if (result.ok() || !result.retryable()) {
+            finish(p, result.ok());
+            return result;
+        }
+        if (!scheduleRetry(p, result)) {
+            return result;
+        }
+        enqueue(std::move(p));
+        return CommunicationResult{};
+    }
+
+    /// @brief 重发到期的排队命令；队首仍失败时本帧不再尝试其后的命令
+    void drainRetries() {
+        while (!m_pending.empty()) {
+            PendingSend& p = m_pending.front();
+            const auto now = m_now();
+            if (now + expectedAttemptCost() > p.deadline) {
+                ++m_stats.exhausted;
+                LOG_WARN(LogLayer::HAL, "RetryingDriver",
+                    std::string(tag(p)) + "latency budget exhausted after "
+                    + std::to_string(p.attempts) + " attempts");
+                finish(p, false);
+                latchFailure(p.cmd, p.last);
+                m_pending.pop_front();
+                continue;
+            }
+            if (now < p.notBefore) {
+                return;
+            }
+
+            CommunicationResult result = attempt(p);
+            if (result.ok()) {
+                finish(p, true);
+                m_pending.pop_front();
+                continue;
+            }
+            if (!result.retryable()) {
+                ++m_stats.abandoned;
+                LOG_WARN(LogLayer::HAL, "RetryingDriver",
+                    std::string(tag(p)) + "queued command failed: " + result.describe());
+                finish(p, false);
+                latchFailure(p.cmd, result);
+                m_pending.pop_front();
+                continue;
+            }
+            if (!scheduleRetry(p, result)) {
+                latchFailure(p.cmd, result);
+                m_pending.pop_front();
+                continue;
+            }
+            return;
+        }
+    }
+
+    /// @brief 单次尝试（记录耗时，更新单次尝试耗时估计）
+    CommunicationResult attempt(PendingSend& p) {
+        const auto begin = m_now();
+        CommunicationResult result = p.jumpQueue ? m_inner.sendUrgent(p.cmd) : m_inner.send(p.cmd);
+        const double costUs = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::microseconds>(m_now() - begin).count());
+        m_attemptCostUs = m_haveAttemptCost
+            ? m_attemptCostUs + ATTEMPT_COST_ALPHA * (costUs - m_attemptCostUs)
+            : costUs;
+        m_haveAttemptCost = true;
+
+        ++p.attempts;
+        ++m_stats.attempts;
+        p.last = result;
+        return result;
+    }
+
+    /// @brief 为失败的尝试安排下一次重发；次数或预算不足时记为耗尽并返回 false
+    bool scheduleRetry(PendingSend& p, const CommunicationResult& result) {
+        const RetryPolicy& policy = policyFor(p);
+        if (p.attempts >= std::max(1, policy.maxAttempts)) {
+            ++m_stats.exhausted;
+            LOG_WARN(LogLayer::HAL, "RetryingDriver",
+                std::string(tag(p)) + "retry attempts exhausted after "
+                + std::to_string(p.attempts) + " attempts: " + result.describe());
+            finish(p, false);
+            return false;
+        }
+
+        const auto now = m_now();
+        const auto wait = jittered(p.backoff, policy.jitterRatio);
+        if (now + wait + expectedAttemptCost() > p.deadline) {
+            ++m_stats.exhausted;
+            LOG_WARN(LogLayer::HAL, "RetryingDriver",
+                std::string(tag(p)) + "latency budget exhausted after "
+                + std::to_string(p.attempts) + " attempts: " + result.describe());
+            finish(p, false);
+            return false;
+        }
+
+        LOG_DEBUG(LogLayer::HAL, "RetryingDriver",
+            "retryable failure (attempt " + std::to_string(p.attempts) + "), retry after "
+            + std::to_string(wait.count()) + "us: " + result.describe());
+        p.notBefore = now + wait;
+        p.backoff = std::min(policy.maxBackoff,
+            std::chrono::microseconds(static_cast<int64_t>(
+                static_cast<double>(p.backoff.count()) * policy.backoffMultiplier)));
+        return true;
+    }
+
+    /// @brief 入队：停止类命令排在所有常规命令之前（已排队的停止类命令之后）
+    void enqueue(PendingSend p) {
+        if (!p.urgent) {
+            m_pending.push_back(std::move(p));
+            return;
+        }
+        auto pos = std::find_if(m_pending.begin(), m_pending.end(),
+                                [](const PendingSend& q) { return !q.urgent; });
+        m_pending.insert(pos, std::move(p));
+    }
+
+    /// @brief 丢弃被新命令取代的排队命令
+    void dropSuperseded(const SystemCommand& cmd, bool urgent) {
+        const bool estop = std::holds_alternative<EmergencyStopCommand>(cmd);
+        const auto* axisCmd = std::get_if<AxisCommandWithId>(&cmd);
+        const size_t before = m_pending.size();
+        std::erase_if(m_pending, [&](const PendingSend& q) {
+            if (sameTarget(q.cmd, cmd)) return true;
+            if (q.urgent || !urgent) return false;
+            if (estop) return true;
+            const auto* queued = std::get_if<AxisCommandWithId>(&q.cmd);
+            return axisCmd && queued && queued->id == axisCmd->id;
+        });
+        m_stats.superseded += before - m_pending.size();
+    }
+
+    static bool sameTarget(const SystemCommand& a, const SystemCommand& b) {
+        if (a.index() != b.index()) return false;
+        const auto* x = std::get_if<AxisCommandWithId>(&a);
+        const auto* y = std::get_if<AxisCommandWithId>(&b);
+        if (!x || !y) return true;
+        return x->id == y->id && x->cmd.index() == y->cmd.index();
+    }
+
+    /// @brief 锁存排队命令的最终失败，由同一目标的下一次常规 send() 返回
+    void latchFailure(const SystemCommand& cmd, const CommunicationResult& result) {
+        if (auto* a = std::get_if<AxisCommandWithId>(&cmd)) {
+            m_axisFailures[a->id] = result;
+        } else {
+            m_systemFailure = result;
+        }
+    }
+
+    /// @brief 取出该命令目标上锁存的失败；安全方向的命令只清除锁存、照常下发
+    std::optional<CommunicationResult> takeLatchedFailure(const SystemCommand& cmd) {
+        std::optional<CommunicationResult> latched;
+        if (auto* a = std::get_if<AxisCommandWithId>(&cmd)) {
+            auto it = m_axisFailures.find(a->id);
+            if (it == m_axisFailures.end()) return std::nullopt;
+            latched = it->second;
+            m_axisFailures.erase(it);
+        } else {
+            if (!m_systemFailure) return std::nullopt;
+            latched = m_systemFailure;
+            m_systemFailure.reset();
+        }
+        if (isSafeDirection(cmd)) return std::nullopt;
+        ++m_stats.failuresReported;
+        LOG_WARN(LogLayer::HAL, "RetryingDriver",
+            "reporting earlier queued command failure to caller: " + latched->describe());
+        return latched;
+    }
+
+    /// @brief 一条命令得到最终结果（成功 / 放弃）时记账
+    void finish(const PendingSend& p, bool ok) {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(m_now() - p.start);
+        if (p.attempts > 1) {
+            ++m_stats.retriedSends;
+            if (ok) ++m_stats.recovered;
+        }
+        m_stats.totalTime += elapsed;
+        m_stats.maxTime = std::max(m_stats.maxTime, elapsed);
+        m_stats.lastAttempts = p.attempts;
+        m_stats.lastElapsed = elapsed;
+    }
+};
+
+#endif // RETRYING_DRIVER_H
@@ -0,0 +1,224 @@
+#ifndef SHARED_PLC_TRANSPORT_H
+#define SHARED_PLC_TRANSPORT_H
+
+#include "infrastructure/ISystemDriver.h"
+#include "infrastructure/FakePLC.h"
+#include "infrastructure/FeedbackFrame.h"
+#include "infrastructure/logger/Logger.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief 多分组共享的 PLC 传输层（一个 PLC、一条连接、一条请求流）
+ *
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║  SystemContext_A     SystemContext_B     SystemContext_C     ║
+ * ║        ↓                   ↓                   ↓             ║
+ * ║  SharedPlcDriver(0)  SharedPlcDriver(1)  SharedPlcDriver(2)  ║
+ * ║        └───────────────────┼───────────────────┘             ║
+ * ║                   SharedPlcTransport                         ║
+ * ║             （写请求队列 + 批次化读交换）                       ║
+ * ║        ┌───────────────────┼───────────────────┐             ║
+ * ║    窗口 0 (FakePLC)     窗口 1 (FakePLC)     窗口 2 (FakePLC)   ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 每个分组拥有 PLC 上一段独立的寄存器窗口（此处每个窗口由一个 FakePLC 建模）。
+ *
+ * 请求流:
+ *   - 写: 各门面的 send() 只把命令追加到共享写队列，按到达顺序排队；
+ *         sendUrgent()（急停）插到队列中所有普通命令之前
+ *   - 交换: 一次 exchange = 顺序冲刷写队列 -> PLC 扫描一个周期 -> 一次性读回全部窗口
+ *   - 读: 门面 pollFeedback() 读取本窗口在最近一次交换中的快照；
+ *         若该快照已被本窗口消费过，才触发下一次交换
+ *
+ * 因此每个主循环周期（每个分组各 poll 一次）只发生一次交换，
+ * 且同一周期内所有分组看到的是同一批次（generation 相同）的一致快照。
+ *
+ * 线程安全: 全部状态由互斥锁保护，可与 GroupPollScheduler 的并行轮询配合使用；
+ *           领域实体的分派在锁外、由各自分组的线程完成。
+ */
+class SharedPlcTransport {
+public:
+    explicit SharedPlcTransport(int cycleMs = 10) : m_cycleMs(cycleMs) {}
+
+    /// @brief 注册一个寄存器窗口，返回窗口编号（门面构造时使用）
+    size_t addWindow(FakePLC& plc) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_windows.push_back(Window{&plc, FeedbackFrame{}, true});
+        return m_windows.size() - 1;
+    }
+
+    [[nodiscard]] size_t windowCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_windows.size();
+    }
+
+    // ========== 请求流 ==========
+
+    /**
+     * @brief 把一条写请求追加到共享请求流（下一次交换时按序写入）
+     * @param urgent true 时插到所有普通写请求之前（先前的插队请求之后），用于急停
+     */
+    CommunicationResult enqueueWrite(size_t window, const SystemCommand& cmd, bool urgent = false) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_connected) {
+            return CommunicationResult{
+                CommunicationResult::Status::Disconnected, 0, "Shared PLC link not connected"};
+        }
+        if (window >= m_windows.size()) {
+            return CommunicationResult{
+                CommunicationResult::Status::ProtocolError, 0x02, "Register window out of range"};
+        }
+        if (urgent) {
+            // 尚未冲刷的普通急停写请求（如解除）作废，否则会在插队请求之后覆盖急停寄存器
+            const auto normal = m_pendingWrites.begin() + static_cast<std::ptrdiff_t>(m_urgentWrites);
+            if (std::holds_alternative<EmergencyStopCommand>(cmd)) {
+                m_pendingWrites.erase(
+                    std::remove_if(normal, m_pendingWrites.end(), [&](const PendingWrite& w) {
+                        return w.window == window && std::holds_alternative<EmergencyStopCommand>(w.cmd);
+                    }),
+                    m_pendingWrites.end());
+            }
+            m_pendingWrites.insert(m_pendingWrites.begin() + static_cast<std::ptrdiff_t>(m_urgentWrites),
+                                   PendingWrite{window, cmd});
+            ++m_urgentWrites;
+        } else {
+            m_pendingWrites.push_back(PendingWrite{window, cmd});
+        }
+        return CommunicationResult{};
+    }
+
+    /// @brief 读取窗口的最新快照（必要时先执行一次交换）
+    /// @return false 表示链路断开，out 未更新（调用方保留上次已知反馈）
+    bool readWindow(size_t window, FeedbackFrame& out) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_connected || window >= m_windows.size()) return false;
+
+        if (m_windows[window].consumed) {
+            exchangeLocked();
+        }
+        Window& w = m_windows[window];
+        w.consumed = true;
+        out.generation = w.frame.generation;
+        out.emergencyStopped = w.frame.emergencyStopped;
+        out.gantry = w.frame.gantry;
+        out.axes.assign(w.frame.axes.begin(), w.frame.axes.end());
+        return true;
+    }
+
+    // ========== 链路控制 / 统计 ==========
+
+    void disconnect() { std::lock_guard<std::mutex> lock(m_mutex); m_connected = false; }
+    void connect()    { std::lock_guard<std::mutex> lock(m_mutex); m_connected = true; }
+
+    /// @brief 已执行的交换次数（= PLC 扫描周期数）
+    [[nodiscard]] uint64_t exchangeCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_generation;
+    }
+
+    /// @brief 累计写入 PLC 的请求数
+    [[nodiscard]] uint64_t writesFlushed() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_writesFlushed;
+    }
+
+private:
+    struct Window {
+        FakePLC* plc;
+        FeedbackFrame frame;
+        bool consumed;
+    };
+
+    struct PendingWrite {
+        size_t window;
+        SystemCommand cmd;
+    };
+
+    int m_cycleMs;
+    mutable std::mutex m_mutex;
+    std::vector<Window> m_windows;
+    std::vector<PendingWrite> m_pendingWrites;
+    size_t m_urgentWrites = 0;   ///< m_pendingWrites 头部的插队请求数
+    bool m_connected = true;
+    uint64_t m_generation = 0;
+    uint64_t m_writesFlushed = 0;
+
+    void exchangeLocked() {
+        // 1. 按到达顺序冲刷写请求
+        for (const auto& w : m_pendingWrites) {
+            m_windows[w.window].plc->onSystemCommand(w.cmd);
+        }
+        m_writesFlushed += m_pendingWrites.size();
+        m_pendingWrites.clear();
+        m_urgentWrites = 0;
+
+        // 2. PLC 扫描一个周期，3. 一次性读回全部窗口
+        ++m_generation;
+        for (auto& w : m_windows) {
+            w.plc->tick(m_cycleMs);
+            w.frame.captureFrom(*w.plc);
+            w.frame.generation = m_generation;
+            w.consumed = false;
+        }
+
+        LOG_TRACE_EVERY_N(100, LogLayer::HAL, "SharedPlc",
+            "exchange #" + std::to_string(m_generation) + " windows=" + std::to_string(m_windows.size()));
+    }
+};
+
+/**
+ * @brief 分组门面驱动 -- 绑定 SharedPlcTransport 上的一个寄存器窗口
+ *
+ * 使用示例：
+ *   FakePLC plcA, plcB;
+ *   SharedPlcTransport link;
+ *   SharedPlcDriver driverA(link, link.addWindow(plcA));
+ *   SharedPlcDriver driverB(link, link.addWindow(plcB));
+ *   ctxA->setDriver(&driverA);
+ *   ctxB->setDriver(&driverB);
+ */
+class SharedPlcDriver : public ISystemDriver {
+public:
+    SharedPlcDriver(SharedPlcTransport& transport, size_t window)
+        : m_transport(transport), m_window(window) {}
+
+    CommunicationResult send(const SystemCommand& cmd) override {
+        return m_transport.enqueueWrite(m_window, cmd);
+    }
+
+    CommunicationResult sendUrgent(const SystemCommand& cmd) override {
+        return m_transport.enqueueWrite(m_window, cmd, true);
+    }
+
+    void pollFeedback(SystemContext& ctx) override {
+        m_dispatched = false;
+        if (!m_transport.readWindow(m_window, m_frame)) {
+            LOG_WARN_EVERY_MS(5000, LogLayer::HAL, "SharedPlc",
+                "pollFeedback skipped: link down, keeping last known feedback");
+            return;
+        }
+        m_frame.dispatchTo(ctx);
+        m_dispatched = true;
+    }
+
+    [[nodiscard]] const FeedbackFrame* lastFeedbackFrame() const override {
+        return m_dispatched ? &m_frame : nullptr;
+    }
+
+    [[nodiscard]] size_t window() const { return m_window; }
+
+    /// @brief 最近一次分派的快照批次号
+    [[nodiscard]] uint64_t lastGeneration() const { return m_frame.generation; }
+
+private:
+    SharedPlcTransport& m_transport;
+    size_t m_window;
+    FeedbackFrame m_frame;
+    bool m_dispatched = false;
+};
+
+#endif // SHARED_PLC_TRANSPORT_H
@@ -0,0 +1,280 @@
+#ifndef SHM_PLC_DRIVER_H
+#define SHM_PLC_DRIVER_H
+
+#include "infrastructure/FeedbackFrame.h"
+#include "infrastructure/ISystemDriver.h"
+#include "infrastructure/ShmRegisterFile.h"
+#include "infrastructure/logger/Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <string>
+
+#if SERVOV6_HAS_SHM_PLC
+
+/**
+ * @brief 进程外仿真器驱动 -- 经共享内存寄存器文件与 servoV6_plcsim 通讯
+ *
+ * ╔════════════════════════════════════════════════════════════════╗
+ * ║  SystemContext ─► ShmPlcDriver ─► /dev/shm/servoV6.<group>     ║
+ * ║                                        ▲                       ║
+ * ║                          servoV6_plcsim（ShmPlcServer + FakePLC）║
+ * ╚════════════════════════════════════════════════════════════════╝
+ *
+ * send():
+ *   命令按序写入命令环，不等待服务端；环满返回 Busy（0x06），服务端不在线返回 Disconnected。
+ *
+ * pollFeedback():
+ *   - Lockstep:    递增 tickRequest 唤醒服务端，等待 tickDone 追上后读取反馈块
+ *                  （等待超时视为本周期无反馈，领域实体保留上次已知反馈）
+ *   - FreeRunning: 不等待，读取最新反馈块；与上次相比没有新周期时不分派
+ *   反馈块以 seqlock 读取：序号为奇数或前后不一致时重读，保证拿到同一周期的完整快照。
+ *   重读有上限：服务端下线或超过 FEEDBACK_READ_TIMEOUT 仍未读到一致快照时放弃本周期，
+ *   领域实体保留上次已知反馈（写端在写入中途崩溃时序号会永远停在奇数）。
+ *
+ * 服务端未启动或已退出时驱动处于断开状态，之后的 pollFeedback 周期性尝试重新连接。
+ * 服务端被 SIGKILL / 崩溃时来不及清除 online：节拍或读取超时（FreeRunning 下长时间没有新周期）时
+ * 以 kill(serverPid, 0) 检查服务端进程，进程已不存在则解除映射转为断开，按同样的节奏重新连接；
+ * connect() 同样拒绝挂接 online 仍为 1 但服务端进程已不存在的残留段。
+ *
+ * 使用示例：
+ *   ShmPlcDriver driverA(shmplc::segmentName("Machine_A"));
+ *   driverA.connect();
+ *   RetryingDriver retryA(driverA);
+ *   ctxA->setDriver(&retryA);
+ */
+class ShmPlcDriver : public ISystemDriver {
+public:
+    /// @brief 连接统计
+    struct Stats {
+        uint64_t sends = 0;
+        uint64_t ringFull = 0;
+        uint64_t polls = 0;
+        uint64_t framesDispatched = 0;
+        uint64_t tickTimeouts = 0;
+        uint64_t readTimeouts = 0;
+        uint64_t serverLost = 0;      ///< 检测到服务端进程已不存在（未清除 online）的次数
+        uint64_t reconnects = 0;
+    };
+
+    /// @brief 断开状态下每隔多少次 poll 尝试一次重连
+    static constexpr int RECONNECT_EVERY_POLLS = 100;
+
+    /// @brief FreeRunning 下连续多少次 poll 没有新周期时检查一次服务端进程
+    static constexpr int LIVENESS_CHECK_STALE_POLLS = 100;
+
+    /// @brief seqlock 读的最长等待：写端停在写入中途（序号为奇数）超过该时长即放弃本周期
+    static constexpr std::chrono::milliseconds FEEDBACK_READ_TIMEOUT{2};
+
+    explicit ShmPlcDriver(std::string segment,
+                          std::chrono::milliseconds tickTimeout = std::chrono::milliseconds(100))
+        : m_segmentName(std::move(segment)), m_tickTimeout(tickTimeout) {}
+
+    /// @brief 映射共享内存段并校验布局；服务端不在线时返回 false
+    bool connect() {
+        if (!m_segment.open(m_segmentName)) return false;
+        shmplc::RegisterFile* f = m_segment.file();
+        // online 置位之后描述区才完整（服务端可能正在初始化）
+        if (f->online.load(std::memory_order_acquire) == 0) {
+            m_segment.close();
+            return false;
+        }
+        // 残留段：服务端被杀死时 online 停在 1
+        if (!serverAlive(*f)) {
+            m_segment.close();
+            return false;
+        }
+        if (!f->compatible()) {
+            LOG_ERROR(LogLayer::HAL, "ShmPlc", "incompatible register file layout: " + m_segmentName);
+            m_segment.close();
+            return false;
+        }
+        m_mode = static_cast<shmplc::Mode>(f->mode);
+        m_lastSeq = 0;
+        m_stalePolls = 0;
+        LOG_INFO(LogLayer::HAL, "ShmPlc", "connected to " + m_segmentName
+            + " (server pid " + std::to_string(f->serverPid) + ")");
+        return true;
+    }
+
+    [[nodiscard]] bool isConnected() const {
+        const shmplc::RegisterFile* f = m_segment.file();
+        return f && f->online.load(std::memory_order_acquire) != 0;
+    }
+
+    /// @brief 请求服务端退出（测试 / 工具使用）
+    void requestServerShutdown() {
+        if (shmplc::RegisterFile* f = m_segment.file()) {
+            f->shutdownRequest.store(1, std::memory_order_release);
+            f->tickRequest.fetch_add(1, std::memory_order_release);
+            shmplc::futexWakeAll(f->tickRequest);
+        }
+    }
+
+    // ========== ISystemDriver ==========
+
+    CommunicationResult send(const SystemCommand& cmd) override {
+        ++m_stats.sends;
+        if (!isConnected()) {
+            return CommunicationResult{
+                CommunicationResult::Status::Disconnected, 0, "PLC simulator not running"};
+        }
+        shmplc::RegisterFile* f = m_segment.file();
+        const uint32_t head = f->cmdHead.load(std::memory_order_relaxed);
+        if (head - f->cmdTail.load(std::memory_order_acquire) >= shmplc::COMMAND_SLOTS) {
+            ++m_stats.ringFull;
+            return CommunicationResult{
+                CommunicationResult::Status::Busy, 0x06, "PLC simulator command ring full"};
+        }
+        std::memcpy(static_cast<void*>(&f->commands[head % shmplc::COMMAND_SLOTS]), &cmd, sizeof(cmd));
+        f->cmdHead.store(head + 1, std::memory_order_release);
+        return CommunicationResult{};
+    }
+
+    void pollFeedback(SystemContext& ctx) override {
+        ++m_stats.polls;
+        m_dispatched = false;
+
+        if (!isConnected() && !tryReconnect()) {
+            LOG_WARN_EVERY_MS(5000, LogLayer::HAL, "ShmPlc",
+                "pollFeedback skipped: simulator " + m_segmentName + " offline, keeping last known feedback");
+            return;
+        }
+        shmplc::RegisterFile* f = m_segment.file();
+
+        if (m_mode == shmplc::Mode::Lockstep) {
+            const uint32_t ticket = f->tickRequest.fetch_add(1, std::memory_order_acq_rel) + 1;
+            shmplc::futexWakeAll(f->tickRequest);
+            if (!awaitTick(*f, ticket)) {
+                ++m_stats.tickTimeouts;
+                LOG_WARN_EVERY_MS(5000, LogLayer::HAL, "ShmPlc",
+                    "simulator " + m_segmentName + " did not answer the tick request in time");
+                dropIfServerGone(*f);
+                return;
+            }
+        }
+
+        if (!readFeedback(*f)) {
+            if (m_mode == shmplc::Mode::FreeRunning && ++m_stalePolls >= LIVENESS_CHECK_STALE_POLLS) {
+                m_stalePolls = 0;
+                dropIfServerGone(*f);
+            }
+            return;
+        }
+        m_stalePolls = 0;
+        m_frame.dispatchTo(ctx);
+        m_dispatched = true;
+        ++m_stats.framesDispatched;
+    }
+
+    [[nodiscard]] const FeedbackFrame* lastFeedbackFrame() const override {
+        return m_dispatched ? &m_frame : nullptr;
+    }
+
+    [[nodiscard]] const Stats& stats() const { return m_stats; }
+    [[nodiscard]] shmplc::Mode mode() const { return m_mode; }
+
+private:
+    std::string m_segmentName;
+    std::chrono::milliseconds m_tickTimeout;
+    shmplc::Segment m_segment;
+    shmplc::Mode m_mode = shmplc::Mode::Lockstep;
+    uint32_t m_lastSeq = 0;
+    int m_reconnectCountdown = 0;
+    int m_stalePolls = 0;
+
+    FeedbackFrame m_frame;
+    bool m_dispatched = false;
+    Stats m_stats;
+
+    bool tryReconnect() {
+        if (m_reconnectCountdown-- > 0) return false;
+        m_reconnectCountdown = RECONNECT_EVERY_POLLS;
+        if (!connect()) return false;
+        ++m_stats.reconnects;
+        return true;
+    }
+
+    /// @brief 服务端进程是否仍存在（EPERM 表示存在但属于其他用户）
+    static bool serverAlive(const shmplc::RegisterFile& f) {
+        if (f.serverPid <= 0) return true;
+        return ::kill(f.serverPid, 0) == 0 || errno == EPERM;
+    }
+
+    /// @brief 服务端进程已不存在时解除映射转为断开（之后由 tryReconnect 重新挂接）
+    void dropIfServerGone(const shmplc::RegisterFile& f) {
+        if (serverAlive(f)) return;
+        ++m_stats.serverLost;
+        LOG_ERROR(LogLayer::HAL, "ShmPlc", "simulator " + m_segmentName + " (pid "
+            + std::to_string(f.serverPid) + ") is gone without going offline -- disconnecting");
+        m_segment.close();
+        m_reconnectCountdown = 0;
+    }
+
+    /// @brief 等待 tickDone 追上 ticket（32 位回绕安全）；服务端下线时提前返回 false
+    bool awaitTick(shmplc::RegisterFile& f, uint32_t ticket) {
+        const auto deadline = std::chrono::steady_clock::now() + m_tickTimeout;
+        for (;;) {
+            const uint32_t done = f.tickDone.load(std::memory_order_acquire);
+            if (static_cast<int32_t>(done - ticket) >= 0) return true;
+            if (f.online.load(std::memory_order_acquire) == 0) return false;
+            const auto left = deadline - std::chrono::steady_clock::now();
+            if (left <= std::chrono::nanoseconds::zero()) return false;
+            shmplc::waitForChange(f.tickDone, done, left);
+        }
+    }
+
+    /**
+     * @brief seqlock 读；FreeRunning 下没有新周期时返回 false
+     *
+     * 写端在写入中途时在 feedbackSeq 上休眠等待发布；服务端下线或超过 FEEDBACK_READ_TIMEOUT
+     * 返回 false，m_frame 不完整但不会被分派（lastFeedbackFrame() 为 nullptr）。
+     */
+    bool readFeedback(shmplc::RegisterFile& f) {
+        const shmplc::FeedbackBlock& b = f.feedback;
+        const auto deadline = std::chrono::steady_clock::now() + FEEDBACK_READ_TIMEOUT;
+        for (;;) {
+            const uint32_t s1 = f.feedbackSeq.load(std::memory_order_acquire);
+            if (s1 & 1u) {
+                if (!mayRetryRead(f, deadline)) return false;
+                shmplc::waitForChange(f.feedbackSeq, s1, deadline - std::chrono::steady_clock::now());
+                continue;
+            }
+            if (m_mode == shmplc::Mode::FreeRunning && s1 == m_lastSeq) return false;
+
+            m_frame.generation = b.generation;
+            m_frame.gantry = b.gantry;
+            m_frame.emergencyStopped = b.emergencyStopped != 0;
+            const uint32_t count = std::min(b.axisCount, shmplc::MAX_AXES);
+            m_frame.axes.resize(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                m_frame.axes[i] = {static_cast<AxisId>(b.axes[i].id), b.axes[i].feedback};
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (f.feedbackSeq.load(std::memory_order_relaxed) == s1) {
+                m_lastSeq = s1;
+                return true;
+            }
+            if (!mayRetryRead(f, deadline)) return false;
+        }
+    }
+
+    /// @brief 是否还值得重读：服务端在线且未超过本次读的期限；超时计数并限频告警
+    bool mayRetryRead(const shmplc::RegisterFile& f, std::chrono::steady_clock::time_point deadline) {
+        if (f.online.load(std::memory_order_acquire) == 0) return false;
+        if (std::chrono::steady_clock::now() < deadline) return true;
+        ++m_stats.readTimeouts;
+        LOG_WARN_EVERY_MS(5000, LogLayer::HAL, "ShmPlc",
+            "simulator " + m_segmentName + " left the feedback block mid-write, keeping last known feedback");
+        return false;
+    }
+};
+
+#endif // SERVOV6_HAS_SHM_PLC
+
+#endif // SHM_PLC_DRIVER_H
@@ -0,0 +1,169 @@
+#ifndef SHM_PLC_SERVER_H
+#define SHM_PLC_SERVER_H
+
+#include "infrastructure/FakePLC.h"
+#include "infrastructure/ShmRegisterFile.h"
+#include "infrastructure/logger/Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#if SERVOV6_HAS_SHM_PLC
+
+/**
+ * @brief 进程外仿真器的服务端 -- 把一个 FakePLC 挂到共享内存寄存器文件上
+ *
+ * 每个扫描周期：按序消费命令环 -> FakePLC::tick(cycleMs) -> 以 seqlock 发布反馈块。
+ *
+ *   - Lockstep:    等待驱动的 tickRequest，每个请求推进一个周期，完成后写 tickDone 并唤醒驱动
+ *   - FreeRunning: 按绝对时间每 cycleMs 推进一个周期（落后时不追赶，直接对齐到下一个周期）
+ *
+ * servoV6_plcsim 为每个分组创建一个 ShmPlcServer 并各用一个线程运行；
+ * 测试中可直接在线程里运行，或 fork 出子进程运行以获得真实的进程边界。
+ *
+ * 使用示例：
+ *   ShmPlcServer server(shmplc::segmentName("Machine_A"), FakePLCConfig::standard());
+ *   if (server.start()) server.run(stopFlag);
+ */
+class ShmPlcServer {
+public:
+    ShmPlcServer(std::string segment, const FakePLCConfig& cfg,
+                 shmplc::Mode mode = shmplc::Mode::Lockstep, int cycleMs = 10)
+        : m_segmentName(std::move(segment)), m_plc(cfg), m_mode(mode), m_cycleMs(cycleMs) {}
+
+    ~ShmPlcServer() { stop(); }
+
+    ShmPlcServer(const ShmPlcServer&) = delete;
+    ShmPlcServer& operator=(const ShmPlcServer&) = delete;
+
+    /// @brief 创建共享内存段、发布初始反馈并上线；失败时记录日志并返回 false
+    bool start() {
+        if (!m_segment.create(m_segmentName, m_mode, m_cycleMs)) {
+            LOG_ERROR(LogLayer::HAL, "PlcSim", "cannot create shared memory segment " + m_segmentName);
+            return false;
+        }
+        publish();
+        m_segment.file()->online.store(1, std::memory_order_release);
+        shmplc::futexWakeAll(m_segment.file()->online);
+        LOG_INFO(LogLayer::HAL, "PlcSim", "serving " + m_segmentName
+            + " axes=" + std::to_string(m_plc.axisCount())
+            + " mode=" + (m_mode == shmplc::Mode::Lockstep ? "lockstep" : "free-running"));
+        return true;
+    }
+
+    /// @brief 下线：清除 online 并唤醒所有等待中的驱动，删除段名
+    void stop() {
+        if (!m_segment.isOpen()) return;
+        shmplc::RegisterFile* f = m_segment.file();
+        f->online.store(0, std::memory_order_release);
+        shmplc::futexWakeAll(f->online);
+        shmplc::futexWakeAll(f->tickDone);
+        shmplc::futexWakeAll(f->feedbackSeq);
+        m_segment.close();
+    }
+
+    /// @brief 服务直到 stopFlag 置位或客户端请求退出
+    void run(const std::atomic<bool>& stopFlag) {
+        if (!m_segment.isOpen()) return;
+        auto next = std::chrono::steady_clock::now();
+        while (!stopFlag.load(std::memory_order_relaxed) && !shutdownRequested()) {
+            if (m_mode == shmplc::Mode::Lockstep) {
+                serveOnce(std::chrono::milliseconds(100));
+            } else {
+                next += std::chrono::milliseconds(m_cycleMs);
+                cycle(1);
+                const auto now = std::chrono::steady_clock::now();
+                if (next < now) next = now;   // 落后时不追赶
+                std::this_thread::sleep_until(next);
+            }
+        }
+    }
+
+    /**
+     * @brief Lockstep：等待一个节拍请求并完成对应周期
+     * @return 是否处理了请求（超时返回 false）
+     */
+    bool serveOnce(std::chrono::nanoseconds wait) {
+        shmplc::RegisterFile* f = m_segment.file();
+        if (!f) return false;
+        const uint32_t requested = f->tickRequest.load(std::memory_order_acquire);
+        if (requested == m_served) {
+            if (!shmplc::waitForChange(f->tickRequest, m_served, wait)) return false;
+        }
+        const uint32_t target = f->tickRequest.load(std::memory_order_acquire);
+        cycle(target - m_served);
+        m_served = target;
+        f->tickDone.store(target, std::memory_order_release);
+        shmplc::futexWakeAll(f->tickDone);
+        return true;
+    }
+
+    [[nodiscard]] bool shutdownRequested() const {
+        const shmplc::RegisterFile* f = m_segment.file();
+        return f && f->shutdownRequest.load(std::memory_order_acquire) != 0;
+    }
+
+    [[nodiscard]] FakePLC& plc() { return m_plc; }
+    [[nodiscard]] uint64_t cycles() const { return m_generation; }
+    [[nodiscard]] uint64_t commandsApplied() const { return m_commandsApplied; }
+
+private:
+    std::string m_segmentName;
+    FakePLC m_plc;
+    shmplc::Mode m_mode;
+    int m_cycleMs;
+    shmplc::Segment m_segment;
+    uint32_t m_served = 0;
+    uint64_t m_generation = 0;
+    uint64_t m_commandsApplied = 0;
+
+    /// @brief n 个扫描周期：消费命令环 -> 推进物理 -> 发布反馈
+    void cycle(uint32_t n) {
+        drainCommands();
+        m_plc.tick(static_cast<double>(m_cycleMs) * n);
+        m_generation += n;
+        publish();
+    }
+
+    void drainCommands() {
+        shmplc::RegisterFile* f = m_segment.file();
+        uint32_t tail = f->cmdTail.load(std::memory_order_relaxed);
+        const uint32_t head = f->cmdHead.load(std::memory_order_acquire);
+        while (tail != head) {
+            SystemCommand cmd;
+            std::memcpy(static_cast<void*>(&cmd), &f->commands[tail % shmplc::COMMAND_SLOTS], sizeof(cmd));
+            m_plc.onSystemCommand(cmd);
+            ++tail;
+            ++m_commandsApplied;
+        }
+        f->cmdTail.store(tail, std::memory_order_release);
+    }
+
+    /// @brief seqlock 写：序号置奇 -> 写反馈块 -> 序号置偶 -> 唤醒
+    void publish() {
+        shmplc::RegisterFile* f = m_segment.file();
+        shmplc::FeedbackBlock& b = f->feedback;
+        f->feedbackSeq.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        b.generation = m_generation;
+        b.gantry = m_plc.getGantryFeedback();
+        b.emergencyStopped = m_plc.getEmergencyStopFeedback() ? 1 : 0;
+        const auto& ids = m_plc.axisIds();
+        const auto count = static_cast<uint32_t>(std::min<size_t>(ids.size(), shmplc::MAX_AXES));
+        b.axisCount = count;
+        for (uint32_t i = 0; i < count; ++i) {
+            b.axes[i].id = static_cast<int32_t>(ids[i]);
+            b.axes[i].feedback = m_plc.getFeedback(ids[i]);
+        }
+
+        f->feedbackSeq.fetch_add(1, std::memory_order_release);
+        shmplc::futexWakeAll(f->feedbackSeq);
+    }
+};
+
+#endif // SERVOV6_HAS_SHM_PLC
+
+#endif // SHM_PLC_SERVER_H
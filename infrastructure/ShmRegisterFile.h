@@ -0,0 +1,253 @@
+#ifndef SHM_REGISTER_FILE_H
+#define SHM_REGISTER_FILE_H
+
+#include "domain/command/SystemCommand.h"
+#include "domain/entity/Axis.h"
+#include "domain/gantry/GantryFeedback.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#if defined(__linux__)
+#define SERVOV6_HAS_SHM_PLC 1
+#include <cerrno>
+#include <ctime>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#define SERVOV6_HAS_SHM_PLC 0
+#endif
+
+// ============================================================================
+// 进程外 PLC 仿真器的共享内存寄存器文件（Linux）
+//
+// ╔═════════════════════════════╗            ╔══════════════════════════════╗
+// ║  servoV6 / 测试进程          ║            ║  servoV6_plcsim 进程          ║
+// ║   ShmPlcDriver              ║            ║   ShmPlcServer -> FakePLC    ║
+// ║     send() ──► 命令环 ──────╫──► /dev/shm ╫──► 扫描前按序写入 PLC          ║
+// ║     pollFeedback() ◄─ 反馈块 ╫◄── seqlock ◄╫── 扫描后整块发布               ║
+// ╚═════════════════════════════╝            ╚══════════════════════════════╝
+//
+// 一个分组一个段（segmentName(group)），段内:
+//   - 描述区: 魔数 / 版本 / 布局指纹 / 运行模式 / 周期，服务端创建时写入
+//   - 命令环: 单生产者（驱动）单消费者（服务端）环形队列，元素为 SystemCommand 原始字节
+//   - 节拍握手: tickRequest / tickDone（Lockstep 模式下驱动每次 poll 请求一个扫描周期）
+//   - 反馈块: 服务端以 seqlock 整块发布，驱动无锁读取一致快照
+//
+// 唤醒使用 futex（共享映射上的非 private futex，可跨进程）；等待方先短暂自旋再休眠，
+// 同机往返延迟为微秒级，不经过网络协议栈。
+// 命令与反馈按结构体原始字节存放，两端必须来自同一构建（描述区保存布局指纹）。
+// ============================================================================
+
+namespace shmplc {
+
+constexpr char MAGIC[8] = {'S', 'V', '6', 'S', 'H', 'M', '0', '1'};
+constexpr uint32_t VERSION = 1;
+constexpr uint32_t MAX_AXES = 256;
+constexpr uint32_t COMMAND_SLOTS = 256;   ///< 2 的幂
+
+static_assert((COMMAND_SLOTS & (COMMAND_SLOTS - 1)) == 0, "COMMAND_SLOTS 必须是 2 的幂");
+static_assert(std::is_trivially_copyable_v<SystemCommand>, "SystemCommand 按原始字节跨进程传递");
+static_assert(std::is_trivially_copyable_v<AxisFeedback>, "AxisFeedback 按原始字节跨进程传递");
+static_assert(std::atomic<uint32_t>::is_always_lock_free && sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "futex 字必须是无锁的 32 位原子量");
+
+/**
+ * @brief 服务端推进方式
+ *
+ * Lockstep:    驱动每次 pollFeedback 请求一个扫描周期并等待结果，
+ *              行为与进程内 FakeAxisDriver 逐周期一致（测试 / 负载对照）
+ * FreeRunning: 服务端按自己的实时周期扫描（与真实 PLC 一致），
+ *              驱动只读取最新快照，不会阻塞主循环
+ */
+enum class Mode : uint32_t { Lockstep = 0, FreeRunning = 1 };
+
+struct AxisSlot {
+    int32_t id;
+    uint32_t reserved;
+    AxisFeedback feedback;
+};
+
+struct FeedbackBlock {
+    uint64_t generation;      ///< 服务端扫描周期计数
+    GantryFeedback gantry;
+    uint8_t emergencyStopped;
+    uint32_t axisCount;
+    AxisSlot axes[MAX_AXES];
+};
+
+struct RegisterFile {
+    // ── 描述区（服务端创建时写入，之后只读） ──
+    char magic[8];
+    uint32_t version;
+    uint16_t commandSize;
+    uint16_t axisFeedbackSize;
+    uint16_t gantryFeedbackSize;
+    uint16_t reserved0;
+    uint32_t mode;
+    uint32_t cycleMs;
+    int32_t serverPid;
+
+    /// @brief 服务端在线标志（1 = 在线；服务端退出前清零并唤醒所有等待者）
+    std::atomic<uint32_t> online;
+    /// @brief 客户端请求服务端退出（测试 / 工具使用）
+    std::atomic<uint32_t> shutdownRequest;
+
+    // ── 命令环（生产者与消费者的下标各占一条缓存行） ──
+    alignas(64) std::atomic<uint32_t> cmdHead;
+    alignas(64) std::atomic<uint32_t> cmdTail;
+
+    // ── 节拍握手 ──
+    alignas(64) std::atomic<uint32_t> tickRequest;
+    alignas(64) std::atomic<uint32_t> tickDone;
+
+    // ── 反馈 seqlock（奇数 = 写入中） ──
+    alignas(64) std::atomic<uint32_t> feedbackSeq;
+
+    alignas(64) SystemCommand commands[COMMAND_SLOTS];
+    FeedbackBlock feedback;
+
+    /// @brief 描述区与当前构建的布局是否一致
+    [[nodiscard]] bool compatible() const {
+        return std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0
+            && version == VERSION
+            && commandSize == sizeof(SystemCommand)
+            && axisFeedbackSize == sizeof(AxisFeedback)
+            && gantryFeedbackSize == sizeof(GantryFeedback);
+    }
+};
+
+/// @brief 分组对应的共享内存段名（/dev/shm/servoV6.<group>）
+inline std::string segmentName(const std::string& group) { return "/servoV6." + group; }
+
+#if SERVOV6_HAS_SHM_PLC
+
+// ========== futex ==========
+
+inline uint32_t* futexWord(std::atomic<uint32_t>& a) { return reinterpret_cast<uint32_t*>(&a); }
+
+inline void futexWakeAll(std::atomic<uint32_t>& word) {
+    syscall(SYS_futex, futexWord(word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+}
+
+/**
+ * @brief 先自旋再 futex 休眠，直到 word != seen 或超时；返回是否等到变化
+ *
+ * 单核机器上对端必须先被调度才能改写 word，自旋只会占满时间片，因此直接休眠。
+ */
+inline bool waitForChange(std::atomic<uint32_t>& word, uint32_t seen, std::chrono::nanoseconds timeout) {
+    constexpr int SPIN_ITERATIONS = 2000;
+    static const int spins = std::thread::hardware_concurrency() > 1 ? SPIN_ITERATIONS : 0;
+    for (int i = 0; i < spins; ++i) {
+        if (word.load(std::memory_order_acquire) != seen) return true;
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (word.load(std::memory_order_acquire) == seen) {
+        const auto left = deadline - std::chrono::steady_clock::now();
+        if (left <= std::chrono::nanoseconds::zero()) return false;
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(left).count();
+        timespec ts{static_cast<time_t>(ns / 1'000'000'000), static_cast<long>(ns % 1'000'000'000)};
+        syscall(SYS_futex, futexWord(word), FUTEX_WAIT, seen, &ts, nullptr, 0);
+    }
+    return true;
+}
+
+// ========== 映射 ==========
+
+/**
+ * @brief 共享内存段的 RAII 映射
+ *
+ * create() 由服务端调用（创建 / 覆盖并初始化描述区），open() 由驱动调用（只映射已存在的段）。
+ */
+class Segment {
+public:
+    Segment() = default;
+    ~Segment() { close(); }
+
+    Segment(const Segment&) = delete;
+    Segment& operator=(const Segment&) = delete;
+
+    bool create(const std::string& name, Mode mode, int cycleMs) {
+        close();
+        const int fd = ::shm_open(name.c_str(), O_CREAT | O_RDWR, 0600);
+        if (fd < 0) return false;
+        if (::ftruncate(fd, static_cast<off_t>(sizeof(RegisterFile))) != 0 || !mapFd(fd)) {
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            return false;
+        }
+        ::close(fd);
+        m_name = name;
+        m_owner = true;
+
+        std::memset(static_cast<void*>(m_file), 0, sizeof(RegisterFile));
+        RegisterFile* f = new (m_file) RegisterFile{};
+        std::memcpy(f->magic, MAGIC, sizeof(MAGIC));
+        f->version = VERSION;
+        f->commandSize = sizeof(SystemCommand);
+        f->axisFeedbackSize = sizeof(AxisFeedback);
+        f->gantryFeedbackSize = sizeof(GantryFeedback);
+        f->mode = static_cast<uint32_t>(mode);
+        f->cycleMs = static_cast<uint32_t>(cycleMs);
+        f->serverPid = static_cast<int32_t>(::getpid());
+        return true;
+    }
+
+    bool open(const std::string& name) {
+        close();
+        const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0) return false;
+        struct stat st {};
+        const bool ok = ::fstat(fd, &st) == 0
+                     && static_cast<size_t>(st.st_size) >= sizeof(RegisterFile)
+                     && mapFd(fd);
+        ::close(fd);
+        if (!ok) return false;
+        m_name = name;
+        m_owner = false;
+        return true;
+    }
+
+    /// @brief 解除映射；服务端同时删除段名（已映射的客户端仍可读到 online == 0）
+    void close() {
+        if (!m_file) return;
+        ::munmap(m_file, sizeof(RegisterFile));
+        if (m_owner) ::shm_unlink(m_name.c_str());
+        m_file = nullptr;
+        m_owner = false;
+    }
+
+    [[nodiscard]] RegisterFile* file() const { return m_file; }
+    [[nodiscard]] bool isOpen() const { return m_file != nullptr; }
+
+private:
+    RegisterFile* m_file = nullptr;
+    std::string m_name;
+    bool m_owner = false;
+
+    bool mapFd(int fd) {
+        void* p = ::mmap(nullptr, sizeof(RegisterFile), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) return false;
+        m_file = static_cast<RegisterFile*>(p);
+        return true;
+    }
+};
+
+#endif // SERVOV6_HAS_SHM_PLC
+
+} // namespace shmplc
+
+#endif // SHM_REGISTER_FILE_H
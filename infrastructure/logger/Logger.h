@@ -31,11 +31,12 @@ struct LogEntry {
 };
 
 // ─── 节流辅助：每 N 次调用输出 1 条 ───
+// 计数器为原子量：宏内的 static 实例会被并行轮询的多个分组线程共享
 struct Throttle {
-    uint64_t counter = 0;
+    std::atomic<uint64_t> counter{0};
     uint64_t interval;
     explicit Throttle(uint64_t n) : interval(n) {}
-    bool should() { return ++counter % interval == 0; }
+    bool should() { return (counter.fetch_add(1, std::memory_order_relaxed) + 1) % interval == 0; }
 };
 
 class Logger {
@@ -198,18 +199,20 @@ private:
     } while(0)
 
 // ─── 时间节流辅助：每 intervalMs 毫秒最多输出 1 条 ───
+// 多线程下由 CAS 保证同一时间窗口内只有一个调用方胜出
 struct TimeThrottle {
-    std::chrono::steady_clock::time_point last = std::chrono::steady_clock::now();
+    std::atomic<int64_t> lastMs{nowMs()};
     uint64_t intervalMs;
     explicit TimeThrottle(uint64_t ms) : intervalMs(ms) {}
     bool should() {
-        auto now = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - last).count();
-        if (static_cast<uint64_t>(elapsed) >= intervalMs) {
-            last = now;
-            return true;
-        }
-        return false;
+        int64_t now = nowMs();
+        int64_t last = lastMs.load(std::memory_order_relaxed);
+        if (now < last || static_cast<uint64_t>(now - last) < intervalMs) return false;
+        return lastMs.compare_exchange_strong(last, now, std::memory_order_relaxed);
+    }
+    static int64_t nowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
     }
 };
 
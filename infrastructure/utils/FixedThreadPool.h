@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// FixedThreadPool -- 固定线程数的 fork-join 线程池
+//
+// 只提供一种调度原语: parallelFor(count, fn)
+//   - fn(i) 对 i ∈ [0, count) 各执行一次
+//   - 调用线程本身也参与执行，全部完成后才返回（天然的 join 屏障）
+//   - 任务分发通过原子计数器领取下标，每批次无堆分配
+//
+// workerCount == 0 时退化为调用线程上的顺序执行。
+// parallelFor 不可重入，也不应从多个线程并发调用。
+// ============================================================================
+class FixedThreadPool {
+public:
+    explicit FixedThreadPool(size_t workerCount) {
+        m_workers.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; ++i) {
+            m_workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ~FixedThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wakeCv.notify_all();
+        for (auto& t : m_workers) {
+            if (t.joinable()) t.join();
+        }
+    }
+
+    FixedThreadPool(const FixedThreadPool&) = delete;
+    FixedThreadPool& operator=(const FixedThreadPool&) = delete;
+
+    [[nodiscard]] size_t workerCount() const { return m_workers.size(); }
+
+    void parallelFor(size_t count, const std::function<void(size_t)>& fn) {
+        if (count == 0) return;
+        if (m_workers.empty() || count == 1) {
+            for (size_t i = 0; i < count; ++i) fn(i);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_job = &fn;
+            m_count = count;
+            m_next.store(0, std::memory_order_relaxed);
+            m_done = 0;
+            ++m_generation;
+        }
+        m_wakeCv.notify_all();
+
+        size_t localDone = drain(fn, count);
+
+        // 等待全部下标完成，且所有参与本批次的工作线程都已退出 drain，
+        // 保证下一批次开始时不存在持有旧任务引用的线程
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done += localDone;
+        m_doneCv.wait(lock, [this] { return m_done == m_count && m_active == 0; });
+        m_job = nullptr;
+    }
+
+private:
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeCv;
+    std::condition_variable m_doneCv;
+
+    const std::function<void(size_t)>* m_job = nullptr;
+    size_t m_count = 0;
+    size_t m_done = 0;
+    size_t m_active = 0;
+    uint64_t m_generation = 0;
+    bool m_stopping = false;
+    std::atomic<size_t> m_next{0};
+
+    /// 领取并执行下标，直到本批次耗尽；返回本线程完成的数量
+    size_t drain(const std::function<void(size_t)>& fn, size_t count) {
+        size_t executed = 0;
+        while (true) {
+            size_t i = m_next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= count) break;
+            fn(i);
+            ++executed;
+        }
+        return executed;
+    }
+
+    void workerLoop() {
+        uint64_t seen = 0;
+        while (true) {
+            const std::function<void(size_t)>* job = nullptr;
+            size_t count = 0;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wakeCv.wait(lock, [&] { return m_stopping || (m_generation != seen && m_job); });
+                if (m_stopping) return;
+                seen = m_generation;
+                job = m_job;
+                count = m_count;
+                ++m_active;
+            }
+
+            size_t executed = drain(*job, count);
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_done += executed;
+                --m_active;
+                if (m_done == m_count && m_active == 0) m_doneCv.notify_one();
+            }
+        }
+    }
+};
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// ============================================================================
+// LatencyHistogram -- HDR 风格的对数-线性直方图（固定内存，无运行期分配）
+//
+// 桶布局（SUB_BITS = 5，每个 2 的幂区间再线性划分 32 个子桶）:
+//   [0, 32)             -> 每个值一个桶（精确）
+//   [2^e, 2^(e+1))      -> 32 个子桶，每个宽度 2^(e-5)
+// 相对误差上界 1/32 ≈ 3%，覆盖 0 ~ 2^MAX_EXP 纳秒（约 68 秒），超出部分钳位到最后一个桶。
+//
+// record() 是 O(1) 的位运算 + 一次数组自增，可以放在 10ms 主循环的热路径上。
+// ============================================================================
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BITS = 5;
+    static constexpr uint64_t SUB_COUNT = uint64_t{1} << SUB_BITS;
+    static constexpr int MAX_EXP = 36;
+    static constexpr size_t BUCKET_COUNT = static_cast<size_t>(MAX_EXP - SUB_BITS + 2) * SUB_COUNT;
+
+    void record(uint64_t valueNs) {
+        ++m_counts[bucketIndex(valueNs)];
+        ++m_total;
+        m_max = std::max(m_max, valueNs);
+    }
+
+    void clear() {
+        m_counts.fill(0);
+        m_total = 0;
+        m_max = 0;
+    }
+
+    [[nodiscard]] uint64_t count() const { return m_total; }
+    [[nodiscard]] uint64_t max() const { return m_max; }
+    [[nodiscard]] uint32_t bucketCount(size_t idx) const { return m_counts[idx]; }
+
+    /// @brief 分位数（0.0 ~ 1.0），返回所在桶的上界（保守估计）；空直方图返回 0
+    [[nodiscard]] uint64_t percentile(double q) const {
+        return percentileOf([this](size_t i) { return m_counts[i]; }, m_total, m_max, q);
+    }
+
+    // ==================== 桶映射 ====================
+
+    static constexpr size_t bucketIndex(uint64_t v) {
+        if (v < SUB_COUNT) return static_cast<size_t>(v);
+        int e = static_cast<int>(std::bit_width(v)) - 1;
+        if (e > MAX_EXP) return BUCKET_COUNT - 1;
+        int shift = e - SUB_BITS;
+        return static_cast<size_t>(shift + 1) * SUB_COUNT + ((v >> shift) - SUB_COUNT);
+    }
+
+    /// @brief 桶内最大可表示值
+    static constexpr uint64_t bucketUpperBound(size_t idx) {
+        uint64_t group = idx / SUB_COUNT;
+        uint64_t offset = idx % SUB_COUNT;
+        if (group == 0) return offset;
+        int shift = static_cast<int>(group) - 1;
+        return ((SUB_COUNT + offset + 1) << shift) - 1;
+    }
+
+    /// @brief 通用分位数计算（供多切片合并时复用，避免拷贝桶数组）
+    template<typename CountAt>
+    static uint64_t percentileOf(CountAt countAt, uint64_t total, uint64_t maxValue, double q) {
+        if (total == 0) return 0;
+        q = std::clamp(q, 0.0, 1.0);
+        uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += countAt(i);
+            if (seen >= rank) return std::min(bucketUpperBound(i), maxValue);
+        }
+        return maxValue;
+    }
+
+private:
+    std::array<uint32_t, BUCKET_COUNT> m_counts{};
+    uint64_t m_total = 0;
+    uint64_t m_max = 0;
+};
+
+/// @brief 滑动窗口内的延迟摘要（单位: 微秒，便于 UI 直接展示）
+struct LatencySummary {
+    uint64_t count = 0;
+    double p50Us = 0.0;
+    double p99Us = 0.0;
+    double maxUs = 0.0;
+};
+
+// ============================================================================
+// SlidingLatencyHistogram -- 按时间切片轮转的滑动窗口直方图
+//
+// 窗口 = sliceCount × sliceDuration。记录落入"当前切片"；时间前进到新切片时，
+// 过期切片被清空复用。summary() 合并窗口内全部切片，不做任何堆分配。
+// ============================================================================
+class SlidingLatencyHistogram {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr size_t MAX_SLICES = 64;
+
+    explicit SlidingLatencyHistogram(size_t sliceCount = 10,
+                                     std::chrono::milliseconds sliceDuration = std::chrono::milliseconds{1000},
+                                     Clock::time_point origin = Clock::time_point{})
+        : m_slices(std::clamp<size_t>(sliceCount, 1, MAX_SLICES))
+        , m_sliceEpoch(m_slices.size(), -1)
+        , m_sliceDuration(std::max(sliceDuration, std::chrono::milliseconds{1}))
+        , m_origin(origin)
+    {}
+
+    void record(uint64_t valueNs, Clock::time_point now) {
+        int64_t epoch = epochOf(now);
+        size_t slot = static_cast<size_t>(epoch % static_cast<int64_t>(m_slices.size()));
+        if (m_sliceEpoch[slot] != epoch) {
+            m_slices[slot].clear();
+            m_sliceEpoch[slot] = epoch;
+        }
+        m_slices[slot].record(valueNs);
+    }
+
+    [[nodiscard]] LatencySummary summary(Clock::time_point now) const {
+        int64_t epoch = epochOf(now);
+        int64_t oldest = epoch - static_cast<int64_t>(m_slices.size()) + 1;
+
+        uint64_t total = 0, maxNs = 0;
+        bool live[MAX_SLICES] = {};
+        const size_t n = m_slices.size();
+        for (size_t s = 0; s < n; ++s) {
+            live[s] = m_sliceEpoch[s] >= oldest && m_sliceEpoch[s] <= epoch;
+            if (!live[s]) continue;
+            total += m_slices[s].count();
+            maxNs = std::max(maxNs, m_slices[s].max());
+        }
+
+        auto countAt = [&](size_t i) {
+            uint64_t c = 0;
+            for (size_t s = 0; s < n; ++s) {
+                if (live[s]) c += m_slices[s].bucketCount(i);
+            }
+            return c;
+        };
+
+        LatencySummary out;
+        out.count = total;
+        if (total == 0) return out;
+        out.p50Us = static_cast<double>(LatencyHistogram::percentileOf(countAt, total, maxNs, 0.50)) / 1000.0;
+        out.p99Us = static_cast<double>(LatencyHistogram::percentileOf(countAt, total, maxNs, 0.99)) / 1000.0;
+        out.maxUs = static_cast<double>(maxNs) / 1000.0;
+        return out;
+    }
+
+private:
+    std::vector<LatencyHistogram> m_slices;
+    std::vector<int64_t> m_sliceEpoch;
+    std::chrono::milliseconds m_sliceDuration;
+    Clock::time_point m_origin;
+
+    int64_t epochOf(Clock::time_point now) const {
+        auto d = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_origin);
+        if (d.count() < 0) return 0;
+        return d.count() / m_sliceDuration.count();
+    }
+};
@@ -8,10 +8,15 @@
 #include <vector>
 
 #include "application/SystemManager.h"
+#include "application/GroupPollScheduler.h"
+#include "application/TickScheduler.h"
 #include "domain/entity/AxisId.h"
 #include "domain/entity/ContextRejection.h"
 #include "infrastructure/FakePLC.h"
-#include "infrastructure/FakeAxisDriver.h"
+#include "infrastructure/SharedPlcTransport.h"
+#include "infrastructure/ShmPlcDriver.h"
+#include "infrastructure/RetryingDriver.h"
+#include "infrastructure/InstrumentedDriver.h"
 #include "presentation/viewmodel/AxisViewModelCore.h"
 #include "presentation/viewmodel/QtAxisViewModel.h"
 #include "presentation/viewmodel/EmergencyStopViewModel.h"
@@ -71,10 +76,35 @@ int main(int argc, char *argv[])
     QQuickStyle::setStyle("Basic");
 
     // ============================
-    // 1. 硬件仿真层（每个分组独立的 FakePLC + FakeAxisDriver）
+    // 1. 硬件仿真层（两个分组位于同一台 PLC、同一条连接之后，各占一段寄存器窗口）
     // ============================
     FakePLC plcA, plcB;
-    FakeAxisDriver driverA(plcA), driverB(plcB);
+    SharedPlcTransport plcLink;
+    SharedPlcDriver sharedA(plcLink, plcLink.addWindow(plcA));
+    SharedPlcDriver sharedB(plcLink, plcLink.addWindow(plcB));
+    ISystemDriver* linkA = &sharedA;
+    ISystemDriver* linkB = &sharedB;
+
+#if SERVOV6_HAS_SHM_PLC
+    // SERVOV6_PLCSIM=1：改连进程外仿真器 servoV6_plcsim（共享内存），进程内 plcA / plcB 不再参与
+    std::unique_ptr<ShmPlcDriver> simA, simB;
+    if (qEnvironmentVariableIntValue("SERVOV6_PLCSIM") != 0) {
+        simA = std::make_unique<ShmPlcDriver>(shmplc::segmentName("Machine_A"));
+        simB = std::make_unique<ShmPlcDriver>(shmplc::segmentName("Machine_B"));
+        if (!simA->connect() || !simB->connect()) {
+            LOG_WARN(LogLayer::APP, "System", "servoV6_plcsim not running yet, drivers will keep retrying");
+        }
+        linkA = simA.get();
+        linkB = simB.get();
+    }
+#endif
+
+    // 通讯重试装饰器：Timeout / Busy 排队到后续帧的 pollFeedback 中重发（不阻塞主循环），停止/急停使用更宽的预算；
+    // 排队命令最终失败时由同一轴的下一次常规发送返回给用例
+    RetryingDriver retryA(*linkA), retryB(*linkB);
+
+    // 延迟度量装饰器（最外层）：度量主循环实际感受到的 send / pollFeedback 耗时（含重试）
+    InstrumentedDriver metricsA(retryA), metricsB(retryB);
 
     // ============================
     // 2. 系统分组管理
@@ -89,8 +119,8 @@ int main(int argc, char *argv[])
     SystemContext* ctxB = nullptr;
     manager.tryGetGroup("Machine_A", ctxA, reason);
     manager.tryGetGroup("Machine_B", ctxB, reason);
-    ctxA->setDriver(&driverA);
-    ctxB->setDriver(&driverB);
+    ctxA->setDriver(&metricsA);
+    ctxB->setDriver(&metricsB);
 
     constexpr std::array<AxisId, 6> ALL_AXES = {
         AxisId::X, AxisId::X1, AxisId::X2, AxisId::Y, AxisId::Z, AxisId::R
@@ -131,8 +161,8 @@ int main(int argc, char *argv[])
     }
 
     // 首次同步（将 plc 默认状态注入 SystemContext）
-    driverA.pollFeedback(*ctxA);
-    driverB.pollFeedback(*ctxB);
+    linkA->pollFeedback(*ctxA);
+    linkB->pollFeedback(*ctxB);
 
     // ============================
     // 4. ViewModels（按 分组+轴 维度，两组各含6轴）
@@ -218,49 +248,39 @@ int main(int argc, char *argv[])
         &qtVM_B_Y, &qtVM_B_Z, &qtVM_B_R, &qtVM_B_X, &qtVM_B_X1, &qtVM_B_X2
     };
 
-    QTimer systemClock;
-    QObject::connect(&systemClock, &QTimer::timeout, [&]() {
-        // 6a. 所有分组推进物理引擎 + 反馈注入
-        for (const auto& groupName : manager.groupNames()) {
-            SystemContext* ctx = nullptr;
-            ContextRejection r;
-            if (manager.tryGetGroup(groupName, ctx, r) && ctx) {
-                auto* drv = ctx->driver();
-                if (!drv) continue;
-
-                // 6a-1. 反馈注入（轴 + 龙门 + 急停）
-                drv->pollFeedback(*ctx);
-
-                // 6a-2. 消费 EmergencyStopController 产生的 pending command
-                auto& estopCtrl = ctx->emergencyStopController();
-                if (estopCtrl.hasPendingCommand()) {
-                    auto commResult = drv->send(estopCtrl.popPendingCommand());
-                    if (!commResult.ok()) {
-                        LOG_WARN(LogLayer::APP, "System",
-                            "[" + groupName + "] EmergencyStop command delivery failed: " + commResult.diagnostic);
-                    }
-                }
-            }
-        }
+    // 分组之间互不共享状态：反馈阶段在固定线程池上并行执行，join 后再进入后续阶段
+    GroupPollScheduler pollScheduler(manager);
 
-        // 6b. 所有 ViewModel 推进状态机
-        for (auto* vm : allViewModels) {
-            vm->tick();
-        }
+    // 10ms 心跳内的工作按优先级执行：反馈与安全每帧必跑；
+    // 运动编排 / UI 投影 / 摘要在 8ms 预算耗尽后推迟到下一帧，不拖慢下一帧的急停处理
+    TickScheduler tickScheduler(std::chrono::milliseconds(8), std::chrono::milliseconds(5));
 
-        // 6c. 急停安全 ViewModel 推进（每帧同步急停控制器状态）
-        emergencyVM_A.tick();
-        emergencyVM_B.tick();
+    // 6a. 所有分组推进物理引擎 + 反馈注入 + 急停命令消费（并行，内部 join）
+    tickScheduler.add("poll", TickPriority::Feedback, [&] { pollScheduler.pollAll(); },
+                      std::chrono::milliseconds(4));
 
-        // 6d. 龙门 ViewModel 推进（每帧推进 Orchestrator + 刷新状态投影）
-        gantryVM_A.tick();
-        gantryVM_B.tick();
-    });
-    systemClock.start(10);  // 10ms 物理心跳
+    // 6b. 急停安全 ViewModel（同步急停控制器状态 + 全局急停确认延迟）
+    tickScheduler.add("estop.A", TickPriority::Safety, [&] { emergencyVM_A.tick(); });
+    tickScheduler.add("estop.B", TickPriority::Safety, [&] { emergencyVM_B.tick(); });
+
+    // 6c. 运动编排：轴 / 龙门 orchestrator 推进
+    for (auto* vm : allViewModels) {
+        tickScheduler.add("axis." + vm->fullName().toStdString(), TickPriority::Motion,
+                          [vm] { vm->advance(); });
+    }
+    tickScheduler.add("gantry.A", TickPriority::Motion, [&] { gantryVM_A.advance(); });
+    tickScheduler.add("gantry.B", TickPriority::Motion, [&] { gantryVM_B.advance(); });
+
+    // 6d. UI 投影：缓存对比 + 按需发射 Qt 信号
+    for (auto* vm : allViewModels) {
+        tickScheduler.add("axis." + vm->fullName().toStdString() + ".ui", TickPriority::UiProjection,
+                          [vm] { vm->project(); }, std::chrono::milliseconds(1));
+    }
+    tickScheduler.add("gantry.A.ui", TickPriority::UiProjection, [&] { gantryVM_A.project(); });
+    tickScheduler.add("gantry.B.ui", TickPriority::UiProjection, [&] { gantryVM_B.project(); });
 
-    // 7. 周期性状态摘要（每秒输出一次，按分组分行）
-    QTimer summaryClock;
-    QObject::connect(&summaryClock, &QTimer::timeout, [&]() {
+    // 7. 周期性状态摘要（每 100 帧 = 1s，按分组分行）
+    tickScheduler.add("summary", TickPriority::Telemetry, [&]() {
         LOG_SUMMARY(LogLayer::UI, "Telemetry",
             "=== Machine_A === "
             + formatAxisSummary(qtVM_A_Y) + "  "
@@ -277,8 +297,36 @@ int main(int argc, char *argv[])
             + formatAxisSummary(qtVM_B_X) + "  "
             + formatAxisSummary(qtVM_B_X1) + "  "
             + formatAxisSummary(qtVM_B_X2));
-    });
-    summaryClock.start(1000);  // 1s 周期
+
+        // 驱动 I/O 延迟（滑动窗口）：区分 10ms 超时是否来自通讯层
+        for (auto [name, metrics] : { std::pair{"Machine_A", &metricsA}, std::pair{"Machine_B", &metricsB} }) {
+            std::ostringstream oss;
+            oss << "=== " << name << " driver latency (us) ===";
+            for (const auto& s : metrics->snapshot()) {
+                oss << std::fixed << std::setprecision(1)
+                    << "  " << s.opName << "/" << s.statusName
+                    << " n=" << s.latency.count
+                    << " p50=" << s.latency.p50Us
+                    << " p99=" << s.latency.p99Us
+                    << " max=" << s.latency.maxUs;
+            }
+            LOG_SUMMARY(LogLayer::UI, "Telemetry", oss.str());
+        }
+
+        // 心跳调度：推迟 / 超限计数
+        const auto& st = tickScheduler.stats();
+        LOG_SUMMARY(LogLayer::UI, "Telemetry",
+            "=== tick scheduler === ticks=" + std::to_string(st.ticks)
+            + " overrun=" + std::to_string(st.overrunTicks)
+            + " deferred=" + std::to_string(st.deferred)
+            + " criticalMiss=" + std::to_string(st.criticalDeadlineMisses)
+            + " maxTickUs=" + std::to_string(st.maxTick.count() / 1000)
+            + " maxCriticalUs=" + std::to_string(st.maxCriticalPhase.count() / 1000));
+    }, {}, 100);
+
+    QTimer systemClock;
+    QObject::connect(&systemClock, &QTimer::timeout, [&]() { tickScheduler.tick(); });
+    systemClock.start(10);  // 10ms 物理心跳
 
     int result = app.exec();
 
@@ -9,6 +9,7 @@
 #include "application/policy/AutoAbsMoveOrchestrator.h"
 #include "application/policy/AutoRelMoveOrchestrator.h"
 #include "application/policy/JogOrchestrator.h"
+#include "application/policy/OrchestratorWake.h"
 #include "domain/entity/Axis.h"
 #include "domain/entity/SystemContext.h"
 #include "ErrorTranslator.h"
@@ -127,7 +128,11 @@ AxisViewModelCore::AxisViewModelCore(SystemManager& manager,
     , m_jogOrch(std::make_unique<JogOrchestrator>(manager, groupName))
     , m_absOrch(std::make_unique<AutoAbsMoveOrchestrator>(manager, groupName))
     , m_relOrch(std::make_unique<AutoRelMoveOrchestrator>(manager, groupName))
+    , m_jogGate(std::make_unique<OrchestratorWakeGate>())
+    , m_absGate(std::make_unique<OrchestratorWakeGate>())
+    , m_relGate(std::make_unique<OrchestratorWakeGate>())
 {
+    refreshSnapshot();
     LOG_INFO(LogLayer::UI, "AxisVM",
         logPrefix() + " ViewModel created");
 }
@@ -138,58 +143,33 @@ AxisViewModelCore::~AxisViewModelCore() = default;
 // 1. 状态投影
 // =============================================================================
 
-AxisState AxisViewModelCore::state() const
-{
-    auto* axis = tryReadAxis(m_manager, m_groupName, m_axisId);
-    if (!axis) return AxisState::Unknown;
-    return axis->state();
-}
-
-double AxisViewModelCore::absPos() const
-{
-    auto* axis = tryReadAxis(m_manager, m_groupName, m_axisId);
-    if (!axis) return 0.0;
-    return axis->currentAbsolutePosition();
-}
-
-double AxisViewModelCore::relPos() const
-{
-    auto* axis = tryReadAxis(m_manager, m_groupName, m_axisId);
-    if (!axis) return 0.0;
-    return axis->currentRelativePosition();
-}
-
-bool AxisViewModelCore::isEnabled() const
-{
-    return state() != AxisState::Disabled;
-}
-
-double AxisViewModelCore::jogVelocity() const
-{
-    auto* axis = tryReadAxis(m_manager, m_groupName, m_axisId);
-    if (!axis) return 0.0;
-    return axis->getjogVelocity();
-}
+AxisState AxisViewModelCore::state() const        { return m_snapshot.state; }
+double    AxisViewModelCore::absPos() const       { return m_snapshot.absPos; }
+double    AxisViewModelCore::relPos() const       { return m_snapshot.relPos; }
+bool      AxisViewModelCore::isEnabled() const    { return m_snapshot.state != AxisState::Disabled; }
+double    AxisViewModelCore::jogVelocity() const  { return m_snapshot.jogVelocity; }
+double    AxisViewModelCore::moveVelocity() const { return m_snapshot.moveVelocity; }
+double    AxisViewModelCore::posLimit() const     { return m_snapshot.posLimit; }
+double    AxisViewModelCore::negLimit() const     { return m_snapshot.negLimit; }
 
-double AxisViewModelCore::moveVelocity() const
+void AxisViewModelCore::refreshSnapshot()
 {
+    // 每次刷新只做一次 分组 -> 龙门语义 -> 轴 查找
     auto* axis = tryReadAxis(m_manager, m_groupName, m_axisId);
-    if (!axis) return 0.0;
-    return axis->getMoveVelocity();
-}
-
-double AxisViewModelCore::posLimit() const
-{
-    auto* axis = tryReadAxis(m_manager, m_groupName, m_axisId);
-    if (!axis) return 0.0;
-    return axis->positiveSoftLimit();
-}
-
-double AxisViewModelCore::negLimit() const
-{
-    auto* axis = tryReadAxis(m_manager, m_groupName, m_axisId);
-    if (!axis) return 0.0;
-    return axis->negativeSoftLimit();
+    if (!axis) {
+        m_snapshot = AxisSnapshot{};
+        return;
+    }
+    m_snapshot = AxisSnapshot{
+        .found        = true,
+        .state        = axis->state(),
+        .absPos       = axis->currentAbsolutePosition(),
+        .relPos       = axis->currentRelativePosition(),
+        .jogVelocity  = axis->getjogVelocity(),
+        .moveVelocity = axis->getMoveVelocity(),
+        .posLimit     = axis->positiveSoftLimit(),
+        .negLimit     = axis->negativeSoftLimit(),
+    };
 }
 
 // =============================================================================
@@ -309,6 +289,7 @@ void AxisViewModelCore::jog(Direction dir)
         logPrefix() + " jog " + dirStr + " pressed");
 
     m_jogOrch->startJog(m_axisId, dir);
+    m_jogGate->arm();
 
     if (m_jogOrch->hasError()) {
         auto vmError = translate(m_jogOrch->lastError());
@@ -326,6 +307,7 @@ void AxisViewModelCore::jogStop(Direction dir)
         logPrefix() + " jog " + dirStr + " released");
 
     m_jogOrch->stopJog(m_axisId, dir);
+    m_jogGate->arm();
 }
 
 void AxisViewModelCore::moveAbsolute(double targetPos)
@@ -336,6 +318,7 @@ void AxisViewModelCore::moveAbsolute(double targetPos)
         logPrefix() + " moveAbsolute target=" + std::to_string(targetPos));
 
     m_absOrch->startAbs(m_axisId, targetPos);
+    m_absGate->arm();
 
     if (m_absOrch->hasError()) {
         auto vmError = translate(m_absOrch->lastError());
@@ -352,6 +335,7 @@ void AxisViewModelCore::moveRelative(double distance)
         logPrefix() + " moveRelative distance=" + std::to_string(distance));
 
     m_relOrch->startRel(m_axisId, distance);
+    m_relGate->arm();
 
     if (m_relOrch->hasError()) {
         auto vmError = translate(m_relOrch->lastError());
@@ -383,6 +367,7 @@ void AxisViewModelCore::stop()
         m_jogOrch->currentStep() != JogOrchestrator::Step::Error &&
         m_jogOrch->currentStep() != JogOrchestrator::Step::Idle) {
         m_jogOrch->stopJog(m_axisId, Direction::Forward);
+        m_jogGate->arm();
         LOG_DEBUG(LogLayer::UI, "AxisVM",
             logPrefix() + " jog orchestrator interrupted by stop");
     }
@@ -408,6 +393,7 @@ void AxisViewModelCore::setJogVelocity(double v)
         LOG_DEBUG(LogLayer::UI, "AxisVM",
             logPrefix() + " jogVelocity set to " + std::to_string(v));
     }
+    refreshSnapshot();  // 速度写入领域层即时生效，无需等待反馈
 }
 
 void AxisViewModelCore::setMoveVelocity(double v)
@@ -430,6 +416,7 @@ void AxisViewModelCore::setMoveVelocity(double v)
         LOG_DEBUG(LogLayer::UI, "AxisVM",
             logPrefix() + " moveVelocity set to " + std::to_string(v));
     }
+    refreshSnapshot();  // 速度写入领域层即时生效，无需等待反馈
 }
 
 // =============================================================================
@@ -529,10 +516,13 @@ void AxisViewModelCore::clearRelativeZero()
 
 void AxisViewModelCore::tick()
 {
-    // Step 1: 驱动所有编排器状态机
-    m_jogOrch->tick();
-    m_absOrch->tick();
-    m_relOrch->tick();
+    // Step 1: 按唤醒条件驱动编排器状态机
+    driveOrchestrators();
+
+    // Step 1.5: 使能保持到期掉电
+    if (m_holdPending) {
+        releaseHeldEnable();
+    }
 
     // Step 2: 收集错误（追加模式，不再覆盖）
     collectOrchError(*m_jogOrch, "JogOrch");
@@ -542,13 +532,93 @@ void AxisViewModelCore::tick()
     // Step 3: 消费零位/速度类 pending command
     consumePendingCommands();
 
-    // Step 4: 日志摘要（每 100 帧输出一次）
+    // Step 4: 采集本帧快照，供 Qt 投影层的全部 getter 读取
+    refreshSnapshot();
+
+    // Step 5: 日志摘要（每 100 帧输出一次）
     LOG_TRACE_EVERY_N(100, LogLayer::UI, "AxisVM",
         logPrefix()
         + " tick: state=" + std::to_string(static_cast<int>(state()))
         + " errors=" + std::to_string(m_errorHistory.size()));
 }
 
+bool AxisViewModelCore::anyOrchestratorActive() const
+{
+    return m_jogOrch->wakeMask() != WakeOn::None || m_jogGate->isArmed() ||
+           m_absOrch->wakeMask() != WakeOn::None || m_absGate->isArmed() ||
+           m_relOrch->wakeMask() != WakeOn::None || m_relGate->isArmed();
+}
+
+void AxisViewModelCore::driveOrchestrators()
+{
+    // 三个编排器都处于终态且没有显式入口待处理时，本帧不做任何查找
+    if (!anyOrchestratorActive()) {
+        return;
+    }
+    m_holdPending = true;
+    m_heldSince.reset();
+
+    // 变化戳每帧只采集一次；分组缺失时保持默认戳，由 arm / EveryTick / 心跳推进编排器自行报错
+    WakeStamp now;
+    SystemContext* group = nullptr;
+    ContextRejection mgrReason = ContextRejection::None;
+    if (m_manager.tryGetGroup(m_groupName, group, mgrReason) && group) {
+        now = WakeStamp::capture(*group, m_axisId);
+    }
+
+    m_jogGate->drive(*m_jogOrch, now);
+    m_absGate->drive(*m_absOrch, now);
+    m_relGate->drive(*m_relOrch, now);
+}
+
+void AxisViewModelCore::releaseHeldEnable()
+{
+    if (anyOrchestratorActive()) {
+        return;
+    }
+
+    SystemContext* group = nullptr;
+    ContextRejection mgrReason = ContextRejection::None;
+    if (!m_manager.tryGetGroup(m_groupName, group, mgrReason) || !group) {
+        m_holdPending = false;
+        return;
+    }
+
+    // AlwaysDisable 已由编排器掉电，HoldUntilDisabled 等待显式掉电；
+    // 急停锁定时 PLC 已强制掉电，保持计时一并作废
+    const EnableRetention policy = group->enableRetention(m_axisId);
+    if (policy.mode != EnableRetention::Mode::HoldFor
+        || group->emergencyStopController().isSystemLocked()) {
+        m_holdPending = false;
+        return;
+    }
+
+    auto* axis = tryReadAxis(m_manager, m_groupName, m_axisId);
+    if (!axis || axis->state() == AxisState::Disabled) {
+        m_holdPending = false;
+        return;
+    }
+    if (axis->state() != AxisState::Idle || axis->hasPendingCommand()) {
+        m_heldSince.reset();
+        return;
+    }
+
+    // 按时钟计时：主循环掉帧或 tick 周期变化都不影响保持时长
+    const Clock::time_point t = now();
+    if (!m_heldSince) {
+        m_heldSince = t;
+    }
+    if (t - *m_heldSince < std::chrono::milliseconds(policy.holdMs)) {
+        return;
+    }
+
+    LOG_INFO(LogLayer::UI, "AxisVM",
+        logPrefix() + " enable hold expired after " + std::to_string(policy.holdMs) + "ms -- disabling");
+    m_enableUc->execute(m_manager, m_groupName, m_axisId, false);
+    m_holdPending = false;
+    m_heldSince.reset();
+}
+
 void AxisViewModelCore::consumePendingCommands()
 {
     auto* axis = tryGetAxis(m_manager, m_groupName, m_axisId);
@@ -597,12 +667,12 @@ void AxisViewModelCore::consumePendingCommands()
         auto vmError = ViewModelError{
             "ZERO_CMD_FAILED",
             "零位/速度命令下发失败",
-            commResult.diagnostic,
+            commResult.describe(),
             ErrorCategory::Modal
         };
         pushError(vmError, "CmdDelivery");
         LOG_ERROR(LogLayer::UI, "AxisVM",
-            logPrefix() + " command delivery failed: " + commResult.diagnostic);
+            logPrefix() + " command delivery failed: " + commResult.describe());
     } else {
         LOG_TRACE(LogLayer::UI, "AxisVM",
             logPrefix() + " command delivered successfully");
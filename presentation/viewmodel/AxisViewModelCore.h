@@ -6,6 +6,8 @@
 #include <vector>
 #include <chrono>
 #include <atomic>
+#include <functional>
+#include <optional>
 
 #include "entity/Axis.h"
 #include "entity/AxisId.h"
@@ -15,6 +17,7 @@ class SystemManager;
 class AutoAbsMoveOrchestrator;
 class AutoRelMoveOrchestrator;
 class JogOrchestrator;
+class OrchestratorWakeGate;
 class EnableUseCase;
 class JogAxisUseCase;
 class MoveAbsoluteUseCase;
@@ -27,6 +30,23 @@ struct ErrorEntry {
     std::string source;
 };
 
+/**
+ * @brief 轴状态的单帧快照（tick() 末尾一次查找采集，所有投影 getter 由此读取）
+ *
+ * 轴不可读（分组缺失 / 龙门语义拦截 / 未注册）时 found=false，其余字段保持默认值，
+ * 与逐项查找时的兜底值一致。
+ */
+struct AxisSnapshot {
+    bool      found        = false;
+    AxisState state        = AxisState::Unknown;
+    double    absPos       = 0.0;
+    double    relPos       = 0.0;
+    double    jogVelocity  = 0.0;
+    double    moveVelocity = 0.0;
+    double    posLimit     = 0.0;
+    double    negLimit     = 0.0;
+};
+
 class AxisViewModelCore {
 public:
     AxisViewModelCore(SystemManager& manager,
@@ -34,7 +54,8 @@ public:
                       AxisId axisId);
     ~AxisViewModelCore();
 
-    // ── 状态投影 ──
+    // ── 状态投影（读取本帧快照，不做查找）──
+    const AxisSnapshot& snapshot() const { return m_snapshot; }
     AxisState  state() const;
     double    absPos() const;
     double    relPos() const;
@@ -70,8 +91,14 @@ public:
     void clearRelativeZero();
 
     // ── 帧驱动 ──
+    static constexpr int FRAME_MS = 10;   ///< tick() 调用周期（主循环定时器）
     void tick();
 
+    /// @brief 使能保持计时所用的时钟；测试中接入链路虚拟时钟，空函数恢复 steady_clock
+    using Clock = std::chrono::steady_clock;
+    using ClockFn = std::function<Clock::time_point()>;
+    void setClock(ClockFn clock) { m_clock = std::move(clock); }
+
     // ── 辅助方法（供 Qt 层 / 外部日志使用）──
     static std::string axisIdToString(AxisId id);
     const std::string& groupName() const { return m_groupName; }
@@ -92,13 +119,31 @@ private:
     std::unique_ptr<AutoAbsMoveOrchestrator>  m_absOrch;
     std::unique_ptr<AutoRelMoveOrchestrator>  m_relOrch;
 
+    // 编排器唤醒闸门：只在其等待的变化发生时推进 tick()
+    std::unique_ptr<OrchestratorWakeGate>     m_jogGate;
+    std::unique_ptr<OrchestratorWakeGate>     m_absGate;
+    std::unique_ptr<OrchestratorWakeGate>     m_relGate;
+
     std::vector<ErrorEntry> m_errorHistory;
 
+    // 构造、tick() 末尾与本地速度设置后刷新；其余时刻 getter 看到的是上一次采集的值
+    AxisSnapshot m_snapshot;
+    void refreshSnapshot();
+
     void pushError(const ViewModelError& error, const std::string& source);
 
     template<typename Orch>
     void collectOrchError(Orch& orch, const std::string& source);
 
+    // 使能保持（HoldFor）：编排器结束后轴进入 Idle 的时刻，now - heldSince 达到 holdMs 掉电
+    bool     m_holdPending = false;
+    std::optional<Clock::time_point> m_heldSince;
+    ClockFn  m_clock;
+    Clock::time_point now() const { return m_clock ? m_clock() : Clock::now(); }
+
+    bool anyOrchestratorActive() const;
+    void driveOrchestrators();
+    void releaseHeldEnable();
     void consumePendingCommands();
 
     static std::string generateTraceId();
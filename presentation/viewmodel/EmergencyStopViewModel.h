@@ -4,7 +4,9 @@
 #include <QObject>
 #include <QString>
 #include "application/SystemManager.h"
+#include "application/safety/EmergencyStopLatencyProbe.h"
 #include "application/safety/EmergencyStopUseCase.h"
+#include "application/safety/GlobalEmergencyStopUseCase.h"
 #include "application/safety/ReleaseEmergencyStopUseCase.h"
 #include "domain/entity/SystemContext.h"
 #include "domain/safety/EmergencyStopController.h"
@@ -15,7 +17,7 @@
  *
  * 职责：
  *   1. 向 QML 暴露分组级安全状态（SafetyState -> Q_PROPERTY）
- *   2. 接收 UI 指令 -> 调用 EmergencyStopUseCase / ReleaseEmergencyStopUseCase
+ *   2. 接收 UI 指令 -> 调用 EmergencyStopUseCase / GlobalEmergencyStopUseCase / ReleaseEmergencyStopUseCase
  *   3. 每帧 tick() 从 EmergencyStopController 读取最新状态并通知 UI
  *
  * 设计原则：
@@ -48,6 +50,9 @@ class EmergencyStopViewModel : public QObject {
     /// @brief 操作反馈文本（成功为空，失败为错误描述）
     Q_PROPERTY(QString lastError READ lastError NOTIFY lastErrorChanged)
 
+    /// @brief 最近一次全局急停中最慢分组的确认延迟（ms，尚无结果或有分组未受理为 -1）
+    Q_PROPERTY(int lastConfirmLatencyMs READ lastConfirmLatencyMs NOTIFY confirmLatencyChanged)
+
 public:
     /**
      * @brief 构造急停 ViewModel
@@ -68,6 +73,7 @@ public:
 
     int safetyState() const { return static_cast<int>(m_cachedState); }
     bool isSystemLocked() const { return m_cachedLocked; }
+    int lastConfirmLatencyMs() const { return m_lastConfirmLatencyMs; }
     bool isEmergencyStopped() const { return m_cachedEmergencyStopped; }
     bool isTransitioning() const { return m_cachedTransitioning; }
     bool isNotSynchronized() const { return m_cachedNotSynchronized; }
@@ -106,6 +112,28 @@ public:
         }
     }
 
+    /**
+     * @brief 触发全局急停（全部分组，一次扇出）
+     *
+     * 调用链：GlobalEmergencyStopUseCase.execute(m_manager, &m_confirmProbe)
+     *   -> 每个分组 requestEmergencyStop() -> sendUrgent(EmergencyStopCommand{true})
+     *
+     * 各分组的确认延迟由 tick() 跟踪，全部确认后更新 lastConfirmLatencyMs。
+     */
+    Q_INVOKABLE void triggerGlobalEmergencyStop() {
+        GlobalEmergencyStopUseCase uc;
+        auto result = uc.execute(m_manager, &m_confirmProbe);
+        if (m_confirmProbe.allConfirmed()) {
+            publishConfirmLatency();   // 没有需要等待确认的分组（如全部下发失败）
+        }
+
+        if (std::holds_alternative<std::monostate>(result)) {
+            setLastError({});
+        } else {
+            setLastError(formatError(result));
+        }
+    }
+
     /**
      * @brief 解除紧急急停
      *
@@ -132,6 +160,10 @@ public:
      * 应在全局 tick loop 中调用（与 AxisViewModel::tick() 同级）
      */
     void tick() {
+        if (!m_confirmProbe.allConfirmed() && m_confirmProbe.poll() == 0) {
+            publishConfirmLatency();
+        }
+
         SystemContext* ctx = nullptr;
         ContextRejection reason = ContextRejection::None;
         if (!m_manager.tryGetGroup(m_groupName, ctx, reason) || !ctx) {
@@ -165,8 +197,17 @@ public:
 signals:
     void safetyStateChanged();
     void lastErrorChanged();
+    void confirmLatencyChanged();
 
 private:
+    /// @brief 最近一次全局急停已有结论：更新 lastConfirmLatencyMs（有分组未受理时为 -1）
+    void publishConfirmLatency() {
+        const auto worst = m_confirmProbe.lastWorstCase();
+        m_lastConfirmLatencyMs = (worst == std::chrono::nanoseconds::max()) ? -1 : static_cast<int>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(worst).count());
+        emit confirmLatencyChanged();
+    }
+
     void setLastError(const QString& err) {
         if (m_lastError != err) {
             m_lastError = err;
@@ -200,7 +241,7 @@ private:
         }
         // CommunicationResult
         if (auto* comm = std::get_if<CommunicationResult>(&error)) {
-            return QString::fromStdString("通讯失败: " + comm->diagnostic);
+            return QString::fromStdString("通讯失败: " + comm->describe());
         }
         // Other unhandled types
         return QStringLiteral("操作失败（未知错误）");
@@ -217,6 +258,9 @@ private:
     bool        m_cachedNotSynchronized    = true;
 
     QString m_lastError;
+
+    EmergencyStopLatencyProbe m_confirmProbe;
+    int m_lastConfirmLatencyMs = -1;
 };
 
 #endif // EMERGENCY_STOP_VIEW_MODEL_H
@@ -1,6 +1,15 @@
 #include "ErrorTranslator.h"
 #include <type_traits>
 
+namespace {
+
+/// @brief 通讯诊断文本（diagnostic 由各驱动填写，可能为空指针）
+std::string diagnosticText(const CommunicationResult& r) {
+    return r.diagnostic ? r.diagnostic : "";
+}
+
+}  // anonymous namespace
+
 ViewModelError translate(const UseCaseError& err) {
     return std::visit([](const auto& e) -> ViewModelError {
         using T = std::decay_t<decltype(e)>;
@@ -110,32 +119,32 @@ ViewModelError translate(const UseCaseError& err) {
             switch (e.status) {
             case CommunicationResult::Status::NetworkError:
                 return {"COMM_NETWORK_ERROR", "网络通讯故障",
-                        e.diagnostic,
+                        diagnosticText(e),
                         ErrorCategory::Modal};
             case CommunicationResult::Status::Timeout:
                 return {"COMM_TIMEOUT", "通讯超时",
-                        e.diagnostic,
+                        diagnosticText(e),
                         ErrorCategory::Modal};
             case CommunicationResult::Status::Busy:
                 return {"COMM_PLC_BUSY", "PLC 忙，请稍后重试",
-                        e.diagnostic,
+                        diagnosticText(e),
                         ErrorCategory::Inline};
             case CommunicationResult::Status::ProtocolError:
                 return {"COMM_PROTOCOL_ERROR", "Modbus 协议错误",
-                        "Exception code: 0x" + std::to_string(e.exceptionCode) + " " + e.diagnostic,
+                        e.describe(),
                         ErrorCategory::Modal};
             case CommunicationResult::Status::InvalidResponse:
                 return {"COMM_INVALID_RESPONSE", "PLC 返回数据异常",
-                        e.diagnostic,
+                        diagnosticText(e),
                         ErrorCategory::Modal};
             case CommunicationResult::Status::Disconnected:
                 return {"COMM_DISCONNECTED", "设备未连接",
-                        e.diagnostic,
+                        diagnosticText(e),
                         ErrorCategory::Modal};
             case CommunicationResult::Status::Sent:
             default:
                 return {"COMM_UNKNOWN", "通讯未知错误",
-                        e.diagnostic,
+                        diagnosticText(e),
                         ErrorCategory::Modal};
             }
         }
@@ -220,5 +229,22 @@ ViewModelError translate(const UseCaseError& err) {
                         ErrorCategory::Modal};
             }
         }
+
+        // =============================================
+        // 编排器流程层错误
+        // =============================================
+        else if constexpr (std::is_same_v<T, OrchestratorRejection>) {
+            switch (e) {
+            case OrchestratorRejection::StepTimeout:
+                return {"ORCH_STEP_TIMEOUT", "流程步骤超时",
+                        "Orchestrator step exceeded its configured deadline",
+                        ErrorCategory::Modal};
+            case OrchestratorRejection::None:
+            default:
+                return {"ORCH_UNKNOWN", "流程未知错误",
+                        "",
+                        ErrorCategory::Modal};
+            }
+        }
     }, err);
 }
@@ -190,7 +190,22 @@ void GantryViewModel::tick() {
     advanceOrchestrator();
     refreshGantryState();
     refreshOrchestratorState();
+    logTickTrace();
+}
+
+void GantryViewModel::advance() {
+    TraceScope scope(m_groupName, "Gantry", generateTraceId());
+    advanceOrchestrator();
+}
+
+void GantryViewModel::project() {
+    TraceScope scope(m_groupName, "Gantry", generateTraceId());
+    refreshGantryState();
+    refreshOrchestratorState();
+    logTickTrace();
+}
 
+void GantryViewModel::logTickTrace() {
     LOG_TRACE_EVERY_N(100, LogLayer::UI, "GantryVM",
         "tick: enabled=" + std::to_string(m_cachedEnabled)
         + " coupled=" + std::to_string(m_cachedCoupled)
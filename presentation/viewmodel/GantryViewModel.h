@@ -101,9 +101,15 @@ public:
 
     // ========== 逐帧驱动 ==========
 
-    /// @brief 驱动 orchestrator 推进 + 刷新缓存状态 + 按需发射信号
+    /// @brief 驱动 orchestrator 推进 + 刷新缓存状态 + 按需发射信号（= advance() + project()）
     void tick();
 
+    /// @brief 仅推进 orchestrator（运动编排阶段）
+    void advance();
+
+    /// @brief 仅刷新缓存状态并按需发射信号（UI 投影阶段，可被调度器推迟）
+    void project();
+
 signals:
     /// @brief 状态聚合变化时发射（isEnabled / isCoupled / isDecoupledAndEnabled / isSynchronized）
     void gantryStateChanged();
@@ -124,6 +130,9 @@ private:
     /// @brief 推进当前 orchestrator（如果存在）
     void advanceOrchestrator();
 
+    /// @brief 周期性 TRACE 摘要（每 100 次调用一次）
+    void logTickTrace();
+
     /// @brief 生成 TraceScope 的唯一 traceId
     static std::string generateTraceId();
 
@@ -190,10 +190,17 @@ void QtAxisViewModel::acknowledgeAllErrors() {
 // =============================================================================
 
 void QtAxisViewModel::tick() {
-    if (!m_core) return;
+    advance();
+    project();
+}
 
+void QtAxisViewModel::advance() {
     // 1. 驱动底层状态机
-    m_core->tick();
+    if (m_core) m_core->tick();
+}
+
+void QtAxisViewModel::project() {
+    if (!m_core) return;
 
     // 2. 缓存对比 -> 按需 emit
     bool emitState  = false;
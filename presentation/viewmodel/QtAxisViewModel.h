@@ -86,7 +86,9 @@ public:
     Q_INVOKABLE double position() const;
 
     // 系统推进
-    void tick();
+    void tick();      ///< advance() + project()
+    void advance();   ///< 推进 Core 状态机（编排器、使能保持）
+    void project();   ///< 读取 Core 状态，按需发射信号（只读，可被调度器推迟）
 
 signals:
     void stateChanged();
@@ -0,0 +1,222 @@
+#include "HeadlessSimulation.h"
+
+#include "application/GroupPollScheduler.h"
+#include "application/policy/GantryOrchestrator.h"
+#include "application/safety/EmergencyStopUseCase.h"
+#include "application/safety/ReleaseEmergencyStopUseCase.h"
+#include "domain/entity/ContextRejection.h"
+#include "domain/entity/SystemContext.h"
+#include "infrastructure/CaptureFile.h"
+#include "infrastructure/FakePLC.h"
+#include "infrastructure/RecordingDriver.h"
+#include "infrastructure/SharedPlcTransport.h"
+#include "infrastructure/logger/Logger.h"
+#include "presentation/viewmodel/AxisViewModelCore.h"
+
+#include <chrono>
+#include <string>
+
+HeadlessConfig HeadlessConfig::scaled(size_t groupCount, size_t axesPerGroup, size_t gantriesPerGroup) {
+    HeadlessConfig cfg;
+    cfg.groups.clear();
+    for (size_t g = 0; g < groupCount; ++g) {
+        std::string index = std::to_string(g);
+        if (index.size() < 2) index.insert(0, 2 - index.size(), '0');
+        cfg.groups.push_back("Group_" + index);
+    }
+    cfg.plc = FakePLCConfig::scaled(axesPerGroup, gantriesPerGroup,
+                                    FakeAxisProfile{20.0, 50.0, 1000.0, -1000.0});
+    return cfg;
+}
+
+// ============================================================================
+// 构造 -- 与 main.cpp 第 1~4 步一一对应
+// ============================================================================
+
+HeadlessSimulation::HeadlessSimulation(const HeadlessConfig& cfg)
+    : m_config(cfg)
+    , m_link(std::make_unique<SharedPlcTransport>(cfg.stepMs))
+{
+    ContextRejection reason;
+
+    if (!m_config.capturePath.empty()) {
+        m_capture = std::make_unique<CaptureWriter>();
+        if (!m_capture->open(m_config.capturePath)) m_capture.reset();
+    }
+
+    for (const auto& name : m_config.groups) {
+        Group& g = m_groups[name];
+        g.plc = std::make_unique<FakePLC>(m_config.plc);
+        g.driver = std::make_unique<SharedPlcDriver>(*m_link, m_link->addWindow(*g.plc));
+
+        SystemContext* ctx = nullptr;
+        if (!m_manager.createGroup(name, reason) || !m_manager.tryGetGroup(name, ctx, reason)) {
+            LOG_ERROR(LogLayer::APP, "Headless", "failed to create group " + name);
+            continue;
+        }
+        ISystemDriver* driver = g.driver.get();
+        if (m_capture) {
+            const auto index = static_cast<uint16_t>(m_groups.size() - 1);
+            g.recorder = std::make_unique<RecordingDriver>(*g.driver, *m_capture, index, name);
+            driver = g.recorder.get();
+        }
+        ctx->setDriver(driver);
+
+        for (auto id : g.plc->axisIds()) {
+            ctx->registerAxis(id);
+            ctx->setAxisIdentity(id, name);
+        }
+
+        // 首次同步（将 plc 默认状态注入 SystemContext）
+        driver->pollFeedback(*ctx);
+    }
+
+    // ViewModel 必须在首次同步之后创建
+    for (auto& [name, g] : m_groups) {
+        for (auto id : g.plc->axisIds()) {
+            auto vm = std::make_unique<AxisViewModelCore>(m_manager, name, id);
+            m_allAxes.push_back(vm.get());
+            g.axes.emplace(id, std::move(vm));
+        }
+    }
+
+    m_scheduler = std::make_unique<GroupPollScheduler>(m_manager, m_config.pollWorkers);
+
+    LOG_INFO(LogLayer::APP, "Headless",
+        "simulation ready: groups=" + std::to_string(m_groups.size())
+        + " axes=" + std::to_string(m_allAxes.size())
+        + " stepMs=" + std::to_string(m_config.stepMs));
+}
+
+HeadlessSimulation::~HeadlessSimulation() = default;
+
+// ============================================================================
+// 虚拟时钟
+// ============================================================================
+
+void HeadlessSimulation::step() {
+    if (m_profiling) {
+        stepProfiled();
+        return;
+    }
+
+    // 1. 所有分组推进物理引擎 + 反馈注入 + 急停命令消费
+    m_scheduler->pollAll();
+
+    // 2. 所有 ViewModel 推进状态机
+    for (auto* vm : m_allAxes) {
+        vm->tick();
+    }
+
+    // 3. 龙门编排器推进（完成 / 出错后保留，供调用方查询结果）
+    for (auto& [name, g] : m_groups) {
+        if (g.gantry && !g.gantry->isDone() && !g.gantry->hasError()) {
+            g.gantry->tick();
+        }
+    }
+
+    ++m_steps;
+}
+
+/// @brief 与 step() 相同的阶段顺序，逐阶段记录墙钟耗时
+void HeadlessSimulation::stepProfiled() {
+    using Clock = std::chrono::steady_clock;
+    auto ns = [](Clock::time_point a, Clock::time_point b) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(b - a).count());
+    };
+
+    const auto t0 = Clock::now();
+    m_scheduler->pollAll();
+    const auto t1 = Clock::now();
+    for (auto* vm : m_allAxes) {
+        vm->tick();
+    }
+    const auto t2 = Clock::now();
+    for (auto& [name, g] : m_groups) {
+        if (g.gantry && !g.gantry->isDone() && !g.gantry->hasError()) {
+            g.gantry->tick();
+        }
+    }
+    const auto t3 = Clock::now();
+
+    m_profile.poll.record(ns(t0, t1));
+    m_profile.viewModels.record(ns(t1, t2));
+    m_profile.gantry.record(ns(t2, t3));
+    m_profile.total.record(ns(t0, t3));
+    ++m_steps;
+}
+
+void HeadlessSimulation::runFor(double simSeconds) {
+    const auto n = static_cast<uint64_t>(simSeconds * 1000.0 / m_config.stepMs + 0.5);
+    for (uint64_t i = 0; i < n; ++i) {
+        step();
+    }
+}
+
+bool HeadlessSimulation::runUntil(const std::function<bool()>& done, double timeoutSimSeconds) {
+    const auto limit = static_cast<uint64_t>(timeoutSimSeconds * 1000.0 / m_config.stepMs + 0.5);
+    for (uint64_t i = 0; i < limit; ++i) {
+        if (done()) return true;
+        step();
+    }
+    return done();
+}
+
+double HeadlessSimulation::simSeconds() const {
+    return static_cast<double>(m_steps) * m_config.stepMs / 1000.0;
+}
+
+// ============================================================================
+// 对象访问
+// ============================================================================
+
+AxisViewModelCore* HeadlessSimulation::axis(const std::string& group, AxisId id) {
+    auto it = m_groups.find(group);
+    if (it == m_groups.end()) return nullptr;
+    auto a = it->second.axes.find(id);
+    return a == it->second.axes.end() ? nullptr : a->second.get();
+}
+
+FakePLC* HeadlessSimulation::plc(const std::string& group) {
+    auto it = m_groups.find(group);
+    return it == m_groups.end() ? nullptr : it->second.plc.get();
+}
+
+SystemContext* HeadlessSimulation::context(const std::string& group) {
+    SystemContext* ctx = nullptr;
+    ContextRejection reason;
+    return m_manager.tryGetGroup(group, ctx, reason) ? ctx : nullptr;
+}
+
+// ============================================================================
+// 龙门 / 急停
+// ============================================================================
+
+void HeadlessSimulation::startGantryCoupling(const std::string& group) {
+    auto it = m_groups.find(group);
+    if (it == m_groups.end()) return;
+    it->second.gantry = std::make_unique<GantryOrchestrator>(m_manager, group);
+    it->second.gantry->startCoupling();
+}
+
+void HeadlessSimulation::stopGantryCouplingAndDisable(const std::string& group) {
+    auto it = m_groups.find(group);
+    if (it == m_groups.end()) return;
+    it->second.gantry = std::make_unique<GantryOrchestrator>(m_manager, group);
+    it->second.gantry->stopCouplingAndDisable();
+}
+
+GantryOrchestrator* HeadlessSimulation::gantry(const std::string& group) {
+    auto it = m_groups.find(group);
+    return it == m_groups.end() ? nullptr : it->second.gantry.get();
+}
+
+UseCaseError HeadlessSimulation::emergencyStop(const std::string& group) {
+    EmergencyStopUseCase uc;
+    return uc.execute(m_manager, group);
+}
+
+UseCaseError HeadlessSimulation::releaseEmergencyStop(const std::string& group) {
+    ReleaseEmergencyStopUseCase uc;
+    return uc.execute(m_manager, group);
+}
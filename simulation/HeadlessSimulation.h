@@ -0,0 +1,137 @@
+#ifndef HEADLESS_SIMULATION_H
+#define HEADLESS_SIMULATION_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "application/SystemManager.h"
+#include "application/UseCaseError.h"
+#include "domain/entity/AxisId.h"
+#include "infrastructure/FakePLCConfig.h"
+#include "infrastructure/utils/LatencyHistogram.h"
+
+class AxisViewModelCore;
+class CaptureWriter;
+class FakePLC;
+class GantryOrchestrator;
+class GroupPollScheduler;
+class RecordingDriver;
+class SharedPlcDriver;
+class SharedPlcTransport;
+
+/**
+ * @brief 无界面仿真配置（默认值与 main.cpp 保持一致）
+ *
+ * 每个分组使用同一份 plc 配置构造自己的 FakePLC；配置中的全部轴都会登记进
+ * SystemContext 并各自创建一个 AxisViewModelCore。负载测试用 FakePLCConfig::scaled()
+ * 配合更多分组即可搭出 16 组 × 32 轴之类的规模。
+ */
+struct HeadlessConfig {
+    std::vector<std::string> groups = {"Machine_A", "Machine_B"};
+    int    stepMs       = 10;       ///< 虚拟时钟步长（= 主循环周期）
+    size_t pollWorkers  = 0;        ///< 反馈阶段额外工作线程数（0 = 主线程顺序执行）
+    FakePLCConfig plc   = FakePLCConfig::standard(FakeAxisProfile{20.0, 50.0, 1000.0, -1000.0});
+    std::string capturePath;        ///< 非空时录制全部分组的驱动流量（ReplayDriver 可回放）
+
+    /// @brief 负载测试配置：groupCount 个分组（Group_00 ...），每组 axesPerGroup 个轴
+    static HeadlessConfig scaled(size_t groupCount, size_t axesPerGroup, size_t gantriesPerGroup = 1);
+};
+
+/**
+ * @brief step() 各阶段墙钟耗时（纳秒直方图），用于定位上层随规模增长的瓶颈
+ */
+struct StepProfile {
+    LatencyHistogram poll;        ///< 反馈阶段（PLC 物理推演 + 反馈注入 + 急停命令消费）
+    LatencyHistogram viewModels;  ///< 全部 AxisViewModelCore::tick（含编排器推进与命令下发）
+    LatencyHistogram gantry;      ///< 活动中的龙门编排器
+    LatencyHistogram total;
+
+    void clear() { poll.clear(); viewModels.clear(); gantry.clear(); total.clear(); }
+};
+
+/**
+ * @brief 无界面全栈仿真 -- 与 main.cpp 相同的对象图，去掉 QML 与 QTimer
+ *
+ * FakePLC → SharedPlcDriver → SystemContext → Orchestrators → AxisViewModelCore
+ *
+ * 主循环不再由 10ms 实时定时器驱动，而是由调用方以 CPU 允许的最快速度调用 step()。
+ * 每次 step() 推进一个虚拟周期（stepMs），整个栈的行为只依赖周期计数，
+ * 因此与实时运行逐周期一致，一小时的机器行为可以在数秒内跑完。
+ *
+ * 每个 step() 的阶段顺序与 main.cpp 的 tick lambda 相同:
+ *   1. 反馈阶段: GroupPollScheduler::pollAll()（pollFeedback + 急停命令消费）
+ *   2. 所有 AxisViewModelCore::tick()
+ *   3. 所有活动中的 GantryOrchestrator::tick()（替代 GantryViewModel）
+ */
+class HeadlessSimulation {
+public:
+    explicit HeadlessSimulation(const HeadlessConfig& cfg = HeadlessConfig{});
+    ~HeadlessSimulation();
+
+    HeadlessSimulation(const HeadlessSimulation&) = delete;
+    HeadlessSimulation& operator=(const HeadlessSimulation&) = delete;
+
+    // ── 虚拟时钟 ──
+    void step();
+    void runFor(double simSeconds);
+
+    /// @brief 推进直到 done() 为真或超时；返回 done() 是否达成
+    bool runUntil(const std::function<bool()>& done, double timeoutSimSeconds);
+
+    [[nodiscard]] uint64_t steps() const { return m_steps; }
+    [[nodiscard]] double simSeconds() const;
+
+    // ── 分阶段计时（默认关闭，开启后每个 step() 额外读取 4 次时钟） ──
+    void setProfiling(bool enabled) { m_profiling = enabled; }
+    StepProfile& profile() { return m_profile; }
+
+    // ── 对象访问 ──
+    SystemManager& manager() { return m_manager; }
+    const HeadlessConfig& config() const { return m_config; }
+
+    /// @return 未知分组/轴时返回 nullptr
+    AxisViewModelCore* axis(const std::string& group, AxisId id);
+    FakePLC* plc(const std::string& group);
+    SystemContext* context(const std::string& group);
+
+    /// @brief 全部分组的全部轴 ViewModel（按分组名、轴槽位顺序）
+    const std::vector<AxisViewModelCore*>& allAxes() const { return m_allAxes; }
+
+    // ── 龙门（替代 GantryViewModel 的入口） ──
+    void startGantryCoupling(const std::string& group);
+    void stopGantryCouplingAndDisable(const std::string& group);
+    /// @return 当前（或最近一次）龙门编排器；从未启动过返回 nullptr
+    GantryOrchestrator* gantry(const std::string& group);
+
+    // ── 急停（替代 EmergencyStopViewModel 的入口） ──
+    UseCaseError emergencyStop(const std::string& group);
+    UseCaseError releaseEmergencyStop(const std::string& group);
+
+private:
+    struct Group {
+        std::unique_ptr<FakePLC> plc;
+        std::unique_ptr<SharedPlcDriver> driver;
+        std::unique_ptr<RecordingDriver> recorder;
+        std::map<AxisId, std::unique_ptr<AxisViewModelCore>> axes;
+        std::unique_ptr<GantryOrchestrator> gantry;
+    };
+
+    HeadlessConfig m_config;
+    SystemManager m_manager;
+    std::unique_ptr<SharedPlcTransport> m_link;
+    std::unique_ptr<GroupPollScheduler> m_scheduler;
+    std::unique_ptr<CaptureWriter> m_capture;   // 须先于 m_groups 声明：录制驱动先析构
+    std::map<std::string, Group> m_groups;
+    std::vector<AxisViewModelCore*> m_allAxes;
+    uint64_t m_steps = 0;
+    bool m_profiling = false;
+    StepProfile m_profile;
+
+    void stepProfiled();
+};
+
+#endif // HEADLESS_SIMULATION_H
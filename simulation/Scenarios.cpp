@@ -0,0 +1,306 @@
+#include "Scenarios.h"
+#include "HeadlessSimulation.h"
+
+#include "application/policy/GantryOrchestrator.h"
+#include "domain/entity/SystemContext.h"
+#include "infrastructure/FakePLC.h"
+#include "presentation/viewmodel/AxisViewModelCore.h"
+
+#include <cmath>
+#include <cstdio>
+#include <variant>
+
+namespace {
+
+constexpr const char* GROUP_A = "Machine_A";
+constexpr const char* GROUP_B = "Machine_B";
+
+/// @brief 超时上限（虚拟秒）-- 远大于任何单步动作的物理耗时
+constexpr double STEP_TIMEOUT_S = 30.0;
+
+/// @brief 位置比较容差（mm）
+constexpr double POS_TOLERANCE = 0.5;
+
+// ============================================================================
+// 场景辅助
+// ============================================================================
+
+class ScenarioScope {
+public:
+    ScenarioScope(HeadlessSimulation& sim, const char* name)
+        : m_sim(sim), m_start(sim.simSeconds()) { m_result.name = name; }
+
+    ScenarioResult fail(const std::string& why) {
+        m_result.passed = false;
+        m_result.detail = why;
+        m_result.simSeconds = m_sim.simSeconds() - m_start;
+        return m_result;
+    }
+
+    ScenarioResult pass(const std::string& detail = {}) {
+        m_result.passed = true;
+        m_result.detail = detail;
+        m_result.simSeconds = m_sim.simSeconds() - m_start;
+        return m_result;
+    }
+
+private:
+    HeadlessSimulation& m_sim;
+    double m_start;
+    ScenarioResult m_result;
+};
+
+std::string fmt(double v) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.2f", v);
+    return buf;
+}
+
+bool waitState(HeadlessSimulation& sim, AxisViewModelCore& vm, AxisState s) {
+    return sim.runUntil([&] { return vm.state() == s; }, STEP_TIMEOUT_S);
+}
+
+/// @brief 确保轴已使能并稳定处于 Idle
+///
+/// 急停打断的运动编排器在解除急停、轴重新使能后才观察到 Idle，
+/// 会按"目标未到达"中止并下发一次掉电 -- 因此这里允许重新使能若干次。
+bool ensureIdle(HeadlessSimulation& sim, AxisViewModelCore& vm) {
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        if (!sim.runUntil([&] {
+                return vm.state() == AxisState::Idle || vm.state() == AxisState::Disabled;
+            }, STEP_TIMEOUT_S)) {
+            return false;
+        }
+        if (vm.state() == AxisState::Disabled) {
+            vm.enable(true);
+            if (!waitState(sim, vm, AxisState::Idle)) return false;
+        }
+        sim.runFor(0.1);
+        if (vm.state() == AxisState::Idle) return true;
+    }
+    return false;
+}
+
+bool ok(const UseCaseError& e) { return std::holds_alternative<std::monostate>(e); }
+
+// ============================================================================
+// 场景
+// ============================================================================
+
+ScenarioResult jogScenario(HeadlessSimulation& sim) {
+    ScenarioScope sc(sim, "jog");
+    auto* y = sim.axis(GROUP_A, AxisId::Y);
+    if (!y) return sc.fail("Machine_A/Y not found");
+    if (!ensureIdle(sim, *y)) return sc.fail("Y did not reach Idle after enable");
+
+    const double start = y->absPos();
+    y->jog(Direction::Forward);
+    if (!waitState(sim, *y, AxisState::Jogging)) return sc.fail("Y never entered Jogging");
+    sim.runFor(1.0);
+    y->jogStop(Direction::Forward);
+    if (!waitState(sim, *y, AxisState::Idle)) return sc.fail("Y did not return to Idle after jogStop");
+
+    const double travelled = y->absPos() - start;
+    if (travelled <= 0.0) return sc.fail("Y did not move forward, delta=" + fmt(travelled));
+    return sc.pass("Y travelled " + fmt(travelled));
+}
+
+ScenarioResult moveAbsoluteScenario(HeadlessSimulation& sim) {
+    ScenarioScope sc(sim, "move-absolute");
+    auto* z = sim.axis(GROUP_A, AxisId::Z);
+    if (!z) return sc.fail("Machine_A/Z not found");
+    if (!ensureIdle(sim, *z)) return sc.fail("Z did not reach Idle after enable");
+
+    const double target = z->absPos() > 50.0 ? 0.0 : 100.0;
+    z->moveAbsolute(target);
+    if (!sim.runUntil([&] {
+            return z->state() == AxisState::Idle && std::abs(z->absPos() - target) < POS_TOLERANCE;
+        }, STEP_TIMEOUT_S)) {
+        return sc.fail("Z did not settle at " + fmt(target) + ", pos=" + fmt(z->absPos()));
+    }
+    if (z->hasError()) return sc.fail("Z reported an error during move");
+    return sc.pass("Z at " + fmt(z->absPos()));
+}
+
+ScenarioResult moveRelativeScenario(HeadlessSimulation& sim) {
+    ScenarioScope sc(sim, "move-relative");
+    auto* r = sim.axis(GROUP_A, AxisId::R);
+    if (!r) return sc.fail("Machine_A/R not found");
+    if (!ensureIdle(sim, *r)) return sc.fail("R did not reach Idle after enable");
+
+    const double distance = r->absPos() > 0.0 ? -30.0 : 30.0;
+    const double target = r->absPos() + distance;
+    r->moveRelative(distance);
+    if (!sim.runUntil([&] {
+            return r->state() == AxisState::Idle && std::abs(r->absPos() - target) < POS_TOLERANCE;
+        }, STEP_TIMEOUT_S)) {
+        return sc.fail("R did not settle at " + fmt(target) + ", pos=" + fmt(r->absPos()));
+    }
+    return sc.pass("R at " + fmt(r->absPos()));
+}
+
+ScenarioResult gantryScenario(HeadlessSimulation& sim) {
+    ScenarioScope sc(sim, "gantry");
+    auto* ctx = sim.context(GROUP_B);
+    if (!ctx) return sc.fail("Machine_B not found");
+
+    sim.startGantryCoupling(GROUP_B);
+    auto* orch = sim.gantry(GROUP_B);
+    if (!sim.runUntil([&] { return orch->isDone() || orch->hasError(); }, STEP_TIMEOUT_S)) {
+        return sc.fail("coupling did not finish");
+    }
+    if (orch->hasError()) return sc.fail("coupling failed");
+    if (!ctx->gantryCouplingController().isCoupled()) return sc.fail("controller not coupled after Done");
+
+    sim.stopGantryCouplingAndDisable(GROUP_B);
+    orch = sim.gantry(GROUP_B);
+    if (!sim.runUntil([&] { return orch->isDone() || orch->hasError(); }, STEP_TIMEOUT_S)) {
+        return sc.fail("decoupling did not finish");
+    }
+    if (orch->hasError()) return sc.fail("decoupling failed");
+    if (ctx->gantryCouplingController().isCoupled()) return sc.fail("controller still coupled");
+    return sc.pass();
+}
+
+ScenarioResult emergencyStopScenario(HeadlessSimulation& sim) {
+    ScenarioScope sc(sim, "estop");
+    auto* ctx = sim.context(GROUP_A);
+    auto* y = sim.axis(GROUP_A, AxisId::Y);
+    if (!ctx || !y) return sc.fail("Machine_A/Y not found");
+    if (!ensureIdle(sim, *y)) return sc.fail("Y did not reach Idle after enable");
+
+    const double target = y->absPos() > 0.0 ? y->absPos() - 200.0 : y->absPos() + 200.0;
+    y->moveAbsolute(target);
+    if (!waitState(sim, *y, AxisState::MovingAbsolute)) return sc.fail("Y never started moving");
+    sim.runFor(0.5);
+
+    if (!ok(sim.emergencyStop(GROUP_A))) return sc.fail("EmergencyStopUseCase rejected");
+    auto& estop = ctx->emergencyStopController();
+    if (!sim.runUntil([&] { return estop.isEmergencyStopped(); }, STEP_TIMEOUT_S)) {
+        return sc.fail("PLC never confirmed emergency stop");
+    }
+    // 急停期间 SystemContext 拒绝轴访问（ViewModel 投影为 Unknown），直接读 PLC 寄存器核对物理状态
+    auto* plc = sim.plc(GROUP_A);
+    sim.runFor(0.1);
+    if (plc->getFeedback(AxisId::Y).state != AxisState::Disabled) {
+        return sc.fail("Y not powered down by emergency stop");
+    }
+    const double stoppedAt = plc->getFeedback(AxisId::Y).absPos;
+    if (std::abs(stoppedAt - target) < POS_TOLERANCE) return sc.fail("Y reached target despite estop");
+
+    sim.runFor(0.5);
+    if (std::abs(plc->getFeedback(AxisId::Y).absPos - stoppedAt) > 1e-9) {
+        return sc.fail("Y kept moving while stopped");
+    }
+
+    if (!ok(sim.releaseEmergencyStop(GROUP_A))) return sc.fail("ReleaseEmergencyStopUseCase rejected");
+    if (!sim.runUntil([&] { return !estop.isEmergencyStopped(); }, STEP_TIMEOUT_S)) {
+        return sc.fail("PLC never confirmed release");
+    }
+    // 急停解除后轴保持掉电，由后续场景按需重新使能
+    return sc.pass("Y stopped at " + fmt(stoppedAt));
+}
+
+} // namespace
+
+// ============================================================================
+// 对外接口
+// ============================================================================
+
+const std::vector<Scenario>& builtinScenarios() {
+    static const std::vector<Scenario> scenarios = {
+        {"jog",           jogScenario},
+        {"move-absolute", moveAbsoluteScenario},
+        {"move-relative", moveRelativeScenario},
+        {"gantry",        gantryScenario},
+        {"estop",         emergencyStopScenario},
+    };
+    return scenarios;
+}
+
+ScenarioResult runScenario(HeadlessSimulation& sim, const std::string& name) {
+    for (const auto& s : builtinScenarios()) {
+        if (name == s.name) return s.run(sim);
+    }
+    ScenarioResult r;
+    r.name = name;
+    r.detail = "unknown scenario";
+    return r;
+}
+
+bool runSoak(HeadlessSimulation& sim, double simSeconds, size_t& iterations, ScenarioResult& firstFailure) {
+    iterations = 0;
+    const double end = sim.simSeconds() + simSeconds;
+    while (sim.simSeconds() < end) {
+        for (const auto& s : builtinScenarios()) {
+            ScenarioResult r = s.run(sim);
+            if (!r.passed) {
+                firstFailure = r;
+                return false;
+            }
+        }
+        ++iterations;
+    }
+    return true;
+}
+
+LoadResult runLoad(HeadlessSimulation& sim, double simSeconds) {
+    constexpr double LOAD_TARGET = 100.0;
+
+    struct Slot {
+        AxisViewModelCore* vm;
+        bool inFlight = false;
+        double target = 0.0;
+        double deadline = 0.0;
+    };
+
+    LoadResult result;
+    const double start = sim.simSeconds();
+    std::vector<Slot> slots;
+    for (auto* vm : sim.allAxes()) {
+        if (vm->axisId() == AxisId::X) continue;
+        slots.push_back(Slot{vm});
+        vm->enable(true);
+    }
+    result.axes = slots.size();
+
+    sim.runUntil([&] {
+        for (const auto& s : slots) {
+            if (s.vm->state() != AxisState::Idle) return false;
+        }
+        return true;
+    }, STEP_TIMEOUT_S);
+    for (const auto& s : slots) {
+        if (s.vm->state() == AxisState::Idle) ++result.enabled;
+    }
+
+    const double end = sim.simSeconds() + simSeconds;
+    while (sim.simSeconds() < end) {
+        const double now = sim.simSeconds();
+        for (auto& s : slots) {
+            if (s.inFlight) {
+                if (s.vm->state() == AxisState::Idle && std::abs(s.vm->absPos() - s.target) < POS_TOLERANCE) {
+                    ++result.movesCompleted;
+                    s.inFlight = false;
+                } else if (now > s.deadline) {
+                    ++result.movesStalled;
+                    s.inFlight = false;
+                }
+                continue;
+            }
+            if (s.vm->state() != AxisState::Idle) continue;
+            s.target = s.vm->absPos() > 0.0 ? -LOAD_TARGET : LOAD_TARGET;
+            s.deadline = now + STEP_TIMEOUT_S;
+            s.inFlight = true;
+            s.vm->moveAbsolute(s.target);
+            ++result.movesIssued;
+        }
+        sim.step();
+    }
+
+    for (const auto& s : slots) {
+        if (s.vm->hasError()) ++result.axesWithErrors;
+    }
+    result.simSeconds = sim.simSeconds() - start;
+    return result;
+}
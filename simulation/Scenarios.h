@@ -0,0 +1,64 @@
+#ifndef HEADLESS_SCENARIOS_H
+#define HEADLESS_SCENARIOS_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+class HeadlessSimulation;
+
+/**
+ * @brief 单个脚本化场景的执行结果
+ */
+struct ScenarioResult {
+    std::string name;
+    bool passed = false;
+    std::string detail;       ///< 失败原因 / 关键观测值
+    double simSeconds = 0.0;  ///< 场景消耗的虚拟时间
+};
+
+/**
+ * @brief 脚本化场景 -- 通过 AxisViewModelCore / 编排器入口驱动整个栈
+ *
+ * 每个场景只使用 UI 层同样会调用的入口（enable / jog / moveAbsolute / 龙门 / 急停），
+ * 断言以 PLC 反馈注入后的领域状态为准。场景之间共享同一个仿真实例，
+ * 因此每个场景结束时都需要把涉及的轴恢复到 Idle（或掉电）状态。
+ */
+struct Scenario {
+    const char* name;
+    std::function<ScenarioResult(HeadlessSimulation&)> run;
+};
+
+/// @brief 全部内置场景（执行顺序即返回顺序）
+const std::vector<Scenario>& builtinScenarios();
+
+/// @brief 按名称执行单个场景；未知名称返回 passed=false
+ScenarioResult runScenario(HeadlessSimulation& sim, const std::string& name);
+
+/// @brief 循环执行全部场景直到累计虚拟时间达到 simSeconds（浸泡测试）
+/// @return 全部通过返回 true；首个失败立即停止并写入 firstFailure
+bool runSoak(HeadlessSimulation& sim, double simSeconds, size_t& iterations, ScenarioResult& firstFailure);
+
+/**
+ * @brief 负载工作量的统计结果
+ */
+struct LoadResult {
+    size_t axes = 0;               ///< 参与的轴（逻辑龙门轴 X 除外，解耦时不可用）
+    size_t enabled = 0;            ///< 使能后到达 Idle 的轴
+    uint64_t movesIssued = 0;
+    uint64_t movesCompleted = 0;   ///< 到位且回到 Idle 的定位
+    uint64_t movesStalled = 0;     ///< 超时未到位的定位
+    size_t axesWithErrors = 0;     ///< 结束时 ViewModel 报告错误的轴
+    double simSeconds = 0.0;
+};
+
+/**
+ * @brief 负载工作量 -- 所有轴同时往复定位，持续 simSeconds 虚拟秒
+ *
+ * 全部轴使能后，每根轴一旦回到 Idle 即向 ±100mm 交替发起下一次绝对定位，
+ * 使每个周期都有大量编排器处于活动状态。配合 HeadlessSimulation::setProfiling()
+ * 可以得到随分组数 / 轴数增长的分阶段耗时。
+ */
+LoadResult runLoad(HeadlessSimulation& sim, double simSeconds);
+
+#endif // HEADLESS_SCENARIOS_H
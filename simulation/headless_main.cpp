@@ -0,0 +1,147 @@
+#include "HeadlessSimulation.h"
+#include "Scenarios.h"
+
+#include "infrastructure/logger/Logger.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// ============================================================================
+// servoV6_headless -- 无界面快进仿真入口
+//
+// 用法:
+//   servoV6_headless                        执行全部内置场景一次
+//   servoV6_headless --scenario <name>      执行单个场景（可重复）
+//   servoV6_headless --soak <sim-seconds>   循环执行全部场景直到虚拟时间耗尽
+//   servoV6_headless --load <G>x<A>         负载测试: G 组 × 每组 A 轴往复定位，
+//                                           持续 --soak 指定的虚拟秒数（默认 10），输出分阶段耗时
+//   servoV6_headless --record <file>        把全部分组的驱动流量录制到捕获文件（ReplayDriver / bench_replay 回放）
+//   servoV6_headless --log                  打开控制台日志（默认关闭以免拖慢快进）
+//
+// 退出码: 0 = 全部通过，1 = 有场景失败，2 = 参数错误
+// ============================================================================
+
+namespace {
+
+void printUsage(const char* argv0) {
+    std::fprintf(stderr,
+        "usage: %s [--scenario <name>]... [--soak <sim-seconds>] [--load <groups>x<axes>] [--record <file>] [--log]\n"
+        "scenarios:", argv0);
+    for (const auto& s : builtinScenarios()) std::fprintf(stderr, " %s", s.name);
+    std::fprintf(stderr, "\n");
+}
+
+void printPhase(const char* name, const LatencyHistogram& h) {
+    std::printf("  %-11s p50=%9.1fus  p99=%9.1fus  max=%9.1fus\n", name,
+        h.percentile(0.50) / 1000.0, h.percentile(0.99) / 1000.0, h.max() / 1000.0);
+}
+
+int runLoadTest(size_t groups, size_t axes, double simSeconds, const std::string& capturePath) {
+    HeadlessConfig cfg = HeadlessConfig::scaled(groups, axes);
+    cfg.capturePath = capturePath;
+    HeadlessSimulation sim(cfg);
+    sim.setProfiling(true);
+
+    const auto wallStart = std::chrono::steady_clock::now();
+    const LoadResult r = runLoad(sim, simSeconds);
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    std::printf("load: %zu groups x %zu axes, %zu/%zu axes enabled\n", groups, axes, r.enabled, r.axes);
+    std::printf("moves: issued=%llu completed=%llu stalled=%llu, axes with errors=%zu\n",
+        static_cast<unsigned long long>(r.movesIssued), static_cast<unsigned long long>(r.movesCompleted),
+        static_cast<unsigned long long>(r.movesStalled), r.axesWithErrors);
+    std::printf("step phases (%llu steps, %d ms budget):\n",
+        static_cast<unsigned long long>(sim.profile().total.count()), sim.config().stepMs);
+    printPhase("poll", sim.profile().poll);
+    printPhase("viewModels", sim.profile().viewModels);
+    printPhase("gantry", sim.profile().gantry);
+    printPhase("total", sim.profile().total);
+    std::printf("simulated %.1fs in %.3fs wall -> %.1fx real time\n",
+        r.simSeconds, wall, wall > 0.0 ? r.simSeconds / wall : 0.0);
+
+    const bool ok = r.enabled == r.axes && r.movesStalled == 0 && r.axesWithErrors == 0;
+    return ok ? 0 : 1;
+}
+
+void printResult(const ScenarioResult& r) {
+    std::printf("[%s] %-14s sim=%7.2fs  %s\n",
+        r.passed ? " OK " : "FAIL", r.name.c_str(), r.simSeconds, r.detail.c_str());
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> selected;
+    double soakSeconds = 0.0;
+    bool verbose = false;
+    size_t loadGroups = 0;
+    size_t loadAxes = 0;
+    std::string capturePath;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--scenario") && i + 1 < argc) {
+            selected.emplace_back(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--soak") && i + 1 < argc) {
+            soakSeconds = std::atof(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--load") && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%zux%zu", &loadGroups, &loadAxes) != 2
+                || loadGroups == 0 || loadAxes == 0) {
+                printUsage(argv[0]);
+                return 2;
+            }
+        } else if (!std::strcmp(argv[i], "--record") && i + 1 < argc) {
+            capturePath = argv[++i];
+        } else if (!std::strcmp(argv[i], "--log")) {
+            verbose = true;
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    LoggerConfig logCfg;
+    logCfg.enableConsole = verbose;
+    logCfg.enableFile = false;
+    Logger::init(logCfg);
+
+    if (loadGroups > 0) {
+        const int rc = runLoadTest(loadGroups, loadAxes, soakSeconds > 0.0 ? soakSeconds : 10.0, capturePath);
+        Logger::shutdown();
+        return rc;
+    }
+
+    HeadlessConfig cfg;
+    cfg.capturePath = capturePath;
+    HeadlessSimulation sim(cfg);
+    const auto wallStart = std::chrono::steady_clock::now();
+    bool allPassed = true;
+
+    if (soakSeconds > 0.0) {
+        size_t iterations = 0;
+        ScenarioResult failure;
+        allPassed = runSoak(sim, soakSeconds, iterations, failure);
+        std::printf("soak: %zu iterations\n", iterations);
+        if (!allPassed) printResult(failure);
+    } else {
+        if (selected.empty()) {
+            for (const auto& s : builtinScenarios()) selected.emplace_back(s.name);
+        }
+        for (const auto& name : selected) {
+            ScenarioResult r = runScenario(sim, name);
+            printResult(r);
+            allPassed = allPassed && r.passed;
+        }
+    }
+
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    std::printf("simulated %.1fs (%llu steps) in %.3fs wall -> %.0fx real time\n",
+        sim.simSeconds(), static_cast<unsigned long long>(sim.steps()), wall,
+        wall > 0.0 ? sim.simSeconds() / wall : 0.0);
+
+    Logger::shutdown();
+    return allPassed ? 0 : 1;
+}
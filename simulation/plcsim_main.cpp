@@ -0,0 +1,129 @@
+#include "infrastructure/FakePLCConfig.h"
+#include "infrastructure/ShmPlcServer.h"
+#include "infrastructure/logger/Logger.h"
+
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// servoV6_plcsim -- 进程外 PLC 仿真器
+//
+// 每个分组一个 FakePLC，挂到共享内存段 /dev/shm/servoV6.<group> 上，由 ShmPlcDriver 连接。
+// 仿真器与主程序分属不同进程：主程序崩溃 / 重启不影响 PLC 状态，
+// 也可以在主程序之外单独 attach 调试器或 perf。
+//
+// 用法:
+//   servoV6_plcsim                          默认分组 Machine_A / Machine_B，标准轴集
+//   servoV6_plcsim --group <name>           指定分组（可重复，替换默认分组）
+//   servoV6_plcsim --axes N [--gantries G]  每组 N 轴、G 组龙门（FakePLCConfig::scaled）
+//   servoV6_plcsim --free-running           按实时周期自行扫描（默认 lockstep: 驱动每次 poll 推进一个周期）
+//   servoV6_plcsim --cycle <ms>             扫描周期，默认 10
+//   servoV6_plcsim --log                    打开控制台日志
+//
+// 主程序以 SERVOV6_PLCSIM=1 启动时改用 ShmPlcDriver 连接本进程。
+// Ctrl+C / SIGTERM 或客户端 requestServerShutdown() 退出；退出时删除共享内存段。
+//
+// 退出码: 0 = 正常退出，1 = 创建共享内存段失败，2 = 参数错误
+// ============================================================================
+
+namespace {
+
+std::atomic<bool> g_stop{false};
+
+extern "C" void onSignal(int) { g_stop.store(true); }
+
+void printUsage(const char* argv0) {
+    std::fprintf(stderr,
+        "usage: %s [--group <name>]... [--axes <n> [--gantries <g>]] [--free-running] [--cycle <ms>] [--log]\n",
+        argv0);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> groups;
+    size_t axes = 0;
+    size_t gantries = 1;
+    shmplc::Mode mode = shmplc::Mode::Lockstep;
+    int cycleMs = 10;
+    bool verbose = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--group") && i + 1 < argc) {
+            groups.emplace_back(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--axes") && i + 1 < argc) {
+            axes = static_cast<size_t>(std::atoi(argv[++i]));
+        } else if (!std::strcmp(argv[i], "--gantries") && i + 1 < argc) {
+            gantries = static_cast<size_t>(std::atoi(argv[++i]));
+        } else if (!std::strcmp(argv[i], "--free-running")) {
+            mode = shmplc::Mode::FreeRunning;
+        } else if (!std::strcmp(argv[i], "--cycle") && i + 1 < argc) {
+            cycleMs = std::atoi(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--log")) {
+            verbose = true;
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+    if (cycleMs <= 0 || axes > shmplc::MAX_AXES) {
+        printUsage(argv[0]);
+        return 2;
+    }
+    if (groups.empty()) groups = {"Machine_A", "Machine_B"};
+
+    LoggerConfig logCfg;
+    logCfg.enableConsole = verbose;
+    logCfg.enableFile = false;
+    Logger::init(logCfg);
+
+    const FakeAxisProfile profile{20.0, 50.0, 1000.0, -1000.0};
+    const FakePLCConfig plcCfg = axes > 0 ? FakePLCConfig::scaled(axes, gantries, profile)
+                                          : FakePLCConfig::standard(profile);
+
+    std::vector<std::unique_ptr<ShmPlcServer>> servers;
+    for (const auto& g : groups) {
+        auto server = std::make_unique<ShmPlcServer>(shmplc::segmentName(g), plcCfg, mode, cycleMs);
+        if (!server->start()) {
+            std::fprintf(stderr, "cannot create shared memory segment for group %s\n", g.c_str());
+            servers.clear();
+            Logger::shutdown();
+            return 1;
+        }
+        servers.push_back(std::move(server));
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    std::printf("plcsim: %zu groups, %zu axes/group, %s, cycle %d ms\n",
+        servers.size(), servers.front()->plc().axisCount(),
+        mode == shmplc::Mode::Lockstep ? "lockstep" : "free-running", cycleMs);
+    std::fflush(stdout);
+
+    // 一个分组一个线程；任一分组收到客户端退出请求时整体退出
+    std::vector<std::thread> threads;
+    for (auto& s : servers) {
+        threads.emplace_back([&server = *s] {
+            server.run(g_stop);
+            g_stop.store(true);
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    for (const auto& s : servers) {
+        std::printf("  cycles=%llu commands=%llu\n",
+            static_cast<unsigned long long>(s->cycles()), static_cast<unsigned long long>(s->commandsApplied()));
+    }
+    servers.clear();
+    Logger::shutdown();
+    return 0;
+}
@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include "application/policy/AutoAbsMoveOrchestrator.h"
+#include "application/policy/JogOrchestrator.h"
+#include "application/safety/EmergencyStopUseCase.h"
+#include "application/SystemManager.h"
+#include "domain/entity/SystemContext.h"
+#include "infrastructure/FakeAxisDriver.h"
+#include "infrastructure/FakePLC.h"
+#include "presentation/viewmodel/AxisViewModelCore.h"
+
+// ============================================================================
+// EnableRetention 测试套件（FakePLC 闭环）
+// 核心验证点：
+//   1. 默认策略 AlwaysDisable：定位完成后掉电（原有行为）
+//   2. HoldUntilDisabled：完成后保持 Idle，下一次定位跳过使能延时
+//   3. 点动停止后按策略保持使能
+//   4. HoldFor：ViewModel 在空闲超时后掉电（按时钟计时，与 tick() 帧率无关）
+//   5. 急停仍强制掉电，保持计时作废
+// ============================================================================
+
+namespace {
+
+const FakeAxisProfile PROFILE{20.0, 50.0, 1000.0, -1000.0};
+
+struct Rig {
+    FakePLC plc{FakePLCConfig::standard(PROFILE)};
+    FakeAxisDriver driver{plc};
+    SystemManager manager;
+    SystemContext* ctx = nullptr;
+    const std::string name = "G";
+
+    Rig() {
+        ContextRejection r;
+        manager.createGroup(name, r);
+        manager.tryGetGroup(name, ctx, r);
+        ctx->setDriver(&driver);
+        driver.pollFeedback(*ctx);
+    }
+
+    Axis& axis(AxisId id) {
+        Axis* a = nullptr;
+        ContextRejection r;
+        ctx->tryReadAxis(id, a, r);
+        return *a;
+    }
+
+    void settle(int cycles = 10) {
+        for (int c = 0; c < cycles; ++c) driver.pollFeedback(*ctx);
+    }
+
+    /// @brief 驱动一次 Y 轴绝对定位，返回完成周期数（失败 -1）
+    int moveY(AutoAbsMoveOrchestrator& orch, double target) {
+        orch.startAbs(AxisId::Y, target);
+        for (int c = 0; c < 5000; ++c) {
+            orch.tick();
+            if (orch.isDone()) return c;
+            if (orch.hasError()) return -1;
+            driver.pollFeedback(*ctx);
+        }
+        return -1;
+    }
+};
+
+} // namespace
+
+TEST(EnableRetentionTest, DefaultPolicyDisablesAfterMove) {
+    Rig rig;
+    EXPECT_EQ(rig.ctx->enableRetention(AxisId::Y).mode, EnableRetention::Mode::AlwaysDisable);
+
+    AutoAbsMoveOrchestrator orch(rig.manager, rig.name);
+    ASSERT_GT(rig.moveY(orch, 30.0), 0);
+    rig.settle();
+    EXPECT_EQ(rig.axis(AxisId::Y).state(), AxisState::Disabled);
+}
+
+TEST(EnableRetentionTest, HoldUntilDisabledSkipsEnableOnNextMove) {
+    Rig rig;
+    rig.ctx->setEnableRetention(AxisId::Y, EnableRetention::holdUntilDisabled());
+
+    AutoAbsMoveOrchestrator orch(rig.manager, rig.name);
+    const int first = rig.moveY(orch, 30.0);
+    ASSERT_GT(first, 0);
+    rig.settle();
+    EXPECT_EQ(rig.axis(AxisId::Y).state(), AxisState::Idle);
+
+    // 同样 30mm 的行程，第二次无需等待使能延时
+    const int second = rig.moveY(orch, 0.0);
+    ASSERT_GT(second, 0);
+    EXPECT_LT(second, first);
+    EXPECT_GE(first - second, 10);   // FakePLC 使能延时 150ms
+    EXPECT_EQ(rig.axis(AxisId::Y).state(), AxisState::Idle);
+}
+
+TEST(EnableRetentionTest, JogStopHoldsEnabledWhenRetained) {
+    Rig rig;
+    rig.ctx->setEnableRetention(AxisId::Y, EnableRetention::holdUntilDisabled());
+
+    JogOrchestrator orch(rig.manager, rig.name);
+    orch.startJog(AxisId::Y, Direction::Forward);
+    for (int c = 0; c < 100 && orch.currentStep() != JogOrchestrator::Step::Jogging; ++c) {
+        orch.tick();
+        rig.driver.pollFeedback(*rig.ctx);
+    }
+    ASSERT_EQ(orch.currentStep(), JogOrchestrator::Step::Jogging);
+
+    orch.stopJog(AxisId::Y, Direction::Forward);
+    for (int c = 0; c < 200 && !orch.isDone(); ++c) {
+        orch.tick();
+        rig.driver.pollFeedback(*rig.ctx);
+    }
+    ASSERT_TRUE(orch.isDone());
+    rig.settle();
+    EXPECT_EQ(rig.axis(AxisId::Y).state(), AxisState::Idle);
+}
+
+TEST(EnableRetentionTest, ViewModelDisablesAfterHoldTimeout) {
+    Rig rig;
+    rig.ctx->setEnableRetention(AxisId::Y, EnableRetention::holdFor(200));
+    AxisViewModelCore vm(rig.manager, rig.name, AxisId::Y);
+    vm.setClock([&rig] {
+        return AxisViewModelCore::Clock::time_point{} + std::chrono::milliseconds(rig.driver.linkClockMs());
+    });
+
+    vm.moveAbsolute(20.0);
+    int64_t idleSinceMs = -1;
+    int64_t disabledAtMs = -1;
+    for (int c = 0; c < 2000 && disabledAtMs < 0; ++c) {
+        vm.tick();
+        rig.driver.pollFeedback(*rig.ctx);
+        const AxisState s = rig.axis(AxisId::Y).state();
+        const int64_t nowMs = rig.driver.linkClockMs();
+        if (idleSinceMs < 0 && rig.axis(AxisId::Y).currentAbsolutePosition() == 20.0 && s == AxisState::Idle) {
+            idleSinceMs = nowMs;
+        }
+        if (idleSinceMs >= 0 && s == AxisState::Disabled) disabledAtMs = nowMs;
+    }
+    ASSERT_GE(idleSinceMs, 0);
+    ASSERT_GE(disabledAtMs, 0);
+    EXPECT_GE(disabledAtMs - idleSinceMs, 200);
+    EXPECT_LE(disabledAtMs - idleSinceMs, 200 + 5 * AxisViewModelCore::FRAME_MS);
+}
+
+TEST(EnableRetentionTest, HoldTimeoutFollowsClockNotFrameCount) {
+    Rig rig;
+    rig.ctx->setEnableRetention(AxisId::Y, EnableRetention::holdFor(200));
+    AxisViewModelCore vm(rig.manager, rig.name, AxisId::Y);
+    vm.setClock([&rig] {
+        return AxisViewModelCore::Clock::time_point{} + std::chrono::milliseconds(rig.driver.linkClockMs());
+    });
+
+    vm.moveAbsolute(20.0);
+    for (int c = 0; c < 2000 && rig.axis(AxisId::Y).currentAbsolutePosition() != 20.0; ++c) {
+        vm.tick();
+        rig.driver.pollFeedback(*rig.ctx);
+    }
+    ASSERT_EQ(rig.axis(AxisId::Y).state(), AxisState::Idle);
+
+    // 主循环以 4 倍帧率调用 tick()：帧数早已超过 200ms / FRAME_MS，但时钟只走了 100ms
+    for (int c = 0; c < 10; ++c) {
+        for (int k = 0; k < 4; ++k) vm.tick();
+        rig.driver.pollFeedback(*rig.ctx);
+    }
+    EXPECT_EQ(rig.axis(AxisId::Y).state(), AxisState::Idle);
+
+    for (int c = 0; c < 20; ++c) {
+        vm.tick();
+        rig.driver.pollFeedback(*rig.ctx);
+    }
+    EXPECT_EQ(rig.axis(AxisId::Y).state(), AxisState::Disabled);
+}
+
+TEST(EnableRetentionTest, EmergencyStopOverridesRetention) {
+    Rig rig;
+    rig.ctx->setEnableRetention(AxisId::Y, EnableRetention::holdFor(300));
+    AxisViewModelCore vm(rig.manager, rig.name, AxisId::Y);
+
+    vm.moveAbsolute(10.0);
+    for (int c = 0; c < 100 && rig.axis(AxisId::Y).currentAbsolutePosition() != 10.0; ++c) {
+        vm.tick();
+        rig.driver.pollFeedback(*rig.ctx);
+    }
+    ASSERT_EQ(rig.axis(AxisId::Y).state(), AxisState::Idle);
+
+    // 急停锁定期间领域轴不再接收反馈，以 PLC 侧状态为准；保持计时随锁定作废
+    EmergencyStopUseCase{}.execute(rig.manager, rig.name);
+    for (int c = 0; c < 50; ++c) {
+        vm.tick();
+        rig.driver.pollFeedback(*rig.ctx);
+    }
+    EXPECT_EQ(rig.plc.getFeedback(AxisId::Y).state, AxisState::Disabled);
+    EXPECT_FALSE(vm.hasError());
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "application/policy/GantryOrchestrator.h"
+#include "application/SystemManager.h"
+#include "domain/entity/SystemContext.h"
+#include "infrastructure/FakeAxisDriver.h"
+#include "infrastructure/FakePLC.h"
+
+// ============================================================================
+// GantryOrchestrator 流水线联动测试套件（FakePLC 闭环，链路时钟计时）
+// 核心验证点：
+//   1. PLC 支持联动排队时，流水线联动只等一次使能延时，端到端耗时短于顺序流程
+//   2. PLC 拒绝排队的联动 -> 回退到顺序流程并最终联动成功
+//   3. 未使能以外的拒绝（如超差）不回退，直接 Error 并原样上报
+//   4. 每次成功联动的端到端耗时都被记录
+// ============================================================================
+
+namespace {
+
+struct Rig {
+    FakePLC plc;
+    FakeAxisDriver driver{plc};
+    SystemManager manager;
+    SystemContext* ctx = nullptr;
+    GantryOrchestrator orch{manager, "G"};
+
+    explicit Rig(bool plcQueuesCoupling) {
+        plc.setGantryCouplingFollowsPower(plcQueuesCoupling);
+        ContextRejection r;
+        manager.createGroup("G", r);
+        manager.tryGetGroup("G", ctx, r);
+        ctx->setDriver(&driver);
+        driver.pollFeedback(*ctx);   // 首帧完成安全 / 龙门同步
+        orch.stepTrace().setClock([this] {
+            return GantryOrchestrator::StepTrace::Clock::time_point{}
+                + std::chrono::milliseconds(driver.linkClockMs());
+        });
+    }
+
+    void run() {
+        for (int c = 0; c < 500 && !orch.isDone() && !orch.hasError(); ++c) {
+            orch.tick();
+            driver.pollFeedback(*ctx);
+        }
+    }
+
+    double lastCouplingMs() const {
+        return static_cast<double>(orch.lastCouplingTime().count()) / 1e6;
+    }
+};
+
+} // namespace
+
+TEST(GantryPipelinedCouplingTest, QueuedCouplingSkipsPowerConfirmationRoundTrip) {
+    Rig sequential(true);
+    sequential.orch.startCoupling();
+    sequential.run();
+    ASSERT_TRUE(sequential.orch.isDone());
+    ASSERT_TRUE(sequential.ctx->gantryCouplingController().isCoupled());
+
+    Rig pipelined(true);
+    pipelined.orch.setPipelinedCoupling(true);
+    pipelined.orch.startCoupling();
+    pipelined.run();
+    ASSERT_TRUE(pipelined.orch.isDone());
+    EXPECT_TRUE(pipelined.ctx->gantryCouplingController().isCoupled());
+    EXPECT_EQ(pipelined.orch.pipelineFallbacks(), 0u);
+
+    using Step = GantryOrchestrator::Step;
+    EXPECT_EQ(pipelined.orch.stepTrace().summary(AxisId::X, Step::PipelinedCoupling).count, 1u);
+    EXPECT_EQ(pipelined.orch.stepTrace().summary(AxisId::X, Step::WaitingEnabled).count, 0u);
+
+    // 顺序：使能 150ms + 往返 + 联动 100ms；流水线：使能 150ms 内完成联动判定
+    EXPECT_GE(sequential.lastCouplingMs(), 250.0);
+    EXPECT_GE(pipelined.lastCouplingMs(), 150.0);
+    EXPECT_LE(pipelined.lastCouplingMs(), 180.0);
+    EXPECT_LE(pipelined.lastCouplingMs() + 90.0, sequential.lastCouplingMs());
+}
+
+TEST(GantryPipelinedCouplingTest, FallsBackToSequentialWhenPlcRejectsQueuedCoupling) {
+    Rig rig(false);
+    rig.orch.setPipelinedCoupling(true);
+    rig.orch.startCoupling();
+    rig.run();
+
+    ASSERT_TRUE(rig.orch.isDone());
+    EXPECT_TRUE(rig.ctx->gantryCouplingController().isCoupled());
+    EXPECT_EQ(rig.orch.pipelineFallbacks(), 1u);
+    using Step = GantryOrchestrator::Step;
+    EXPECT_EQ(rig.orch.stepTrace().summary(AxisId::X, Step::WaitingCoupled).count, 1u);
+    EXPECT_GE(rig.lastCouplingMs(), 250.0);
+}
+
+TEST(GantryPipelinedCouplingTest, ToleranceRejectionEndsInErrorWithoutFallback) {
+    Rig rig(true);
+    rig.plc.setAbsolutePosition(AxisId::X1, 5.0);   // 位置超差：排队的联动被拒绝
+    rig.orch.setPipelinedCoupling(true);
+    rig.orch.startCoupling();
+    rig.run();
+
+    ASSERT_TRUE(rig.orch.hasError());
+    ASSERT_TRUE(std::holds_alternative<GantryRejection>(rig.orch.lastError()));
+    EXPECT_EQ(std::get<GantryRejection>(rig.orch.lastError()), GantryRejection::PositionToleranceExceeded);
+    EXPECT_EQ(rig.orch.pipelineFallbacks(), 0u);
+    EXPECT_EQ(rig.orch.couplingLatency().count(), 0u);
+    using Step = GantryOrchestrator::Step;
+    EXPECT_EQ(rig.orch.stepTrace().summary(AxisId::X, Step::WaitingEnabled).count, 0u);
+    EXPECT_EQ(rig.orch.stepTrace().summary(AxisId::X, Step::WaitingCoupled).count, 0u);
+}
+
+TEST(GantryPipelinedCouplingTest, RecordsEveryCoupleEndToEnd) {
+    Rig rig(true);
+    rig.orch.setPipelinedCoupling(true);
+    for (int round = 0; round < 3; ++round) {
+        rig.orch.startCoupling();
+        rig.run();
+        ASSERT_TRUE(rig.orch.isDone());
+        rig.orch.stopCouplingAndDisable();
+        rig.run();
+        ASSERT_TRUE(rig.orch.isDone());
+    }
+    EXPECT_EQ(rig.orch.couplingLatency().count(), 3u);
+    EXPECT_LE(rig.orch.couplingLatency().max(), 180'000'000u);
+}
@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+#include "application/policy/MotionProgramExecutor.h"
+#include "application/policy/AutoAbsMoveOrchestrator.h"
+#include "application/safety/EmergencyStopUseCase.h"
+#include "application/SystemManager.h"
+#include "domain/entity/SystemContext.h"
+#include "infrastructure/FakeAxisDriver.h"
+#include "infrastructure/FakePLC.h"
+
+#include <functional>
+
+// ============================================================================
+// MotionProgramExecutor 测试套件（FakePLC 闭环）
+// 核心验证点：
+//   1. 整段程序只使能 / 掉电一次，比逐段编排器更快完成
+//   2. 轴不相交的段前瞻下发；同一轴上的段严格按序
+//   3. 停留段为屏障，计时期间不下发后续段
+//   4. 暂停停稳且保持使能，恢复后按原终点完成
+//   5. 中止 / 急停 / 软限位 / 非法程序
+// ============================================================================
+
+namespace {
+
+using Step = MotionProgramExecutor::Step;
+using Seg = MotionSegment;
+
+const FakeAxisProfile PROFILE{20.0, 50.0, 1000.0, -1000.0};
+
+struct Rig {
+    FakePLC plc{FakePLCConfig::standard(PROFILE)};
+    FakeAxisDriver driver{plc};
+    SystemManager manager;
+    SystemContext* ctx = nullptr;
+    const std::string name = "G";
+
+    Rig() {
+        ContextRejection r;
+        manager.createGroup(name, r);
+        manager.tryGetGroup(name, ctx, r);
+        ctx->setDriver(&driver);
+        driver.pollFeedback(*ctx);
+    }
+
+    Axis& axis(AxisId id) {
+        Axis* a = nullptr;
+        ContextRejection r;
+        ctx->tryReadAxis(id, a, r);
+        return *a;
+    }
+
+    /// @brief 推进直到执行器进入终态（或 stopAt 返回 true）；返回所用周期数（超时 -1）
+    int run(MotionProgramExecutor& exec, const std::function<bool(int)>& stopAt = nullptr) {
+        for (int c = 0; c < 20000; ++c) {
+            exec.tick();
+            if (exec.isDone() || exec.hasError() || exec.isAborted()) return c;
+            if (stopAt && stopAt(c)) return c;
+            driver.pollFeedback(*ctx);
+        }
+        return -1;
+    }
+};
+
+} // namespace
+
+TEST(MotionProgramExecutorTest, StaysEnabledAcrossProgramAndBeatsPerMoveOrchestrator) {
+    std::vector<MotionSegment> program;
+    for (int i = 1; i <= 10; ++i) program.push_back(Seg::absolute({{AxisId::Y, (i % 2) ? 20.0 : 0.0}}));
+
+    Rig rig;
+    MotionProgramExecutor exec(rig.manager, rig.name);
+    exec.start(program);
+    bool enabled = false;
+    bool disabledMidProgram = false;
+    const int cycles = rig.run(exec, [&](int) {
+        const AxisState s = rig.axis(AxisId::Y).state();
+        if (s == AxisState::Idle) enabled = true;
+        if (enabled && s == AxisState::Disabled) disabledMidProgram = true;
+        return false;
+    });
+    ASSERT_TRUE(exec.isDone());
+    EXPECT_FALSE(disabledMidProgram);
+    EXPECT_EQ(exec.segmentsCompleted(), 10u);
+
+    for (int c = 0; c < 5; ++c) rig.driver.pollFeedback(*rig.ctx);
+    EXPECT_EQ(rig.axis(AxisId::Y).state(), AxisState::Disabled);
+
+    // 同样的十次定位交给单轴编排器逐个执行
+    Rig single;
+    AutoAbsMoveOrchestrator orch(single.manager, single.name);
+    int perMove = 0;
+    for (const auto& seg : program) {
+        orch.startAbs(AxisId::Y, seg.targets[0].value);
+        while (!orch.isDone() && !orch.hasError() && perMove < 20000) {
+            orch.tick();
+            single.driver.pollFeedback(*single.ctx);
+            ++perMove;
+        }
+        ASSERT_TRUE(orch.isDone());
+    }
+    EXPECT_LT(cycles, perMove);
+}
+
+TEST(MotionProgramExecutorTest, DisjointSegmentsAreIssuedTogether) {
+    Rig rig;
+    MotionProgramExecutor exec(rig.manager, rig.name);
+    exec.start({Seg::absolute({{AxisId::Y, 100.0}}),
+                Seg::absolute({{AxisId::Z, 20.0}}),
+                Seg::absolute({{AxisId::R, 30.0}})});
+    size_t maxActive = 0;
+    rig.run(exec, [&](int) {
+        maxActive = std::max(maxActive, exec.segmentsActive());
+        return false;
+    });
+    ASSERT_TRUE(exec.isDone());
+    EXPECT_EQ(maxActive, 3u);
+    EXPECT_DOUBLE_EQ(rig.axis(AxisId::R).currentAbsolutePosition(), 30.0);
+}
+
+TEST(MotionProgramExecutorTest, SameAxisSegmentsRunInOrderFromPlannedEndpoint) {
+    Rig rig;
+    MotionProgramExecutor exec(rig.manager, rig.name);
+    exec.start({Seg::absolute({{AxisId::Y, 50.0}}),
+                Seg::relative({{AxisId::Y, 25.0}}),
+                Seg::relative({{AxisId::Y, -5.0}, {AxisId::Z, 5.0}})});
+    size_t maxActive = 0;
+    rig.run(exec, [&](int) {
+        maxActive = std::max(maxActive, exec.segmentsActive());
+        return false;
+    });
+    ASSERT_TRUE(exec.isDone());
+    EXPECT_EQ(maxActive, 1u);
+    EXPECT_DOUBLE_EQ(rig.axis(AxisId::Y).currentAbsolutePosition(), 70.0);
+    EXPECT_DOUBLE_EQ(rig.axis(AxisId::Z).currentAbsolutePosition(), 5.0);
+}
+
+TEST(MotionProgramExecutorTest, DwellHoldsBackLaterSegments) {
+    Rig rig;
+    MotionProgramExecutor exec(rig.manager, rig.name);
+    exec.start({Seg::absolute({{AxisId::Y, 10.0}}),
+                Seg::dwell(200),
+                Seg::absolute({{AxisId::Z, 10.0}})});
+    int yArrived = -1;
+    int zStarted = -1;
+    rig.run(exec, [&](int c) {
+        if (yArrived < 0 && rig.axis(AxisId::Y).currentAbsolutePosition() == 10.0) yArrived = c;
+        if (zStarted < 0 && rig.axis(AxisId::Z).currentAbsolutePosition() != 0.0) zStarted = c;
+        return false;
+    });
+    ASSERT_TRUE(exec.isDone());
+    ASSERT_GE(yArrived, 0);
+    ASSERT_GE(zStarted, 0);
+    EXPECT_GE(zStarted - yArrived, 200 / MotionProgramExecutor::DEFAULT_CYCLE_MS);
+}
+
+TEST(MotionProgramExecutorTest, PauseHoldsEnabledAndResumeFinishesAtEndpoint) {
+    Rig rig;
+    MotionProgramExecutor exec(rig.manager, rig.name);
+    exec.start({Seg::absolute({{AxisId::Y, 300.0}}), Seg::relative({{AxisId::Y, -100.0}})});
+    rig.run(exec, [&](int) { return rig.axis(AxisId::Y).currentAbsolutePosition() > 100.0; });
+    ASSERT_TRUE(exec.pause());
+
+    rig.run(exec, [&](int) { return exec.isPaused(); });
+    ASSERT_TRUE(exec.isPaused());
+    const double held = rig.axis(AxisId::Y).currentAbsolutePosition();
+    EXPECT_GT(held, 100.0);
+    EXPECT_LT(held, 300.0);
+
+    for (int c = 0; c < 50; ++c) {
+        exec.tick();
+        rig.driver.pollFeedback(*rig.ctx);
+    }
+    EXPECT_EQ(rig.axis(AxisId::Y).state(), AxisState::Idle);
+    EXPECT_DOUBLE_EQ(rig.axis(AxisId::Y).currentAbsolutePosition(), held);
+
+    EXPECT_FALSE(exec.pause());
+    ASSERT_TRUE(exec.resume());
+    ASSERT_GT(rig.run(exec), 0);
+    ASSERT_TRUE(exec.isDone());
+    EXPECT_DOUBLE_EQ(rig.axis(AxisId::Y).currentAbsolutePosition(), 200.0);
+}
+
+TEST(MotionProgramExecutorTest, AbortStopsAndDisables) {
+    Rig rig;
+    MotionProgramExecutor exec(rig.manager, rig.name);
+    exec.start({Seg::absolute({{AxisId::Y, 300.0}, {AxisId::Z, 300.0}}), Seg::dwell(100)});
+    rig.run(exec, [&](int) { return rig.axis(AxisId::Y).currentAbsolutePosition() > 50.0; });
+    exec.abort();
+    ASSERT_GT(rig.run(exec), 0);
+    ASSERT_TRUE(exec.isAborted());
+
+    for (int c = 0; c < 10; ++c) rig.driver.pollFeedback(*rig.ctx);
+    EXPECT_EQ(rig.axis(AxisId::Y).state(), AxisState::Disabled);
+    EXPECT_EQ(rig.axis(AxisId::Z).state(), AxisState::Disabled);
+    EXPECT_LT(rig.axis(AxisId::Y).currentAbsolutePosition(), 300.0);
+}
+
+TEST(MotionProgramExecutorTest, EmergencyStopAbortsProgram) {
+    Rig rig;
+    MotionProgramExecutor exec(rig.manager, rig.name);
+    exec.start({Seg::absolute({{AxisId::Y, 300.0}})});
+    rig.run(exec, [&](int) { return exec.segmentsActive() == 1; });
+    EmergencyStopUseCase{}.execute(rig.manager, rig.name);
+    exec.tick();
+    EXPECT_TRUE(exec.isAborted());
+}
+
+TEST(MotionProgramExecutorTest, RejectsInvalidProgramsBeforeMotion) {
+    Rig rig;
+    MotionProgramExecutor exec(rig.manager, rig.name);
+
+    exec.start({});
+    EXPECT_EQ(exec.errorReason(), RejectionReason::InvalidArgument);
+    exec.start({Seg::absolute({{AxisId::Y, 1.0}, {AxisId::Y, 2.0}})});
+    EXPECT_EQ(exec.errorReason(), RejectionReason::InvalidArgument);
+    exec.start({Seg::dwell(-1)});
+    EXPECT_EQ(exec.errorReason(), RejectionReason::InvalidArgument);
+
+    // 第三段的累计终点越过正限位 -> 任何轴运动前整体拒绝
+    exec.start({Seg::absolute({{AxisId::Y, 500.0}}),
+                Seg::relative({{AxisId::Y, 400.0}}),
+                Seg::relative({{AxisId::Y, 400.0}})});
+    ASSERT_GE(rig.run(exec), 0);
+    ASSERT_TRUE(exec.hasError());
+    EXPECT_EQ(exec.errorReason(), RejectionReason::TargetOutOfPositiveLimit);
+    EXPECT_DOUBLE_EQ(rig.axis(AxisId::Y).currentAbsolutePosition(), 0.0);
+}
@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include "application/policy/MultiAxisMoveOrchestrator.h"
+#include "application/policy/AutoAbsMoveOrchestrator.h"
+#include "application/safety/EmergencyStopUseCase.h"
+#include "application/SystemManager.h"
+#include "domain/entity/SystemContext.h"
+#include "infrastructure/FakeAxisDriver.h"
+#include "infrastructure/FakePLC.h"
+
+#include <map>
+
+// ============================================================================
+// MultiAxisMoveOrchestrator 测试套件（FakePLC 闭环）
+// 核心验证点：
+//   1. 各轴按距离换算同步速度，同一周期到位
+//   2. 完成后恢复原定位速度并掉电
+//   3. 任一目标越过软限位时，任何轴运动前整体拒绝
+//   4. 空目标 / 重复轴直接 InvalidArgument
+//   5. 急停锁定时优雅中止（Done）；急停与出错中止都恢复原定位速度
+//   6. 并行定位的总周期数不超过最长单轴定位
+// ============================================================================
+
+namespace {
+
+using Step = MultiAxisMoveOrchestrator::Step;
+
+const FakeAxisProfile PROFILE{20.0, 50.0, 1000.0, -1000.0};
+
+struct Rig {
+    FakePLC plc{FakePLCConfig::standard(PROFILE)};
+    FakeAxisDriver driver{plc};
+    SystemManager manager;
+    SystemContext* ctx = nullptr;
+    const std::string name = "G";
+
+    Rig() {
+        ContextRejection r;
+        manager.createGroup(name, r);
+        manager.tryGetGroup(name, ctx, r);
+        ctx->setDriver(&driver);
+        driver.pollFeedback(*ctx);
+    }
+
+    Axis& axis(AxisId id) {
+        Axis* a = nullptr;
+        ContextRejection r;
+        ctx->tryReadAxis(id, a, r);
+        return *a;
+    }
+
+    /// @brief 推进直到编排器结束；记录每根轴首次到达目标的周期。返回结束周期（超时 -1）
+    int run(MultiAxisMoveOrchestrator& orch, const std::vector<MultiAxisMoveOrchestrator::AxisTarget>& targets,
+            std::map<AxisId, int>* arrivals = nullptr) {
+        for (int c = 0; c < 5000; ++c) {
+            orch.tick();
+            if (orch.isDone() || orch.hasError()) return c;
+            driver.pollFeedback(*ctx);
+            if (arrivals) {
+                for (const auto& t : targets) {
+                    if (!arrivals->count(t.id) && axis(t.id).currentAbsolutePosition() == t.target) {
+                        (*arrivals)[t.id] = c;
+                    }
+                }
+            }
+        }
+        return -1;
+    }
+};
+
+} // namespace
+
+TEST(MultiAxisMoveOrchestratorTest, AllAxesArriveOnTheSameCycle) {
+    Rig rig;
+    MultiAxisMoveOrchestrator orch(rig.manager, rig.name);
+    const std::vector<MultiAxisMoveOrchestrator::AxisTarget> targets{
+        {AxisId::Y, 150.0}, {AxisId::Z, -30.0}, {AxisId::R, 60.0}};
+    orch.startAbs(targets);
+
+    std::map<AxisId, int> arrivals;
+    ASSERT_GT(rig.run(orch, targets, &arrivals), 0);
+    ASSERT_TRUE(orch.isDone());
+    ASSERT_EQ(arrivals.size(), 3u);
+
+    // 最慢轴（Y：150mm @ 50mm/s）决定共同时长，其余轴按距离降速
+    EXPECT_DOUBLE_EQ(orch.syncDuration(), 3.0);
+    EXPECT_DOUBLE_EQ(orch.syncVelocity(AxisId::Y), 50.0);
+    EXPECT_DOUBLE_EQ(orch.syncVelocity(AxisId::Z), 10.0);
+    EXPECT_DOUBLE_EQ(orch.syncVelocity(AxisId::R), 20.0);
+
+    const auto [lo, hi] = std::minmax({arrivals[AxisId::Y], arrivals[AxisId::Z], arrivals[AxisId::R]});
+    EXPECT_LE(hi - lo, 1);
+}
+
+TEST(MultiAxisMoveOrchestratorTest, RestoresVelocityAndDisablesOnSuccess) {
+    Rig rig;
+    MultiAxisMoveOrchestrator orch(rig.manager, rig.name);
+    const std::vector<MultiAxisMoveOrchestrator::AxisTarget> targets{{AxisId::Y, 40.0}, {AxisId::Z, 10.0}};
+    orch.startAbs(targets);
+    ASSERT_GT(rig.run(orch, targets), 0);
+    ASSERT_TRUE(orch.isDone());
+
+    for (int c = 0; c < 10; ++c) rig.driver.pollFeedback(*rig.ctx);
+    for (AxisId id : {AxisId::Y, AxisId::Z}) {
+        EXPECT_DOUBLE_EQ(rig.axis(id).getMoveVelocity(), PROFILE.moveVelocity);
+        EXPECT_EQ(rig.axis(id).state(), AxisState::Disabled);
+    }
+    EXPECT_DOUBLE_EQ(rig.axis(AxisId::Y).currentAbsolutePosition(), 40.0);
+    EXPECT_DOUBLE_EQ(rig.axis(AxisId::Z).currentAbsolutePosition(), 10.0);
+}
+
+TEST(MultiAxisMoveOrchestratorTest, TargetBeyondSoftLimitRejectsBeforeAnyMotion) {
+    Rig rig;
+    MultiAxisMoveOrchestrator orch(rig.manager, rig.name);
+    const std::vector<MultiAxisMoveOrchestrator::AxisTarget> targets{{AxisId::Y, 50.0}, {AxisId::Z, 5000.0}};
+    orch.startAbs(targets);
+    ASSERT_GT(rig.run(orch, targets), 0);
+
+    ASSERT_TRUE(orch.hasError());
+    EXPECT_EQ(orch.errorReason(), RejectionReason::TargetOutOfPositiveLimit);
+    for (int c = 0; c < 10; ++c) rig.driver.pollFeedback(*rig.ctx);
+    EXPECT_DOUBLE_EQ(rig.axis(AxisId::Y).currentAbsolutePosition(), 0.0);
+    EXPECT_EQ(rig.axis(AxisId::Y).state(), AxisState::Disabled);
+}
+
+TEST(MultiAxisMoveOrchestratorTest, EmptyOrDuplicateTargetsAreInvalid) {
+    Rig rig;
+    MultiAxisMoveOrchestrator orch(rig.manager, rig.name);
+    orch.startAbs({});
+    EXPECT_TRUE(orch.hasError());
+    EXPECT_EQ(orch.errorReason(), RejectionReason::InvalidArgument);
+
+    orch.startAbs({{AxisId::Y, 1.0}, {AxisId::Y, 2.0}});
+    EXPECT_TRUE(orch.hasError());
+    EXPECT_EQ(orch.errorReason(), RejectionReason::InvalidArgument);
+}
+
+TEST(MultiAxisMoveOrchestratorTest, EmergencyStopAbortsGracefully) {
+    Rig rig;
+    MultiAxisMoveOrchestrator orch(rig.manager, rig.name);
+    orch.startAbs({{AxisId::Y, 200.0}, {AxisId::R, 100.0}});
+    for (int c = 0; c < 200 && orch.currentStep() != Step::WaitingMotionFinish; ++c) {
+        orch.tick();
+        rig.driver.pollFeedback(*rig.ctx);
+    }
+    ASSERT_EQ(orch.currentStep(), Step::WaitingMotionFinish);
+
+    ASSERT_DOUBLE_EQ(rig.plc.getFeedback(AxisId::R).getMoveVelocity, 25.0);
+
+    EmergencyStopUseCase{}.execute(rig.manager, rig.name);
+    orch.tick();
+    EXPECT_TRUE(orch.isDone());
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(orch.lastError()));
+
+    // 急停锁定期间领域轴不再接收反馈，以 PLC 侧为准：同步速度已恢复
+    for (int c = 0; c < 10; ++c) rig.driver.pollFeedback(*rig.ctx);
+    for (AxisId id : {AxisId::Y, AxisId::R}) {
+        EXPECT_DOUBLE_EQ(rig.plc.getFeedback(id).getMoveVelocity, PROFILE.moveVelocity);
+    }
+}
+
+TEST(MultiAxisMoveOrchestratorTest, AxisErrorAbortRestoresVelocity) {
+    Rig rig;
+    MultiAxisMoveOrchestrator orch(rig.manager, rig.name);
+    const std::vector<MultiAxisMoveOrchestrator::AxisTarget> targets{{AxisId::Y, 200.0}, {AxisId::R, 100.0}};
+    orch.startAbs(targets);
+    for (int c = 0; c < 200 && orch.currentStep() != Step::WaitingMotionFinish; ++c) {
+        orch.tick();
+        rig.driver.pollFeedback(*rig.ctx);
+    }
+    ASSERT_EQ(orch.currentStep(), Step::WaitingMotionFinish);
+    ASSERT_DOUBLE_EQ(rig.axis(AxisId::R).getMoveVelocity(), 25.0);
+
+    rig.plc.forceState(AxisId::Y, AxisState::Error);
+    rig.driver.pollFeedback(*rig.ctx);
+    ASSERT_GE(rig.run(orch, targets), 0);
+    ASSERT_TRUE(orch.hasError());
+
+    for (int c = 0; c < 10; ++c) rig.driver.pollFeedback(*rig.ctx);
+    for (AxisId id : {AxisId::Y, AxisId::R}) {
+        EXPECT_DOUBLE_EQ(rig.axis(id).getMoveVelocity(), PROFILE.moveVelocity);
+    }
+}
+
+TEST(MultiAxisMoveOrchestratorTest, ParallelPoseIsNoSlowerThanLongestSingleMove) {
+    Rig single;
+    AutoAbsMoveOrchestrator abs(single.manager, single.name);
+    abs.startAbs(AxisId::Y, 150.0);
+    int longest = -1;
+    for (int c = 0; c < 5000; ++c) {
+        abs.tick();
+        if (abs.isDone()) { longest = c; break; }
+        single.driver.pollFeedback(*single.ctx);
+    }
+    ASSERT_GT(longest, 0);
+
+    Rig rig;
+    MultiAxisMoveOrchestrator orch(rig.manager, rig.name);
+    const std::vector<MultiAxisMoveOrchestrator::AxisTarget> targets{
+        {AxisId::Y, 150.0}, {AxisId::Z, -30.0}, {AxisId::R, 60.0}};
+    orch.startAbs(targets);
+    const int multi = rig.run(orch, targets);
+    ASSERT_TRUE(orch.isDone());
+    // 额外开销只有同步速度与恢复速度的两次闭环
+    EXPECT_LE(multi, longest + 6);
+}
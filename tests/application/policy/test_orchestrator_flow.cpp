@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include "application/policy/OrchestratorFlow.h"
+#include "application/policy/AutoAbsMoveOrchestrator.h"
+#include "application/policy/JogOrchestrator.h"
+#include "application/SystemManager.h"
+#include "domain/entity/SystemContext.h"
+#include "infrastructure/FakeAxisDriver.h"
+#include "infrastructure/FakePLC.h"
+
+#include <memory>
+#include <vector>
+
+// ============================================================================
+// FlowTask（编排流程协程）测试套件
+// 核心验证点：
+//   1. 创建后挂起，第一次 poll() 才执行到第一个挂起点
+//   2. until() 条件不满足时 poll() 不执行流程代码；wakeMask() 随挂起点变化
+//   3. signal() 无条件唤醒一次（外部事件，如停止点动）
+//   4. reset() / 重新赋值销毁协程帧，挂起点上的局部对象正常析构
+//   5. 点动在使能阶段被停止：直接进入停止序列
+//   6. 数百个流程同时挂起，经唤醒闸门推进全部完成
+// ============================================================================
+
+namespace {
+
+const FakeAxisProfile PROFILE{20.0, 50.0, 1000.0, -1000.0};
+
+struct Probe {
+    int ran = 0;
+    bool ready = false;
+    int* alive = nullptr;
+};
+
+/// @brief 局部对象存活计数（验证协程帧销毁）
+struct Guard {
+    explicit Guard(int& alive) : m_alive(alive) { ++m_alive; }
+    ~Guard() { --m_alive; }
+    int& m_alive;
+};
+
+FlowTask probeFlow(Probe& p) {
+    ++p.ran;
+    co_await until(WakeOn::AxisState | WakeOn::Safety, [&p] { return p.ready; });
+    ++p.ran;
+    co_await nextTick();
+    ++p.ran;
+}
+
+FlowTask guardedFlow(Probe& p) {
+    Guard g(*p.alive);
+    co_await until(WakeOn::AxisPosition, [&p] { return p.ready; });
+    ++p.ran;
+}
+
+} // namespace
+
+TEST(OrchestratorFlowTest, FirstPollRunsToFirstSuspendPoint) {
+    Probe p;
+    FlowTask flow = probeFlow(p);
+    EXPECT_TRUE(flow.active());
+    EXPECT_EQ(p.ran, 0);
+
+    EXPECT_TRUE(flow.poll());
+    EXPECT_EQ(p.ran, 1);
+    EXPECT_EQ(flow.wakeMask(), WakeOn::AxisState | WakeOn::Safety);
+}
+
+TEST(OrchestratorFlowTest, UntilBlocksUntilPredicateHolds) {
+    Probe p;
+    FlowTask flow = probeFlow(p);
+    flow.poll();
+
+    for (int i = 0; i < 5; ++i) EXPECT_FALSE(flow.poll());
+    EXPECT_EQ(p.ran, 1);
+
+    p.ready = true;
+    EXPECT_TRUE(flow.poll());
+    EXPECT_EQ(p.ran, 2);
+    EXPECT_EQ(flow.wakeMask(), WakeOn::EveryTick);
+
+    EXPECT_TRUE(flow.poll());
+    EXPECT_EQ(p.ran, 3);
+    EXPECT_FALSE(flow.active());
+    EXPECT_EQ(flow.wakeMask(), WakeOn::None);
+    EXPECT_FALSE(flow.poll());
+}
+
+TEST(OrchestratorFlowTest, SignalForcesOneResume) {
+    Probe p;
+    FlowTask flow = probeFlow(p);
+    flow.poll();
+
+    flow.signal();
+    EXPECT_EQ(flow.wakeMask(), WakeOn::EveryTick);
+    EXPECT_TRUE(flow.poll());
+    EXPECT_EQ(p.ran, 2);
+    EXPECT_FALSE(p.ready);
+}
+
+TEST(OrchestratorFlowTest, ResetAndReassignDestroySuspendedFrame) {
+    int alive = 0;
+    Probe p;
+    p.alive = &alive;
+
+    FlowTask flow = guardedFlow(p);
+    flow.poll();
+    EXPECT_EQ(alive, 1);
+    flow.reset();
+    EXPECT_EQ(alive, 0);
+    EXPECT_FALSE(flow.active());
+
+    flow = guardedFlow(p);
+    flow.poll();
+    EXPECT_EQ(alive, 1);
+    flow = guardedFlow(p);   // 重新开始：旧帧销毁，新帧尚未执行
+    EXPECT_EQ(alive, 0);
+    flow.poll();
+    p.ready = true;
+    flow.poll();
+    EXPECT_EQ(alive, 0);
+    EXPECT_EQ(p.ran, 1);
+}
+
+TEST(OrchestratorFlowTest, JogStoppedWhileEnablingSkipsToStopSequence) {
+    FakePLC plc{FakePLCConfig::standard(PROFILE)};
+    FakeAxisDriver driver{plc};
+    SystemManager manager;
+    SystemContext* ctx = nullptr;
+    ContextRejection r;
+    manager.createGroup("G", r);
+    manager.tryGetGroup("G", ctx, r);
+    ctx->setDriver(&driver);
+    driver.pollFeedback(*ctx);
+
+    JogOrchestrator orch(manager, "G");
+    orch.startJog(AxisId::Y, Direction::Forward);
+    orch.tick();
+    driver.pollFeedback(*ctx);
+    ASSERT_EQ(orch.currentStep(), JogOrchestrator::Step::EnsuringEnabled);
+
+    orch.stopJog(AxisId::Y, Direction::Forward);
+    EXPECT_EQ(orch.wakeMask(), WakeOn::EveryTick);
+    for (int c = 0; c < 200 && !orch.isDone() && !orch.hasError(); ++c) {
+        orch.tick();
+        driver.pollFeedback(*ctx);
+    }
+    ASSERT_TRUE(orch.isDone());
+    for (int c = 0; c < 5; ++c) driver.pollFeedback(*ctx);
+
+    Axis* axis = nullptr;
+    ctx->tryReadAxis(AxisId::Y, axis, r);
+    EXPECT_EQ(axis->state(), AxisState::Disabled);
+    EXPECT_DOUBLE_EQ(axis->currentAbsolutePosition(), 0.0);
+}
+
+TEST(OrchestratorFlowTest, HundredsOfSuspendedFlowsCompleteThroughWakeGates) {
+    constexpr size_t AXES = 200;
+    FakePLC plc{FakePLCConfig::scaled(AXES + 6, 1, PROFILE)};
+    FakeAxisDriver driver{plc};
+    SystemManager manager;
+    SystemContext* ctx = nullptr;
+    ContextRejection r;
+    manager.createGroup("G", r);
+    manager.tryGetGroup("G", ctx, r);
+    for (size_t n = 0; n < AXES; ++n) ctx->registerAxis(FakePLCConfig::extraAxisId(n));
+    ctx->setDriver(&driver);
+    driver.pollFeedback(*ctx);
+
+    std::vector<std::unique_ptr<AutoAbsMoveOrchestrator>> orchs;
+    std::vector<OrchestratorWakeGate> gates(AXES);
+    for (size_t n = 0; n < AXES; ++n) {
+        orchs.push_back(std::make_unique<AutoAbsMoveOrchestrator>(manager, "G"));
+        orchs.back()->startAbs(FakePLCConfig::extraAxisId(n), 10.0 + static_cast<double>(n % 10));
+        gates[n].arm();
+    }
+
+    int cycles = 0;
+    size_t finished = 0;
+    for (; cycles < 2000 && finished < AXES; ++cycles) {
+        finished = 0;
+        for (size_t n = 0; n < AXES; ++n) {
+            gates[n].drive(*orchs[n], WakeStamp::capture(*ctx, FakePLCConfig::extraAxisId(n)));
+            ASSERT_FALSE(orchs[n]->hasError()) << "axis #" << n;
+            finished += orchs[n]->isDone() ? 1 : 0;
+        }
+        driver.pollFeedback(*ctx);
+    }
+    ASSERT_EQ(finished, AXES);
+
+    uint64_t wakes = 0;
+    for (size_t n = 0; n < AXES; ++n) {
+        Axis* axis = nullptr;
+        ctx->tryReadAxis(FakePLCConfig::extraAxisId(n), axis, r);
+        EXPECT_DOUBLE_EQ(axis->currentAbsolutePosition(), 10.0 + static_cast<double>(n % 10));
+        wakes += gates[n].wakes();
+    }
+    // 挂起中的流程不被推进：总推进次数远小于 轴数 × 周期数
+    EXPECT_LT(wakes, static_cast<uint64_t>(AXES) * static_cast<uint64_t>(cycles) / 3);
+}
@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+#include "application/policy/OrchestratorStepTrace.h"
+#include "application/policy/AutoAbsMoveOrchestrator.h"
+#include "application/policy/GantryOrchestrator.h"
+#include "application/policy/JogOrchestrator.h"
+#include "application/SystemManager.h"
+#include "domain/entity/SystemContext.h"
+#include "infrastructure/FakeAxisDriver.h"
+#include "infrastructure/FakePLC.h"
+
+// ============================================================================
+// OrchestratorStepTrace 测试套件
+// 核心验证点：
+//   1. 步骤停留时长按轴、按步骤入账；终态不计时
+//   2. 链路时钟下的绝对定位：使能延时与运动时长落在各自的步骤里
+//   3. 步骤期限到期 -> Error(StepTimeout)，运动中的轴被停止、静止的轴被掉电，超时计数 +1
+//      龙门流程超时撤回联动请求并掉电龙门电机
+//   4. 点动与龙门编排器同样受期限约束
+// ============================================================================
+
+namespace {
+
+using namespace std::chrono_literals;
+
+const FakeAxisProfile PROFILE{20.0, 50.0, 1000.0, -1000.0};
+
+struct Rig {
+    FakePLC plc{FakePLCConfig::standard(PROFILE)};
+    FakeAxisDriver driver{plc};
+    SystemManager manager;
+    SystemContext* ctx = nullptr;
+    const std::string name = "G";
+
+    Rig() {
+        ContextRejection r;
+        manager.createGroup(name, r);
+        manager.tryGetGroup(name, ctx, r);
+        ctx->setDriver(&driver);
+        driver.pollFeedback(*ctx);
+    }
+
+    Axis& axis(AxisId id) {
+        Axis* a = nullptr;
+        ContextRejection r;
+        ctx->tryReadAxis(id, a, r);
+        return *a;
+    }
+
+    /// @brief 以链路虚拟时钟作为编排器的时间源（每次 pollFeedback 前进 10ms）
+    template<typename Trace>
+    void useLinkClock(Trace& trace) {
+        trace.setClock([this] {
+            return typename Trace::Clock::time_point{} + std::chrono::milliseconds(driver.linkClockMs());
+        });
+    }
+
+    template<typename Orch>
+    void run(Orch& orch) {
+        for (int c = 0; c < 5000 && !orch.isDone() && !orch.hasError(); ++c) {
+            orch.tick();
+            driver.pollFeedback(*ctx);
+        }
+    }
+};
+
+enum class TestStep { Initial, A, B, Done, Error };
+using TestTrace = OrchestratorStepTrace<TestStep, 5>;
+
+} // namespace
+
+TEST(OrchestratorStepTraceTest, RecordsDurationsPerAxisAndSkipsTerminalSteps) {
+    TestTrace trace{TestStep::Initial, TestStep::Done, TestStep::Error};
+    int64_t nowMs = 0;
+    trace.setClock([&] { return TestTrace::Clock::time_point{} + std::chrono::milliseconds(nowMs); });
+
+    trace.begin(AxisId::Y, TestStep::A);
+    nowMs = 30;
+    trace.observe(TestStep::B);
+    nowMs = 100;
+    trace.observe(TestStep::Done);
+    nowMs = 5000;   // 终态停留不入账
+    trace.begin(AxisId::Z, TestStep::A);
+    nowMs = 5020;
+    trace.observe(TestStep::Done);
+
+    EXPECT_EQ(trace.summary(AxisId::Y, TestStep::A).count, 1u);
+    EXPECT_DOUBLE_EQ(trace.summary(AxisId::Y, TestStep::A).maxUs, 30000.0);
+    EXPECT_DOUBLE_EQ(trace.summary(AxisId::Y, TestStep::B).maxUs, 70000.0);
+    EXPECT_DOUBLE_EQ(trace.summary(AxisId::Z, TestStep::A).maxUs, 20000.0);
+    EXPECT_EQ(trace.histogram(AxisId::Y, TestStep::Done)->count(), 0u);
+    EXPECT_EQ(trace.histogram(AxisId::R, TestStep::A), nullptr);
+
+    const auto history = trace.recentTransitions();
+    ASSERT_EQ(history.size(), 5u);
+    EXPECT_EQ(history[2].from, TestStep::B);
+    EXPECT_EQ(history[2].to, TestStep::Done);
+    EXPECT_EQ(history[2].at, TestTrace::Clock::time_point{} + 100ms);
+    EXPECT_EQ(history[3].axis, AxisId::Z);
+}
+
+TEST(OrchestratorStepTraceTest, DeadlineExpiresOnlyForConfiguredActiveStep) {
+    TestTrace trace{TestStep::Initial, TestStep::Done, TestStep::Error};
+    int64_t nowMs = 0;
+    trace.setClock([&] { return TestTrace::Clock::time_point{} + std::chrono::milliseconds(nowMs); });
+    trace.setDeadline(TestStep::B, 50ms);
+
+    trace.begin(AxisId::Y, TestStep::A);
+    nowMs = 1000;
+    EXPECT_FALSE(trace.deadlineExpired());
+    trace.observe(TestStep::B);
+    nowMs = 1049;
+    EXPECT_FALSE(trace.deadlineExpired());
+    nowMs = 1050;
+    EXPECT_TRUE(trace.deadlineExpired());
+    trace.noteTimeout();
+    trace.observe(TestStep::Error);
+    EXPECT_FALSE(trace.deadlineExpired());
+    EXPECT_EQ(trace.timeouts(AxisId::Y, TestStep::B), 1u);
+}
+
+TEST(OrchestratorStepTraceTest, AbsMoveSplitsEnableDelayFromMotion) {
+    Rig rig;
+    AutoAbsMoveOrchestrator orch(rig.manager, rig.name);
+    rig.useLinkClock(orch.stepTrace());
+    orch.startAbs(AxisId::Y, 30.0);
+    rig.run(orch);
+    ASSERT_TRUE(orch.isDone());
+
+    using Step = AutoAbsMoveOrchestrator::Step;
+    const auto& trace = orch.stepTrace();
+    const double enableMs = trace.summary(AxisId::Y, Step::EnsuringEnabled).maxUs / 1000.0;
+    const double motionMs = trace.summary(AxisId::Y, Step::WaitingMotionFinish).maxUs / 1000.0;
+
+    // FakePLC：使能延时 150ms；30mm @ 50mm/s = 600ms
+    EXPECT_GE(enableMs, 150.0);
+    EXPECT_LE(enableMs, 180.0);
+    EXPECT_GE(motionMs, 560.0);
+    EXPECT_LE(motionMs, 640.0);
+    EXPECT_EQ(trace.summary(AxisId::Y, Step::IssuingMove).count, 1u);
+    EXPECT_EQ(trace.timeouts(AxisId::Y, Step::EnsuringEnabled), 0u);
+}
+
+TEST(OrchestratorStepTraceTest, EnableDeadlineAbortsMoveWithStepTimeout) {
+    Rig rig;
+    AutoAbsMoveOrchestrator orch(rig.manager, rig.name);
+    using Step = AutoAbsMoveOrchestrator::Step;
+    rig.useLinkClock(orch.stepTrace());
+    orch.stepTrace().setDeadline(Step::EnsuringEnabled, 50ms);
+
+    orch.startAbs(AxisId::Y, 30.0);
+    rig.run(orch);
+    ASSERT_TRUE(orch.hasError());
+    ASSERT_TRUE(std::holds_alternative<OrchestratorRejection>(orch.lastError()));
+    EXPECT_EQ(std::get<OrchestratorRejection>(orch.lastError()), OrchestratorRejection::StepTimeout);
+    EXPECT_EQ(orch.stepTrace().timeouts(AxisId::Y, Step::EnsuringEnabled), 1u);
+
+    for (int c = 0; c < 30; ++c) rig.driver.pollFeedback(*rig.ctx);
+    EXPECT_EQ(rig.axis(AxisId::Y).state(), AxisState::Disabled);
+    EXPECT_DOUBLE_EQ(rig.axis(AxisId::Y).currentAbsolutePosition(), 0.0);
+
+    // 超时不影响下一次流程（期限放宽后正常完成）
+    orch.stepTrace().setDeadline(Step::EnsuringEnabled, 0ms);
+    orch.startAbs(AxisId::Y, 30.0);
+    rig.run(orch);
+    EXPECT_TRUE(orch.isDone());
+}
+
+TEST(OrchestratorStepTraceTest, JogDeadlineStopsRunawayJog) {
+    Rig rig;
+    JogOrchestrator orch(rig.manager, rig.name);
+    using Step = JogOrchestrator::Step;
+    rig.useLinkClock(orch.stepTrace());
+    orch.stepTrace().setDeadline(Step::Jogging, 500ms);
+
+    orch.startJog(AxisId::Y, Direction::Forward);
+    rig.run(orch);
+    ASSERT_TRUE(orch.hasError());
+    EXPECT_EQ(std::get<OrchestratorRejection>(orch.lastError()), OrchestratorRejection::StepTimeout);
+    EXPECT_EQ(orch.stepTrace().timeouts(AxisId::Y, Step::Jogging), 1u);
+
+    // 运动中超时：停止而不是掉电
+    for (int c = 0; c < 30; ++c) rig.driver.pollFeedback(*rig.ctx);
+    EXPECT_EQ(rig.axis(AxisId::Y).state(), AxisState::Idle);
+    const double stoppedAt = rig.axis(AxisId::Y).currentAbsolutePosition();
+    for (int c = 0; c < 30; ++c) rig.driver.pollFeedback(*rig.ctx);
+    EXPECT_DOUBLE_EQ(rig.axis(AxisId::Y).currentAbsolutePosition(), stoppedAt);
+    EXPECT_LT(stoppedAt, 20.0);
+}
+
+TEST(OrchestratorStepTraceTest, GantryStepsAreTracedAndBounded) {
+    using Step = GantryOrchestrator::Step;
+    {
+        Rig rig;
+        GantryOrchestrator orch(rig.manager, rig.name);
+        rig.useLinkClock(orch.stepTrace());
+        orch.startCoupling();
+        rig.run(orch);
+        ASSERT_TRUE(orch.isDone());
+        EXPECT_EQ(orch.stepTrace().summary(AxisId::X, Step::WaitingEnabled).count, 1u);
+        EXPECT_EQ(orch.stepTrace().summary(AxisId::X, Step::WaitingCoupled).count, 1u);
+        EXPECT_GT(orch.stepTrace().summary(AxisId::X, Step::WaitingEnabled).maxUs, 0.0);
+    }
+    {
+        Rig rig;
+        GantryOrchestrator orch(rig.manager, rig.name);
+        rig.useLinkClock(orch.stepTrace());
+        orch.stepTrace().setDeadline(Step::WaitingEnabled, 10ms);
+        orch.startCoupling();
+        rig.run(orch);
+        ASSERT_TRUE(orch.hasError());
+        EXPECT_EQ(std::get<OrchestratorRejection>(orch.lastError()), OrchestratorRejection::StepTimeout);
+        EXPECT_EQ(orch.stepTrace().timeouts(AxisId::X, Step::WaitingEnabled), 1u);
+    }
+}
+
+TEST(OrchestratorStepTraceTest, GantryTimeoutWithdrawsCouplingAndDropsPower) {
+    using Step = GantryOrchestrator::Step;
+    Rig rig;
+    GantryOrchestrator orch(rig.manager, rig.name);
+    rig.useLinkClock(orch.stepTrace());
+    orch.stepTrace().setDeadline(Step::WaitingCoupled, 20ms);
+    orch.startCoupling();
+    rig.run(orch);
+    ASSERT_TRUE(orch.hasError());
+    EXPECT_EQ(std::get<OrchestratorRejection>(orch.lastError()), OrchestratorRejection::StepTimeout);
+
+    // 超时时联动请求尚未被 PLC 判定；撤回与掉电生效后龙门回到解耦 + 掉电
+    for (int c = 0; c < 50; ++c) rig.driver.pollFeedback(*rig.ctx);
+    EXPECT_FALSE(rig.plc.getGantryFeedback().isCoupled);
+    EXPECT_FALSE(rig.plc.getGantryFeedback().enable);
+    EXPECT_EQ(rig.ctx->gantryCouplingController().status(), GantryCouplingState::Status::Decoupled);
+    EXPECT_EQ(rig.ctx->gantryPowerController().status(), GantryPowerController::Status::Disabled);
+}
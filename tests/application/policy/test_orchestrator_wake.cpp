@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include "application/policy/OrchestratorWake.h"
+#include "application/policy/AutoAbsMoveOrchestrator.h"
+#include "application/policy/JogOrchestrator.h"
+#include "application/safety/EmergencyStopUseCase.h"
+#include "application/SystemManager.h"
+#include "domain/entity/SystemContext.h"
+#include "infrastructure/FakeAxisDriver.h"
+#include "infrastructure/FakePLC.h"
+
+// ============================================================================
+// OrchestratorWakeGate 测试套件
+// 核心验证点：
+//   1. 终态编排器（Initial / Done / Error）不被推进
+//   2. 等待步骤只在声明的变化发生时推进，长时间匀速段仅靠心跳推进
+//   3. 按需推进与逐帧推进的完成周期数一致
+//   4. 急停锁定作为 Safety 变化唤醒活动中的编排器
+// ============================================================================
+
+namespace {
+
+const FakeAxisProfile PROFILE{20.0, 50.0, 1000.0, -1000.0};
+
+struct Rig {
+    FakePLC plc{FakePLCConfig::standard(PROFILE)};
+    FakeAxisDriver driver{plc};
+    SystemManager manager;
+    SystemContext* ctx = nullptr;
+    const std::string name = "G";
+
+    Rig() {
+        ContextRejection r;
+        manager.createGroup(name, r);
+        manager.tryGetGroup(name, ctx, r);
+        ctx->setDriver(&driver);
+        driver.pollFeedback(*ctx);   // 首帧完成安全 / 龙门同步
+    }
+
+    WakeStamp stamp(AxisId id = AxisId::Y) { return WakeStamp::capture(*ctx, id); }
+};
+
+/// @brief 驱动一次 Y 轴绝对定位；gated == true 时经由唤醒闸门推进，返回完成周期数（失败 -1）
+int runAbsMove(Rig& rig, double target, bool gated, uint64_t* wakes = nullptr) {
+    AutoAbsMoveOrchestrator orch(rig.manager, rig.name);
+    OrchestratorWakeGate gate;
+    orch.startAbs(AxisId::Y, target);
+    gate.arm();
+    for (int c = 0; c < 2000; ++c) {
+        if (gated) {
+            gate.drive(orch, rig.stamp());
+        } else {
+            orch.tick();
+        }
+        if (orch.isDone()) {
+            if (wakes) *wakes = gate.wakes();
+            return c;
+        }
+        if (orch.hasError()) return -1;
+        rig.driver.pollFeedback(*rig.ctx);
+    }
+    return -1;
+}
+
+} // namespace
+
+TEST(OrchestratorWakeTest, TerminalStepsAreNeverWoken) {
+    Rig rig;
+    AutoAbsMoveOrchestrator orch(rig.manager, rig.name);
+    OrchestratorWakeGate gate;
+    EXPECT_EQ(orch.wakeMask(), WakeOn::None);
+
+    for (int c = 0; c < 100; ++c) {
+        EXPECT_FALSE(gate.drive(orch, rig.stamp()));
+        rig.driver.pollFeedback(*rig.ctx);
+    }
+    EXPECT_EQ(gate.wakes(), 0u);
+    EXPECT_EQ(orch.currentStep(), AutoAbsMoveOrchestrator::Step::Initial);
+}
+
+TEST(OrchestratorWakeTest, ArmWakesOnceThenWaitsForDeclaredChange) {
+    OrchestratorWakeGate gate;
+    WakeStamp s;
+    const WakeOn mask = WakeOn::AxisState | WakeOn::Safety;
+
+    gate.arm();
+    EXPECT_TRUE(gate.shouldWake(mask, s));
+    EXPECT_FALSE(gate.shouldWake(mask, s));
+
+    // 位置变化不在掩码内
+    s.axisPosition = 7;
+    EXPECT_FALSE(gate.shouldWake(mask, s));
+
+    s.axisState = 1;
+    EXPECT_TRUE(gate.shouldWake(mask, s));
+    EXPECT_FALSE(gate.shouldWake(mask, s));
+
+    s.safety = 3;
+    EXPECT_TRUE(gate.shouldWake(mask, s));
+    EXPECT_TRUE(gate.shouldWake(WakeOn::EveryTick, s));
+}
+
+TEST(OrchestratorWakeTest, HeartbeatWakesActiveStepWithoutChanges) {
+    OrchestratorWakeGate gate;
+    const WakeStamp s;
+    const WakeOn mask = WakeOn::AxisState;
+
+    int woken = 0;
+    for (uint32_t i = 0; i < 10 * OrchestratorWakeGate::HEARTBEAT_TICKS; ++i) {
+        woken += gate.shouldWake(mask, s) ? 1 : 0;
+    }
+    EXPECT_EQ(woken, 10);
+    for (uint32_t i = 0; i < 10 * OrchestratorWakeGate::HEARTBEAT_TICKS; ++i) {
+        EXPECT_FALSE(gate.shouldWake(WakeOn::None, s));
+    }
+}
+
+TEST(OrchestratorWakeTest, GatedMoveFinishesOnSameCycleWithFewerWakes) {
+    Rig ticked;
+    const int everyTick = runAbsMove(ticked, 150.0, false);
+    ASSERT_GT(everyTick, 0);
+
+    Rig gatedRig;
+    uint64_t wakes = 0;
+    EXPECT_EQ(runAbsMove(gatedRig, 150.0, true, &wakes), everyTick);
+    // 匀速段状态不变，只靠心跳推进
+    EXPECT_LT(wakes, static_cast<uint64_t>(everyTick) / 4);
+}
+
+TEST(OrchestratorWakeTest, SafetyLockWakesActiveJog) {
+    Rig rig;
+    JogOrchestrator orch(rig.manager, rig.name);
+    OrchestratorWakeGate gate;
+    orch.startJog(AxisId::Y, Direction::Forward);
+    gate.arm();
+    for (int c = 0; c < 20 && orch.currentStep() != JogOrchestrator::Step::Jogging; ++c) {
+        gate.drive(orch, rig.stamp());
+        rig.driver.pollFeedback(*rig.ctx);
+    }
+    ASSERT_EQ(orch.currentStep(), JogOrchestrator::Step::Jogging);
+
+    // 让上一次推进后的变化全部被消化
+    for (uint32_t c = 0; c < OrchestratorWakeGate::HEARTBEAT_TICKS; ++c) {
+        gate.drive(orch, rig.stamp());
+        rig.driver.pollFeedback(*rig.ctx);
+    }
+    ASSERT_EQ(orch.currentStep(), JogOrchestrator::Step::Jogging);
+
+    EmergencyStopUseCase{}.execute(rig.manager, rig.name);
+    EXPECT_TRUE(gate.drive(orch, rig.stamp()));
+    EXPECT_TRUE(orch.isDone());
+}
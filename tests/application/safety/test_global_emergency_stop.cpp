@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+#include "application/safety/GlobalEmergencyStopUseCase.h"
+#include "application/safety/EmergencyStopLatencyProbe.h"
+#include "application/safety/EmergencyStopUseCase.h"
+#include "application/SystemManager.h"
+#include "domain/entity/SystemContext.h"
+#include "infrastructure/FakeAxisDriver.h"
+#include "infrastructure/FakePLC.h"
+#include "infrastructure/RetryingDriver.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// GlobalEmergencyStopUseCase / EmergencyStopLatencyProbe 测试套件（FakePLC 闭环）
+// 核心验证点：
+//   1. 一次调用对全部分组下发急停（经 sendUrgent 插队），全部到达 EmergencyStopped
+//   2. 已在急停中的分组视为成功；单个分组失败不中断其余分组，重试时补发
+//   3. 探针记录每个分组的确认延迟：不早于 PLC 急停生效延时，且有上界；
+//      失败分组使最坏值为无穷大，已在急停中的分组单独计数、不计入延迟统计
+//   4. 典型链路 + 排队中的运动命令下，最坏确认延迟仍在预算内
+// ============================================================================
+
+namespace {
+
+using namespace std::chrono_literals;
+
+/// @brief 多分组全栈：每组 FakePLC -> FakeAxisDriver(链路模型) -> RetryingDriver(虚拟时钟)
+struct FleetRig {
+    struct Group {
+        std::string name;
+        std::unique_ptr<FakePLC> plc;
+        std::unique_ptr<FakeAxisDriver> raw;
+        std::unique_ptr<RetryingDriver> driver;
+        SystemContext* ctx = nullptr;
+    };
+
+    SystemManager manager;
+    std::vector<Group> groups;
+    RetryingDriver::Clock::time_point retryNow{};
+    EmergencyStopLatencyProbe probe;
+
+    explicit FleetRig(size_t count, const LinkModel& link = LinkModel::ideal()) {
+        for (size_t i = 0; i < count; ++i) {
+            Group g;
+            g.name = "G" + std::to_string(i);
+            g.plc = std::make_unique<FakePLC>();
+            g.raw = std::make_unique<FakeAxisDriver>(*g.plc);
+            LinkModel perGroup = link;
+            perGroup.seed = link.seed + static_cast<uint32_t>(i);
+            g.raw->setLinkModel(perGroup);
+            g.driver = std::make_unique<RetryingDriver>(*g.raw);
+            g.driver->setClock([this] { return retryNow; });
+            ContextRejection r;
+            manager.createGroup(g.name, r);
+            manager.tryGetGroup(g.name, g.ctx, r);
+            g.ctx->setDriver(g.driver.get());
+            groups.push_back(std::move(g));
+        }
+        probe.setClock([this] {
+            return EmergencyStopLatencyProbe::Clock::time_point{}
+                + std::chrono::milliseconds(groups.front().raw->linkClockMs());
+        });
+        // 等待全部分组完成首次同步
+        for (int c = 0; c < 50 && !synced(); ++c) cycle();
+    }
+
+    bool synced() const {
+        for (const auto& g : groups) {
+            if (g.ctx->emergencyStopController().isNotSynchronized()) return false;
+        }
+        return true;
+    }
+
+    /// @brief 一个主循环周期：全部分组 poll，随后探针检查
+    void cycle() {
+        retryNow += std::chrono::milliseconds(FakeAxisDriver::CYCLE_MS);
+        for (auto& g : groups) g.driver->pollFeedback(*g.ctx);
+        probe.poll();
+    }
+
+    /// @brief 推进直到探针全部确认；返回所用周期数（超时 -1）
+    int untilConfirmed(int maxCycles = 200) {
+        for (int c = 0; c < maxCycles; ++c) {
+            if (probe.allConfirmed()) return c;
+            cycle();
+        }
+        return -1;
+    }
+};
+
+} // namespace
+
+TEST(GlobalEmergencyStopTest, FansOutToEveryGroupInOnePass) {
+    FleetRig rig(3);
+    ASSERT_TRUE(rig.synced());
+
+    auto result = GlobalEmergencyStopUseCase{}.execute(rig.manager, &rig.probe);
+    ASSERT_TRUE(std::holds_alternative<std::monostate>(result));
+    EXPECT_EQ(rig.probe.pending(), 3u);
+    for (const auto& g : rig.groups) {
+        EXPECT_EQ(g.raw->linkStats().urgentSends, 1u) << g.name;
+        EXPECT_EQ(g.ctx->emergencyStopController().state(), SafetyState::EmergencyStopping) << g.name;
+    }
+
+    ASSERT_GE(rig.untilConfirmed(), 0);
+    const auto& outcome = rig.probe.lastRequest();
+    ASSERT_EQ(outcome.size(), 3u);
+    for (const auto& g : outcome) {
+        EXPECT_TRUE(g.confirmed) << g.groupName;
+        EXPECT_GE(g.latency, std::chrono::milliseconds(EMERGENCY_STOP_ENGAGE_DELAY_MS)) << g.groupName;
+    }
+    EXPECT_LE(rig.probe.worstCase(),
+              std::chrono::milliseconds(EMERGENCY_STOP_ENGAGE_DELAY_MS + 2 * FakeAxisDriver::CYCLE_MS));
+    EXPECT_EQ(rig.probe.summary().count, 3u);
+    for (const auto& g : rig.groups) {
+        EXPECT_TRUE(g.ctx->emergencyStopController().isEmergencyStopped()) << g.name;
+    }
+}
+
+TEST(GlobalEmergencyStopTest, GroupAlreadyStoppingCountsAsAccepted) {
+    FleetRig rig(2);
+    ASSERT_TRUE(std::holds_alternative<std::monostate>(EmergencyStopUseCase{}.execute(rig.manager, "G0")));
+    for (int c = 0; c < 2; ++c) rig.cycle();
+
+    auto result = GlobalEmergencyStopUseCase{}.execute(rig.manager, &rig.probe);
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(result));
+    ASSERT_GE(rig.untilConfirmed(), 0);
+    ASSERT_EQ(rig.probe.lastRequest().size(), 2u);
+    // G0 在全局请求之前已开始急停，确认得更早，但不计入延迟统计
+    EXPECT_LT(rig.probe.lastRequest()[0].latency, rig.probe.lastRequest()[1].latency);
+    EXPECT_TRUE(rig.probe.lastRequest()[0].alreadyInState);
+    EXPECT_FALSE(rig.probe.lastRequest()[1].alreadyInState);
+    EXPECT_EQ(rig.probe.alreadyInState(), 1u);
+    EXPECT_EQ(rig.probe.summary().count, 1u);
+    EXPECT_EQ(rig.probe.worstCase(), rig.probe.lastRequest()[1].latency);
+    EXPECT_EQ(rig.probe.lastWorstCase(), rig.probe.lastRequest()[1].latency);
+}
+
+TEST(GlobalEmergencyStopTest, FailingGroupDoesNotAbortFanOut) {
+    FleetRig rig(3);
+    rig.groups[1].raw->disconnect();
+
+    auto result = GlobalEmergencyStopUseCase{}.execute(rig.manager, &rig.probe);
+    ASSERT_TRUE(std::holds_alternative<CommunicationResult>(result));
+    EXPECT_EQ(std::get<CommunicationResult>(result).status, CommunicationResult::Status::Disconnected);
+    EXPECT_EQ(rig.probe.pending(), 2u);
+
+    ASSERT_GE(rig.untilConfirmed(), 0);
+    EXPECT_TRUE(rig.groups[0].plc->getEmergencyStopFeedback());
+    EXPECT_FALSE(rig.groups[1].plc->getEmergencyStopFeedback());
+    EXPECT_TRUE(rig.groups[2].plc->getEmergencyStopFeedback());
+
+    // 失败的分组记为未确认，最坏值视为无穷大（不会通过任何预算）
+    ASSERT_EQ(rig.probe.lastRequest().size(), 3u);
+    EXPECT_TRUE(rig.probe.lastRequest()[1].failed);
+    EXPECT_FALSE(rig.probe.lastRequest()[1].confirmed);
+    EXPECT_EQ(rig.probe.failures(), 1u);
+    EXPECT_EQ(rig.probe.lastWorstCase(), std::chrono::nanoseconds::max());
+    EXPECT_EQ(rig.probe.worstCase(), std::chrono::nanoseconds::max());
+    EXPECT_EQ(rig.probe.summary().count, 2u);
+
+    // 链路恢复后再次请求：G1 仍在 EmergencyStopping，补发急停命令
+    rig.groups[1].raw->connect();
+    result = GlobalEmergencyStopUseCase{}.execute(rig.manager, &rig.probe);
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(result));
+    ASSERT_GE(rig.untilConfirmed(), 0);
+    EXPECT_TRUE(rig.groups[1].plc->getEmergencyStopFeedback());
+    EXPECT_EQ(rig.probe.requests(), 2u);
+    // 第二次请求时三组都已在急停流程中：单独计数，延迟统计不变
+    EXPECT_EQ(rig.probe.alreadyInState(), 3u);
+    EXPECT_EQ(rig.probe.summary().count, 2u);
+    EXPECT_NE(rig.probe.lastWorstCase(), std::chrono::nanoseconds::max());
+    EXPECT_EQ(rig.probe.worstCase(), std::chrono::nanoseconds::max());
+}
+
+TEST(GlobalEmergencyStopTest, ProbeStopsTrackingRemovedGroup) {
+    FleetRig rig(2);
+    GlobalEmergencyStopUseCase{}.execute(rig.manager, &rig.probe);
+    rig.manager.removeGroup("G1");
+
+    for (int c = 0; c < 20; ++c) {
+        rig.groups[0].driver->pollFeedback(*rig.groups[0].ctx);
+        rig.probe.poll();
+    }
+    EXPECT_TRUE(rig.probe.allConfirmed());
+    EXPECT_TRUE(rig.probe.lastRequest()[0].confirmed);
+    EXPECT_FALSE(rig.probe.lastRequest()[1].confirmed);
+}
+
+TEST(GlobalEmergencyStopTest, WorstCaseLatencyBoundedUnderTypicalLinkWithQueuedMotion) {
+    // 预算：命令单程最大 20ms + PLC 急停生效 50ms + 反馈最大陈旧度 20ms + 丢帧 / 周期取整余量
+    constexpr auto BUDGET = std::chrono::milliseconds(150);
+
+    EmergencyStopLatencyProbe::Clock::duration worst{0};
+    for (uint32_t seed = 1; seed <= 20; ++seed) {
+        FleetRig rig(4, LinkModel::typical(seed * 100));
+        ASSERT_TRUE(rig.synced()) << "seed " << seed;
+
+        // 每组都有排队中的运动命令
+        for (auto& g : rig.groups) {
+            for (auto id : g.plc->axisIds()) {
+                g.driver->send(AxisCommandWithId{id, EnableCommand{true}});
+                g.driver->send(AxisCommandWithId{id, MoveCommand{MoveType::Absolute, 30.0, 0.0}});
+            }
+        }
+        GlobalEmergencyStopUseCase{}.execute(rig.manager, &rig.probe);
+        ASSERT_GE(rig.untilConfirmed(), 0) << "seed " << seed;
+        EXPECT_EQ(rig.probe.lastRequest().size(), 4u) << "seed " << seed;
+        worst = std::max<EmergencyStopLatencyProbe::Clock::duration>(worst, rig.probe.worstCase());
+    }
+    EXPECT_LE(worst, BUDGET);
+}
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <variant>
+#include "application/axis/AxisHandle.h"
+#include "application/axis/EnableUseCase.h"
+#include "application/axis/JogAxisUseCase.h"
+#include "application/axis/MoveAbsoluteUseCase.h"
+#include "application/axis/StopAxisUseCase.h"
+#include "application/safety/EmergencyStopUseCase.h"
+#include "application/SystemManager.h"
+#include "domain/entity/SystemContext.h"
+#include "infrastructure/FakeAxisDriver.h"
+#include "infrastructure/FakePLC.h"
+
+// ============================================================
+// AxisHandle 测试套件
+//
+// 核心验证点：
+//   1. 首次获取后缓存分组 / 轴，用例经句柄下发与按名称下发结果一致
+//   2. 缓存命中时仍逐次做安全锁定与龙门语义校验
+//   3. 分组移除 / 轴登记 / 驱动替换使代数变化，句柄重新查找（不悬空）
+// ============================================================
+
+namespace {
+
+const FakeAxisProfile PROFILE{20.0, 50.0, 1000.0, -1000.0};
+
+template<typename T>
+T expectError(const UseCaseError& err) {
+    EXPECT_TRUE(std::holds_alternative<T>(err))
+        << "Expected error type " << typeid(T).name()
+        << " but got variant index " << err.index();
+    return std::holds_alternative<T>(err) ? std::get<T>(err) : T{};
+}
+
+inline void expectSuccess(const UseCaseError& err) {
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(err))
+        << "Expected success (monostate) but got variant index " << err.index();
+}
+
+class AxisHandleTest : public ::testing::Test {
+protected:
+    FakePLC plc{FakePLCConfig::standard(PROFILE)};
+    FakeAxisDriver driver{plc};
+    SystemManager manager;
+    SystemContext* ctx = nullptr;
+
+    static constexpr const char* GROUP = "Machine_A";
+
+    void SetUp() override {
+        ContextRejection reason;
+        ASSERT_TRUE(manager.createGroup(GROUP, reason));
+        ASSERT_TRUE(manager.tryGetGroup(GROUP, ctx, reason));
+        ctx->setDriver(&driver);
+        driver.pollFeedback(*ctx);   // 首帧完成安全 / 龙门同步
+    }
+
+    void settle(int cycles = 20) {
+        for (int c = 0; c < cycles; ++c) driver.pollFeedback(*ctx);
+    }
+
+    Axis& axis(AxisId id) {
+        Axis* a = nullptr;
+        ContextRejection r;
+        ctx->tryReadAxis(id, a, r);
+        return *a;
+    }
+};
+
+} // namespace
+
+TEST_F(AxisHandleTest, UseCasesRunThroughBoundHandle) {
+    AxisHandle y(manager, GROUP, AxisId::Y);
+    EXPECT_FALSE(y.isCurrent());
+
+    expectSuccess(EnableUseCase{}.execute(y, true));
+    EXPECT_TRUE(y.isCurrent());
+    EXPECT_EQ(y.context(), ctx);
+    settle();
+    ASSERT_EQ(axis(AxisId::Y).state(), AxisState::Idle);
+
+    expectSuccess(MoveAbsoluteUseCase{}.execute(y, 10.0));
+    settle(60);
+    EXPECT_DOUBLE_EQ(axis(AxisId::Y).currentAbsolutePosition(), 10.0);
+
+    expectSuccess(JogAxisUseCase{}.execute(y, Direction::Forward));
+    settle(5);
+    JogAxisUseCase{}.stop(y, Direction::Forward);
+    settle();
+    EXPECT_EQ(axis(AxisId::Y).state(), AxisState::Idle);
+    expectSuccess(StopAxisUseCase{}.execute(y));
+
+    // 领域层拒绝原样返回
+    EXPECT_EQ(expectError<RejectionReason>(MoveAbsoluteUseCase{}.execute(y, 5000.0)),
+              RejectionReason::TargetOutOfPositiveLimit);
+    EXPECT_TRUE(y.isCurrent());
+}
+
+TEST_F(AxisHandleTest, CachedHandleStillChecksSafetyAndGantry) {
+    AxisHandle y(manager, GROUP, AxisId::Y);
+    AxisHandle x(manager, GROUP, AxisId::X);
+    expectSuccess(EnableUseCase{}.execute(y, true));
+
+    // 解耦状态下逻辑轴 X 不可用，与 tryGetAxis 一致
+    EXPECT_EQ(expectError<ContextRejection>(EnableUseCase{}.execute(x, true)),
+              ContextRejection::LogicalAxisUnavailableWhenDecoupled);
+    EXPECT_FALSE(x.isCurrent());
+
+    EmergencyStopUseCase{}.execute(manager, GROUP);
+    settle();
+    EXPECT_EQ(expectError<ContextRejection>(EnableUseCase{}.execute(y, false)),
+              ContextRejection::SystemSafetyLocked);
+    EXPECT_TRUE(y.isCurrent());
+}
+
+TEST_F(AxisHandleTest, RemovedGroupIsNotDereferenced) {
+    AxisHandle y(manager, GROUP, AxisId::Y);
+    expectSuccess(EnableUseCase{}.execute(y, true));
+    ASSERT_TRUE(y.isCurrent());
+
+    manager.removeGroup(GROUP);
+    ctx = nullptr;
+    EXPECT_FALSE(y.isCurrent());
+    EXPECT_EQ(expectError<ContextRejection>(EnableUseCase{}.execute(y, true)),
+              ContextRejection::GroupNotFound);
+
+    // 同名分组重建后自动重新绑定
+    ContextRejection reason;
+    ASSERT_TRUE(manager.createGroup(GROUP, reason));
+    ASSERT_TRUE(manager.tryGetGroup(GROUP, ctx, reason));
+    ctx->setDriver(&driver);
+    driver.pollFeedback(*ctx);
+    expectSuccess(EnableUseCase{}.execute(y, true));
+    EXPECT_EQ(y.context(), ctx);
+}
+
+TEST_F(AxisHandleTest, StructuralChangesInvalidateCache) {
+    AxisHandle y(manager, GROUP, AxisId::Y);
+    expectSuccess(EnableUseCase{}.execute(y, true));
+    ASSERT_TRUE(y.isCurrent());
+
+    const uint64_t before = ctx->generation();
+    EXPECT_FALSE(ctx->registerAxis(AxisId::Y));   // 已存在：不变
+    EXPECT_EQ(ctx->generation(), before);
+    EXPECT_TRUE(ctx->registerAxis(FakePLCConfig::extraAxisId(0)));
+    EXPECT_FALSE(y.isCurrent());
+    expectSuccess(StopAxisUseCase{}.execute(y));
+    EXPECT_TRUE(y.isCurrent());
+
+    ctx->setDriver(&driver);
+    EXPECT_FALSE(y.isCurrent());
+
+    // 改绑到另一根轴：下一次获取重新查找
+    y.rebind(AxisId::Z);
+    expectSuccess(EnableUseCase{}.execute(y, true));
+    EXPECT_EQ(y.id(), AxisId::Z);
+    settle();
+    EXPECT_EQ(axis(AxisId::Z).state(), AxisState::Idle);
+}
+
+TEST_F(AxisHandleTest, UnknownGroupOrAxisIsRejected) {
+    AxisHandle missing(manager, "NoSuchGroup", AxisId::Y);
+    EXPECT_EQ(expectError<ContextRejection>(EnableUseCase{}.execute(missing, true)),
+              ContextRejection::GroupNotFound);
+
+    AxisHandle unregistered(manager, GROUP, FakePLCConfig::extraAxisId(7));
+    EXPECT_EQ(expectError<ContextRejection>(StopAxisUseCase{}.execute(unregistered)),
+              ContextRejection::AxisNotRegistered);
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include "application/GroupPollScheduler.h"
+#include "application/SystemManager.h"
+#include "infrastructure/FakeAxisDriver.h"
+#include "infrastructure/FakePLC.h"
+#include "infrastructure/utils/FixedThreadPool.h"
+
+// ============================================================
+// GroupPollScheduler / FixedThreadPool 测试套件
+//
+// 验证点：
+//   1. parallelFor 每个下标恰好执行一次，且可反复调用
+//   2. 每个分组的 pollFeedback 每轮恰好执行一次，分组之间真正并行
+//   3. 急停 pending command 在反馈阶段被消费并下发到本分组驱动
+// ============================================================
+
+namespace {
+
+/// 记录并发度的驱动替身：每次 poll 睡眠一小段时间，统计同时在途的 poll 数
+class ConcurrencyProbeDriver : public ISystemDriver {
+public:
+    static inline std::atomic<int> inFlight{0};
+    static inline std::atomic<int> maxInFlight{0};
+    std::atomic<int> polls{0};
+
+    CommunicationResult send(const SystemCommand&) override { return {}; }
+
+    void pollFeedback(SystemContext&) override {
+        int now = ++inFlight;
+        int prev = maxInFlight.load();
+        while (now > prev && !maxInFlight.compare_exchange_weak(prev, now)) {}
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        --inFlight;
+        ++polls;
+    }
+};
+
+} // namespace
+
+TEST(FixedThreadPoolTest, RunsEveryIndexExactlyOnce) {
+    FixedThreadPool pool(3);
+    std::vector<std::atomic<int>> hits(100);
+
+    for (int round = 0; round < 50; ++round) {
+        pool.parallelFor(hits.size(), [&](size_t i) { ++hits[i]; });
+    }
+    for (auto& h : hits) EXPECT_EQ(h.load(), 50);
+}
+
+TEST(FixedThreadPoolTest, ZeroWorkersRunsInline) {
+    FixedThreadPool pool(0);
+    auto caller = std::this_thread::get_id();
+    int count = 0;
+    pool.parallelFor(5, [&](size_t) {
+        EXPECT_EQ(std::this_thread::get_id(), caller);
+        ++count;
+    });
+    EXPECT_EQ(count, 5);
+}
+
+class GroupPollSchedulerTest : public ::testing::Test {
+protected:
+    SystemManager manager;
+
+    SystemContext* addGroup(const std::string& name, ISystemDriver& drv) {
+        ContextRejection r;
+        EXPECT_TRUE(manager.createGroup(name, r));
+        SystemContext* ctx = nullptr;
+        EXPECT_TRUE(manager.tryGetGroup(name, ctx, r));
+        ctx->setDriver(&drv);
+        return ctx;
+    }
+};
+
+TEST_F(GroupPollSchedulerTest, PollsAllGroupsInParallel) {
+    constexpr int GROUPS = 4;
+    std::vector<std::unique_ptr<ConcurrencyProbeDriver>> drivers;
+    for (int i = 0; i < GROUPS; ++i) {
+        drivers.push_back(std::make_unique<ConcurrencyProbeDriver>());
+        addGroup("G" + std::to_string(i), *drivers.back());
+    }
+    ConcurrencyProbeDriver::maxInFlight = 0;
+
+    GroupPollScheduler scheduler(manager, GROUPS - 1);
+    scheduler.pollAll();
+    scheduler.pollAll();
+
+    for (auto& d : drivers) EXPECT_EQ(d->polls.load(), 2);
+    EXPECT_EQ(ConcurrencyProbeDriver::inFlight.load(), 0);   // pollAll 返回时全部已 join
+    EXPECT_GT(ConcurrencyProbeDriver::maxInFlight.load(), 1);
+}
+
+TEST_F(GroupPollSchedulerTest, SkipsGroupsWithoutDriver) {
+    ContextRejection r;
+    ASSERT_TRUE(manager.createGroup("NoDriver", r));
+    ConcurrencyProbeDriver drv;
+    addGroup("WithDriver", drv);
+
+    GroupPollScheduler scheduler(manager, 2);
+    scheduler.pollAll();
+
+    EXPECT_EQ(drv.polls.load(), 1);
+}
+
+TEST_F(GroupPollSchedulerTest, FeedsFakePlcAndConsumesEmergencyStop) {
+    FakePLC plcA, plcB;
+    FakeAxisDriver driverA(plcA), driverB(plcB);
+    SystemContext* ctxA = addGroup("Machine_A", driverA);
+    SystemContext* ctxB = addGroup("Machine_B", driverB);
+
+    GroupPollScheduler scheduler(manager, 1);
+    scheduler.pollAll();   // 首次同步：急停控制器 NotSynchronized -> Running
+    ASSERT_FALSE(ctxA->emergencyStopController().isSystemLocked());
+
+    ASSERT_EQ(ctxA->emergencyStopController().requestEmergencyStop(), SafetyRejection::None);
+
+    // 反馈阶段消费 pending command -> 写入 A 组 PLC，B 组不受影响
+    for (int i = 0; i < 20; ++i) scheduler.pollAll();
+
+    EXPECT_FALSE(ctxA->emergencyStopController().hasPendingCommand());
+    EXPECT_TRUE(plcA.getEmergencyStopFeedback());
+    EXPECT_TRUE(ctxA->emergencyStopController().isEmergencyStopped());
+    EXPECT_FALSE(plcB.getEmergencyStopFeedback());
+    EXPECT_FALSE(ctxB->emergencyStopController().isEmergencyStopped());
+}
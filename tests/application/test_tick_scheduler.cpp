@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include "application/TickScheduler.h"
+#include "application/GroupPollScheduler.h"
+#include "application/SystemManager.h"
+#include "application/safety/EmergencyStopLatencyProbe.h"
+#include "application/safety/GlobalEmergencyStopUseCase.h"
+#include "domain/entity/SystemContext.h"
+#include "infrastructure/FakeAxisDriver.h"
+#include "infrastructure/FakePLC.h"
+#include <string>
+#include <vector>
+
+// ============================================================================
+// TickScheduler 测试套件（虚拟时钟：工作项自行推进时间）
+// 核心验证点：
+//   1. 按类别顺序执行，同类按注册顺序
+//   2. 预算耗尽后非关键项推迟到下一帧，且下一帧优先执行（不饿死）；计数正确
+//   3. 关键类（Feedback / Safety）不受预算约束，慢 UI 不影响关键阶段期限
+//   4. 单项超限与整帧超限计数；周期项按帧间隔执行，被推迟后补执行
+//   5. 闭环：UI 持续过慢时，急停确认所需帧数不变
+// ============================================================================
+
+namespace {
+
+using namespace std::chrono_literals;
+
+struct VirtualClock {
+    TickScheduler::Clock::time_point t{};
+    void advance(std::chrono::microseconds d) { t += d; }
+    void attach(TickScheduler& s) { s.setClock([this] { return t; }); }
+};
+
+} // namespace
+
+TEST(TickSchedulerTest, RunsClassesInPriorityOrder) {
+    TickScheduler scheduler;
+    std::vector<std::string> order;
+    scheduler.add("telemetry", TickPriority::Telemetry, [&] { order.push_back("telemetry"); });
+    scheduler.add("ui", TickPriority::UiProjection, [&] { order.push_back("ui"); });
+    scheduler.add("motion.1", TickPriority::Motion, [&] { order.push_back("motion.1"); });
+    scheduler.add("safety", TickPriority::Safety, [&] { order.push_back("safety"); });
+    scheduler.add("motion.2", TickPriority::Motion, [&] { order.push_back("motion.2"); });
+    scheduler.add("feedback", TickPriority::Feedback, [&] { order.push_back("feedback"); });
+
+    scheduler.tick();
+    const std::vector<std::string> expected{"feedback", "safety", "motion.1", "motion.2", "ui", "telemetry"};
+    EXPECT_EQ(order, expected);
+    EXPECT_EQ(scheduler.stats().deferred, 0u);
+}
+
+TEST(TickSchedulerTest, DefersLowerPriorityWorkOnceBudgetIsSpent) {
+    VirtualClock clock;
+    TickScheduler scheduler(8ms);
+    clock.attach(scheduler);
+
+    std::vector<std::string> order;
+    auto work = [&](const char* name, std::chrono::microseconds cost) {
+        return [&, name, cost] { order.push_back(name); clock.advance(cost); };
+    };
+    scheduler.add("feedback", TickPriority::Feedback, work("feedback", 2ms));
+    const size_t ui1 = scheduler.add("ui.1", TickPriority::UiProjection, work("ui.1", 4ms));
+    const size_t ui2 = scheduler.add("ui.2", TickPriority::UiProjection, work("ui.2", 3ms));
+    const size_t ui3 = scheduler.add("ui.3", TickPriority::UiProjection, work("ui.3", 1ms));
+    const size_t tel = scheduler.add("telemetry", TickPriority::Telemetry, work("telemetry", 1ms));
+
+    // 帧 1：2 + 4 + 3 = 9ms，ui.3 与 telemetry 推迟
+    scheduler.tick();
+    EXPECT_EQ(order, (std::vector<std::string>{"feedback", "ui.1", "ui.2"}));
+    EXPECT_EQ(scheduler.backlog(), 2u);
+    EXPECT_EQ(scheduler.itemStats(ui3).deferred, 1u);
+    EXPECT_EQ(scheduler.itemStats(tel).deferred, 1u);
+    EXPECT_EQ(scheduler.stats().overrunTicks, 1u);
+
+    // 帧 2：被推迟的 ui.3 最先执行；2 + 1 + 4 = 7ms 仍在预算内，ui.2 照常执行，telemetry 再次推迟
+    order.clear();
+    scheduler.tick();
+    EXPECT_EQ(order, (std::vector<std::string>{"feedback", "ui.3", "ui.1", "ui.2"}));
+    EXPECT_EQ(scheduler.itemStats(ui2).deferred, 0u);
+    EXPECT_EQ(scheduler.itemStats(ui1).runs, 2u);
+    EXPECT_EQ(scheduler.itemStats(tel).deferred, 2u);
+
+    const auto stats = scheduler.stats();
+    EXPECT_EQ(stats.ticks, 2u);
+    EXPECT_EQ(stats.deferringTicks, 2u);
+    EXPECT_EQ(stats.deferred, 3u);
+    EXPECT_EQ(scheduler.classStats(TickPriority::UiProjection).deferred, 1u);
+}
+
+TEST(TickSchedulerTest, CriticalClassesRunEvenWhenUiIsSlow) {
+    VirtualClock clock;
+    TickScheduler scheduler(8ms, 3ms);
+    clock.attach(scheduler);
+
+    int feedbackRuns = 0;
+    int safetyRuns = 0;
+    scheduler.add("feedback", TickPriority::Feedback, [&] { ++feedbackRuns; clock.advance(1ms); });
+    scheduler.add("safety", TickPriority::Safety, [&] { ++safetyRuns; clock.advance(500us); });
+    const size_t slow = scheduler.add("ui.slow", TickPriority::UiProjection,
+                                      [&] { clock.advance(30ms); }, 5ms);
+    const size_t other = scheduler.add("ui.other", TickPriority::UiProjection, [&] { clock.advance(1ms); });
+
+    for (int i = 0; i < 10; ++i) scheduler.tick();
+
+    EXPECT_EQ(feedbackRuns, 10);
+    EXPECT_EQ(safetyRuns, 10);
+    EXPECT_EQ(scheduler.stats().criticalDeadlineMisses, 0u);
+    EXPECT_EQ(scheduler.stats().maxCriticalPhase, std::chrono::nanoseconds(1500us));
+    EXPECT_EQ(scheduler.stats().overrunTicks, scheduler.itemStats(slow).runs);
+
+    // 慢项之后的 UI 项被推迟，下一帧最先执行：隔帧运行而不是饿死
+    EXPECT_EQ(scheduler.itemStats(slow).runs, 10u);
+    EXPECT_EQ(scheduler.itemStats(other).runs, 5u);
+    EXPECT_EQ(scheduler.itemStats(other).deferred, 5u);
+    EXPECT_EQ(scheduler.itemStats(slow).overruns, 10u);
+    EXPECT_EQ(scheduler.itemStats(slow).maxCost, std::chrono::nanoseconds(30ms));
+}
+
+TEST(TickSchedulerTest, CriticalDeadlineMissIsCounted) {
+    VirtualClock clock;
+    TickScheduler scheduler(8ms, 2ms);
+    clock.attach(scheduler);
+    scheduler.add("feedback", TickPriority::Feedback, [&] { clock.advance(3ms); });
+
+    scheduler.tick();
+    EXPECT_EQ(scheduler.stats().criticalDeadlineMisses, 1u);
+    EXPECT_EQ(scheduler.stats().overrunTicks, 0u);
+}
+
+TEST(TickSchedulerTest, PeriodicTelemetryRunsEveryNTicksAndCatchesUpAfterDeferral) {
+    VirtualClock clock;
+    TickScheduler scheduler(8ms);
+    clock.attach(scheduler);
+
+    bool busy = false;
+    scheduler.add("ui", TickPriority::UiProjection, [&] { if (busy) clock.advance(10ms); });
+    const size_t summary = scheduler.add("summary", TickPriority::Telemetry, [] {}, {}, 10);
+
+    for (int i = 0; i < 30; ++i) scheduler.tick();
+    EXPECT_EQ(scheduler.itemStats(summary).runs, 3u);
+
+    // 第 40 帧到期时 UI 过慢：推迟一帧后补执行，周期从补执行时刻重新计算
+    for (int i = 0; i < 9; ++i) scheduler.tick();
+    busy = true;
+    scheduler.tick();
+    EXPECT_EQ(scheduler.itemStats(summary).runs, 3u);
+    EXPECT_EQ(scheduler.itemStats(summary).deferred, 1u);
+    busy = false;
+    scheduler.tick();
+    EXPECT_EQ(scheduler.itemStats(summary).runs, 4u);
+    EXPECT_EQ(scheduler.backlog(), 0u);
+}
+
+TEST(TickSchedulerTest, EmergencyStopConfirmationUnaffectedBySlowUi) {
+    auto confirmTicks = [](bool slowUi) {
+        VirtualClock clock;
+        FakePLC plc;
+        FakeAxisDriver driver(plc);
+        SystemManager manager;
+        ContextRejection r;
+        SystemContext* ctx = nullptr;
+        manager.createGroup("G", r);
+        manager.tryGetGroup("G", ctx, r);
+        ctx->setDriver(&driver);
+
+        GroupPollScheduler polls(manager, 0);
+        EmergencyStopLatencyProbe probe;
+        TickScheduler scheduler(8ms);
+        clock.attach(scheduler);
+        scheduler.add("poll", TickPriority::Feedback, [&] { polls.pollAll(); clock.advance(1ms); });
+        scheduler.add("estop.probe", TickPriority::Safety, [&] { probe.poll(); });
+        for (int i = 0; i < 4; ++i) {
+            scheduler.add("ui." + std::to_string(i), TickPriority::UiProjection,
+                          [&, slowUi] { clock.advance(slowUi ? 20ms : 100us); });
+        }
+
+        for (int i = 0; i < 3; ++i) scheduler.tick();
+        GlobalEmergencyStopUseCase{}.execute(manager, &probe);
+        int ticks = 0;
+        while (!probe.allConfirmed() && ticks < 100) {
+            scheduler.tick();
+            ++ticks;
+        }
+        EXPECT_EQ(scheduler.stats().criticalDeadlineMisses, 0u);
+        return ticks;
+    };
+
+    const int normal = confirmTicks(false);
+    EXPECT_GT(normal, 0);
+    EXPECT_EQ(confirmTicks(true), normal);
+}
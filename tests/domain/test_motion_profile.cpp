@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "motion/MotionProfile.h"
+
+#include <cmath>
+
+// ============================================================================
+// MotionPlan 测试套件
+// 核心验证点：
+//   1. 三种曲线的总耗时解析值（含行程不足时的三角形 / 降峰 S 曲线）
+//   2. 位置曲线单调、连续，速度与加速度不超过约束
+//   3. timeAtDistance 是 distanceAt 的反函数（二分上界）
+// ============================================================================
+
+namespace {
+
+constexpr MotionLimits LIMITS{50.0, 500.0, 500.0, 5000.0};
+
+/// @brief 数值检查：位置单调、速度 <= v、加速度 <= max(a, d)（中心差分）
+void expectWithinLimits(const MotionPlan& p, const MotionLimits& lim) {
+    const double T = p.duration();
+    const double h = T / 4000.0;
+    double prev = 0.0;
+    for (int k = 1; k <= 4000; ++k) {
+        const double s = p.distanceAt(k * h);
+        EXPECT_GE(s, prev - 1e-12);
+        EXPECT_LE((s - prev) / h, lim.velocity * (1.0 + 1e-6));
+        if (k >= 2) {
+            const double acc = (s - 2.0 * prev + p.distanceAt((k - 2) * h)) / (h * h);
+            EXPECT_LE(std::abs(acc), std::max(lim.acceleration, lim.deceleration) * 1.01);
+        }
+        prev = s;
+    }
+    EXPECT_DOUBLE_EQ(p.distanceAt(T), p.distance());
+}
+
+} // namespace
+
+TEST(MotionPlanTest, ConstantProfileIsDistanceOverVelocity) {
+    const MotionPlan p = MotionPlan::plan(MotionProfileType::Constant, -20.0, LIMITS);
+    EXPECT_DOUBLE_EQ(p.distance(), 20.0);
+    EXPECT_DOUBLE_EQ(p.duration(), 0.4);
+    EXPECT_DOUBLE_EQ(p.distanceAt(0.1), 5.0);
+}
+
+TEST(MotionPlanTest, TrapezoidalWithCruise) {
+    const MotionPlan p = MotionPlan::plan(MotionProfileType::Trapezoidal, 10.0, LIMITS);
+    EXPECT_DOUBLE_EQ(p.duration(), 0.3);
+    EXPECT_DOUBLE_EQ(p.peakVelocity(), 50.0);
+    EXPECT_DOUBLE_EQ(p.distanceAt(0.1), 2.5);
+    EXPECT_DOUBLE_EQ(p.distanceAt(0.2), 7.5);
+    expectWithinLimits(p, LIMITS);
+}
+
+TEST(MotionPlanTest, TrapezoidalAsymmetricRamps) {
+    const MotionLimits lim{50.0, 1000.0, 250.0, 0.0};
+    const MotionPlan p = MotionPlan::plan(MotionProfileType::Trapezoidal, 100.0, lim);
+    // D/v + v/(2a) + v/(2d)
+    EXPECT_NEAR(p.duration(), 2.0 + 0.025 + 0.1, 1e-12);
+    expectWithinLimits(p, lim);
+}
+
+TEST(MotionPlanTest, ShortMoveBecomesTriangular) {
+    const MotionPlan p = MotionPlan::plan(MotionProfileType::Trapezoidal, 1.0, LIMITS);
+    const double vp = std::sqrt(500.0);   // √(2·D·a·d / (a + d))
+    EXPECT_NEAR(p.peakVelocity(), vp, 1e-9);
+    EXPECT_NEAR(p.duration(), 2.0 * vp / 500.0, 1e-9);
+    expectWithinLimits(p, LIMITS);
+}
+
+TEST(MotionPlanTest, SCurveWithCruise) {
+    const MotionPlan p = MotionPlan::plan(MotionProfileType::SCurve, 100.0, LIMITS);
+    // 斜坡：tj = a/j = 0.1s，时长 v/a + tj = 0.2s，行程 v·T/2 = 5mm；匀速 90mm / 50 = 1.8s
+    EXPECT_NEAR(p.duration(), 2.2, 1e-12);
+    EXPECT_NEAR(p.distanceAt(0.1), 5000.0 * 0.001 / 6.0, 1e-12);   // j·t³/6
+    EXPECT_NEAR(p.distanceAt(0.2), 5.0, 1e-12);
+    expectWithinLimits(p, LIMITS);
+}
+
+TEST(MotionPlanTest, ShortSCurveLowersPeak) {
+    const MotionPlan p = MotionPlan::plan(MotionProfileType::SCurve, 0.5, LIMITS);
+    EXPECT_LT(p.peakVelocity(), 50.0);
+    EXPECT_GT(p.duration(), MotionPlan::plan(MotionProfileType::Trapezoidal, 0.5, LIMITS).duration());
+    expectWithinLimits(p, LIMITS);
+}
+
+TEST(MotionPlanTest, TimeAtDistanceInvertsDistanceAt) {
+    const MotionPlan p = MotionPlan::plan(MotionProfileType::SCurve, 37.0, {80.0, 400.0, 250.0, 4000.0});
+    for (double s : {0.01, 1.0, 12.5, 30.0, 36.99}) {
+        const double t = p.timeAtDistance(s);
+        EXPECT_GE(p.distanceAt(t), s);
+        EXPECT_NEAR(p.distanceAt(t), s, 1e-9);
+    }
+    EXPECT_DOUBLE_EQ(p.timeAtDistance(37.0), p.duration());
+}
+
+TEST(MotionPlanTest, ZeroVelocityNeverArrives) {
+    const MotionPlan p = MotionPlan::plan(MotionProfileType::Trapezoidal, 5.0, {0.0, 500.0, 500.0, 0.0});
+    EXPECT_TRUE(std::isinf(p.duration()));
+    EXPECT_DOUBLE_EQ(p.distanceAt(10.0), 0.0);
+    EXPECT_DOUBLE_EQ(MotionPlan::plan(MotionProfileType::SCurve, 0.0, LIMITS).duration(), 0.0);
+}
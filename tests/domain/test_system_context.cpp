@@ -340,3 +340,56 @@ TEST_F(SystemContextTest, Safety_AfterSetUpSync_StateIsRunning) {
     EXPECT_FALSE(context.emergencyStopController().isNotSynchronized());
     EXPECT_FALSE(context.emergencyStopController().isTransitioning());
 }
+
+// ============================================================
+// registerAxis() -- 额外轴登记
+// ============================================================
+
+// 默认 6 轴；额外登记的轴按普通轴处理，重复登记保持原实体
+TEST_F(SystemContextTest, RegisterAxis_ExtraAxisIsReachableAsPlainAxis) {
+    const AxisId extra = static_cast<AxisId>(42);
+    EXPECT_EQ(context.axisCount(), 6u);
+    EXPECT_FALSE(context.tryGetAxis(extra, outAxis, reason));
+    EXPECT_EQ(reason, ContextRejection::AxisNotRegistered);
+
+    EXPECT_TRUE(context.registerAxis(extra));
+    ASSERT_TRUE(context.tryGetAxis(extra, outAxis, reason));
+    Axis* first = outAxis;
+    EXPECT_EQ(context.axisCount(), 7u);
+
+    EXPECT_FALSE(context.registerAxis(extra));
+    EXPECT_FALSE(context.registerAxis(AxisId::Y));
+    ASSERT_TRUE(context.tryGetAxis(extra, outAxis, reason));
+    EXPECT_EQ(outAxis, first);
+    EXPECT_EQ(context.axisCount(), 7u);
+}
+
+// ============================================================
+// checkControlAccess() -- 安全层 + 龙门层拆分后的组合校验
+// ============================================================
+
+// 与 tryGetAxis() 的 Layer 0 ~ Layer 2 裁决一致：安全锁定优先于龙门语义
+TEST_F(SystemContextTest, CheckControlAccess_MatchesTryGetAxisLayers) {
+    context.gantryCouplingController().applyFeedback({ .isCoupled = true, .errorCode = 0 });
+    EXPECT_TRUE(context.checkControlAccess(AxisId::X, reason));
+    EXPECT_EQ(reason, ContextRejection::None);
+    EXPECT_FALSE(context.checkControlAccess(AxisId::X1, reason));
+    EXPECT_EQ(reason, ContextRejection::PhysicalAxisLockedByGantry);
+
+    context.emergencyStopController().applyFeedback(true);
+    EXPECT_FALSE(context.checkControlAccess(AxisId::Y, reason));
+    EXPECT_EQ(reason, ContextRejection::SystemSafetyLocked);
+    EXPECT_FALSE(context.checkControlAccess(AxisId::X1, reason));
+    EXPECT_EQ(reason, ContextRejection::SystemSafetyLocked);
+}
+
+// 遥测读取只经龙门层：急停中仍可读，龙门语义照常生效
+TEST_F(SystemContextTest, TryReadAxis_SkipsSafetyLayerButKeepsGantryLayer) {
+    context.gantryCouplingController().applyFeedback({ .isCoupled = true, .errorCode = 0 });
+    context.emergencyStopController().applyFeedback(true);
+
+    EXPECT_TRUE(context.tryReadAxis(AxisId::Y, outAxis, reason));
+    EXPECT_NE(outAxis, nullptr);
+    EXPECT_FALSE(context.tryReadAxis(AxisId::X2, outAxis, reason));
+    EXPECT_EQ(reason, ContextRejection::PhysicalAxisLockedByGantry);
+}
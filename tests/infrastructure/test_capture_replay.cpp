@@ -0,0 +1,351 @@
+#include <gtest/gtest.h>
+#include "infrastructure/CaptureFile.h"
+#include "infrastructure/FakeAxisDriver.h"
+#include "infrastructure/FakePLC.h"
+#include "infrastructure/RecordingDriver.h"
+#include "infrastructure/ReplayDriver.h"
+#include "application/SystemManager.h"
+#include "application/policy/AutoAbsMoveOrchestrator.h"
+#include "domain/entity/SystemContext.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+// ============================================================================
+// CaptureWriter / CaptureReader / RecordingDriver / ReplayDriver 测试套件
+// 核心验证点：
+//   1. 捕获文件往返：记录顺序、分组名、时间戳、命令与反馈解码
+//   2. 回放把领域状态序列逐周期复现，上层重发的命令与录制一致（无分歧）
+//   3. 丢帧录为 NoFeedback，回放时同样不分派
+//   4. 截断尾部被容忍，格式不兼容的文件被拒绝
+//   5. OriginalSpeed 节奏按录制时间戳等待；命令分歧被计数
+// ============================================================================
+
+namespace {
+
+using Status = CommunicationResult::Status;
+using Clock = std::chrono::steady_clock;
+
+std::string tempCapture(const std::string& name) {
+    return ::testing::TempDir() + "servov6_" + name + ".cap";
+}
+
+/// @brief 每个周期的领域可观测状态（轴被拒绝访问时记为 Unknown / 0）
+struct AxisSample {
+    AxisState state = AxisState::Unknown;
+    double absPos = 0.0;
+    bool operator==(const AxisSample&) const = default;
+};
+
+AxisSample sample(SystemContext& ctx, AxisId id) {
+    Axis* axis = nullptr;
+    ContextRejection r;
+    if (!ctx.tryGetAxis(id, axis, r) || !axis) return {};
+    return {axis->state(), axis->currentAbsolutePosition()};
+}
+
+struct Group {
+    SystemManager manager;
+    SystemContext* ctx = nullptr;
+    const std::string name = "G";
+
+    explicit Group(ISystemDriver& driver) {
+        ContextRejection r;
+        manager.createGroup(name, r);
+        manager.tryGetGroup(name, ctx, r);
+        ctx->setDriver(&driver);
+    }
+};
+
+/// @brief 有延迟与丢帧、无通讯失败的链路（编排器不经重试即可完成）
+LinkModel lossyLink(double dropRate) {
+    LinkModel link = LinkModel::typical(7);
+    link.timeoutRate = 0.0;
+    link.busyRate = 0.0;
+    link.dropFeedbackRate = dropRate;
+    return link;
+}
+
+/// @brief 录制一次 Y 轴绝对定位，返回每个周期的 Y 轴采样
+std::vector<AxisSample> recordAbsMove(const std::string& path, const LinkModel& link, LinkStats* stats = nullptr) {
+    FakePLC plc;
+    FakeAxisDriver raw(plc);
+    raw.setLinkModel(link);
+    for (auto id : plc.axisIds()) plc.setSimulatedMoveVelocity(id, 50.0);
+
+    CaptureWriter writer;
+    EXPECT_TRUE(writer.open(path, 4096));   // 小初始容量：覆盖映射扩容路径
+    RecordingDriver rec(raw, writer, 0, "G");
+    Group g(rec);
+
+    AutoAbsMoveOrchestrator orch(g.manager, g.name);
+    std::vector<AxisSample> trace;
+    bool started = false;
+    for (int c = 0; c < 1000 && !(started && (orch.isDone() || orch.hasError())); ++c) {
+        rec.pollFeedback(*g.ctx);
+        trace.push_back(sample(*g.ctx, AxisId::Y));
+        if (!started && !g.ctx->emergencyStopController().isNotSynchronized()) {
+            orch.startAbs(AxisId::Y, 120.0);
+            started = true;
+        }
+        orch.tick();
+    }
+    EXPECT_TRUE(orch.isDone());
+    if (stats) *stats = raw.linkStats();
+    writer.close();
+    return trace;
+}
+
+} // namespace
+
+// ── 文件格式 ─────────────────────────────────────────────
+
+TEST(CaptureFileTest, RoundTripPreservesRecordsAndTimestamps) {
+    const std::string path = tempCapture("roundtrip");
+    Clock::time_point now{};
+    {
+        CaptureWriter writer;
+        writer.setClock([&now] { return now; });
+        ASSERT_TRUE(writer.open(path));
+
+        writer.appendGroupName(0, "Machine_A");
+        writer.appendGroupName(1, "Machine_B");
+        now += std::chrono::milliseconds(10);
+        writer.appendCommand(1, AxisCommandWithId{AxisId::Z, MoveCommand{MoveType::Absolute, 42.5, 1.0}},
+                             CommunicationResult{Status::Busy, 0x06, "busy"});
+
+        FeedbackFrame frame;
+        frame.generation = 9;
+        frame.emergencyStopped = true;
+        frame.gantry = GantryFeedback{true, false, 3};
+        AxisFeedback fb{};
+        fb.state = AxisState::MovingAbsolute;
+        fb.absPos = 12.25;
+        frame.axes.emplace_back(AxisId::R, fb);
+        now += std::chrono::milliseconds(10);
+        writer.appendFeedback(0, frame);
+        writer.appendNoFeedback(0);
+        EXPECT_EQ(writer.recordCount(), 5u);
+    }
+
+    CaptureReader reader;
+    ASSERT_TRUE(reader.open(path));
+    const auto& recs = reader.records();
+    ASSERT_EQ(recs.size(), 5u);
+
+    uint16_t id = 99;
+    ASSERT_TRUE(reader.tryGetGroupId("Machine_B", id));
+    EXPECT_EQ(id, 1);
+    EXPECT_FALSE(reader.tryGetGroupId("Machine_C", id));
+
+    capture::CommandPayload cmd;
+    ASSERT_TRUE(CaptureReader::decodeCommand(recs[2], cmd));
+    EXPECT_EQ(recs[2].group, 1);
+    EXPECT_EQ(recs[2].timestampNs, 10'000'000u);
+    EXPECT_EQ(cmd.status, static_cast<int32_t>(Status::Busy));
+    EXPECT_EQ(cmd.exceptionCode, 0x06);
+    EXPECT_TRUE(ReplayDriver::sameCommand(cmd.cmd,
+        AxisCommandWithId{AxisId::Z, MoveCommand{MoveType::Absolute, 42.5, 1.0}}));
+
+    FeedbackFrame decoded;
+    ASSERT_TRUE(CaptureReader::decodeFeedback(recs[3], decoded));
+    EXPECT_EQ(recs[3].timestampNs, 20'000'000u);
+    EXPECT_EQ(decoded.generation, 9u);
+    EXPECT_TRUE(decoded.emergencyStopped);
+    EXPECT_TRUE(decoded.gantry.enable);
+    EXPECT_EQ(decoded.gantry.errorCode, 3);
+    ASSERT_EQ(decoded.axes.size(), 1u);
+    EXPECT_EQ(decoded.axes[0].first, AxisId::R);
+    EXPECT_EQ(decoded.axes[0].second.state, AxisState::MovingAbsolute);
+    EXPECT_DOUBLE_EQ(decoded.axes[0].second.absPos, 12.25);
+
+    EXPECT_EQ(recs[4].type, capture::RecordType::NoFeedback);
+    EXPECT_FALSE(CaptureReader::decodeFeedback(recs[4], decoded));
+    std::remove(path.c_str());
+}
+
+TEST(CaptureFileTest, TruncatedTailIsIgnored) {
+    const std::string path = tempCapture("truncated");
+    {
+        CaptureWriter writer;
+        ASSERT_TRUE(writer.open(path));
+        writer.appendGroupName(0, "G");
+        for (int i = 0; i < 3; ++i) writer.appendNoFeedback(0);
+        writer.appendCommand(0, AxisCommandWithId{AxisId::Y, StopCommand{}}, CommunicationResult{});
+    }
+    // 录制进程在写最后一条命令时崩溃
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+
+    CaptureReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_EQ(reader.records().size(), 4u);
+    EXPECT_EQ(reader.records().back().type, capture::RecordType::NoFeedback);
+    std::remove(path.c_str());
+}
+
+TEST(CaptureFileTest, IncompatibleHeaderIsRejected) {
+    const std::string path = tempCapture("badheader");
+    {
+        CaptureWriter writer;
+        ASSERT_TRUE(writer.open(path));
+        writer.appendNoFeedback(0);
+    }
+    {
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(0);
+        f.put('X');
+    }
+    CaptureReader reader;
+    EXPECT_FALSE(reader.open(path));
+    EXPECT_TRUE(reader.records().empty());
+    EXPECT_FALSE(reader.open(tempCapture("does_not_exist")));
+    std::remove(path.c_str());
+}
+
+// ── 录制 / 回放 ───────────────────────────────────────────
+
+TEST(CaptureReplayTest, ReplayReproducesDomainStateAndCommands) {
+    const std::string path = tempCapture("absmove");
+    const auto recorded = recordAbsMove(path, lossyLink(0.05));
+    ASSERT_GT(recorded.size(), 20u);
+    EXPECT_EQ(recorded.back().state, AxisState::Idle);
+
+    CaptureReader reader;
+    ASSERT_TRUE(reader.open(path));
+    uint16_t id = 0;
+    ASSERT_TRUE(reader.tryGetGroupId("G", id));
+    ReplayDriver replay(reader, id);
+    EXPECT_EQ(replay.pollCount(), recorded.size());
+    Group g(replay);
+
+    // 回放端运行同一个编排器：反馈逐周期相同，它发出的命令也必须与录制一致
+    AutoAbsMoveOrchestrator orch(g.manager, g.name);
+    std::vector<AxisSample> replayed;
+    bool started = false;
+    while (!replay.finished()) {
+        replay.pollFeedback(*g.ctx);
+        replayed.push_back(sample(*g.ctx, AxisId::Y));
+        if (!started && !g.ctx->emergencyStopController().isNotSynchronized()) {
+            orch.startAbs(AxisId::Y, 120.0);
+            started = true;
+        }
+        orch.tick();
+    }
+
+    EXPECT_EQ(replayed, recorded);
+    EXPECT_TRUE(orch.isDone());
+    EXPECT_GT(replay.stats().commandsMatched, 0u);
+    EXPECT_EQ(replay.stats().commandsMatched, replay.commandCount());
+    EXPECT_EQ(replay.stats().divergences, 0u);
+    std::remove(path.c_str());
+}
+
+TEST(CaptureReplayTest, DroppedFeedbackIsNotDispatchedOnReplay) {
+    const std::string path = tempCapture("drops");
+    // 反馈无延迟：每个未分派的周期都来自丢帧（有延迟时陈旧快照同样不分派）
+    LinkModel model = lossyLink(0.3);
+    model.feedbackDelayMs = 0;
+    model.feedbackJitterMs = 0;
+    LinkStats link;
+    recordAbsMove(path, model, &link);
+    ASSERT_GT(link.framesDropped, 0u);
+
+    CaptureReader reader;
+    ASSERT_TRUE(reader.open(path));
+    size_t noFeedback = 0;
+    for (const auto& r : reader.records()) {
+        if (r.type == capture::RecordType::NoFeedback) ++noFeedback;
+    }
+    EXPECT_EQ(noFeedback, link.framesDropped);
+
+    ReplayDriver replay(reader, 0);
+    Group g(replay);
+    size_t silent = 0;
+    while (!replay.finished()) {
+        replay.pollFeedback(*g.ctx);
+        if (!replay.lastFeedbackFrame()) ++silent;
+    }
+    EXPECT_EQ(silent, link.framesDropped);
+    EXPECT_EQ(replay.stats().framesDispatched, replay.stats().polls - link.framesDropped);
+
+    // 序列耗尽后不再分派，领域状态保持最后一帧
+    replay.pollFeedback(*g.ctx);
+    EXPECT_EQ(replay.lastFeedbackFrame(), nullptr);
+    EXPECT_DOUBLE_EQ(sample(*g.ctx, AxisId::Y).absPos, 120.0);
+    std::remove(path.c_str());
+}
+
+TEST(CaptureReplayTest, OriginalSpeedWaitsForRecordedTimestamps) {
+    const std::string path = tempCapture("pacing");
+    {
+        Clock::time_point now{};
+        CaptureWriter writer;
+        writer.setClock([&now] { return now; });
+        ASSERT_TRUE(writer.open(path));
+        for (int gapMs : {5, 10, 20, 0}) {
+            now += std::chrono::milliseconds(gapMs);
+            writer.appendNoFeedback(0);
+        }
+    }
+
+    CaptureReader reader;
+    ASSERT_TRUE(reader.open(path));
+    ReplayDriver replay(reader, 0, ReplayDriver::Pacing::OriginalSpeed);
+    Clock::time_point now{};
+    std::vector<std::chrono::nanoseconds> sleeps;
+    replay.setClock([&now] { return now; },
+                    [&](std::chrono::nanoseconds d) { sleeps.push_back(d); now += d; });
+    Group g(replay);
+
+    replay.pollFeedback(*g.ctx);                      // 起点：不等待
+    now += std::chrono::milliseconds(4);              // 上层处理耗时计入间隔
+    replay.pollFeedback(*g.ctx);
+    replay.pollFeedback(*g.ctx);
+    now += std::chrono::milliseconds(50);             // 已落后于录制节奏：不再等待
+    replay.pollFeedback(*g.ctx);
+
+    ASSERT_EQ(sleeps.size(), 2u);
+    EXPECT_EQ(sleeps[0], std::chrono::milliseconds(6));
+    EXPECT_EQ(sleeps[1], std::chrono::milliseconds(20));
+    EXPECT_TRUE(replay.finished());
+    std::remove(path.c_str());
+}
+
+TEST(CaptureReplayTest, CommandsAreMatchedSemanticallyAndDivergencesCounted) {
+    const std::string path = tempCapture("commands");
+    const SystemCommand enable = AxisCommandWithId{AxisId::Y, EnableCommand{true}};
+    const SystemCommand jog = AxisCommandWithId{AxisId::Y, JogCommand{Direction::Forward, true}};
+    const SystemCommand estop = EmergencyStopCommand{true};
+    {
+        CaptureWriter writer;
+        ASSERT_TRUE(writer.open(path));
+        writer.appendCommand(0, enable, CommunicationResult{Status::Timeout, 0, "timeout"});
+        writer.appendCommand(0, enable, CommunicationResult{});
+        writer.appendCommand(0, jog, CommunicationResult{});
+        writer.appendCommand(0, estop, CommunicationResult{});
+    }
+
+    CaptureReader reader;
+    ASSERT_TRUE(reader.open(path));
+    ReplayDriver replay(reader, 0);
+
+    // 录制时的通讯失败原样重现
+    EXPECT_EQ(replay.send(enable).status, Status::Timeout);
+    EXPECT_TRUE(replay.send(enable).ok());
+
+    // 方向不同：分歧，不消费录制命令
+    const auto r = replay.send(AxisCommandWithId{AxisId::Y, JogCommand{Direction::Backward, true}});
+    EXPECT_TRUE(r.ok());
+    EXPECT_EQ(replay.stats().divergences, 1u);
+
+    // 上层少发了 Jog：在前瞻窗口内重新对齐
+    EXPECT_TRUE(replay.send(estop).ok());
+    EXPECT_EQ(replay.stats().commandsMatched, 3u);
+    EXPECT_EQ(replay.stats().commandsSkipped, 1u);
+
+    EXPECT_FALSE(ReplayDriver::sameCommand(enable, jog));
+    EXPECT_FALSE(ReplayDriver::sameCommand(enable, AxisCommandWithId{AxisId::Z, EnableCommand{true}}));
+    EXPECT_TRUE(ReplayDriver::sameCommand(AxisCommandWithId{AxisId::Y, StopCommand{}},
+                                          AxisCommandWithId{AxisId::Y, StopCommand{}}));
+    std::remove(path.c_str());
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include "infrastructure/CommandRecorder.h"
+#include "infrastructure/FakePLC.h"
+#include "infrastructure/FakeAxisDriver.h"
+
+// ============================================================================
+// CommandRecorder 测试套件
+// 核心验证点：
+//   1. 容量写满后覆盖最旧记录，内存有界
+//   2. has<T>() / lastForAxis<T>() 索引覆盖已被覆盖的历史
+//   3. 落盘后可读回完整历史
+// ============================================================================
+
+namespace {
+
+CommandRecord jog(AxisId id, bool active) {
+    return {id, JogCommand{Direction::Forward, active}};
+}
+
+CommandRecord move(AxisId id, double target) {
+    return {id, MoveCommand{MoveType::Absolute, target, 0.0}};
+}
+
+} // namespace
+
+TEST(CommandRecorderTest, KeepsOrderUntilCapacity) {
+    CommandRecorder rec(4);
+    rec.push_back(move(AxisId::Y, 1.0));
+    rec.push_back(move(AxisId::Y, 2.0));
+
+    ASSERT_EQ(rec.size(), 2u);
+    EXPECT_DOUBLE_EQ(std::get<MoveCommand>(rec[0].cmd).target, 1.0);
+    EXPECT_DOUBLE_EQ(std::get<MoveCommand>(rec.back().cmd).target, 2.0);
+    EXPECT_EQ(rec.evicted(), 0u);
+}
+
+TEST(CommandRecorderTest, OverwritesOldestWhenFull) {
+    CommandRecorder rec(3);
+    for (int i = 0; i < 10; ++i) {
+        rec.push_back(move(AxisId::Z, static_cast<double>(i)));
+    }
+
+    ASSERT_EQ(rec.size(), 3u);
+    EXPECT_EQ(rec.evicted(), 7u);
+    EXPECT_DOUBLE_EQ(std::get<MoveCommand>(rec[0].cmd).target, 7.0);
+    EXPECT_DOUBLE_EQ(std::get<MoveCommand>(rec[2].cmd).target, 9.0);
+
+    // 正向 / 反向迭代均按时间顺序
+    std::vector<double> fwd, rev;
+    for (const auto& r : rec) fwd.push_back(std::get<MoveCommand>(r.cmd).target);
+    for (auto it = rec.rbegin(); it != rec.rend(); ++it) rev.push_back(std::get<MoveCommand>(it->cmd).target);
+    EXPECT_EQ(fwd, (std::vector<double>{7.0, 8.0, 9.0}));
+    EXPECT_EQ(rev, (std::vector<double>{9.0, 8.0, 7.0}));
+}
+
+TEST(CommandRecorderTest, IndexesSurviveEviction) {
+    CommandRecorder rec(2);
+    rec.push_back(jog(AxisId::Y, true));
+    rec.push_back(move(AxisId::Y, 5.0));
+    rec.push_back(move(AxisId::Z, 6.0));   // JogCommand 已被覆盖
+
+    EXPECT_TRUE(rec.has<JogCommand>());
+    EXPECT_TRUE(rec.lastForAxis<JogCommand>(AxisId::Y).active);
+    EXPECT_DOUBLE_EQ(rec.lastForAxis<MoveCommand>(AxisId::Y).target, 5.0);
+    EXPECT_DOUBLE_EQ(rec.lastForAxis<MoveCommand>(AxisId::Z).target, 6.0);
+    EXPECT_FALSE(rec.has<StopCommand>());
+    EXPECT_DOUBLE_EQ(rec.lastForAxis<MoveCommand>(AxisId::R).target, 0.0);  // 未下发 -> T{}
+}
+
+TEST(CommandRecorderTest, ClearResetsIndexes) {
+    CommandRecorder rec(8);
+    rec.push_back(move(AxisId::R, 3.0));
+    rec.clear();
+
+    EXPECT_TRUE(rec.empty());
+    EXPECT_FALSE(rec.has<MoveCommand>());
+    EXPECT_DOUBLE_EQ(rec.lastForAxis<MoveCommand>(AxisId::R).target, 0.0);
+}
+
+TEST(CommandRecorderTest, WorksWithStandardAlgorithms) {
+    CommandRecorder rec(8);
+    rec.push_back(jog(AxisId::Y, true));
+    rec.push_back(jog(AxisId::Y, false));
+    rec.push_back(move(AxisId::Y, 1.0));
+
+    auto jogs = std::count_if(rec.begin(), rec.end(), [](const CommandRecord& r) {
+        return std::holds_alternative<JogCommand>(r.cmd);
+    });
+    EXPECT_EQ(jogs, 2);
+    EXPECT_EQ(rec.end() - rec.begin(), 3);
+}
+
+TEST(CommandRecorderTest, SpillKeepsFullHistory) {
+    std::string path = ::testing::TempDir() + "command_recorder_spill.bin";
+    {
+        CommandRecorder rec(2);
+        ASSERT_TRUE(rec.enableSpill(path));
+        for (int i = 0; i < 5; ++i) {
+            rec.push_back(move(AxisId::X, static_cast<double>(i)));
+        }
+        ASSERT_EQ(rec.size(), 2u);
+
+        auto all = rec.readSpill();
+        ASSERT_EQ(all.size(), 5u);
+        for (int i = 0; i < 5; ++i) {
+            EXPECT_EQ(all[i].id, AxisId::X);
+            EXPECT_DOUBLE_EQ(std::get<MoveCommand>(all[i].cmd).target, static_cast<double>(i));
+        }
+
+        rec.clear();
+        EXPECT_TRUE(rec.readSpill().empty());
+    }
+    std::remove(path.c_str());
+}
+
+TEST(CommandRecorderTest, FakeAxisDriverHistoryIsBounded) {
+    FakePLC plc;
+    FakeAxisDriver driver(plc, 16);
+    for (int i = 0; i < 100; ++i) {
+        driver.send(AxisCommandWithId{AxisId::Y, SetMoveVelocityCommand{static_cast<double>(i + 1)}});
+    }
+
+    EXPECT_EQ(driver.history.size(), 16u);
+    EXPECT_TRUE(driver.has<SetMoveVelocityCommand>());
+    EXPECT_DOUBLE_EQ(driver.lastForAxis<SetMoveVelocityCommand>(AxisId::Y).velocity, 100.0);
+}
@@ -949,3 +949,464 @@ TEST_F(FakePLCGantryTest, ShouldDelayCouplingBeforeGANTRY_COUPLING_DELAY_MS) {
     gf = plc.getGantryFeedback();
     EXPECT_TRUE(gf.isCoupled);
 }
+
+// ============================================================================
+// 用例 G23：联动排队----使能进行中的联动请求挂起到使能完成的同一扫描周期
+// ============================================================================
+TEST_F(FakePLCGantryTest, ShouldQueueCouplingBehindPowerWhenEnabled) {
+    plc.setGantryCouplingFollowsPower(true);
+
+    plc.onGantryCommand(GantryPowerCommand{true});
+    plc.onGantryCommand(GantryCouplingCommand{true});
+    plc.tick(140); // 联动延迟已过，但使能未完成：挂起而非拒绝
+    auto gf = plc.getGantryFeedback();
+    EXPECT_FALSE(gf.isCoupled);
+    EXPECT_EQ(gf.errorCode, 0);
+
+    plc.tick(10); // 总 150ms = 使能延迟
+    gf = plc.getGantryFeedback();
+    EXPECT_TRUE(gf.enable);
+    EXPECT_TRUE(gf.isCoupled);
+}
+
+// ============================================================================
+// 用例 G24：未开启排队时同样的命令序列以 X1NotEnabled 拒绝；新的联动命令清除拒绝码
+// ============================================================================
+TEST_F(FakePLCGantryTest, ShouldRejectUnqueuedCouplingAndClearCodeOnRetry) {
+    plc.onGantryCommand(GantryPowerCommand{true});
+    plc.onGantryCommand(GantryCouplingCommand{true});
+    plc.tick(100);
+    EXPECT_EQ(plc.getGantryFeedback().errorCode, 2); // X1NotEnabled
+
+    plc.tick(50);
+    plc.onGantryCommand(GantryCouplingCommand{true});
+    EXPECT_EQ(plc.getGantryFeedback().errorCode, 0);
+    plc.tick(100);
+    EXPECT_TRUE(plc.getGantryFeedback().isCoupled);
+}
+
+// ============================================================================
+// 多轴（SoA）测试套件
+// 核心验证点：任意轴集合构造、逐轴独立推演、缺少龙门轴时龙门仿真停用
+// ============================================================================
+
+static std::vector<AxisId> makeAxisIds(size_t n) {
+    std::vector<AxisId> ids;
+    for (size_t i = 0; i < n; ++i) ids.push_back(static_cast<AxisId>(i));
+    return ids;
+}
+
+// ============================================================================
+// 用例 M1：数百个轴各自独立运动，互不干扰
+// ============================================================================
+TEST(FakePLCManyAxesTest, ShouldSimulateHundredsOfIndependentAxes) {
+    const auto ids = makeAxisIds(300);
+    FakePLC plc(ids);
+    ASSERT_EQ(plc.axisCount(), 300u);
+
+    for (auto id : ids) plc.onCommand(id, EnableCommand{true});
+    plc.tick(200);
+
+    // 偶数轴定位到 +10，奇数轴保持静止
+    for (size_t i = 0; i < ids.size(); i += 2) {
+        plc.onCommand(ids[i], MoveCommand{MoveType::Absolute, 10.0, 0.0});
+    }
+    for (int k = 0; k < 30; ++k) plc.tick(10);   // 300ms * 50mm/s = 15mm > 10mm
+
+    for (size_t i = 0; i < ids.size(); ++i) {
+        auto fb = plc.getFeedback(ids[i]);
+        EXPECT_EQ(fb.state, AxisState::Idle) << "axis " << i;
+        EXPECT_DOUBLE_EQ(fb.absPos, (i % 2 == 0) ? 10.0 : 0.0) << "axis " << i;
+    }
+}
+
+// ============================================================================
+// 用例 M2：限位只钳住触碰的轴，并停止其点动
+// ============================================================================
+TEST(FakePLCManyAxesTest, ShouldClampOnlyTheAxisHittingItsLimit) {
+    const auto ids = makeAxisIds(8);
+    FakePLC plc(ids);
+    for (auto id : ids) {
+        plc.setLimits(id, 5.0, -5.0);
+        plc.setSimulatedJogVelocity(id, 100.0);
+        plc.onCommand(id, EnableCommand{true});
+    }
+    plc.tick(200);
+
+    plc.onCommand(ids[3], JogCommand{Direction::Backward, true});
+    for (int k = 0; k < 10; ++k) plc.tick(10);   // 100ms * 100mm/s = 10mm > 5mm
+
+    auto hit = plc.getFeedback(ids[3]);
+    EXPECT_EQ(hit.state, AxisState::Idle);
+    EXPECT_TRUE(hit.negLimit);
+    EXPECT_DOUBLE_EQ(hit.absPos, -5.0);
+    EXPECT_DOUBLE_EQ(hit.relPos, -5.0);
+
+    auto other = plc.getFeedback(ids[4]);
+    EXPECT_FALSE(other.negLimit);
+    EXPECT_DOUBLE_EQ(other.absPos, 0.0);
+}
+
+// ============================================================================
+// 用例 M3：轴集合中没有龙门轴时，龙门命令不生效也不会越界
+// ============================================================================
+TEST(FakePLCManyAxesTest, ShouldIgnoreGantryWithoutGantryAxes) {
+    FakePLC plc({AxisId::Y, AxisId::Z});
+    EXPECT_FALSE(plc.hasAxis(AxisId::X1));
+
+    plc.onGantryCommand(GantryPowerCommand{true});
+    plc.onGantryCommand(GantryCouplingCommand{true});
+    plc.tick(300);
+
+    auto gf = plc.getGantryFeedback();
+    EXPECT_FALSE(gf.enable);
+    EXPECT_FALSE(gf.isCoupled);
+}
+
+// ============================================================================
+// 用例 M4：访问未登记的轴与原实现一致地抛出 std::out_of_range
+// ============================================================================
+TEST(FakePLCManyAxesTest, ShouldThrowForUnregisteredAxis) {
+    FakePLC plc({AxisId::Y});
+    EXPECT_THROW(plc.getFeedback(AxisId::Z), std::out_of_range);
+    EXPECT_THROW(plc.getFeedback(static_cast<AxisId>(1000)), std::out_of_range);
+}
+
+// ============================================================================
+// FakePLCConfig 测试套件
+// 核心验证点：
+//   1. 每轴速度/限位按配置生效（含速度回读寄存器）
+//   2. 多组龙门互相独立，第 0 组对应无下标的龙门接口
+//   3. scaled() 布局：标准 6 轴在前，额外龙门组占用生成轴
+//   4. resetAll 回到配置参数而非寄存器上电默认值
+// ============================================================================
+
+// 用例 C1：每轴参数按配置生效
+TEST(FakePLCConfigTest, ShouldApplyPerAxisProfiles) {
+    FakePLCConfig cfg;
+    cfg.axes.push_back({AxisId::Y, FakeAxisProfile{5.0, 20.0, 50.0, -50.0}});
+    cfg.axes.push_back({AxisId::Z, FakeAxisProfile{}});
+    FakePLC plc(cfg);
+
+    auto y = plc.getFeedback(AxisId::Y);
+    EXPECT_DOUBLE_EQ(y.getjogVelocity, 5.0);
+    EXPECT_DOUBLE_EQ(y.getMoveVelocity, 20.0);
+    EXPECT_DOUBLE_EQ(y.posLimitValue, 50.0);
+    EXPECT_DOUBLE_EQ(y.negLimitValue, -50.0);
+    EXPECT_EQ(plc.gantryCount(), 0u);
+
+    plc.onCommand(AxisId::Y, EnableCommand{true});
+    plc.tick(200);
+    plc.onCommand(AxisId::Y, MoveCommand{MoveType::Absolute, 100.0, 0.0});
+    for (int k = 0; k < 300; ++k) plc.tick(10);
+
+    y = plc.getFeedback(AxisId::Y);
+    EXPECT_DOUBLE_EQ(y.absPos, 50.0);   // 被配置的正限位钳住
+    EXPECT_TRUE(y.posLimit);
+}
+
+// 用例 C1b：resetAll 后每轴速度/限位/速度曲线仍为配置值
+TEST(FakePLCConfigTest, ResetAllKeepsConfiguredProfiles) {
+    FakePLCConfig cfg;
+    cfg.axes.push_back({AxisId::Y, FakeAxisProfile{5.0, 20.0, 50.0, -50.0,
+                                                   MotionProfileType::Trapezoidal, 100.0, 200.0}});
+    cfg.axes.push_back({AxisId::Z, FakeAxisProfile{}});
+    FakePLC plc(cfg);
+
+    plc.onCommand(AxisId::Y, EnableCommand{true});
+    plc.tick(200);
+    plc.onCommand(AxisId::Y, SetMoveVelocityCommand{80.0});
+    plc.tick(10);
+    ASSERT_DOUBLE_EQ(plc.getFeedback(AxisId::Y).getMoveVelocity, 80.0);
+
+    plc.resetAll();
+
+    auto y = plc.getFeedback(AxisId::Y);
+    EXPECT_EQ(y.state, AxisState::Disabled);
+    EXPECT_DOUBLE_EQ(y.getjogVelocity, 5.0);
+    EXPECT_DOUBLE_EQ(y.getMoveVelocity, 20.0);
+    EXPECT_DOUBLE_EQ(y.posLimitValue, 50.0);
+    EXPECT_DOUBLE_EQ(y.negLimitValue, -50.0);
+    auto lim = plc.motionLimits(AxisId::Y);
+    EXPECT_DOUBLE_EQ(lim.velocity, 20.0);
+    EXPECT_DOUBLE_EQ(lim.acceleration, 100.0);
+    EXPECT_DOUBLE_EQ(lim.deceleration, 200.0);
+
+    auto z = plc.getFeedback(AxisId::Z);
+    EXPECT_DOUBLE_EQ(z.getMoveVelocity, 50.0);
+    EXPECT_DOUBLE_EQ(z.posLimitValue, 1000.0);
+}
+
+// 用例 C2：引用未登记轴的龙门组被忽略
+TEST(FakePLCConfigTest, ShouldIgnoreGantryWithUnregisteredAxes) {
+    FakePLCConfig cfg;
+    cfg.axes.push_back({AxisId::X, {}});
+    cfg.axes.push_back({AxisId::X1, {}});
+    cfg.gantries.push_back({AxisId::X, AxisId::X1, AxisId::X2});
+    FakePLC plc(cfg);
+
+    EXPECT_EQ(plc.gantryCount(), 0u);
+}
+
+// 用例 C3：额外龙门组独立联动，且只锁定自身的物理轴
+TEST(FakePLCConfigTest, ShouldCoupleExtraGantryIndependently) {
+    FakePLC plc(FakePLCConfig::scaled(12, 2));
+    ASSERT_EQ(plc.gantryCount(), 2u);
+
+    const AxisId a = FakePLCConfig::extraAxisId(1);
+    const AxisId b = FakePLCConfig::extraAxisId(2);
+    plc.onGantryCommand(1, GantryPowerCommand{true});
+    plc.tick(200);
+    EXPECT_EQ(plc.getFeedback(a).state, AxisState::Idle);
+    EXPECT_EQ(plc.getFeedback(b).state, AxisState::Idle);
+    EXPECT_EQ(plc.getFeedback(AxisId::X1).state, AxisState::Disabled);
+
+    plc.onGantryCommand(1, GantryCouplingCommand{true});
+    for (int k = 0; k < 12; ++k) plc.tick(10);
+
+    EXPECT_TRUE(plc.getGantryFeedback(1).isCoupled);
+    EXPECT_FALSE(plc.getGantryFeedback().isCoupled);
+
+    // 已联动组的物理轴拒绝独立点动；第 0 组的 X1 不受影响
+    plc.onCommand(a, JogCommand{Direction::Forward, true});
+    plc.onCommand(AxisId::X1, EnableCommand{true});
+    plc.tick(200);
+    plc.onCommand(AxisId::X1, JogCommand{Direction::Forward, true});
+    plc.tick(10);
+    EXPECT_EQ(plc.getFeedback(a).state, AxisState::Idle);
+    EXPECT_EQ(plc.getFeedback(AxisId::X1).state, AxisState::Jogging);
+
+    // 急停解除全部龙门组的联动
+    plc.forceEmergencyStopCommand(true);
+    plc.tick(EMERGENCY_STOP_ENGAGE_DELAY_MS);
+    EXPECT_FALSE(plc.getGantryFeedback(1).isCoupled);
+}
+
+// 用例 C4：scaled() 布局
+TEST(FakePLCConfigTest, ScaledLayoutKeepsNamedAxesFirst) {
+    auto cfg = FakePLCConfig::scaled(32, 3);
+    ASSERT_EQ(cfg.axes.size(), 32u);
+    EXPECT_EQ(cfg.axes[0].id, AxisId::Y);
+    EXPECT_EQ(cfg.axes[6].id, FakePLCConfig::extraAxisId(0));
+    ASSERT_EQ(cfg.gantries.size(), 3u);
+    EXPECT_EQ(cfg.gantries[0].logical, AxisId::X);
+    EXPECT_EQ(cfg.gantries[2].logical, FakePLCConfig::extraAxisId(3));
+
+    // 放不下的龙门组被丢弃；不足 6 轴按 6 计
+    EXPECT_EQ(FakePLCConfig::scaled(8, 3).gantries.size(), 1u);
+    EXPECT_EQ(FakePLCConfig::scaled(2, 0).axes.size(), 6u);
+    EXPECT_TRUE(FakePLCConfig::scaled(6, 0).gantries.empty());
+}
+
+// ============================================================================
+// 变步长 / 事件推进测试套件
+// 核心验证点：
+//   1. 结果与步长划分无关（大步长 = 多个 10ms 小步 = 任意小数步长）
+//   2. 急停 / 龙门判定发生在定时器到期的时刻，而不是大步长的末尾
+//   3. nextEventIn() 给出精确的事件时刻，advanceToNextEvent() 一次跳到位
+// ============================================================================
+
+namespace {
+
+/// @brief 使能 Y 并完成使能延迟
+void enableY(FakePLC& plc) {
+    plc.onCommand(AxisId::Y, EnableCommand{true});
+    plc.tick(150);
+    ASSERT_EQ(plc.getFeedback(AxisId::Y).state, AxisState::Idle);
+}
+
+} // namespace
+
+// 用例 V1：同一段运动，一个大步长与逐周期推进结果一致
+TEST(FakePLCVariableStepTest, LargeStepMatchesTenMillisecondSteps) {
+    FakePLC coarse, fine, fractional;
+    for (FakePLC* plc : {&coarse, &fine, &fractional}) {
+        enableY(*plc);
+        plc->setSimulatedMoveVelocity(AxisId::Y, 40.0);
+        plc->onCommand(AxisId::Y, MoveCommand{MoveType::Absolute, 73.0, 0.0});
+        plc->onCommand(AxisId::Z, EnableCommand{true});
+    }
+
+    coarse.tick(3000.0);
+    for (int k = 0; k < 300; ++k) fine.tick(10);
+    for (int k = 0; k < 7; ++k) fractional.tick(3000.0 / 7.0);
+
+    for (FakePLC* plc : {&coarse, &fine, &fractional}) {
+        EXPECT_EQ(plc->getFeedback(AxisId::Y).state, AxisState::Idle);
+        EXPECT_DOUBLE_EQ(plc->getFeedback(AxisId::Y).absPos, 73.0);
+        EXPECT_EQ(plc->getFeedback(AxisId::Z).state, AxisState::Idle);
+    }
+}
+
+// 用例 V2：小数步长累计到使能延迟时恰好完成使能
+TEST(FakePLCVariableStepTest, FractionalStepsHitEnableDelayExactly) {
+    FakePLC plc;
+    plc.onCommand(AxisId::Y, EnableCommand{true});
+    for (int k = 0; k < 599; ++k) plc.tick(0.25);
+    EXPECT_EQ(plc.getFeedback(AxisId::Y).state, AxisState::Unknown);
+    plc.tick(0.25);
+    EXPECT_EQ(plc.getFeedback(AxisId::Y).state, AxisState::Idle);
+}
+
+// 用例 V3：急停在生效时刻截断运动，大步长不会多走也不会少走
+TEST(FakePLCVariableStepTest, EmergencyStopCutsMotionAtEngageTime) {
+    FakePLC plc;
+    enableY(plc);
+    plc.setSimulatedJogVelocity(AxisId::Y, 10.0);
+    plc.onCommand(AxisId::Y, JogCommand{Direction::Forward, true});
+    plc.forceEmergencyStopCommand(true);
+
+    plc.tick(1000.0);
+    EXPECT_TRUE(plc.getEmergencyStopFeedback());
+    EXPECT_EQ(plc.getFeedback(AxisId::Y).state, AxisState::Disabled);
+    // 10 mm/s × 50 ms
+    EXPECT_NEAR(plc.getFeedback(AxisId::Y).absPos, 0.5, 1e-9);
+}
+
+// 用例 V4：龙门联动判定读取的是定时器到期时刻的轴状态
+TEST(FakePLCVariableStepTest, GantryCouplingJudgedAtDelayExpiry) {
+    FakePLC plc;
+    plc.onGantryCommand(GantryPowerCommand{true});
+    plc.tick(150);  // 龙门使能延迟
+    ASSERT_TRUE(plc.getGantryFeedback().enable);
+
+    // X1 定位 150ms 后才到位；联动判定在 100ms 时刻，此时 X1 仍在运动
+    plc.setSimulatedMoveVelocity(AxisId::X1, 100.0);
+    plc.onCommand(AxisId::X1, MoveCommand{MoveType::Absolute, 15.0, 0.0});
+    plc.onGantryCommand(GantryCouplingCommand{true});
+    plc.tick(400.0);
+
+    EXPECT_FALSE(plc.getGantryFeedback().isCoupled);
+    EXPECT_EQ(plc.getGantryFeedback().errorCode, 4);  // X1NotStationary
+    EXPECT_DOUBLE_EQ(plc.getFeedback(AxisId::X1).absPos, 15.0);
+}
+
+// 用例 V5：nextEventIn 给出精确事件时刻，advanceToNextEvent 一次跳到位
+TEST(FakePLCVariableStepTest, AdvanceToNextEventJumpsStraightToArrival) {
+    FakePLC plc;
+    EXPECT_TRUE(std::isinf(plc.nextEventIn()));
+    EXPECT_DOUBLE_EQ(plc.advanceToNextEvent(5000.0), 5000.0);  // 空闲：整段跳过
+
+    plc.onCommand(AxisId::Y, EnableCommand{true});
+    EXPECT_DOUBLE_EQ(plc.nextEventIn(), 150.0);
+    plc.advanceToNextEvent(1e9);
+    EXPECT_EQ(plc.getFeedback(AxisId::Y).state, AxisState::Idle);
+
+    plc.setSimulatedMoveVelocity(AxisId::Y, 50.0);
+    plc.onCommand(AxisId::Y, MoveCommand{MoveType::Absolute, 400.0, 0.0});
+    EXPECT_DOUBLE_EQ(plc.nextEventIn(), 8000.0);
+    EXPECT_DOUBLE_EQ(plc.advanceToNextEvent(1e9), 8000.0);
+    EXPECT_EQ(plc.getFeedback(AxisId::Y).state, AxisState::Idle);
+    EXPECT_DOUBLE_EQ(plc.getFeedback(AxisId::Y).absPos, 400.0);
+    EXPECT_TRUE(std::isinf(plc.nextEventIn()));
+
+    // 点动触限：事件时刻 = 到限位的距离 / 点动速度
+    plc.setLimits(AxisId::Y, 420.0, -1000.0);
+    plc.setSimulatedJogVelocity(AxisId::Y, 8.0);
+    plc.onCommand(AxisId::Y, JogCommand{Direction::Forward, true});
+    EXPECT_DOUBLE_EQ(plc.nextEventIn(), 2500.0);
+    while (plc.getFeedback(AxisId::Y).state == AxisState::Jogging) {
+        plc.advanceToNextEvent(1e9);
+    }
+    EXPECT_TRUE(plc.getFeedback(AxisId::Y).posLimit);
+    EXPECT_DOUBLE_EQ(plc.getFeedback(AxisId::Y).absPos, 420.0);
+
+    // 待执行的停止请求是立即事件
+    plc.setLimits(AxisId::Y, 1000.0, -1000.0);
+    plc.onCommand(AxisId::Y, JogCommand{Direction::Backward, true});
+    plc.tick(10);
+    plc.onCommand(AxisId::Y, StopCommand{});
+    EXPECT_DOUBLE_EQ(plc.nextEventIn(), 0.0);
+    plc.advanceToNextEvent(1e9);
+    EXPECT_EQ(plc.getFeedback(AxisId::Y).state, AxisState::Idle);
+}
+
+// ============================================================================
+// 定位速度曲线（Trapezoidal / SCurve）
+// ============================================================================
+
+// 用例 P1：梯形曲线逐周期推进，到位周期与 estimateMoveTimeMs 一致，加速段位置符合 a·t²/2
+TEST(FakePLCMotionProfileTest, TrapezoidalMoveArrivesAtEstimatedTime) {
+    FakePLC plc;
+    enableY(plc);
+    plc.setSimulatedMoveVelocity(AxisId::Y, 50.0);
+    plc.setMotionProfile(AxisId::Y, MotionProfileType::Trapezoidal, 500.0, 500.0);
+
+    // 10mm：加速 100ms / 2.5mm，匀速 100ms / 5mm，减速 100ms / 2.5mm（匀速模型为 200ms）
+    EXPECT_DOUBLE_EQ(plc.estimateMoveTimeMs(AxisId::Y, 10.0), 300.0);
+    plc.onCommand(AxisId::Y, MoveCommand{MoveType::Absolute, 10.0, 0.0});
+
+    int cycles = 0;
+    while (plc.getFeedback(AxisId::Y).state != AxisState::Idle && cycles < 100) {
+        plc.tick(10);
+        ++cycles;
+        if (cycles == 5) {
+            EXPECT_NEAR(plc.getFeedback(AxisId::Y).absPos, 0.625, 1e-9);
+        }
+        if (cycles == 10) {
+            EXPECT_NEAR(plc.getFeedback(AxisId::Y).absPos, 2.5, 1e-9);
+        }
+    }
+    EXPECT_EQ(cycles, 30);
+    EXPECT_DOUBLE_EQ(plc.getFeedback(AxisId::Y).absPos, 10.0);
+}
+
+// 用例 P2：S 曲线下任意步长划分得到相同的轨迹与到位时刻
+TEST(FakePLCMotionProfileTest, SCurveIsIndependentOfStepPartition) {
+    FakePLC coarse, fine;
+    for (FakePLC* plc : {&coarse, &fine}) {
+        enableY(*plc);
+        plc->setSimulatedMoveVelocity(AxisId::Y, 80.0);
+        plc->setMotionProfile(AxisId::Y, MotionProfileType::SCurve, 400.0, 250.0, 4000.0);
+        plc->onCommand(AxisId::Y, MoveCommand{MoveType::Relative, -37.0, 0.0});
+    }
+
+    for (int k = 0; k < 4; ++k) {
+        coarse.tick(130.0);
+        for (int m = 0; m < 13; ++m) fine.tick(10.0);
+        EXPECT_NEAR(coarse.getFeedback(AxisId::Y).absPos, fine.getFeedback(AxisId::Y).absPos, 1e-9);
+        EXPECT_EQ(coarse.getFeedback(AxisId::Y).state, fine.getFeedback(AxisId::Y).state);
+    }
+
+    const double total = coarse.nextEventIn();
+    coarse.advanceToNextEvent(1e9);
+    EXPECT_EQ(coarse.getFeedback(AxisId::Y).state, AxisState::Idle);
+    EXPECT_DOUBLE_EQ(coarse.getFeedback(AxisId::Y).absPos, -37.0);
+    EXPECT_NEAR(520.0 + total,
+        MotionPlan::plan(MotionProfileType::SCurve, 37.0, {80.0, 400.0, 250.0, 4000.0}).duration() * 1000.0, 1e-9);
+}
+
+// 用例 P3：加速段中触限 -> nextEventIn 给出触限时刻，轴停在限位上
+TEST(FakePLCMotionProfileTest, LimitHitDuringRampIsAnEvent) {
+    FakePLC plc;
+    enableY(plc);
+    plc.setLimits(AxisId::Y, 2.0, -1000.0);
+    plc.setSimulatedMoveVelocity(AxisId::Y, 50.0);
+    plc.setMotionProfile(AxisId::Y, MotionProfileType::Trapezoidal, 100.0, 100.0);
+    plc.onCommand(AxisId::Y, MoveCommand{MoveType::Absolute, 50.0, 0.0});
+
+    // a·t²/2 = 2mm -> t = 200ms
+    EXPECT_NEAR(plc.nextEventIn(), 200.0, 1e-6);
+    plc.advanceToNextEvent(1e9);
+    EXPECT_TRUE(plc.getFeedback(AxisId::Y).posLimit);
+    EXPECT_EQ(plc.getFeedback(AxisId::Y).state, AxisState::Idle);
+    EXPECT_DOUBLE_EQ(plc.getFeedback(AxisId::Y).absPos, 2.0);
+}
+
+// 用例 P4：Constant 曲线与原匀速模型一致；运动中改速度只影响下一次定位
+TEST(FakePLCMotionProfileTest, PlanIsFixedWhenMoveStarts) {
+    FakePLC plc;
+    enableY(plc);
+    plc.setSimulatedMoveVelocity(AxisId::Y, 50.0);
+    EXPECT_DOUBLE_EQ(plc.estimateMoveTimeMs(AxisId::Y, 10.0), 200.0);
+
+    plc.setMotionProfile(AxisId::Y, MotionProfileType::Trapezoidal, 500.0, 500.0);
+    plc.onCommand(AxisId::Y, MoveCommand{MoveType::Relative, 10.0, 0.0});
+    plc.onCommand(AxisId::Y, SetMoveVelocityCommand{5.0});
+    plc.tick(300.0);
+    EXPECT_EQ(plc.getFeedback(AxisId::Y).state, AxisState::Idle);
+    EXPECT_DOUBLE_EQ(plc.getFeedback(AxisId::Y).absPos, 10.0);
+
+    // 新速度 5mm/s：加速 10ms / 0.025mm，行程 1mm -> 0.2s + 0.01s
+    EXPECT_NEAR(plc.estimateMoveTimeMs(AxisId::Y, 1.0, MoveType::Relative), 210.0, 1e-9);
+}
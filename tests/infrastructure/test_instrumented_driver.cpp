@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include "infrastructure/InstrumentedDriver.h"
+#include "infrastructure/utils/LatencyHistogram.h"
+#include "domain/entity/SystemContext.h"
+
+// ============================================================================
+// LatencyHistogram / InstrumentedDriver 测试套件
+// 核心验证点：
+//   1. 对数-线性桶映射的精度与单调性
+//   2. 滑动窗口过期切片不再参与统计
+//   3. 装饰器按 (操作类型, 通讯结果) 分维度记录 send / poll 延迟
+// ============================================================================
+
+using namespace std::chrono_literals;
+
+namespace {
+
+using Status = CommunicationResult::Status;
+using Op = InstrumentedDriver::Op;
+
+/// 每次调用都让虚拟时钟前进固定时长的驱动替身
+class SlowDriver : public ISystemDriver {
+public:
+    std::chrono::steady_clock::time_point* now = nullptr;
+    std::chrono::microseconds sendCost{100};
+    std::chrono::microseconds pollCost{2000};
+    Status nextStatus = Status::Sent;
+
+    CommunicationResult send(const SystemCommand&) override {
+        *now += sendCost;
+        return CommunicationResult{nextStatus, 0, ""};
+    }
+    void pollFeedback(SystemContext&) override { *now += pollCost; }
+};
+
+} // namespace
+
+// ── LatencyHistogram ─────────────────────────────────────────
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+    for (uint64_t v = 0; v < LatencyHistogram::SUB_COUNT * 2; ++v) {
+        EXPECT_EQ(LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketIndex(v)), v);
+    }
+}
+
+TEST(LatencyHistogramTest, BucketErrorIsBoundedAndMonotonic) {
+    size_t prev = 0;
+    for (uint64_t v = 1; v < (uint64_t{1} << 34); v = v * 3 / 2 + 1) {
+        size_t idx = LatencyHistogram::bucketIndex(v);
+        EXPECT_GE(idx, prev);
+        prev = idx;
+        uint64_t upper = LatencyHistogram::bucketUpperBound(idx);
+        EXPECT_GE(upper, v);
+        EXPECT_LE(static_cast<double>(upper - v), static_cast<double>(v) / 32.0 + 1.0);
+    }
+}
+
+TEST(LatencyHistogramTest, HugeValuesAreClamped) {
+    EXPECT_EQ(LatencyHistogram::bucketIndex(~uint64_t{0}), LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST(LatencyHistogramTest, PercentilesFollowDistribution) {
+    LatencyHistogram h;
+    for (int i = 0; i < 99; ++i) h.record(1000);   // 1us
+    h.record(1000000);                              // 1ms 长尾
+
+    EXPECT_EQ(h.count(), 100u);
+    EXPECT_NEAR(static_cast<double>(h.percentile(0.50)), 1000.0, 1000.0 / 32.0);
+    EXPECT_NEAR(static_cast<double>(h.percentile(0.99)), 1000.0, 1000.0 / 32.0);
+    EXPECT_EQ(h.percentile(1.0), 1000000u);
+    EXPECT_EQ(h.max(), 1000000u);
+}
+
+TEST(SlidingLatencyHistogramTest, ExpiredSlicesDropOutOfWindow) {
+    std::chrono::steady_clock::time_point t0{};
+    SlidingLatencyHistogram h(3, 100ms, t0);
+
+    h.record(5'000'000, t0);              // 5ms，切片 0
+    h.record(1'000, t0 + 150ms);          // 1us，切片 1
+
+    auto s = h.summary(t0 + 250ms);
+    EXPECT_EQ(s.count, 2u);
+    EXPECT_DOUBLE_EQ(s.maxUs, 5000.0);
+
+    // 窗口 3×100ms，t=350ms 时切片 0 已过期
+    s = h.summary(t0 + 350ms);
+    EXPECT_EQ(s.count, 1u);
+    EXPECT_DOUBLE_EQ(s.maxUs, 1.0);
+
+    s = h.summary(t0 + 1000ms);
+    EXPECT_EQ(s.count, 0u);
+}
+
+// ── InstrumentedDriver ───────────────────────────────────────
+
+class InstrumentedDriverTest : public ::testing::Test {
+protected:
+    std::chrono::steady_clock::time_point now{std::chrono::seconds{1}};
+    SlowDriver inner;
+    InstrumentedDriver driver{inner};
+
+    void SetUp() override {
+        inner.now = &now;
+        driver.setClock([this] { return now; });
+    }
+};
+
+TEST_F(InstrumentedDriverTest, ClassifiesCommandsByAlternative) {
+    EXPECT_EQ(InstrumentedDriver::opOf(AxisCommandWithId{AxisId::Y, StopCommand{}}), Op::Stop);
+    EXPECT_EQ(InstrumentedDriver::opOf(AxisCommandWithId{AxisId::Y, EnableCommand{true}}), Op::Enable);
+    EXPECT_EQ(InstrumentedDriver::opOf(AxisCommandWithId{AxisId::Y, SetMoveVelocityCommand{1.0}}),
+              Op::SetMoveVelocity);
+    EXPECT_EQ(InstrumentedDriver::opOf(GantryCouplingCommand{true}), Op::GantryCoupling);
+    EXPECT_EQ(InstrumentedDriver::opOf(GantryPowerCommand{true}), Op::GantryPower);
+    EXPECT_EQ(InstrumentedDriver::opOf(EmergencyStopCommand{true}), Op::EmergencyStop);
+}
+
+TEST_F(InstrumentedDriverTest, RecordsSendLatencyPerOpAndStatus) {
+    for (int i = 0; i < 10; ++i) {
+        driver.send(AxisCommandWithId{AxisId::Y, EnableCommand{true}});
+    }
+    inner.nextStatus = Status::Timeout;
+    inner.sendCost = 3000us;
+    driver.send(AxisCommandWithId{AxisId::Y, EnableCommand{true}});
+
+    auto ok = driver.summary(Op::Enable, Status::Sent);
+    EXPECT_EQ(ok.count, 10u);
+    EXPECT_NEAR(ok.p50Us, 100.0, 100.0 / 32.0);
+    EXPECT_NEAR(ok.maxUs, 100.0, 1e-9);
+
+    auto timeout = driver.summary(Op::Enable, Status::Timeout);
+    EXPECT_EQ(timeout.count, 1u);
+    EXPECT_NEAR(timeout.maxUs, 3000.0, 1e-9);
+
+    EXPECT_EQ(driver.summary(Op::Stop, Status::Sent).count, 0u);
+}
+
+TEST_F(InstrumentedDriverTest, RecordsPollLatency) {
+    SystemContext ctx;
+    driver.pollFeedback(ctx);
+    driver.pollFeedback(ctx);
+
+    auto s = driver.summary(Op::Poll, Status::Sent);
+    EXPECT_EQ(s.count, 2u);
+    EXPECT_NEAR(s.p99Us, 2000.0, 2000.0 / 32.0);
+}
+
+TEST_F(InstrumentedDriverTest, SnapshotListsOnlyActiveSeries) {
+    SystemContext ctx;
+    driver.pollFeedback(ctx);
+    driver.send(EmergencyStopCommand{true});
+
+    auto snap = driver.snapshot();
+    ASSERT_EQ(snap.size(), 2u);
+    EXPECT_EQ(snap[0].opName, "EmergencyStop");
+    EXPECT_EQ(snap[0].statusName, "Sent");
+    EXPECT_EQ(snap[1].opName, "Poll");
+
+    // 窗口（默认 10 × 1s）过后全部过期
+    now += 20s;
+    EXPECT_TRUE(driver.snapshot().empty());
+}
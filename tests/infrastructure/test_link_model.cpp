@@ -0,0 +1,321 @@
+#include <gtest/gtest.h>
+#include "infrastructure/FakeAxisDriver.h"
+#include "infrastructure/FakePLC.h"
+#include "infrastructure/RetryingDriver.h"
+#include "application/SystemManager.h"
+#include "application/policy/AutoAbsMoveOrchestrator.h"
+#include "application/policy/GantryOrchestrator.h"
+#include "application/policy/JogOrchestrator.h"
+#include "domain/entity/SystemContext.h"
+
+// ============================================================================
+// LinkModel / FakeAxisDriver 链路仿真测试套件
+// 核心验证点：
+//   1. 理想链路行为不变；命令 / 反馈延迟按链路时钟生效，命令保持发送顺序，sendUrgent 插队
+//   2. 通讯失败与丢帧按配置比例出现，且同一 seed 完全可复现
+//   3. 端到端：典型链路下 Jog / 绝对定位 / 龙门编排器仍然完成，延迟增加有上界
+// ============================================================================
+
+namespace {
+
+using Status = CommunicationResult::Status;
+
+SystemCommand enableY() { return AxisCommandWithId{AxisId::Y, EnableCommand{true}}; }
+
+/// @brief 单分组全栈：FakePLC -> FakeAxisDriver(链路模型) -> RetryingDriver(虚拟时钟) -> SystemContext
+struct LinkRig {
+    FakePLC plc;
+    FakeAxisDriver raw{plc};
+    RetryingDriver driver{raw};
+    SystemManager manager;
+    SystemContext* ctx = nullptr;
+    RetryingDriver::Clock::time_point now{};
+    const std::string group = "G";
+
+    explicit LinkRig(const LinkModel& link) {
+        raw.setLinkModel(link);
+        driver.setClock([this] { return now; });
+        ContextRejection r;
+        manager.createGroup(group, r);
+        manager.tryGetGroup(group, ctx, r);
+        ctx->setDriver(&driver);
+        for (auto id : plc.axisIds()) plc.setSimulatedMoveVelocity(id, 50.0);
+    }
+
+    /// @brief 一个主循环周期：推进虚拟时钟，重发到期的排队命令并读取反馈
+    void cycle() {
+        now += std::chrono::milliseconds(FakeAxisDriver::CYCLE_MS);
+        driver.pollFeedback(*ctx);
+    }
+
+    /// @brief 主循环：poll -> tick，直到 done() 或超过 maxCycles；返回所用周期数（超时 -1）
+    template<typename Tick, typename Done>
+    int loop(Tick tick, Done done, int maxCycles = 3000) {
+        for (int c = 0; c < maxCycles; ++c) {
+            if (done()) return c;
+            cycle();
+            tick();
+        }
+        return done() ? maxCycles : -1;
+    }
+
+    /// @brief 等待领域层首次同步（急停 + 龙门状态机离开 NotSynchronized）
+    int sync() {
+        return loop([] {}, [this] {
+            return !ctx->emergencyStopController().isNotSynchronized()
+                && !ctx->gantryCouplingController().isNotSynchronized();
+        });
+    }
+};
+
+/// @brief 从 Disabled 绝对定位到 target 的端到端周期数（失败返回 -1）
+int absMoveCycles(const LinkModel& link, double target) {
+    LinkRig rig(link);
+    if (rig.sync() < 0) return -1;
+    AutoAbsMoveOrchestrator orch(rig.manager, rig.group);
+    orch.startAbs(AxisId::Y, target);
+    const int cycles = rig.loop([&] { orch.tick(); }, [&] { return orch.isDone() || orch.hasError(); });
+    if (orch.hasError() || std::abs(rig.plc.getFeedback(AxisId::Y).absPos - target) > 1e-6) return -1;
+    return cycles;
+}
+
+/// @brief 龙门从掉电到联动完成的端到端周期数（失败返回 -1）
+int gantryCoupleCycles(const LinkModel& link) {
+    LinkRig rig(link);
+    if (rig.sync() < 0) return -1;
+    GantryOrchestrator orch(rig.manager, rig.group);
+    orch.startCoupling();
+    const int cycles = rig.loop([&] { orch.tick(); }, [&] { return orch.isDone() || orch.hasError(); });
+    if (orch.hasError() || !rig.plc.getGantryFeedback().isCoupled) return -1;
+    return cycles;
+}
+
+/// @brief 点动：从 startJog 到 PLC 开始运动、从 stopJog 到编排器结束的周期数
+bool jogCycles(const LinkModel& link, int& startCycles, int& stopCycles) {
+    LinkRig rig(link);
+    if (rig.sync() < 0) return false;
+    JogOrchestrator orch(rig.manager, rig.group);
+    orch.startJog(AxisId::Y, Direction::Forward);
+    startCycles = rig.loop([&] { orch.tick(); }, [&] {
+        return orch.hasError() || rig.plc.getFeedback(AxisId::Y).state == AxisState::Jogging;
+    });
+    if (startCycles < 0 || orch.hasError()) return false;
+
+    rig.loop([&] { orch.tick(); }, [] { return false; }, 20);
+    orch.stopJog(AxisId::Y, Direction::Forward);
+    stopCycles = rig.loop([&] { orch.tick(); }, [&] { return orch.isDone() || orch.hasError(); });
+    return stopCycles >= 0 && !orch.hasError()
+        && rig.plc.getFeedback(AxisId::Y).state != AxisState::Jogging;
+}
+
+} // namespace
+
+// ── 命令 / 反馈通路 ─────────────────────────────────────────
+
+TEST(LinkModelTest, IdealLinkWritesCommandImmediately) {
+    FakePLC plc;
+    FakeAxisDriver driver(plc);
+
+    EXPECT_TRUE(driver.send(enableY()).ok());
+    EXPECT_EQ(plc.getFeedback(AxisId::Y).state, AxisState::Unknown);
+    EXPECT_EQ(driver.commandsInFlight(), 0u);
+}
+
+TEST(LinkModelTest, CommandDelayHoldsCommandForLinkTime) {
+    FakePLC plc;
+    FakeAxisDriver driver(plc);
+    SystemContext ctx;
+    LinkModel link;
+    link.commandDelayMs = 30;
+    driver.setLinkModel(link);
+
+    ASSERT_TRUE(driver.send(enableY()).ok());
+    EXPECT_TRUE(driver.has<EnableCommand>());   // 发送即记录
+    for (int c = 0; c < 2; ++c) {
+        driver.pollFeedback(ctx);
+        EXPECT_EQ(plc.getFeedback(AxisId::Y).state, AxisState::Disabled) << "cycle " << c;
+    }
+    driver.pollFeedback(ctx);
+    EXPECT_NE(plc.getFeedback(AxisId::Y).state, AxisState::Disabled);
+    EXPECT_EQ(driver.commandsInFlight(), 0u);
+    EXPECT_EQ(driver.linkStats().delivered, 1u);
+}
+
+TEST(LinkModelTest, JitteredCommandsKeepSendOrder) {
+    FakePLC plc;
+    FakeAxisDriver driver(plc);
+    SystemContext ctx;
+    LinkModel link;
+    link.commandDelayMs = 10;
+    link.commandJitterMs = 50;
+    driver.setLinkModel(link);
+
+    double lastSeen = 0.0;
+    for (int k = 1; k <= 50; ++k) {
+        ASSERT_TRUE(driver.send(AxisCommandWithId{AxisId::Y, SetJogVelocityCommand{static_cast<double>(k)}}).ok());
+        driver.pollFeedback(ctx);
+        const double v = plc.getFeedback(AxisId::Y).getjogVelocity;
+        EXPECT_GE(v, lastSeen);
+        lastSeen = v;
+    }
+    for (int c = 0; c < 10; ++c) driver.pollFeedback(ctx);
+    EXPECT_DOUBLE_EQ(plc.getFeedback(AxisId::Y).getjogVelocity, 50.0);
+}
+
+TEST(LinkModelTest, UrgentCommandJumpsInFlightQueue) {
+    FakePLC plc;
+    FakeAxisDriver driver(plc);
+    SystemContext ctx;
+    LinkModel link;
+    link.commandDelayMs = 30;
+    driver.setLinkModel(link);
+
+    // 普通命令 t=0 发出（t=30 到达）；在途的解除急停 t=20 发出
+    ASSERT_TRUE(driver.send(enableY()).ok());
+    driver.pollFeedback(ctx);
+    driver.pollFeedback(ctx);
+    ASSERT_TRUE(driver.send(EmergencyStopCommand{false}).ok());
+
+    // t=20 插队急停：在途的解除作废，使能顺延到急停之后（t=50）
+    ASSERT_TRUE(driver.sendUrgent(EmergencyStopCommand{true}).ok());
+    EXPECT_EQ(driver.commandsInFlight(), 2u);
+    EXPECT_EQ(driver.linkStats().urgentSends, 1u);
+
+    driver.pollFeedback(ctx);   // t=30
+    EXPECT_EQ(driver.linkStats().delivered, 0u);
+    EXPECT_EQ(plc.getFeedback(AxisId::Y).state, AxisState::Disabled);
+
+    driver.pollFeedback(ctx);   // t=40
+    driver.pollFeedback(ctx);   // t=50
+    EXPECT_EQ(driver.linkStats().delivered, 2u);
+    EXPECT_EQ(driver.commandsInFlight(), 0u);
+    for (int c = 0; c < 10; ++c) driver.pollFeedback(ctx);
+    EXPECT_TRUE(plc.getEmergencyStopFeedback());
+}
+
+TEST(LinkModelTest, FeedbackDelayShowsOlderSnapshot) {
+    FakePLC plc;
+    FakeAxisDriver driver(plc);
+    SystemContext ctx;
+    LinkModel link;
+    link.feedbackDelayMs = 40;
+    driver.setLinkModel(link);
+
+    Axis* y = nullptr;
+    ContextRejection r;
+    ASSERT_TRUE(ctx.tryReadAxis(AxisId::Y, y, r));
+
+    // 前 4 个周期链路尚未送回任何快照，领域层保持未同步
+    for (int c = 0; c < 4; ++c) driver.pollFeedback(ctx);
+    EXPECT_TRUE(ctx.emergencyStopController().isNotSynchronized());
+    driver.pollFeedback(ctx);
+    EXPECT_FALSE(ctx.emergencyStopController().isNotSynchronized());
+
+    // PLC 已到位之后，领域层还要再过 4 个周期才看到
+    plc.forceState(AxisId::Y, AxisState::Idle);
+    plc.setAbsolutePosition(AxisId::Y, 12.0);
+    for (int c = 0; c < 4; ++c) {
+        driver.pollFeedback(ctx);
+        EXPECT_DOUBLE_EQ(y->currentAbsolutePosition(), 0.0) << "cycle " << c;
+    }
+    driver.pollFeedback(ctx);
+    EXPECT_DOUBLE_EQ(y->currentAbsolutePosition(), 12.0);
+}
+
+TEST(LinkModelTest, DroppedFramesKeepLastKnownFeedback) {
+    FakePLC plc;
+    FakeAxisDriver driver(plc);
+    SystemContext ctx;
+    LinkModel link;
+    link.dropFeedbackRate = 1.0;
+    driver.setLinkModel(link);
+
+    for (int c = 0; c < 20; ++c) driver.pollFeedback(ctx);
+    EXPECT_TRUE(ctx.emergencyStopController().isNotSynchronized());
+    EXPECT_EQ(driver.linkStats().framesDropped, 20u);
+    EXPECT_EQ(driver.linkStats().polls, 20u);
+}
+
+// ── 故障注入 / 可复现性 ─────────────────────────────────────
+
+TEST(LinkModelTest, FaultRatesMatchConfiguration) {
+    FakePLC plc;
+    FakeAxisDriver driver(plc);
+    LinkModel link;
+    link.timeoutRate = 0.10;
+    link.busyRate = 0.05;
+    link.protocolErrorRate = 0.02;
+    link.seed = 7;
+    driver.setLinkModel(link);
+
+    constexpr int N = 20000;
+    int ok = 0;
+    for (int k = 0; k < N; ++k) {
+        auto res = driver.send(AxisCommandWithId{AxisId::Y, SetMoveVelocityCommand{1.0}});
+        if (res.ok()) {
+            ++ok;
+        }
+        if (res.status == Status::Busy) {
+            EXPECT_EQ(res.exceptionCode, 0x06);
+        }
+    }
+    const auto& s = driver.linkStats();
+    EXPECT_NEAR(static_cast<double>(s.timeouts) / N, 0.10, 0.01);
+    EXPECT_NEAR(static_cast<double>(s.busy) / N, 0.05, 0.01);
+    EXPECT_NEAR(static_cast<double>(s.protocolErrors) / N, 0.02, 0.005);
+    EXPECT_EQ(s.delivered, static_cast<uint64_t>(ok));   // 失败的命令不写入 PLC
+    EXPECT_EQ(s.sends, static_cast<uint64_t>(N));
+}
+
+TEST(LinkModelTest, SameSeedReproducesSameSequence) {
+    auto trace = [](uint32_t seed) {
+        FakePLC plc;
+        FakeAxisDriver driver(plc);
+        SystemContext ctx;
+        driver.setLinkModel(LinkModel::degraded(seed));
+        std::vector<int> out;
+        for (int k = 0; k < 300; ++k) {
+            out.push_back(static_cast<int>(driver.send(enableY()).status));
+            driver.pollFeedback(ctx);
+        }
+        out.push_back(static_cast<int>(driver.linkStats().framesDropped));
+        return out;
+    };
+    EXPECT_EQ(trace(3), trace(3));
+    EXPECT_NE(trace(3), trace(4));
+}
+
+// ── 端到端编排器延迟 ────────────────────────────────────────
+
+TEST(LinkModelTest, AbsMoveCompletesUnderTypicalLink) {
+    const int ideal = absMoveCycles(LinkModel::ideal(), 50.0);
+    ASSERT_GT(ideal, 0);
+    for (uint32_t seed = 1; seed <= 5; ++seed) {
+        const int typical = absMoveCycles(LinkModel::typical(seed), 50.0);
+        ASSERT_GT(typical, 0) << "seed " << seed;
+        EXPECT_GE(typical, ideal) << "seed " << seed;
+        EXPECT_LE(typical, ideal + 20) << "seed " << seed;   // 每个握手阶段至多多出数个周期
+    }
+}
+
+TEST(LinkModelTest, GantryCouplingCompletesUnderTypicalLink) {
+    const int ideal = gantryCoupleCycles(LinkModel::ideal());
+    ASSERT_GT(ideal, 0);
+    for (uint32_t seed = 1; seed <= 5; ++seed) {
+        const int typical = gantryCoupleCycles(LinkModel::typical(seed));
+        ASSERT_GT(typical, 0) << "seed " << seed;
+        EXPECT_GE(typical, ideal) << "seed " << seed;
+        EXPECT_LE(typical, ideal + 20) << "seed " << seed;
+    }
+}
+
+TEST(LinkModelTest, JogStartsAndStopsUnderTypicalLink) {
+    int idealStart = 0, idealStop = 0;
+    ASSERT_TRUE(jogCycles(LinkModel::ideal(), idealStart, idealStop));
+    for (uint32_t seed = 1; seed <= 5; ++seed) {
+        int start = 0, stop = 0;
+        ASSERT_TRUE(jogCycles(LinkModel::typical(seed), start, stop)) << "seed " << seed;
+        EXPECT_LE(start, idealStart + 10) << "seed " << seed;
+        EXPECT_LE(stop, idealStop + 10) << "seed " << seed;
+    }
+}
@@ -0,0 +1,318 @@
+#include <gtest/gtest.h>
+#include <deque>
+#include <vector>
+#include "infrastructure/RetryingDriver.h"
+#include "infrastructure/FakePLC.h"
+#include "infrastructure/FakeAxisDriver.h"
+#include "domain/entity/SystemContext.h"
+#include "application/SystemManager.h"
+#include "application/axis/EnableUseCase.h"
+
+// ============================================================================
+// RetryingDriver 测试套件
+// 核心验证点：
+//   1. 只对 retryable()（Timeout / Busy）的失败重试；重试在之后的 pollFeedback 中进行，send() 不等待
+//   2. 重试受次数与延迟预算双重约束，预算判定计入单次尝试耗时
+//   3. 停止 / 急停命令使用独立的 urgent 策略，并丢弃同一轴排队中的常规命令
+//   4. 排队期间后续命令保持发送顺序
+//   5. 排队命令最终失败时锁存，同一轴的下一次常规发送把失败返回给调用方（停止 / 掉电不受拦截）
+// ============================================================================
+
+namespace {
+
+using Status = CommunicationResult::Status;
+using namespace std::chrono_literals;
+
+/// 按脚本依次返回通讯结果的驱动替身（脚本耗尽后返回 Sent）；每次发送推进虚拟时钟 cost
+/// 设置 forward 时，成功的发送与反馈轮询转交给该驱动（接入 FakePLC 闭环）
+class ScriptedDriver : public ISystemDriver {
+public:
+    std::deque<Status> script;
+    std::vector<SystemCommand> sent;
+    int sendCount = 0;
+    int pollCount = 0;
+    RetryingDriver::Clock::time_point* clock = nullptr;
+    std::chrono::microseconds cost{0};
+    ISystemDriver* forward = nullptr;
+
+    CommunicationResult send(const SystemCommand& cmd) override {
+        ++sendCount;
+        sent.push_back(cmd);
+        if (clock) *clock += cost;
+        if (script.empty()) return forward ? forward->send(cmd) : CommunicationResult{};
+        Status s = script.front();
+        script.pop_front();
+        if (s == Status::Sent && forward) return forward->send(cmd);
+        return CommunicationResult{s, 0, "scripted"};
+    }
+
+    void pollFeedback(SystemContext& ctx) override {
+        ++pollCount;
+        if (forward) forward->pollFeedback(ctx);
+    }
+};
+
+} // namespace
+
+class RetryingDriverTest : public ::testing::Test {
+protected:
+    ScriptedDriver inner;
+    RetryingDriver driver{inner};
+    SystemContext ctx;
+
+    // 虚拟时钟：只由 cycle() 与替身的单次尝试耗时推进
+    RetryingDriver::Clock::time_point now{};
+
+    void SetUp() override {
+        inner.clock = &now;
+        driver.setClock([this] { return now; });
+    }
+
+    /// @brief 一个 10ms 主循环周期
+    void cycle(RetryingDriver& d) {
+        now += 10ms;
+        d.pollFeedback(ctx);
+    }
+    void cycle() { cycle(driver); }
+
+    static SystemCommand moveCmd() {
+        return AxisCommandWithId{AxisId::Y, MoveCommand{MoveType::Absolute, 10.0, 0.0}};
+    }
+    static SystemCommand stopCmd() {
+        return AxisCommandWithId{AxisId::Y, StopCommand{}};
+    }
+    static SystemCommand enableCmd() {
+        return AxisCommandWithId{AxisId::Y, EnableCommand{true}};
+    }
+};
+
+TEST_F(RetryingDriverTest, SuccessIsPassedThroughWithoutRetry) {
+    auto r = driver.send(moveCmd());
+
+    EXPECT_TRUE(r.ok());
+    EXPECT_EQ(inner.sendCount, 1);
+    EXPECT_EQ(driver.pendingRetries(), 0u);
+    EXPECT_EQ(driver.stats().lastAttempts, 1);
+    EXPECT_EQ(driver.stats().retriedSends, 0u);
+}
+
+TEST_F(RetryingDriverTest, RetryableFailureIsRetriedOnLaterPollsWithoutBlocking) {
+    inner.script = {Status::Timeout, Status::Busy};
+
+    // send() 只尝试一次，命令进入重试队列，调用方不等待
+    auto r = driver.send(moveCmd());
+    EXPECT_TRUE(r.ok());
+    EXPECT_EQ(inner.sendCount, 1);
+    EXPECT_EQ(now, RetryingDriver::Clock::time_point{});
+    EXPECT_EQ(driver.pendingRetries(), 1u);
+
+    cycle();
+    EXPECT_EQ(inner.sendCount, 2);
+    EXPECT_EQ(driver.pendingRetries(), 1u);
+
+    cycle();
+    EXPECT_EQ(inner.sendCount, 3);
+    EXPECT_EQ(driver.pendingRetries(), 0u);
+    EXPECT_EQ(inner.pollCount, 2);
+    EXPECT_EQ(driver.stats().lastAttempts, 3);
+    EXPECT_EQ(driver.stats().recovered, 1u);
+    EXPECT_EQ(driver.stats().exhausted, 0u);
+    EXPECT_EQ(driver.stats().lastElapsed, 20ms);
+}
+
+TEST_F(RetryingDriverTest, NonRetryableFailureIsReturnedImmediately) {
+    inner.script = {Status::NetworkError};
+
+    auto r = driver.send(moveCmd());
+
+    EXPECT_EQ(r.status, Status::NetworkError);
+    EXPECT_EQ(inner.sendCount, 1);
+    EXPECT_EQ(driver.pendingRetries(), 0u);
+}
+
+TEST_F(RetryingDriverTest, GivesUpWhenLatencyBudgetWouldBeExceeded) {
+    RetryPolicy p;
+    p.maxAttempts = 10;
+    p.initialBackoff = 1ms;
+    p.maxBackoff = 1ms;
+    p.jitterRatio = 0.0;
+    p.latencyBudget = 25ms;
+    RetryingDriver bounded(inner, p);
+    bounded.setClock([this] { return now; });
+    inner.script = std::deque<Status>(10, Status::Timeout);
+
+    EXPECT_TRUE(bounded.send(moveCmd()).ok());
+
+    // t=0 尝试1 -> t=10 尝试2 -> t=20 尝试3 -> t=30 已越过 25ms 预算，放弃
+    for (int c = 0; c < 5; ++c) cycle(bounded);
+    EXPECT_EQ(inner.sendCount, 3);
+    EXPECT_EQ(bounded.pendingRetries(), 0u);
+    EXPECT_EQ(bounded.stats().exhausted, 1u);
+    EXPECT_EQ(bounded.stats().recovered, 0u);
+}
+
+TEST_F(RetryingDriverTest, BudgetCheckIncludesAttemptCost) {
+    RetryPolicy p;
+    p.initialBackoff = 1ms;
+    p.maxBackoff = 1ms;
+    p.jitterRatio = 0.0;
+    p.latencyBudget = 20ms;
+    RetryingDriver bounded(inner, p);
+    bounded.setClock([this] { return now; });
+    inner.cost = 6ms;
+    inner.script = std::deque<Status>(10, Status::Timeout);
+
+    // 尝试1 耗时 6ms：6 + 1 + 6 <= 20，排队
+    EXPECT_TRUE(bounded.send(moveCmd()).ok());
+    EXPECT_EQ(bounded.expectedAttemptCost(), 6ms);
+    ASSERT_EQ(bounded.pendingRetries(), 1u);
+
+    // t=16：再尝试一次预计在 22ms 结束，越过预算，不再尝试
+    cycle(bounded);
+    EXPECT_EQ(inner.sendCount, 1);
+    EXPECT_EQ(bounded.stats().exhausted, 1u);
+
+    // 预算连一次重试都容不下时，send() 直接返回失败
+    p.latencyBudget = 10ms;
+    RetryingDriver tight(inner, p);
+    tight.setClock([this] { return now; });
+    EXPECT_EQ(tight.send(moveCmd()).status, Status::Timeout);
+    EXPECT_EQ(tight.pendingRetries(), 0u);
+}
+
+TEST_F(RetryingDriverTest, StopCommandsUseUrgentPolicy) {
+    inner.script = std::deque<Status>(20, Status::Busy);
+    driver.send(moveCmd());
+    for (int c = 0; c < 10 && driver.pendingRetries() > 0; ++c) cycle();
+    int standardAttempts = driver.stats().lastAttempts;
+
+    inner.script = std::deque<Status>(20, Status::Busy);
+    driver.send(stopCmd());
+    for (int c = 0; c < 10 && driver.pendingRetries() > 0; ++c) cycle();
+    int urgentAttempts = driver.stats().lastAttempts;
+
+    EXPECT_EQ(driver.pendingRetries(), 0u);
+    EXPECT_GT(urgentAttempts, standardAttempts);
+    EXPECT_LE(urgentAttempts, RetryPolicy::urgent().maxAttempts);
+}
+
+TEST_F(RetryingDriverTest, QueuedCommandsKeepSendOrder) {
+    inner.script = {Status::Busy};
+    EXPECT_TRUE(driver.send(enableCmd()).ok());
+    EXPECT_TRUE(driver.send(moveCmd()).ok());     // 前序命令排队中：不立即尝试
+    EXPECT_EQ(inner.sendCount, 1);
+    EXPECT_EQ(driver.stats().heldForOrder, 1u);
+
+    cycle();
+    ASSERT_EQ(inner.sent.size(), 3u);
+    EXPECT_TRUE(std::holds_alternative<EnableCommand>(std::get<AxisCommandWithId>(inner.sent[1]).cmd));
+    EXPECT_TRUE(std::holds_alternative<MoveCommand>(std::get<AxisCommandWithId>(inner.sent[2]).cmd));
+    EXPECT_EQ(driver.pendingRetries(), 0u);
+}
+
+TEST_F(RetryingDriverTest, StopDropsQueuedMotionForSameAxis) {
+    inner.script = {Status::Busy};
+    driver.send(moveCmd());
+    driver.send(AxisCommandWithId{AxisId::Z, MoveCommand{MoveType::Absolute, 5.0, 0.0}});
+    ASSERT_EQ(driver.pendingRetries(), 2u);
+
+    // 停止命令立即尝试，Y 轴排队中的运动命令不再重发；Z 轴不受影响
+    EXPECT_TRUE(driver.send(stopCmd()).ok());
+    EXPECT_EQ(inner.sendCount, 2);
+    EXPECT_EQ(driver.stats().superseded, 1u);
+    ASSERT_EQ(driver.pendingRetries(), 1u);
+
+    cycle();
+    ASSERT_EQ(inner.sent.size(), 3u);
+    EXPECT_EQ(std::get<AxisCommandWithId>(inner.sent[2]).id, AxisId::Z);
+}
+
+TEST_F(RetryingDriverTest, AbandonedQueuedCommandFailureReachesUseCase) {
+    FakePLC plc;
+    FakeAxisDriver fake(plc);
+    inner.forward = &fake;
+    SystemManager manager;
+    SystemContext* group = nullptr;
+    ContextRejection r;
+    ASSERT_TRUE(manager.createGroup("G", r));
+    ASSERT_TRUE(manager.tryGetGroup("G", group, r));
+    group->setDriver(&driver);
+    driver.pollFeedback(*group);   // 首帧同步：Y 轴 Disabled
+
+    // 使能先遇到 Busy 被受理排队，用例看到成功；下一帧重发遇到不可重试的失败而放弃
+    inner.script = {Status::Busy, Status::ProtocolError};
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(EnableUseCase{}.execute(manager, "G", AxisId::Y, true)));
+    now += 10ms;
+    driver.pollFeedback(*group);
+    EXPECT_EQ(driver.stats().abandoned, 1u);
+    EXPECT_EQ(driver.latchedFailures(), 1u);
+    EXPECT_TRUE(fake.history.empty());
+
+    // 同一轴的下一次用例调用拿到先前命令的最终失败，命令不再下发
+    const int attemptsBefore = inner.sendCount;
+    const UseCaseError err = EnableUseCase{}.execute(manager, "G", AxisId::Y, true);
+    ASSERT_TRUE(std::holds_alternative<CommunicationResult>(err));
+    EXPECT_EQ(std::get<CommunicationResult>(err).status, Status::ProtocolError);
+    EXPECT_EQ(inner.sendCount, attemptsBefore);
+    EXPECT_EQ(driver.stats().failuresReported, 1u);
+    EXPECT_EQ(driver.latchedFailures(), 0u);
+
+    // 失败只报告一次：重新发起的使能正常送达
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(EnableUseCase{}.execute(manager, "G", AxisId::Y, true)));
+    EXPECT_EQ(fake.history.size(), 1u);
+}
+
+TEST_F(RetryingDriverTest, LatchedFailureNeverBlocksStopOrDisable) {
+    inner.script = std::deque<Status>(10, Status::Busy);
+    driver.send(moveCmd());
+    for (int c = 0; c < 10 && driver.pendingRetries() > 0; ++c) cycle();
+    ASSERT_EQ(driver.latchedFailures(), 1u);
+
+    // 停止命令照常下发并清除锁存
+    inner.script.clear();
+    EXPECT_TRUE(driver.send(stopCmd()).ok());
+    EXPECT_EQ(driver.latchedFailures(), 0u);
+    EXPECT_EQ(driver.stats().failuresReported, 0u);
+
+    // 掉电同样不受拦截
+    inner.script = std::deque<Status>(10, Status::Busy);
+    driver.send(moveCmd());
+    for (int c = 0; c < 10 && driver.pendingRetries() > 0; ++c) cycle();
+    ASSERT_EQ(driver.latchedFailures(), 1u);
+    inner.script.clear();
+    const int before = inner.sendCount;
+    EXPECT_TRUE(driver.send(AxisCommandWithId{AxisId::Y, EnableCommand{false}}).ok());
+    EXPECT_EQ(inner.sendCount, before + 1);
+    EXPECT_EQ(driver.latchedFailures(), 0u);
+}
+
+TEST_F(RetryingDriverTest, ClassifiesUrgentCommands) {
+    EXPECT_TRUE(RetryingDriver::isUrgent(stopCmd()));
+    EXPECT_TRUE(RetryingDriver::isUrgent(EmergencyStopCommand{true}));
+    EXPECT_TRUE(RetryingDriver::isUrgent(
+        AxisCommandWithId{AxisId::Z, JogCommand{Direction::Forward, false}}));
+    EXPECT_FALSE(RetryingDriver::isUrgent(
+        AxisCommandWithId{AxisId::Z, JogCommand{Direction::Forward, true}}));
+    EXPECT_FALSE(RetryingDriver::isUrgent(moveCmd()));
+    EXPECT_FALSE(RetryingDriver::isUrgent(GantryPowerCommand{true}));
+}
+
+TEST_F(RetryingDriverTest, PollFeedbackIsDelegated) {
+    driver.pollFeedback(ctx);
+    EXPECT_EQ(inner.pollCount, 1);
+}
+
+TEST_F(RetryingDriverTest, WrapsFakeDriverTransparently) {
+    FakePLC plc;
+    FakeAxisDriver fake(plc);
+    RetryingDriver wrapped(fake);
+
+    auto r = wrapped.send(AxisCommandWithId{AxisId::Y, EnableCommand{true}});
+    EXPECT_TRUE(r.ok());
+    ASSERT_EQ(fake.history.size(), 1u);
+
+    fake.disconnect();
+    r = wrapped.send(AxisCommandWithId{AxisId::Y, EnableCommand{false}});
+    EXPECT_EQ(r.status, Status::Disconnected);
+    EXPECT_EQ(wrapped.stats().lastAttempts, 1);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "infrastructure/SharedPlcTransport.h"
+#include "infrastructure/FakePLC.h"
+#include "domain/entity/SystemContext.h"
+
+// ============================================================================
+// SharedPlcTransport 测试套件
+// 核心验证点：
+//   1. 多个分组门面共享一条请求流，每周期只发生一次交换
+//   2. 同一周期内所有分组看到同一批次的一致快照
+//   3. 写请求只落到本分组的寄存器窗口
+//   4. 链路断开时 send 返回 Disconnected，poll 保留上次反馈
+//   5. sendUrgent 插到普通写请求之前，并取代本窗口排队中的急停写请求
+// ============================================================================
+
+class SharedPlcTransportTest : public ::testing::Test {
+protected:
+    FakePLC plcA, plcB;
+    SharedPlcTransport link;
+    SharedPlcDriver driverA{link, link.addWindow(plcA)};
+    SharedPlcDriver driverB{link, link.addWindow(plcB)};
+    SystemContext ctxA, ctxB;
+
+    void SetUp() override {
+        ctxA.setDriver(&driverA);
+        ctxB.setDriver(&driverB);
+    }
+
+    void cycle(int n = 1) {
+        for (int i = 0; i < n; ++i) {
+            driverA.pollFeedback(ctxA);
+            driverB.pollFeedback(ctxB);
+        }
+    }
+
+    static AxisState stateOf(SystemContext& ctx, AxisId id) {
+        Axis* axis = nullptr;
+        ContextRejection r;
+        EXPECT_TRUE(ctx.tryGetAxis(id, axis, r));
+        return axis ? axis->state() : AxisState::Unknown;
+    }
+};
+
+TEST_F(SharedPlcTransportTest, OneExchangePerCycleAcrossGroups) {
+    cycle(5);
+
+    EXPECT_EQ(link.exchangeCount(), 5u);
+    EXPECT_EQ(driverA.lastGeneration(), driverB.lastGeneration());
+    EXPECT_EQ(driverA.lastGeneration(), 5u);
+}
+
+TEST_F(SharedPlcTransportTest, WritesAreRoutedToOwnWindow) {
+    cycle();
+    ASSERT_TRUE(driverA.send(AxisCommandWithId{AxisId::Y, EnableCommand{true}}).ok());
+
+    // 写请求排队，直到下一次交换才写入 PLC
+    EXPECT_EQ(link.writesFlushed(), 0u);
+    cycle(20);   // 200ms > 使能延迟 150ms
+    EXPECT_EQ(link.writesFlushed(), 1u);
+
+    EXPECT_EQ(stateOf(ctxA, AxisId::Y), AxisState::Idle);
+    EXPECT_EQ(stateOf(ctxB, AxisId::Y), AxisState::Disabled);
+    EXPECT_EQ(plcB.getFeedback(AxisId::Y).state, AxisState::Disabled);
+}
+
+TEST_F(SharedPlcTransportTest, RepeatedPollOfSameGroupTriggersNewExchange) {
+    driverA.pollFeedback(ctxA);
+    driverA.pollFeedback(ctxA);
+    EXPECT_EQ(link.exchangeCount(), 2u);
+
+    // B 组读取的是最近一次交换的快照，不再额外交换
+    driverB.pollFeedback(ctxB);
+    EXPECT_EQ(link.exchangeCount(), 2u);
+    EXPECT_EQ(driverB.lastGeneration(), 2u);
+}
+
+TEST_F(SharedPlcTransportTest, DisconnectedLinkRejectsWritesAndKeepsFeedback) {
+    cycle();
+    link.disconnect();
+
+    auto r = driverA.send(AxisCommandWithId{AxisId::Y, EnableCommand{true}});
+    EXPECT_EQ(r.status, CommunicationResult::Status::Disconnected);
+
+    cycle(3);
+    EXPECT_EQ(link.exchangeCount(), 1u);
+    EXPECT_EQ(stateOf(ctxA, AxisId::Y), AxisState::Disabled);
+
+    link.connect();
+    cycle();
+    EXPECT_EQ(link.exchangeCount(), 2u);
+}
+
+TEST_F(SharedPlcTransportTest, UrgentWriteJumpsQueueAndSupersedesRelease) {
+    cycle();
+    ASSERT_TRUE(driverA.send(EmergencyStopCommand{false}).ok());
+    ASSERT_TRUE(driverB.send(AxisCommandWithId{AxisId::Y, EnableCommand{true}}).ok());
+    ASSERT_TRUE(driverA.sendUrgent(EmergencyStopCommand{true}).ok());
+
+    // A 组排队中的解除被急停取代；B 组的普通写请求照常冲刷
+    cycle(10);
+    EXPECT_EQ(link.writesFlushed(), 2u);
+    EXPECT_TRUE(plcA.getEmergencyStopFeedback());
+    EXPECT_FALSE(plcB.getEmergencyStopFeedback());
+}
+
+TEST_F(SharedPlcTransportTest, OutOfRangeWindowIsProtocolError) {
+    auto r = link.enqueueWrite(99, EmergencyStopCommand{true});
+    EXPECT_EQ(r.status, CommunicationResult::Status::ProtocolError);
+    EXPECT_EQ(r.exceptionCode, 0x02);
+}
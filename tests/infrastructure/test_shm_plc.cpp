@@ -0,0 +1,321 @@
+#include <gtest/gtest.h>
+#include "infrastructure/FakeAxisDriver.h"
+#include "infrastructure/FakePLC.h"
+#include "infrastructure/ShmPlcDriver.h"
+#include "infrastructure/ShmPlcServer.h"
+#include "application/SystemManager.h"
+#include "application/policy/AutoAbsMoveOrchestrator.h"
+#include "domain/entity/SystemContext.h"
+
+#if SERVOV6_HAS_SHM_PLC
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+// ============================================================================
+// ShmPlcServer / ShmPlcDriver 测试套件（进程外仿真器，Linux）
+// 核心验证点：
+//   1. Lockstep 下每次 pollFeedback 恰好推进一个扫描周期，行为与进程内 FakeAxisDriver 逐周期一致
+//   2. 服务端不在线时 send 返回 Disconnected，pollFeedback 不阻塞、不分派
+//   3. 命令环满时 send 返回 Busy，服务端消费后恢复
+//   4. 服务端下线（含被 SIGKILL、未清除 online）后驱动转为断开，重新上线后自动重连
+//      写端停在发布中途时反馈读有上限，不自旋
+//   5. 跨进程（fork）完成一次绝对定位并由客户端请求服务端退出
+// ============================================================================
+
+namespace {
+
+using Status = CommunicationResult::Status;
+
+const FakeAxisProfile PROFILE{20.0, 50.0, 1000.0, -1000.0};
+
+/// @brief 每个测试独立的段名（并行运行的测试进程互不干扰）
+std::string uniqueSegment(const std::string& tag) {
+    return shmplc::segmentName("test." + tag + "." + std::to_string(::getpid()));
+}
+
+/// @brief 在后台线程中运行的服务端
+struct ServerThread {
+    ShmPlcServer server;
+    std::atomic<bool> stop{false};
+    std::thread thread;
+
+    ServerThread(const std::string& segment, shmplc::Mode mode = shmplc::Mode::Lockstep)
+        : server(segment, FakePLCConfig::standard(PROFILE), mode) {
+        EXPECT_TRUE(server.start());
+        thread = std::thread([this] { server.run(stop); });
+    }
+    ~ServerThread() {
+        stop.store(true);
+        thread.join();
+        server.stop();
+    }
+};
+
+struct Group {
+    SystemManager manager;
+    SystemContext* ctx = nullptr;
+    const std::string name = "G";
+
+    explicit Group(ISystemDriver& driver) {
+        ContextRejection r;
+        manager.createGroup(name, r);
+        manager.tryGetGroup(name, ctx, r);
+        ctx->setDriver(&driver);
+    }
+};
+
+double absPos(SystemContext& ctx, AxisId id) {
+    Axis* axis = nullptr;
+    ContextRejection r;
+    if (!ctx.tryGetAxis(id, axis, r) || !axis) return 0.0;
+    return axis->currentAbsolutePosition();
+}
+
+/// @brief 驱动一次 Y 轴绝对定位，返回完成所需的周期数（未完成返回 -1）
+int runAbsMove(ISystemDriver& driver, double target) {
+    Group g(driver);
+    AutoAbsMoveOrchestrator orch(g.manager, g.name);
+    bool started = false;
+    for (int c = 0; c < 2000; ++c) {
+        driver.pollFeedback(*g.ctx);
+        if (!started && !g.ctx->emergencyStopController().isNotSynchronized()) {
+            orch.startAbs(AxisId::Y, target);
+            started = true;
+        }
+        orch.tick();
+        if (started && orch.isDone()) {
+            return absPos(*g.ctx, AxisId::Y) == target ? c : -1;
+        }
+        if (orch.hasError()) return -1;
+    }
+    return -1;
+}
+
+} // namespace
+
+TEST(ShmPlcTest, LockstepAdvancesOneCyclePerPoll) {
+    const std::string seg = uniqueSegment("lockstep");
+    ServerThread srv(seg);
+    ShmPlcDriver driver(seg);
+    ASSERT_TRUE(driver.connect());
+    EXPECT_EQ(driver.mode(), shmplc::Mode::Lockstep);
+
+    Group g(driver);
+    for (uint64_t i = 1; i <= 5; ++i) {
+        driver.pollFeedback(*g.ctx);
+        ASSERT_NE(driver.lastFeedbackFrame(), nullptr);
+        EXPECT_EQ(driver.lastFeedbackFrame()->generation, i);
+    }
+    EXPECT_EQ(driver.lastFeedbackFrame()->axes.size(), 6u);
+    EXPECT_EQ(driver.stats().tickTimeouts, 0u);
+}
+
+TEST(ShmPlcTest, AbsMoveMatchesInProcessDriverCycleForCycle) {
+    FakePLC plc(FakePLCConfig::standard(PROFILE));
+    FakeAxisDriver local(plc);
+    const int localCycles = runAbsMove(local, 120.0);
+    ASSERT_GT(localCycles, 0);
+
+    const std::string seg = uniqueSegment("parity");
+    ServerThread srv(seg);
+    ShmPlcDriver remote(seg);
+    ASSERT_TRUE(remote.connect());
+    EXPECT_EQ(runAbsMove(remote, 120.0), localCycles);
+    EXPECT_GT(srv.server.commandsApplied(), 0u);
+}
+
+TEST(ShmPlcTest, OfflineServerReportsDisconnectedWithoutBlocking) {
+    ShmPlcDriver driver(uniqueSegment("offline"), std::chrono::milliseconds(1000));
+    EXPECT_FALSE(driver.connect());
+
+    const auto r = driver.send(AxisCommandWithId{AxisId::Y, StopCommand{}});
+    EXPECT_EQ(r.status, Status::Disconnected);
+
+    Group g(driver);
+    const auto start = std::chrono::steady_clock::now();
+    driver.pollFeedback(*g.ctx);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+    EXPECT_EQ(driver.lastFeedbackFrame(), nullptr);
+}
+
+TEST(ShmPlcTest, FullCommandRingReportsBusyUntilDrained) {
+    const std::string seg = uniqueSegment("ring");
+    ShmPlcServer server(seg, FakePLCConfig::standard(PROFILE));
+    ASSERT_TRUE(server.start());
+    ShmPlcDriver driver(seg);
+    ASSERT_TRUE(driver.connect());
+
+    const SystemCommand cmd = AxisCommandWithId{AxisId::Y, SetMoveVelocityCommand{30.0}};
+    for (uint32_t i = 0; i < shmplc::COMMAND_SLOTS; ++i) {
+        ASSERT_EQ(driver.send(cmd).status, Status::Sent);
+    }
+    const auto busy = driver.send(cmd);
+    EXPECT_EQ(busy.status, Status::Busy);
+    EXPECT_EQ(busy.exceptionCode, 0x06);
+    EXPECT_EQ(driver.stats().ringFull, 1u);
+
+    // 服务端开始服务：下一次 poll 的周期里整环命令按序生效
+    std::atomic<bool> stop{false};
+    std::thread t([&] { while (!stop.load()) server.serveOnce(std::chrono::milliseconds(5)); });
+    Group g(driver);
+    driver.pollFeedback(*g.ctx);
+    stop.store(true);
+    t.join();
+
+    EXPECT_EQ(server.commandsApplied(), shmplc::COMMAND_SLOTS);
+    EXPECT_EQ(driver.send(cmd).status, Status::Sent);
+    EXPECT_DOUBLE_EQ(server.plc().getFeedback(AxisId::Y).getMoveVelocity, 30.0);
+}
+
+TEST(ShmPlcTest, StalledFeedbackWriteGivesUpInsteadOfSpinning) {
+    const std::string seg = uniqueSegment("stall");
+    ShmPlcServer server(seg, FakePLCConfig::standard(PROFILE), shmplc::Mode::FreeRunning);
+    ASSERT_TRUE(server.start());
+    ShmPlcDriver driver(seg);
+    ASSERT_TRUE(driver.connect());
+    Group g(driver);
+
+    // 模拟写端停在发布中途：序号停在奇数
+    shmplc::Segment peer;
+    ASSERT_TRUE(peer.open(seg));
+    peer.file()->feedbackSeq.fetch_add(1, std::memory_order_release);
+
+    const auto start = std::chrono::steady_clock::now();
+    driver.pollFeedback(*g.ctx);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+    EXPECT_EQ(driver.lastFeedbackFrame(), nullptr);
+    EXPECT_EQ(driver.stats().readTimeouts, 1u);
+    EXPECT_EQ(driver.stats().framesDispatched, 0u);
+
+    // 写端完成发布后恢复正常分派
+    peer.file()->feedbackSeq.fetch_add(1, std::memory_order_release);
+    driver.pollFeedback(*g.ctx);
+    EXPECT_NE(driver.lastFeedbackFrame(), nullptr);
+    EXPECT_EQ(driver.stats().framesDispatched, 1u);
+
+    // 写端中途下线：不计超时，立即放弃
+    peer.file()->feedbackSeq.fetch_add(1, std::memory_order_release);
+    peer.file()->online.store(0, std::memory_order_release);
+    driver.pollFeedback(*g.ctx);
+    EXPECT_EQ(driver.lastFeedbackFrame(), nullptr);
+    EXPECT_EQ(driver.stats().readTimeouts, 1u);
+}
+
+TEST(ShmPlcTest, DriverReconnectsAfterServerRestart) {
+    const std::string seg = uniqueSegment("restart");
+    ShmPlcDriver driver(seg, std::chrono::milliseconds(200));
+    Group g(driver);
+    {
+        ServerThread srv(seg);
+        ASSERT_TRUE(driver.connect());
+        driver.pollFeedback(*g.ctx);
+        ASSERT_NE(driver.lastFeedbackFrame(), nullptr);
+    }
+    EXPECT_FALSE(driver.isConnected());
+    EXPECT_EQ(driver.send(AxisCommandWithId{AxisId::Y, StopCommand{}}).status, Status::Disconnected);
+    driver.pollFeedback(*g.ctx);
+    EXPECT_EQ(driver.lastFeedbackFrame(), nullptr);
+
+    ServerThread again(seg);
+    for (int i = 0; i <= ShmPlcDriver::RECONNECT_EVERY_POLLS && !driver.isConnected(); ++i) {
+        driver.pollFeedback(*g.ctx);
+    }
+    EXPECT_TRUE(driver.isConnected());
+    EXPECT_EQ(driver.stats().reconnects, 1u);
+    // 重连所在的那次 poll 即请求新服务端的第一个周期
+    ASSERT_NE(driver.lastFeedbackFrame(), nullptr);
+    EXPECT_EQ(driver.lastFeedbackFrame()->generation, 1u);
+}
+
+TEST(ShmPlcTest, KilledServerIsDetectedAndReattached) {
+    const std::string seg = uniqueSegment("killed");
+    const pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        ShmPlcServer server(seg, FakePLCConfig::standard(PROFILE));
+        if (!server.start()) ::_exit(1);
+        std::atomic<bool> never{false};
+        server.run(never);
+        ::_exit(0);
+    }
+
+    ShmPlcDriver driver(seg, std::chrono::milliseconds(50));
+    Group g(driver);
+    bool connected = false;
+    for (int i = 0; i < 500 && !connected; ++i) {
+        connected = driver.connect();
+        if (!connected) std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    if (!connected) ::kill(child, SIGKILL);
+    ASSERT_TRUE(connected);
+    driver.pollFeedback(*g.ctx);
+    ASSERT_NE(driver.lastFeedbackFrame(), nullptr);
+
+    // SIGKILL：服务端来不及清除 online，段名也未删除
+    ::kill(child, SIGKILL);
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    EXPECT_TRUE(driver.isConnected());
+
+    // 一次节拍超时后确认进程已不存在，转为断开；之后的 poll 不再等待
+    driver.pollFeedback(*g.ctx);
+    EXPECT_EQ(driver.stats().tickTimeouts, 1u);
+    EXPECT_EQ(driver.stats().serverLost, 1u);
+    EXPECT_FALSE(driver.isConnected());
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 5; ++i) driver.pollFeedback(*g.ctx);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+    EXPECT_EQ(driver.stats().tickTimeouts, 1u);
+    EXPECT_FALSE(driver.connect());   // 残留段不被挂接
+
+    // 新服务端接管同名段后自动重连
+    ServerThread again(seg);
+    for (int i = 0; i <= ShmPlcDriver::RECONNECT_EVERY_POLLS && !driver.isConnected(); ++i) {
+        driver.pollFeedback(*g.ctx);
+    }
+    EXPECT_TRUE(driver.isConnected());
+    EXPECT_EQ(driver.stats().reconnects, 1u);
+}
+
+TEST(ShmPlcTest, AbsMoveAcrossProcessBoundary) {
+    const std::string seg = uniqueSegment("fork");
+    const pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        ShmPlcServer server(seg, FakePLCConfig::standard(PROFILE));
+        if (!server.start()) ::_exit(1);
+        std::atomic<bool> never{false};
+        server.run(never);
+        server.stop();
+        ::_exit(0);
+    }
+
+    ShmPlcDriver driver(seg);
+    bool connected = false;
+    for (int i = 0; i < 500 && !connected; ++i) {
+        connected = driver.connect();
+        if (!connected) std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    EXPECT_TRUE(connected);
+    if (connected) {
+        EXPECT_GT(runAbsMove(driver, -75.0), 0);
+        EXPECT_EQ(driver.stats().tickTimeouts, 0u);
+        driver.requestServerShutdown();
+    } else {
+        ::kill(child, SIGKILL);
+    }
+
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    if (connected) {
+        EXPECT_TRUE(WIFEXITED(status));
+        EXPECT_EQ(WEXITSTATUS(status), 0);
+    }
+}
+
+#endif // SERVOV6_HAS_SHM_PLC
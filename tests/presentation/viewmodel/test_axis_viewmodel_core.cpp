@@ -68,7 +68,7 @@ protected:
 
     // ====================================================================
     // 辅助：时间推进器
-    //   1. 驱动 ViewModel（编排器状态机）
+    //   1. 驱动 ViewModel（编排器状态机 + 采集本帧快照）
     //   2. 驱动物理 PLC 引擎
     //   3. 同步硬件反馈到领域层
     // ====================================================================
@@ -94,6 +94,16 @@ protected:
         return false;
     }
 
+    // ====================================================================
+    // 辅助：让 PLC 报告轴 Error 并同步到领域层
+    //   零位类操作只在 Idle / Disabled 下被接受，Error 态下被 Axis 层以 InvalidState 拒绝
+    // ====================================================================
+    void forceAxisError() {
+        plc.forceState(AxisId::Y, AxisState::Error);
+        driver.pollFeedback(*ctx);
+        ASSERT_EQ(getAxis()->state(), AxisState::Error);
+    }
+
     // ====================================================================
     // 辅助：获取领域层 Axis 指针（用于状态断言）
     // ====================================================================
@@ -304,9 +314,10 @@ TEST_F(AxisViewModelCoreTest, ShouldRejectMoveWhenDisabled) {
 
     vm->moveAbsolute(100.0);
 
-    // 先推进一帧确保 Orchestrator 状态机被驱动启动（避免 waitUntil
-    // 因 condition 初始为 true 而直接返回，导致从未 tick 过）
-    advanceTime(TICK_MS);
+    // 先推进两帧确保 Orchestrator 状态机被驱动启动（避免 waitUntil
+    // 因 condition 初始为 true 而直接返回，导致从未 tick 过）：
+    // 第一帧下发使能，第二帧反馈回读后才进入快照
+    advanceTime(2 * TICK_MS);
 
     // 等待运动完成（Orchestrator 自动 Enable + Move + Disable）
     bool done = waitUntil([this]() { return vm->state() == AxisState::Disabled; }, 10000);
@@ -428,12 +439,13 @@ TEST_F(AxisViewModelCoreTest, ShouldAccumulateErrorsWithoutOverwriting) {
     EXPECT_FALSE(vm->hasError());
     EXPECT_EQ(vm->errorCount(), 0u);
 
-    // 在 Disabled 状态执行零位操作（产生 Modal 错误）
+    // 在 Error 状态执行零位操作（产生 Modal 错误）
+    forceAxisError();
     vm->zeroAbsolutePosition();
     ASSERT_TRUE(vm->hasError());
     EXPECT_EQ(vm->errorCount(), 1u);
     auto firstErr = vm->lastError();
-    // 轴存在但处于 Disabled 状态，zeroAbsolutePosition() 被 Axis 层拒绝
+    // 轴存在但处于 Error 状态，zeroAbsolutePosition() 被 Axis 层拒绝
     EXPECT_EQ(firstErr.code, "AXIS_INVALID_STATE");
 
     // 执行另一个零位操作（产生第二个错误，应追加而非覆盖第一个）
@@ -447,12 +459,13 @@ TEST_F(AxisViewModelCoreTest, ShouldAccumulateErrorsWithoutOverwriting) {
 TEST_F(AxisViewModelCoreTest, AllErrorsShouldReturnFullSnapshot) {
     EXPECT_EQ(vm->allErrors().size(), 0u);
 
+    forceAxisError();
     vm->zeroAbsolutePosition();
     ASSERT_GE(vm->errorCount(), 1u);
 
     auto errors = vm->allErrors();
     EXPECT_EQ(errors.size(), vm->errorCount());
-    // 轴存在但处于 Disabled 状态，被 Axis 层以 InvalidState 拒绝
+    // 轴存在但处于 Error 状态，被 Axis 层以 InvalidState 拒绝
     EXPECT_EQ(errors[0].code, "AXIS_INVALID_STATE");
 }
 
@@ -460,6 +473,7 @@ TEST_F(AxisViewModelCoreTest, AllErrorsShouldReturnFullSnapshot) {
 // ⭐ 测试 16：acknowledgeError 按索引移除单条错误
 // =========================================================
 TEST_F(AxisViewModelCoreTest, ShouldAcknowledgeErrorByIndex) {
+    forceAxisError();
     vm->zeroAbsolutePosition();
     ASSERT_GE(vm->errorCount(), 1u);
 
@@ -476,6 +490,7 @@ TEST_F(AxisViewModelCoreTest, ShouldAcknowledgeErrorByIndex) {
 // ⭐ 测试 17：clearAllErrors 批量清除
 // =========================================================
 TEST_F(AxisViewModelCoreTest, ShouldClearAllErrors) {
+    forceAxisError();
     vm->zeroAbsolutePosition();
     vm->setRelativeZero();
     ASSERT_GE(vm->errorCount(), 2u);
@@ -490,6 +505,7 @@ TEST_F(AxisViewModelCoreTest, ShouldClearAllErrors) {
 // ⭐ 测试 18：clearError() 兼容接口等价于 clearAllErrors
 // =========================================================
 TEST_F(AxisViewModelCoreTest, ClearErrorShouldBeEquivalentToClearAllErrors) {
+    forceAxisError();
     vm->zeroAbsolutePosition();
     ASSERT_TRUE(vm->hasError());
 
@@ -519,3 +535,37 @@ TEST_F(AxisViewModelCoreTest, LastErrorShouldReturnInvalidWhenEmpty) {
     EXPECT_FALSE(err.isValid());
     EXPECT_TRUE(err.code.empty());
 }
+
+// =========================================================
+// 测试 21：单帧快照 -- getter 读取 tick() 采集的值，反馈变化在下一帧可见
+// =========================================================
+TEST_F(AxisViewModelCoreTest, GettersServeSnapshotTakenByTick) {
+    EXPECT_TRUE(vm->snapshot().found);
+
+    plc.setAbsolutePosition(AxisId::Y, 42.0);
+    plc.forceState(AxisId::Y, AxisState::Idle);
+    driver.pollFeedback(*ctx);
+    ASSERT_DOUBLE_EQ(getAxis()->currentAbsolutePosition(), 42.0);
+
+    // 领域层已更新，快照仍是上一帧
+    EXPECT_DOUBLE_EQ(vm->absPos(), 0.0);
+    EXPECT_EQ(vm->state(), AxisState::Disabled);
+
+    vm->tick();
+    EXPECT_DOUBLE_EQ(vm->absPos(), 42.0);
+    EXPECT_EQ(vm->state(), AxisState::Idle);
+    EXPECT_TRUE(vm->isEnabled());
+    EXPECT_DOUBLE_EQ(vm->posLimit(), 1000.0);
+}
+
+// =========================================================
+// 测试 22：轴不可读时快照回落到默认值
+// =========================================================
+TEST_F(AxisViewModelCoreTest, SnapshotFallsBackToDefaultsWhenGroupMissing) {
+    AxisViewModelCore orphan(manager, "NoSuchGroup", AxisId::Y);
+    orphan.tick();
+    EXPECT_FALSE(orphan.snapshot().found);
+    EXPECT_EQ(orphan.state(), AxisState::Unknown);
+    EXPECT_DOUBLE_EQ(orphan.absPos(), 0.0);
+    EXPECT_DOUBLE_EQ(orphan.negLimit(), 0.0);
+}
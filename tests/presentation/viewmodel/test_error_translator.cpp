@@ -221,6 +221,28 @@ TEST_F(ErrorTranslatorTest, CommunicationResult_SentShouldFallThrough) {
     EXPECT_EQ(vmErr.code, "COMM_UNKNOWN");
 }
 
+TEST_F(ErrorTranslatorTest, CommunicationResult_DescribeFormatsLazily) {
+    CommunicationResult commResult;
+    commResult.status = CommunicationResult::Status::ProtocolError;
+    commResult.exceptionCode = 0x02;
+    commResult.diagnostic = "Illegal Data Address";
+    EXPECT_EQ(commResult.describe(), "ProtocolError (exception 0x2): Illegal Data Address");
+
+    CommunicationResult ok;
+    EXPECT_EQ(ok.describe(), "Sent");
+    EXPECT_TRUE(std::is_trivially_copyable_v<UseCaseError>);
+}
+
+TEST_F(ErrorTranslatorTest, CommunicationResult_NullDiagnosticIsTreatedAsEmpty) {
+    CommunicationResult commResult;
+    commResult.status = CommunicationResult::Status::Timeout;
+    commResult.diagnostic = nullptr;
+    auto vmErr = translate(UseCaseError{commResult});
+    EXPECT_EQ(vmErr.code, "COMM_TIMEOUT");
+    EXPECT_TRUE(vmErr.debugMessage.empty());
+    EXPECT_EQ(commResult.describe(), "Timeout");
+}
+
 // ============================================================================
 // 5. GantryRejection（龙门联动层）
 // ============================================================================
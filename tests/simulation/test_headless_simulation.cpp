@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "simulation/HeadlessSimulation.h"
+#include "simulation/Scenarios.h"
+#include "presentation/viewmodel/AxisViewModelCore.h"
+#include "domain/entity/SystemContext.h"
+#include "infrastructure/FakePLC.h"
+
+// ============================================================================
+// HeadlessSimulation 测试套件
+// 核心验证点：
+//   1. 虚拟时钟按步长推进，与实时运行无关
+//   2. 全部内置场景在同一仿真实例上顺序通过
+//   3. 浸泡循环可以反复执行场景（场景结束时恢复了轴状态）
+// ============================================================================
+
+TEST(HeadlessSimulationTest, VirtualClockAdvancesByStep) {
+    HeadlessSimulation sim;
+    sim.runFor(1.0);
+
+    EXPECT_EQ(sim.steps(), 100u);
+    EXPECT_DOUBLE_EQ(sim.simSeconds(), 1.0);
+}
+
+TEST(HeadlessSimulationTest, UnknownGroupOrAxisReturnsNull) {
+    HeadlessSimulation sim;
+
+    EXPECT_EQ(sim.axis("Machine_C", AxisId::Y), nullptr);
+    EXPECT_EQ(sim.plc("Machine_C"), nullptr);
+    EXPECT_EQ(sim.gantry("Machine_A"), nullptr);
+    EXPECT_NE(sim.axis("Machine_A", AxisId::Y), nullptr);
+}
+
+TEST(HeadlessSimulationTest, AllBuiltinScenariosPass) {
+    HeadlessSimulation sim;
+    for (const auto& s : builtinScenarios()) {
+        ScenarioResult r = s.run(sim);
+        EXPECT_TRUE(r.passed) << r.name << ": " << r.detail;
+    }
+}
+
+TEST(HeadlessSimulationTest, SoakRepeatsScenarios) {
+    HeadlessSimulation sim;
+    size_t iterations = 0;
+    ScenarioResult failure;
+
+    ASSERT_TRUE(runSoak(sim, 60.0, iterations, failure)) << failure.name << ": " << failure.detail;
+    EXPECT_GE(iterations, 2u);
+    EXPECT_GE(sim.simSeconds(), 60.0);
+}
+
+TEST(HeadlessSimulationTest, UnknownScenarioFails) {
+    HeadlessSimulation sim;
+    EXPECT_FALSE(runScenario(sim, "no-such-scenario").passed);
+}
+
+TEST(HeadlessSimulationTest, ScaledConfigRegistersEveryAxis) {
+    HeadlessSimulation sim(HeadlessConfig::scaled(3, 12, 2));
+
+    EXPECT_EQ(sim.allAxes().size(), 3u * 12u);
+    ASSERT_NE(sim.context("Group_02"), nullptr);
+    EXPECT_EQ(sim.context("Group_02")->axisCount(), 12u);
+    EXPECT_NE(sim.axis("Group_00", FakePLCConfig::extraAxisId(5)), nullptr);
+    EXPECT_EQ(sim.plc("Group_01")->gantryCount(), 2u);
+}
+
+TEST(HeadlessSimulationTest, LoadWorkloadMovesEveryAxis) {
+    HeadlessSimulation sim(HeadlessConfig::scaled(4, 16));
+    sim.setProfiling(true);
+
+    LoadResult r = runLoad(sim, 10.0);
+
+    EXPECT_EQ(r.axes, 4u * 15u);   // 每组的逻辑龙门轴 X 不参与
+    EXPECT_EQ(r.enabled, r.axes);
+    EXPECT_GE(r.movesCompleted, r.axes);
+    EXPECT_EQ(r.movesStalled, 0u);
+    EXPECT_EQ(r.axesWithErrors, 0u);
+    EXPECT_EQ(sim.profile().total.count(), sim.steps());
+}